@@ -22,7 +22,9 @@ def check_list(NEXUSDIR):
                   NEXUSDIR + "/macros/NEW.init.mac",
                   NEXUSDIR + "/macros/NEXT100_ovlp.init.mac",
                   NEXUSDIR + "/macros/NEXT100opt_ovlp.init.mac",
+                  NEXUSDIR + "/macros/NEXT100_parameterised_ovlp.init.mac",
                   NEXUSDIR + "/macros/NextFlex_ovlp.init.mac",
+                  NEXUSDIR + "/macros/NextFlex_parameterised_ovlp.init.mac",
                   NEXUSDIR + "/macros/NextTonScale.init.mac",
                   NEXUSDIR + "/macros/black_box.init.mac"]
 
@@ -32,7 +34,10 @@ def check_list(NEXUSDIR):
 @pytest.fixture(scope='module')
 def macro_list(NEXUSDIR):
 
-    all_macros = np.array(glob.glob(NEXUSDIR + '/macros/**/*.init.mac', recursive=True))
+    # The benchmark macros are run by nexus-bench, which sets their output file
+    all_macros = [m for m in glob.glob(NEXUSDIR + '/macros/**/*.init.mac', recursive=True)
+                  if '/macros/benchmarks/' not in m]
+    all_macros = np.array(all_macros)
     full       = np.array(['full'  in m    for m in all_macros])
     lu_table   = np.array(['table' in m or
                            'LT'    in m or
@@ -44,6 +44,7 @@ def test_hdf5_structure(detectors):
             assert 'length'             in pcolumns
             assert 'creator_proc'       in pcolumns
             assert 'final_proc'         in pcolumns
+            assert 'weight'             in pcolumns
 
 
             hcolumns = h5out.root.MC.hits.colnames
@@ -54,6 +55,7 @@ def test_hdf5_structure(detectors):
             assert 'z'           in hcolumns
             assert 'time'        in hcolumns
             assert 'energy'      in hcolumns
+            assert 'weight'      in hcolumns
             assert 'label'       in hcolumns
             assert 'particle_id' in hcolumns
             assert 'hit_id'      in hcolumns
@@ -209,3 +211,33 @@ def test_string_map_ids_are_in_hits_particles_tables(nexus_output_file_no_string
     assert np.all(np.isin(particles.final_volume.values, map_ids))
     assert np.all(np.isin(particles.creator_proc.values, map_ids))
     assert np.all(np.isin(particles.final_proc.values, map_ids))
+
+
+def test_performance_tables(nexus_output_file_no_strings):
+    """Check that the performance telemetry is stored for every event."""
+
+    with tb.open_file(nexus_output_file_no_strings) as h5out:
+        assert 'performance'           in h5out.root.MC
+        assert 'performance_particles' in h5out.root.MC
+
+    perf      = pd.read_hdf(nexus_output_file_no_strings, 'MC/performance')
+    perf_part = pd.read_hdf(nexus_output_file_no_strings, 'MC/performance_particles')
+    particles = pd.read_hdf(nexus_output_file_no_strings, 'MC/particles')
+
+    assert len(perf) == 1
+    assert np.all(perf.filter(like='time').values >= 0)
+    assert np.all(perf.peak_rss > 0)
+    assert np.all(perf_part.steps >= perf_part.tracks)
+    assert np.all(np.isin(perf.event_id[perf.event_id >= 0],
+                          particles.event_id.unique()))
+
+
+def test_particle_weights_without_biasing(nexus_output_file_no_strings):
+    """Check that all tracks have unit weight when no biasing is used."""
+
+    particles = pd.read_hdf(nexus_output_file_no_strings, 'MC/particles')
+
+    assert np.all(particles.weight == 1)
+
+    hits = pd.read_hdf(nexus_output_file_no_strings, 'MC/hits')
+    assert np.all(hits.weight == 1)
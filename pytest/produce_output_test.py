@@ -1,8 +1,13 @@
 import pytest
 
+import glob
 import os
+import shutil
+import signal
 import subprocess
 
+import pandas as pd
+
 common_init_params = """
 /PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
 /PhysicsList/RegisterPhysics G4DecayPhysics
@@ -41,6 +46,52 @@ def run_simulation(NEXUSDIR, init_path):
     command   = [nexus_exe, '-b', '-n', '1', init_path]
     p         = subprocess.run(command, check=True, env=my_env)
 
+def job_command(NEXUSDIR, config_tmpdir, base_name, output, nevents,
+                resume=False, max_file_events=0, max_file_size=0,
+                generator='SingleParticleGenerator', generator_params=None):
+    """Write the macros of a job in the NEXT-100 geometry that writes a
+    checkpoint after each event, and return the command that runs it."""
+    init_text = f"""
+/nexus/RegisterGeometry Next100OpticalGeometry
+
+/nexus/RegisterGenerator {generator}
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+    init_text = f'{common_init_params} {init_text}'
+    init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+    with open(init_path, 'w') as init_file:
+        init_file.write(init_text)
+
+    if generator_params is None:
+        generator_params = f'/Generator/SingleParticle/region CENTER\n{single_part_params}'
+
+    config_text = f"""
+/Geometry/Next100/pressure 15. bar
+/Geometry/Next100/elfield false
+
+/nexus/persistency/save_strings false
+/nexus/persistency/checkpoint_interval 1
+/nexus/persistency/max_file_events {max_file_events}
+/nexus/persistency/max_file_size {max_file_size}
+/nexus/persistency/output_file {output}
+/nexus/random_seed 21051817
+"""
+    config_text = f'{config_text} {generator_params}'
+    with open(os.path.join(config_tmpdir, base_name+'.config.mac'), 'w') as config_file:
+        config_file.write(config_text)
+
+    command = [NEXUSDIR + '/bin/nexus', '-b', '-n', str(nevents), init_path]
+    if resume:
+        command.insert(2, '-r')
+    return command
+
+def run_job(*args, **kwargs):
+    subprocess.run(job_command(*args, **kwargs), check=True, env=os.environ)
+
+def read_table(filename, table):
+    return pd.read_hdf(filename, 'MC/' + table).reset_index(drop=True)
+
 @pytest.mark.order(1)
 def test_create_nexus_output_file_next100(config_tmpdir, output_tmpdir,
                                           NEXUSDIR,
@@ -287,6 +338,8 @@ def test_create_nexus_output_file_no_strings(config_tmpdir, output_tmpdir,
 
 /nexus/RegisterGenerator SingleParticleGenerator
 
+/nexus/performance_monitor true
+
 /nexus/RegisterMacro {config_tmpdir}/{base_name_no_strings}.config.mac
 """
     init_text = f'{common_init_params} {init_text}'
@@ -319,3 +372,410 @@ def test_create_nexus_output_file_no_strings(config_tmpdir, output_tmpdir,
     run_simulation(NEXUSDIR, init_path)
 
     return nexus_output_file_no_strings
+
+
+@pytest.mark.order(6)
+def test_event_range_is_reproducible(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that an event simulated on its own with -e is identical
+    to the same event simulated in a longer range."""
+
+    base_name = 'event_range'
+    init_text = f"""
+/nexus/RegisterGeometry Next100OpticalGeometry
+
+/nexus/RegisterGenerator SingleParticleGenerator
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+    init_text = f'{common_init_params} {init_text}'
+    init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+    with open(init_path, 'w') as init_file:
+        init_file.write(init_text)
+
+    def run_range(first, count, seed=21051817):
+        output = f'{output_tmpdir}/{base_name}_{first}_{count}_{seed}'
+        seed_text = '' if seed is None else f'/nexus/random_seed {seed}'
+        config_text = f"""
+/Generator/SingleParticle/region CENTER
+/Geometry/Next100/pressure 15. bar
+/Geometry/Next100/elfield false
+
+/nexus/persistency/save_strings true
+/nexus/persistency/output_file {output}
+{seed_text}
+"""
+        config_text = f'{config_text} {single_part_params}'
+        with open(os.path.join(config_tmpdir, base_name+'.config.mac'), 'w') as config_file:
+            config_file.write(config_text)
+
+        command = [NEXUSDIR + '/bin/nexus', '-b', '-e', f'{first}:{count}', init_path]
+        subprocess.run(command, check=True, env=os.environ)
+        return pd.read_hdf(output + '.h5', 'MC/particles')
+
+    full   = run_range(10, 3)
+    single = run_range(12, 1)
+
+    assert sorted(full.event_id.unique()) == [10, 11, 12]
+    assert single.event_id.unique().tolist() == [12]
+
+    event = full[full.event_id == 12].reset_index(drop=True)
+    pd.testing.assert_frame_equal(event, single.reset_index(drop=True))
+
+    # All the bits of the seed are used
+    other = run_range(12, 1, 21051817 + 2**32)
+    assert not other.reset_index(drop=True).equals(single.reset_index(drop=True))
+
+    # Without a seed the events could not be simulated again
+    with pytest.raises(subprocess.CalledProcessError):
+        run_range(12, 1, None)
+
+
+@pytest.mark.order(7)
+def test_resumed_job_is_identical(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that a job continued from a checkpoint with -r produces
+    the same events as a job run in one go."""
+
+    base_name = 'resume'
+    full    = f'{output_tmpdir}/{base_name}_full'
+    resumed = f'{output_tmpdir}/{base_name}_resumed'
+    job = (NEXUSDIR, config_tmpdir, base_name)
+    run_job(*job, full,    4)
+    run_job(*job, resumed, 2)
+    run_job(*job, resumed, 4, resume=True)
+
+    for table in ['particles', 'hits', 'string_map']:
+        pd.testing.assert_frame_equal(read_table(full + '.h5', table),
+                                      read_table(resumed + '.h5', table))
+
+    # The configuration of the first part of the job is replaced
+    assert (len(read_table(full    + '.h5', 'configuration')) ==
+            len(read_table(resumed + '.h5', 'configuration')))
+
+    conf = read_table(resumed + '.h5', 'configuration')
+    conf = dict(zip(conf.param_key, conf.param_value))
+    assert conf['num_events']   == '4'
+    assert conf['saved_events'] == '4'
+
+
+@pytest.mark.order(8)
+def test_rotated_output_is_identical(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that an output split in several files holds the same
+    events as a single file, and that each file stands on its own."""
+
+    base_name = 'rotation'
+    single  = f'{output_tmpdir}/{base_name}_single'
+    rotated = f'{output_tmpdir}/{base_name}_rotated'
+    job = (NEXUSDIR, config_tmpdir, base_name)
+    run_job(*job, single,  5)
+    run_job(*job, rotated, 5, max_file_events=2)
+
+    files = [f'{rotated}.{i:04d}.h5' for i in range(3)]
+    assert all(os.path.isfile(f) for f in files)
+    assert not os.path.isfile(f'{rotated}.0003.h5')
+
+    for table in ['particles', 'hits']:
+        parts = pd.concat([read_table(f, table) for f in files], ignore_index=True)
+        pd.testing.assert_frame_equal(read_table(single + '.h5', table), parts)
+
+    for i, filename in enumerate(files):
+        conf = read_table(filename, 'configuration')
+        conf = dict(zip(conf.param_key, conf.param_value))
+        assert conf['file_index']   == str(i)
+        assert conf['saved_events'] == ('2' if i < 2 else '1')
+
+        # Event ids go on from one file to the next, and the
+        # string map of each file covers all its ids
+        particles = read_table(filename, 'particles')
+        assert sorted(particles.event_id.unique()) == list(range(2*i, min(2*i + 2, 5)))
+
+        map_ids = read_table(filename, 'string_map').name_id.values
+        assert particles.particle_name.isin(map_ids).all()
+        assert particles.initial_volume.isin(map_ids).all()
+
+
+@pytest.mark.order(9)
+def test_resumed_pool_job_is_identical(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that a job reading a Decay0 pool goes on from the same
+    event of the pool when it is resumed."""
+
+    pool = f'{output_tmpdir}/resume_pool.bin'
+    command = [NEXUSDIR + '/bin/nexus-decay0-pool', '-n', '20', '-o', pool, '-s', '4356']
+    subprocess.run(command, check=True, env=os.environ)
+
+    base_name = 'resume_pool'
+    job = (NEXUSDIR, config_tmpdir, base_name)
+
+    def pool_params(decay_mode):
+        return f"""
+/Generator/Decay0Interface/region CENTER
+/Generator/Decay0Interface/pool_file {pool}
+/Generator/Decay0Interface/Xe136DecayMode {decay_mode}
+"""
+    pool_job = dict(generator='Decay0Interface', generator_params=pool_params(1))
+
+    full    = f'{output_tmpdir}/{base_name}_full'
+    resumed = f'{output_tmpdir}/{base_name}_resumed'
+    run_job(*job, full,    4, **pool_job)
+    run_job(*job, resumed, 2, **pool_job)
+    run_job(*job, resumed, 4, resume=True, **pool_job)
+
+    # The primaries of each event come from a different event of the pool
+    particles = read_table(full + '.h5', 'particles')
+    primaries = particles[particles.primary == 1]
+    assert primaries.groupby('event_id').ini_momentum_x.sum().nunique() == 4
+
+    for table in ['particles', 'hits']:
+        pd.testing.assert_frame_equal(read_table(full + '.h5', table),
+                                      read_table(resumed + '.h5', table))
+
+    # A pool generated for another decay mode is rejected
+    with pytest.raises(subprocess.CalledProcessError):
+        run_job(*job, f'{output_tmpdir}/{base_name}_bb2nu', 1,
+                generator='Decay0Interface', generator_params=pool_params(4))
+
+
+@pytest.mark.order(10)
+def test_resumed_rotated_job_is_identical(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that a job split in several files goes on in the right
+    file when it is resumed, without writing again the files it
+    finished, and that the output can be split by size."""
+
+    base_name = 'resume_rotation'
+    job = (NEXUSDIR, config_tmpdir, base_name)
+
+    def rotated_files(output):
+        files = [f'{output}.{i:04d}.h5' for i in range(10)]
+        return [f for f in files if os.path.isfile(f)]
+
+    def assert_same_events(single, files):
+        for table in ['particles', 'hits']:
+            parts = pd.concat([read_table(f, table) for f in files], ignore_index=True)
+            pd.testing.assert_frame_equal(read_table(single + '.h5', table), parts)
+
+    single  = f'{output_tmpdir}/{base_name}_single'
+    rotated = f'{output_tmpdir}/{base_name}_rotated'
+    resumed = f'{output_tmpdir}/{base_name}_resumed'
+    crashed = f'{output_tmpdir}/{base_name}_crashed'
+    run_job(*job, single,  5)
+    run_job(*job, rotated, 5, max_file_events=2)
+
+    # Stopped in the second file, after the first one was finished
+    run_job(*job, resumed, 3, max_file_events=2)
+    for i in range(2):
+        shutil.copy(f'{resumed}.{i:04d}.h5', f'{crashed}.{i:04d}.h5')
+    run_job(*job, resumed, 5, resume=True, max_file_events=2)
+
+    # Stopped when the second file was created, before its first checkpoint
+    open(f'{crashed}.0001.h5', 'w').close()
+    finished = read_table(f'{crashed}.0000.h5', 'configuration')
+    run_job(*job, crashed, 5, resume=True, max_file_events=2)
+
+    # The finished file is left as it was
+    pd.testing.assert_frame_equal(read_table(f'{crashed}.0000.h5', 'configuration'), finished)
+
+    for output in [resumed, crashed]:
+        files = rotated_files(output)
+        assert len(files) == 3
+        assert_same_events(single, files)
+
+        # Each file holds its configuration once
+        for filename, reference in zip(files, rotated_files(rotated)):
+            conf = read_table(filename, 'configuration')
+            assert len(conf) == len(read_table(reference, 'configuration'))
+            for key in ['file_index', 'num_events', 'saved_events']:
+                assert (conf.param_key == key).sum() == 1
+
+    # Every file is full after its first event
+    by_size = f'{output_tmpdir}/{base_name}_size'
+    run_job(*job, by_size, 5, max_file_size=0.001)
+    files = rotated_files(by_size)
+    assert len(files) == 5
+    assert_same_events(single, files)
+
+
+@pytest.mark.order(11)
+def test_killed_job_is_resumed(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that a job killed at any point, even while writing a
+    checkpoint, goes on from its last complete checkpoint."""
+
+    base_name = 'killed'
+    job = (NEXUSDIR, config_tmpdir, base_name)
+    nevents = 40
+
+    full = f'{output_tmpdir}/{base_name}_full'
+    run_job(*job, full, nevents)
+
+    # Killed without warning once half of the events are simulated
+    killed = f'{output_tmpdir}/{base_name}_resumed'
+    command = job_command(*job, killed, nevents)
+    process = subprocess.Popen(command, stdout=subprocess.PIPE, text=True, env=os.environ)
+    for line in process.stdout:
+        if f'Event no. {nevents // 2}' in line:
+            process.send_signal(signal.SIGKILL)
+            break
+    process.wait()
+    assert process.returncode == -signal.SIGKILL
+
+    run_job(*job, killed, nevents, resume=True)
+
+    for table in ['particles', 'hits', 'string_map']:
+        pd.testing.assert_frame_equal(read_table(full + '.h5', table),
+                                      read_table(killed + '.h5', table))
+
+
+@pytest.mark.order(12)
+def test_hit_weights_with_biasing(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that each energy deposit keeps the weight of its track
+    when it was left, with importance biasing of the gammas."""
+
+    base_name = 'biasing'
+    init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics G4RadioactiveDecayPhysics
+/PhysicsList/RegisterPhysics NexusPhysics
+/PhysicsList/RegisterPhysics G4StepLimiterPhysics
+/PhysicsList/RegisterPhysics ImportanceBiasingPhysics
+
+/nexus/RegisterGeometry Next100
+
+/nexus/RegisterGenerator SingleParticleGenerator
+
+/nexus/RegisterPersistencyManager PersistencyManager
+
+/nexus/RegisterTrackingAction DefaultTrackingAction
+/nexus/RegisterEventAction DefaultEventAction
+/nexus/RegisterRunAction DefaultRunAction
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+    init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+    with open(init_path, 'w') as init_file:
+        init_file.write(init_text)
+
+    # Gammas from the vessel are split in four when they enter the gas
+    config_text = f"""
+/PhysicsList/Nexus/clustering          false
+/PhysicsList/Nexus/drift               false
+/PhysicsList/Nexus/electroluminescence false
+
+/PhysicsList/Importance/particles gamma
+/PhysicsList/Importance/volume VESSEL     1
+/PhysicsList/Importance/volume VESSEL_GAS 4
+
+/Generator/SingleParticle/particle gamma
+/Generator/SingleParticle/min_energy 2.447 MeV
+/Generator/SingleParticle/max_energy 2.447 MeV
+/Generator/SingleParticle/region VESSEL
+
+/nexus/persistency/output_file {output_tmpdir}/{base_name}
+/nexus/random_seed 21051817
+"""
+    with open(os.path.join(config_tmpdir, base_name+'.config.mac'), 'w') as config_file:
+        config_file.write(config_text)
+
+    command = [NEXUSDIR + '/bin/nexus', '-b', '-n', '100', init_path]
+    subprocess.run(command, check=True, env=os.environ)
+
+    filename  = f'{output_tmpdir}/{base_name}.h5'
+    particles = pd.read_hdf(filename, 'MC/particles')
+    hits      = pd.read_hdf(filename, 'MC/hits')
+
+    assert (particles.weight != 1).any()
+    assert len(hits) > 0
+
+    hits = hits.merge(particles[['event_id', 'particle_id', 'particle_name', 'weight']],
+                      on=['event_id', 'particle_id'], suffixes=('', '_track'))
+
+    # The gammas in the gas, where the detector is, are split
+    gammas = hits[hits.particle_name == 'gamma']
+    assert (gammas.weight == 0.25).all()
+
+    # Other particles are not biased and keep their weight
+    others = hits[hits.particle_name != 'gamma']
+    assert (others.weight == others.weight_track).all()
+    assert (others.weight == 0.25).any()
+
+
+@pytest.mark.order(13)
+def test_persistency_manager_plugin(config_tmpdir, output_tmpdir, NEXUSDIR):
+    """Check that a persistency manager built as a separate library
+    is loaded with /nexus/LoadPlugin and chosen by name."""
+
+    plugin_text = """
+#include "PersistencyManagerBase.h"
+#include "FactoryBase.h"
+
+#include <G4Event.hh>
+#include <G4ios.hh>
+
+class PluginPersistencyManager: public PersistencyManagerBase
+{
+public:
+  void OpenFile() {}
+  void CloseFile() {}
+  G4long ResumeFile() { return 0; }
+
+  G4bool Store(const G4Event* event)
+  {
+    const nexus::EventView& view = GetEventView(event);
+    G4cout << "[PluginPersistencyManager] Event " << view.GetEventID() << G4endl;
+    return true;
+  }
+  G4bool Store(const G4Run*) { return true; }
+  G4bool Store(const G4VPhysicalVolume*) { return false; }
+
+  G4bool Retrieve(G4Event*&) { return false; }
+  G4bool Retrieve(G4Run*&) { return false; }
+  G4bool Retrieve(G4VPhysicalVolume*&) { return false; }
+};
+
+REGISTER_CLASS(PluginPersistencyManager, PersistencyManagerBase)
+"""
+    plugin_src = os.path.join(config_tmpdir, 'plugin.cc')
+    plugin_lib = os.path.join(output_tmpdir, 'libplugin.so')
+    with open(plugin_src, 'w') as plugin_file:
+        plugin_file.write(plugin_text)
+
+    # Built against the headers only: the nexus symbols
+    # are taken from the executable when it is loaded
+    includes = ' '.join(f'-I{d}' for d in glob.glob(NEXUSDIR + '/source/*/'))
+    subprocess.run(f'g++ -std=c++17 -shared -fPIC {includes} $(geant4-config --cflags) '
+                   f'-o {plugin_lib} {plugin_src}', shell=True, check=True)
+
+    base_name = 'plugin'
+    init_text = f"""
+/PhysicsList/RegisterPhysics G4EmStandardPhysics_option4
+/PhysicsList/RegisterPhysics G4DecayPhysics
+/PhysicsList/RegisterPhysics NexusPhysics
+
+/nexus/RegisterGeometry Next100OpticalGeometry
+
+/nexus/RegisterGenerator SingleParticleGenerator
+
+/nexus/LoadPlugin {plugin_lib}
+/nexus/RegisterPersistencyManager PluginPersistencyManager
+
+/nexus/RegisterMacro {config_tmpdir}/{base_name}.config.mac
+"""
+    init_path = os.path.join(config_tmpdir, base_name+'.init.mac')
+    with open(init_path, 'w') as init_file:
+        init_file.write(init_text)
+
+    config_text = f"""
+/Generator/SingleParticle/region CENTER
+/Geometry/Next100/elfield false
+/PhysicsList/Nexus/clustering          false
+/PhysicsList/Nexus/drift               false
+/PhysicsList/Nexus/electroluminescence false
+"""
+    config_text = f'{config_text} {single_part_params}'
+    with open(os.path.join(config_tmpdir, base_name+'.config.mac'), 'w') as config_file:
+        config_file.write(config_text)
+
+    command = [NEXUSDIR + '/bin/nexus', '-b', '-n', '2', init_path]
+    job = subprocess.run(command, check=True, env=os.environ,
+                         stdout=subprocess.PIPE, text=True)
+
+    assert '[PluginPersistencyManager] Event 0' in job.stdout
+    assert '[PluginPersistencyManager] Event 1' in job.stdout
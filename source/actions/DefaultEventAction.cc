@@ -9,7 +9,7 @@
 
 #include "DefaultEventAction.h"
 #include "Trajectory.h"
-#include "PersistencyManager.h"
+#include "PersistencyManagerBase.h"
 #include "IonizationHit.h"
 #include "FactoryBase.h"
 
@@ -46,7 +46,7 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
     max_energy_cmd.SetUnitCategory("Energy");
     max_energy_cmd.SetRange("max_energy>0.");
 
-    PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+    PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
       (G4VPersistencyManager::GetPersistencyManager());
 
     pm->SaveNumbOfInteractingEvents(true);
@@ -106,7 +106,7 @@ REGISTER_CLASS(DefaultEventAction, G4UserEventAction)
                     "and not using OpticalTrackingAction, you should not specify any event actions.");
       }
 
-      PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+      PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
         (G4VPersistencyManager::GetPersistencyManager());
 
       if (!event->IsAborted() && edep>0) {
@@ -74,6 +74,7 @@ void DefaultTrackingAction::PostUserTrackingAction(const G4Track *track)
   trj->SetTrackLength(track->GetTrackLength());
   trj->SetFinalVolume(track->GetVolume()->GetName());
   trj->SetFinalMomentum(track->GetMomentum());
+  trj->SetWeight(track->GetWeight());
 
   // Record last process of the track
   G4String proc_name = track->GetStep()->GetPostStepPoint()->GetProcessDefinedStep()->GetProcessName();
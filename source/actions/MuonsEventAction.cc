@@ -9,7 +9,7 @@
 
 #include "MuonsEventAction.h"
 #include "Trajectory.h"
-#include "PersistencyManager.h"
+#include "PersistencyManagerBase.h"
 #include "IonizationHit.h"
 #include "FactoryBase.h"
 
@@ -112,7 +112,7 @@ REGISTER_CLASS(MuonsEventAction, G4UserEventAction)
       // Control plot for energy
       fG4AnalysisMan_->FillH1(0, edep);
 
-      PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+      PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
         (G4VPersistencyManager::GetPersistencyManager());
 
       if (edep > energy_threshold_) pm->StoreCurrentEvent(true);
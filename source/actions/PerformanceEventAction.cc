@@ -0,0 +1,39 @@
+// ----------------------------------------------------------------------------
+// nexus | PerformanceEventAction.cc
+//
+// This event action delimits the events for the PerformanceMonitor.
+// It is installed by NexusApp alongside the user event action when the
+// performance monitor is enabled; it is not meant to be registered directly.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PerformanceEventAction.h"
+#include "PerformanceMonitor.h"
+
+using namespace nexus;
+
+
+PerformanceEventAction::PerformanceEventAction(): G4UserEventAction()
+{
+}
+
+
+
+PerformanceEventAction::~PerformanceEventAction()
+{
+}
+
+
+
+void PerformanceEventAction::BeginOfEventAction(const G4Event*)
+{
+  PerformanceMonitor::Instance().BeginOfEvent();
+}
+
+
+
+void PerformanceEventAction::EndOfEventAction(const G4Event*)
+{
+  PerformanceMonitor::Instance().EndOfEvent();
+}
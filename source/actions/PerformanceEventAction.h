@@ -0,0 +1,35 @@
+// ----------------------------------------------------------------------------
+// nexus | PerformanceEventAction.h
+//
+// This event action delimits the events for the PerformanceMonitor.
+// It is installed by NexusApp alongside the user event action when the
+// performance monitor is enabled; it is not meant to be registered directly.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PERFORMANCE_EVENT_ACTION_H
+#define PERFORMANCE_EVENT_ACTION_H
+
+#include <G4UserEventAction.hh>
+
+class G4Event;
+
+
+namespace nexus {
+
+  class PerformanceEventAction: public G4UserEventAction
+  {
+  public:
+    /// Constructor
+    PerformanceEventAction();
+    /// Destructor
+    ~PerformanceEventAction();
+
+    void BeginOfEventAction(const G4Event*);
+    void EndOfEventAction(const G4Event*);
+  };
+
+} // namespace nexus
+
+#endif
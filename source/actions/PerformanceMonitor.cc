@@ -0,0 +1,169 @@
+// ----------------------------------------------------------------------------
+// nexus | PerformanceMonitor.cc
+//
+// This class collects per-event performance telemetry: wall and CPU time
+// split by simulation stage (particle tracking, ionization drift and optical
+// photon transport), number of tracks and steps per particle type, number
+// of secondaries created by the clustering and electroluminescence
+// processes and peak resident memory. It is fed by PerformanceEventAction
+// and PerformanceTrackingAction, which are only installed when the
+// /nexus/performance_monitor command is enabled in the init macro.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PerformanceMonitor.h"
+
+#include "IonizationElectron.h"
+#include "IonizationClustering.h"
+#include "Electroluminescence.h"
+
+#include <G4Track.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4VProcess.hh>
+
+#include <sys/resource.h>
+
+using namespace nexus;
+
+namespace {
+  enum CreatorCategory { OTHER_CREATOR, CLUSTERING_CREATOR, EL_CREATOR };
+}
+
+
+PerformanceMonitor& PerformanceMonitor::Instance()
+{
+  static PerformanceMonitor monitor;
+  return monitor;
+}
+
+
+
+PerformanceMonitor::PerformanceMonitor():
+  enabled_(false), stage_(TRACKING), cpu_start_(0),
+  clust_secondaries_(0), el_secondaries_(0), peak_rss_(0.),
+  total_events_(0), total_tracks_(0), total_steps_(0)
+{
+  for (G4int i=0; i<NUM_STAGES; ++i) {
+    wall_time_[i] = 0.;
+    cpu_time_[i]  = 0.;
+  }
+}
+
+
+
+PerformanceMonitor::~PerformanceMonitor()
+{
+}
+
+
+
+void PerformanceMonitor::BeginOfEvent()
+{
+  for (G4int i=0; i<NUM_STAGES; ++i) {
+    wall_time_[i] = 0.;
+    cpu_time_[i]  = 0.;
+  }
+  clust_secondaries_ = 0;
+  el_secondaries_    = 0;
+  particles_.clear();
+
+  stage_      = TRACKING;
+  wall_start_ = std::chrono::steady_clock::now();
+  cpu_start_  = std::clock();
+}
+
+
+
+void PerformanceMonitor::EndOfEvent()
+{
+  // Close the interval of the stage being timed
+  SwitchStage(stage_);
+  total_events_++;
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  peak_rss_ = usage.ru_maxrss / (1024. * 1024.); // bytes
+#else
+  peak_rss_ = usage.ru_maxrss / 1024.; // kilobytes
+#endif
+}
+
+
+
+void PerformanceMonitor::BeginOfTrack(const G4Track* track)
+{
+  // Clocks are only read when the stage changes, which happens
+  // rarely since tracks of the same type are usually stacked together
+  Stage stage = GetStage(track);
+  if (stage != stage_) SwitchStage(stage);
+}
+
+
+
+void PerformanceMonitor::EndOfTrack(const G4Track* track,
+                                    const G4TrackVector* secondaries)
+{
+  // A suspended track will be resumed later on, so count it only once
+  if (track->GetTrackStatus() != fSuspend) {
+    ParticleCounts& counts = particles_[track->GetDefinition()];
+    counts.tracks++;
+    counts.steps += track->GetCurrentStepNumber();
+    total_tracks_++;
+    total_steps_ += track->GetCurrentStepNumber();
+  }
+
+  if (!secondaries) return;
+
+  for (const G4Track* sec : *secondaries) {
+    G4int category = GetCreatorCategory(sec->GetCreatorProcess());
+    if (category == CLUSTERING_CREATOR) clust_secondaries_++;
+    else if (category == EL_CREATOR) el_secondaries_++;
+  }
+}
+
+
+
+PerformanceMonitor::Stage PerformanceMonitor::GetStage(const G4Track* track) const
+{
+  const G4ParticleDefinition* pdef = track->GetDefinition();
+  if (pdef == G4OpticalPhoton::Definition()) return OPTICAL;
+  if (pdef == IonizationElectron::Definition()) return DRIFT;
+  return TRACKING;
+}
+
+
+
+void PerformanceMonitor::SwitchStage(Stage stage)
+{
+  auto wall_now = std::chrono::steady_clock::now();
+  std::clock_t cpu_now = std::clock();
+
+  wall_time_[stage_] +=
+    std::chrono::duration<G4double>(wall_now - wall_start_).count();
+  cpu_time_[stage_] += G4double(cpu_now - cpu_start_) / CLOCKS_PER_SEC;
+
+  stage_      = stage;
+  wall_start_ = wall_now;
+  cpu_start_  = cpu_now;
+}
+
+
+
+G4int PerformanceMonitor::GetCreatorCategory(const G4VProcess* proc)
+{
+  if (!proc) return OTHER_CREATOR;
+
+  auto it = creators_.find(proc);
+  if (it != creators_.end()) return it->second;
+
+  G4int category = OTHER_CREATOR;
+  if (dynamic_cast<const IonizationClustering*>(proc))
+    category = CLUSTERING_CREATOR;
+  else if (dynamic_cast<const Electroluminescence*>(proc))
+    category = EL_CREATOR;
+
+  creators_[proc] = category;
+  return category;
+}
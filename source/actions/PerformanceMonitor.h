@@ -0,0 +1,120 @@
+// ----------------------------------------------------------------------------
+// nexus | PerformanceMonitor.h
+//
+// This class collects per-event performance telemetry: wall and CPU time
+// split by simulation stage (particle tracking, ionization drift and optical
+// photon transport), number of tracks and steps per particle type, number
+// of secondaries created by the clustering and electroluminescence
+// processes and peak resident memory. It is fed by PerformanceEventAction
+// and PerformanceTrackingAction, which are only installed when the
+// /nexus/performance_monitor command is enabled in the init macro.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PERFORMANCE_MONITOR_H
+#define PERFORMANCE_MONITOR_H
+
+#include <globals.hh>
+#include <G4TrackVector.hh>
+
+#include <chrono>
+#include <ctime>
+#include <map>
+
+class G4Track;
+class G4VProcess;
+class G4ParticleDefinition;
+
+
+namespace nexus {
+
+  class PerformanceMonitor
+  {
+  public:
+    /// Simulation stages for which time is accounted separately
+    enum Stage { TRACKING = 0, DRIFT, OPTICAL, NUM_STAGES };
+
+    struct ParticleCounts {
+      G4long tracks = 0;
+      G4long steps  = 0;
+    };
+
+    /// Return the (Meyers-style) singleton instance of the monitor
+    static PerformanceMonitor& Instance();
+
+    void Enable(G4bool);
+    G4bool IsEnabled() const;
+
+    void BeginOfEvent();
+    void EndOfEvent();
+    void BeginOfTrack(const G4Track*);
+    void EndOfTrack(const G4Track*, const G4TrackVector* secondaries);
+
+    /// Wall and CPU time (in seconds) spent in a stage in the last event
+    G4double GetWallTime(Stage) const;
+    G4double GetCpuTime(Stage) const;
+
+    G4long GetClusteringSecondaries() const;
+    G4long GetELSecondaries() const;
+
+    /// Peak resident set size of the process (in MB) at the end of the event
+    G4double GetPeakRSS() const;
+
+    const std::map<const G4ParticleDefinition*, ParticleCounts>&
+    GetParticleCounts() const;
+
+    /// Totals accumulated over all the events processed so far
+    G4long GetTotalEvents() const;
+    G4long GetTotalTracks() const;
+    G4long GetTotalSteps() const;
+
+  private:
+    PerformanceMonitor();
+    ~PerformanceMonitor();
+    PerformanceMonitor(const PerformanceMonitor&);
+
+    Stage GetStage(const G4Track*) const;
+    void SwitchStage(Stage);
+    G4int GetCreatorCategory(const G4VProcess*);
+
+  private:
+    G4bool enabled_;
+
+    Stage stage_; ///< stage currently being timed
+    std::chrono::steady_clock::time_point wall_start_;
+    std::clock_t cpu_start_;
+
+    G4double wall_time_[NUM_STAGES];
+    G4double cpu_time_[NUM_STAGES];
+
+    G4long clust_secondaries_;
+    G4long el_secondaries_;
+    G4double peak_rss_;
+
+    std::map<const G4ParticleDefinition*, ParticleCounts> particles_;
+
+    G4long total_events_;
+    G4long total_tracks_;
+    G4long total_steps_;
+    std::map<const G4VProcess*, G4int> creators_; ///< cached process categories
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void PerformanceMonitor::Enable(G4bool enable) { enabled_ = enable; }
+  inline G4bool PerformanceMonitor::IsEnabled() const { return enabled_; }
+  inline G4double PerformanceMonitor::GetWallTime(Stage s) const { return wall_time_[s]; }
+  inline G4double PerformanceMonitor::GetCpuTime(Stage s) const { return cpu_time_[s]; }
+  inline G4long PerformanceMonitor::GetClusteringSecondaries() const { return clust_secondaries_; }
+  inline G4long PerformanceMonitor::GetELSecondaries() const { return el_secondaries_; }
+  inline G4double PerformanceMonitor::GetPeakRSS() const { return peak_rss_; }
+  inline const std::map<const G4ParticleDefinition*, PerformanceMonitor::ParticleCounts>&
+  PerformanceMonitor::GetParticleCounts() const { return particles_; }
+  inline G4long PerformanceMonitor::GetTotalEvents() const { return total_events_; }
+  inline G4long PerformanceMonitor::GetTotalTracks() const { return total_tracks_; }
+  inline G4long PerformanceMonitor::GetTotalSteps() const { return total_steps_; }
+
+} // namespace nexus
+
+#endif
@@ -0,0 +1,44 @@
+// ----------------------------------------------------------------------------
+// nexus | PerformanceTrackingAction.cc
+//
+// This tracking action feeds the PerformanceMonitor with the stage, step
+// count and secondaries of every track. It is installed by NexusApp alongside
+// the user tracking action when the performance monitor is enabled; it is
+// not meant to be registered directly.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PerformanceTrackingAction.h"
+#include "PerformanceMonitor.h"
+
+#include <G4Track.hh>
+#include <G4TrackingManager.hh>
+
+using namespace nexus;
+
+
+PerformanceTrackingAction::PerformanceTrackingAction(): G4UserTrackingAction()
+{
+}
+
+
+
+PerformanceTrackingAction::~PerformanceTrackingAction()
+{
+}
+
+
+
+void PerformanceTrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  PerformanceMonitor::Instance().BeginOfTrack(track);
+}
+
+
+
+void PerformanceTrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  PerformanceMonitor::Instance().EndOfTrack(track,
+                                            fpTrackingManager->GimmeSecondaries());
+}
@@ -0,0 +1,36 @@
+// ----------------------------------------------------------------------------
+// nexus | PerformanceTrackingAction.h
+//
+// This tracking action feeds the PerformanceMonitor with the stage, step
+// count and secondaries of every track. It is installed by NexusApp alongside
+// the user tracking action when the performance monitor is enabled; it is
+// not meant to be registered directly.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PERFORMANCE_TRACKING_ACTION_H
+#define PERFORMANCE_TRACKING_ACTION_H
+
+#include <G4UserTrackingAction.hh>
+
+class G4Track;
+
+
+namespace nexus {
+
+  class PerformanceTrackingAction: public G4UserTrackingAction
+  {
+  public:
+    /// Constructor
+    PerformanceTrackingAction();
+    /// Destructor
+    virtual ~PerformanceTrackingAction();
+
+    virtual void PreUserTrackingAction(const G4Track*);
+    virtual void PostUserTrackingAction(const G4Track*);
+  };
+
+} // namespace nexus
+
+#endif
@@ -19,7 +19,7 @@
 // ----------------------------------------------------------------------------
 
 #include "SaveAllSteppingAction.h"
-#include "PersistencyManager.h"
+#include "PersistencyManagerBase.h"
 #include "FactoryBase.h"
 
 #include <G4Step.hh>
@@ -56,7 +56,7 @@ kill_after_selection_(false)
   msg_->DeclareProperty("kill_after_selection", kill_after_selection_,
                         "Whether to kill a particle after a step has been selected");
 
-  PersistencyManager* pm = dynamic_cast<PersistencyManager*>
+  PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
         (G4VPersistencyManager::GetPersistencyManager());
 
   pm->StoreSteps(true);
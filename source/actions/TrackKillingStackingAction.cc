@@ -0,0 +1,206 @@
+// ----------------------------------------------------------------------------
+// nexus | TrackKillingStackingAction.cc
+//
+// This class kills new secondary tracks that cannot contribute to the
+// signal, according to rules on particle type, kinetic energy and creation
+// volume. Optical photons created after the acquisition window of every
+// sensor can be killed too. The number of tracks killed by each rule in a
+// run is stored in the configuration table, and printed, at the end of it.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "TrackKillingStackingAction.h"
+
+#include "FactoryBase.h"
+#include "PersistencyManagerBase.h"
+#include "SensorSD.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4ParticleTable.hh>
+#include <G4PhysicalVolumeStore.hh>
+#include <G4RunManager.hh>
+#include <G4Run.hh>
+#include <G4Track.hh>
+#include <G4UIcommand.hh>
+#include <G4UnitsTable.hh>
+#include <G4VTouchable.hh>
+
+#include <sstream>
+
+
+using namespace nexus;
+
+REGISTER_CLASS(TrackKillingStackingAction, G4UserStackingAction)
+
+TrackKillingStackingAction::TrackKillingStackingAction():
+  G4UserStackingAction(), pm_(nullptr), resolved_(false), run_id_(-1),
+  kill_after_daq_(false), nkilled_after_daq_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/Actions/TrackKillingStackingAction/");
+  msg_->DeclareMethod("kill", &TrackKillingStackingAction::AddRule,
+                      "Kill new tracks: 'particle threshold unit volume inside|outside'. "
+                      "Use 'all' for any particle or volume, and a null "
+                      "threshold to kill tracks of any energy.");
+  msg_->DeclareProperty("kill_after_daq_window", kill_after_daq_,
+                        "Kill optical photons created after the acquisition "
+                        "window of every sensor.");
+}
+
+
+
+TrackKillingStackingAction::~TrackKillingStackingAction()
+{
+  delete msg_;
+}
+
+
+
+void TrackKillingStackingAction::AddRule(G4String command)
+{
+  std::istringstream iss(command);
+  KillRule rule;
+  G4String unit, location;
+  iss >> rule.particle_name >> rule.threshold >> unit
+      >> rule.volume_name >> location;
+
+  if (iss.fail() || rule.threshold < 0. ||
+      (location != "inside" && location != "outside") ||
+      (rule.volume_name == "all" && location == "outside"))
+    G4Exception("[TrackKillingStackingAction]", "AddRule()",
+                FatalException, ("Wrong kill rule: " + command).c_str());
+
+  // An unknown unit would give a null threshold, which kills
+  // the tracks of any energy
+  if (!G4UnitDefinition::IsUnitDefined(unit))
+    G4Exception("[TrackKillingStackingAction]", "AddRule()",
+                FatalException, ("Unknown unit " + unit + " in kill rule: " + command).c_str());
+
+  rule.threshold *= G4UIcommand::ValueOf(unit);
+  rule.inside = (location == "inside");
+  rule.counter_name = "killed_" + rule.particle_name + "_" +
+    location + "_" + rule.volume_name;
+  rule.particle = nullptr;
+  rule.nkilled = 0;
+
+  rules_.push_back(rule);
+  resolved_ = false;
+}
+
+
+
+void TrackKillingStackingAction::ResolveRules()
+{
+  G4ParticleTable* ptable = G4ParticleTable::GetParticleTable();
+  G4PhysicalVolumeStore* pvstore = G4PhysicalVolumeStore::GetInstance();
+
+  for (auto& rule : rules_) {
+
+    if (rule.particle_name != "all") {
+      rule.particle = ptable->FindParticle(rule.particle_name);
+      if (!rule.particle)
+        G4Exception("[TrackKillingStackingAction]", "ResolveRules()",
+                    FatalException, ("Unknown particle " + rule.particle_name).c_str());
+    }
+
+    // Volumes are compared by address, which is much faster than by name
+    rule.volumes.clear();
+    if (rule.volume_name != "all") {
+      for (const auto pv : *pvstore)
+        if (pv->GetName() == rule.volume_name) rule.volumes.insert(pv);
+
+      if (rule.volumes.empty())
+        G4Exception("[TrackKillingStackingAction]", "ResolveRules()",
+                    FatalException, ("Unknown volume " + rule.volume_name).c_str());
+    }
+  }
+
+  // The persistency manager reads the counters when it writes them,
+  // so that nothing but the counters is updated for every killed track
+  pm_ = dynamic_cast<PersistencyManagerBase*>
+    (G4VPersistencyManager::GetPersistencyManager());
+  if (pm_) {
+    for (auto& rule : rules_)
+      pm_->RegisterRunCounter(rule.counter_name, &rule.nkilled);
+    if (kill_after_daq_)
+      pm_->RegisterRunCounter("killed_opticalphoton_after_daq_window", &nkilled_after_daq_);
+  }
+
+  resolved_ = true;
+}
+
+
+
+G4bool TrackKillingStackingAction::IsInVolume(const G4Track* track,
+                                              const KillRule& rule) const
+{
+  if (rule.volumes.empty()) return true;
+
+  // New secondaries carry the touchable of the step that created them,
+  // so the creation volume and all its mothers are known
+  const G4VTouchable* touchable = track->GetTouchable();
+  if (!touchable) return false;
+
+  for (G4int depth=0; depth<=touchable->GetHistoryDepth(); ++depth)
+    if (rule.volumes.count(touchable->GetVolume(depth))) return true;
+
+  return false;
+}
+
+
+
+G4ClassificationOfNewTrack
+TrackKillingStackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  // Primary particles are always tracked
+  if (track->GetParentID() == 0) return fUrgent;
+
+  // Photons only get later, so those created after the last
+  // window closes can never be recorded by any sensor
+  if (kill_after_daq_ && track->GetDefinition() == G4OpticalPhoton::Definition() &&
+      track->GetGlobalTime() >= SensorSD::GetLatestDAQTime()) {
+    ++nkilled_after_daq_;
+    return fKill;
+  }
+
+  for (auto& rule : rules_) {
+
+    if (rule.particle && rule.particle != track->GetDefinition()) continue;
+
+    if (rule.threshold > 0. && track->GetKineticEnergy() >= rule.threshold)
+      continue;
+
+    if (IsInVolume(track, rule) != rule.inside) continue;
+
+    ++rule.nkilled;
+    return fKill;
+  }
+
+  return fUrgent;
+}
+
+
+
+void TrackKillingStackingAction::NewStage()
+{
+  return;
+}
+
+
+
+void TrackKillingStackingAction::PrepareNewEvent()
+{
+  // Counters start from zero in every run. A resumed job
+  // restores them afterwards, when they are registered.
+  G4int run_id = G4RunManager::GetRunManager()->GetCurrentRun()->GetRunID();
+  if (run_id != run_id_) {
+    for (auto& rule : rules_) rule.nkilled = 0;
+    nkilled_after_daq_ = 0;
+    run_id_ = run_id;
+  }
+
+  // The geometry and the particle table are complete
+  // by the time the first event starts
+  if (!resolved_) ResolveRules();
+}
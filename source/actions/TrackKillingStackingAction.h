@@ -0,0 +1,81 @@
+// ----------------------------------------------------------------------------
+// nexus | TrackKillingStackingAction.h
+//
+// This class kills new secondary tracks that cannot contribute to the
+// signal, according to rules on particle type, kinetic energy and creation
+// volume. Optical photons created after the acquisition window of every
+// sensor can be killed too. The number of tracks killed by each rule in a
+// run is stored in the configuration table, and printed, at the end of it.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef TRACK_KILLING_STACKING_ACTION_H
+#define TRACK_KILLING_STACKING_ACTION_H
+
+#include <G4UserStackingAction.hh>
+
+#include <cstdint>
+#include <deque>
+#include <set>
+
+class G4GenericMessenger;
+class G4ParticleDefinition;
+class G4VPhysicalVolume;
+class PersistencyManagerBase;
+
+
+namespace nexus {
+
+  class TrackKillingStackingAction: public G4UserStackingAction
+  {
+  public:
+    /// Constructor
+    TrackKillingStackingAction();
+    /// Destructor
+    ~TrackKillingStackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+    virtual void NewStage();
+    virtual void PrepareNewEvent();
+
+  private:
+    /// A track is killed if it matches the particle, its kinetic energy
+    /// is below the threshold (any energy if null) and it is created
+    /// inside (or outside) the given volume, daughters included
+    struct KillRule
+    {
+      G4String particle_name; ///< Particle name, or "all"
+      G4double threshold;     ///< Kinetic energy threshold
+      G4String volume_name;   ///< Volume name, or "all"
+      G4bool inside;          ///< Whether the track is killed inside the volume
+      G4String counter_name;  ///< Key of the counter in the configuration table
+
+      const G4ParticleDefinition* particle;  ///< Null if any particle
+      std::set<const G4VPhysicalVolume*> volumes; ///< Volumes with that name
+      int64_t nkilled; ///< Number of tracks killed in the run
+    };
+
+    /// Add a rule, given as "particle threshold unit volume inside|outside"
+    void AddRule(G4String);
+
+    /// Find the particle definitions and physical volumes of the rules
+    void ResolveRules();
+
+    G4bool IsInVolume(const G4Track*, const KillRule&) const;
+
+  private:
+    G4GenericMessenger* msg_;
+    PersistencyManagerBase* pm_; ///< Null if no output is written
+
+    std::deque<KillRule> rules_; ///< Their counters never move once registered
+    G4bool resolved_; ///< True once the rules are resolved
+    G4int run_id_;    ///< Run of the last event, to reset the counters
+
+    G4bool kill_after_daq_; ///< Kill optical photons after the DAQ windows
+    int64_t nkilled_after_daq_; ///< Number of them killed in the run
+  };
+
+} // end namespace nexus
+
+#endif
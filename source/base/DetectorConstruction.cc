@@ -8,21 +8,61 @@
 
 #include "DetectorConstruction.h"
 #include "GeometryBase.h"
-
+#include "GeometryCache.h"
+#include "NavigationTuning.h"
+#include "SensorSD.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4GeometryManager.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
 #include <G4Box.hh>
 #include <G4Material.hh>
 #include <G4NistManager.hh>
 #include <G4LogicalVolume.hh>
 #include <G4VisAttributes.hh>
 #include <G4PVPlacement.hh>
+#include <G4UIcommand.hh>
+#include <G4UnitsTable.hh>
+
+#include <chrono>
+#include <sstream>
 
 
 using namespace nexus;
 
 
 
-DetectorConstruction::DetectorConstruction(): geometry_(nullptr)
+DetectorConstruction::DetectorConstruction():
+  geometry_(nullptr), construction_time_(0.), settings_file_(""),
+  benchmark_region_("ACTIVE"), benchmark_output_("")
 {
+  msg_ = std::make_unique<G4GenericMessenger>(this, "/nexus/navigation/",
+                                              "Control commands of the navigation.");
+
+  msg_->DeclareProperty("settings_file", settings_file_,
+                        "File with the smartless value of logical volumes, "
+                        "applied when the geometry is built.");
+
+  msg_->DeclareProperty("benchmark_region", benchmark_region_,
+                        "Region of the geometry where the benchmark rays start.");
+
+  msg_->DeclareProperty("benchmark_output", benchmark_output_,
+                        "csv file where the benchmark results are written.");
+
+  msg_->DeclareMethod("benchmark", &DetectorConstruction::RunNavigationBenchmark,
+                      "Trace geantinos and optical photons through the geometry "
+                      "and report the navigation cost of each logical volume.");
+
+  sensors_msg_ = std::make_unique<G4GenericMessenger>(this, "/nexus/sensors/",
+                                                      "Control commands of the sensors.");
+
+  sensors_msg_->DeclareMethod("daq_window", &DetectorConstruction::AddDAQWindow,
+                              "Acquisition window of the sensors of a sensitive "
+                              "detector: 'sd_name start length unit [event|ionization]'. "
+                              "The detector is named with or without its path, or "
+                              "'all' for every sensor. The window starts at the "
+                              "start of the event (default) or at the first ionization.");
 }
 
 
@@ -41,6 +81,10 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
       FatalException, "Geometry not set!");
   }
 
+  auto start = std::chrono::steady_clock::now();
+  const GeometryCache& cache = GeometryCache::Instance();
+  G4int nreads = cache.GetNumberOfReads(), nwrites = cache.GetNumberOfWrites();
+
   // At this point the user should have loaded the configuration
   // parameters of the geometry or it will get built with the
   // default values.
@@ -71,6 +115,24 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   new G4PVPlacement(0, G4ThreeVector(0,0,0),
 		    geometry_logic, geometry_logic->GetName(), world_logic, false, 0);
 
+  // Navigation settings of the volumes, before the geometry is closed
+  if (!settings_file_.empty())
+    NavigationTuning::ApplySettings(settings_file_);
+
+  ApplyDAQWindows();
+
+  // Construction time, to be compared between jobs with and without
+  // a geometry cache. The tables of the vertex samplers are built with
+  // the first vertices, so they are not counted here (see ~NexusApp).
+  std::chrono::duration<G4double, std::milli> elapsed =
+    std::chrono::steady_clock::now() - start;
+  construction_time_ = elapsed.count();
+  G4cout << "[DetectorConstruction] Geometry built in " << construction_time_ << " ms";
+  if (!cache.GetDirectory().empty())
+    G4cout << " (" << cache.GetNumberOfReads() - nreads << " entries read from the geometry cache, "
+           << cache.GetNumberOfWrites() - nwrites << " computed and stored)";
+  G4cout << G4endl;
+
   return world_physi;
 }
 
@@ -84,3 +146,84 @@ const GeometryBase* DetectorConstruction::GetGeometry() const
 {
   return geometry_.get();
 }
+
+
+
+void DetectorConstruction::AddDAQWindow(G4String command)
+{
+  std::istringstream iss(command);
+  DAQWindow window;
+  G4String unit, reference;
+  iss >> window.sd_name >> window.start >> window.length >> unit;
+  G4bool valid = !iss.fail();
+  if (!(iss >> reference)) reference = "event";
+
+  // An unknown unit would give a null window
+  if (!valid || !G4UnitDefinition::IsUnitDefined(unit))
+    G4Exception("[DetectorConstruction]", "AddDAQWindow()",
+                FatalException, ("Wrong acquisition window: " + command).c_str());
+
+  window.start  *= G4UIcommand::ValueOf(unit);
+  window.length *= G4UIcommand::ValueOf(unit);
+
+  if (window.length <= 0. || (reference != "event" && reference != "ionization"))
+    G4Exception("[DetectorConstruction]", "AddDAQWindow()",
+                FatalException, ("Wrong acquisition window: " + command).c_str());
+
+  window.from_ionization = (reference == "ionization");
+
+  daq_windows_.push_back(window);
+}
+
+
+
+void DetectorConstruction::ApplyDAQWindows()
+{
+  // Windows are applied in order, so that a window
+  // for all sensors can be overridden for some of them
+  for (const auto& window : daq_windows_) {
+
+    SensorSD::DAQReference reference =
+      window.from_ionization ? SensorSD::FIRST_IONIZATION : SensorSD::EVENT_START;
+
+    // Detectors are named with their full path or, as in
+    // the digitization commands, with their name alone
+    G4bool full_path = G4StrUtil::contains(window.sd_name, "/");
+    G4bool found = false;
+
+    for (auto sensor : SensorSD::GetSensors()) {
+      G4String name = full_path ? sensor->GetFullPathName() : sensor->GetName();
+      if (window.sd_name != "all" && window.sd_name != name) continue;
+      sensor->SetDAQWindow(window.start, window.length, reference);
+      found = true;
+    }
+
+    if (!found && window.sd_name != "all")
+      G4Exception("[DetectorConstruction]", "ApplyDAQWindows()", FatalException,
+                  ("No sensor sensitive detector named " + window.sd_name).c_str());
+  }
+}
+
+
+
+void DetectorConstruction::RunNavigationBenchmark(G4int nrays)
+{
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+    ->GetNavigatorForTracking()->GetWorldVolume();
+
+  NavigationTuning tuning(world);
+
+  // The benchmark is run before the first run closes the geometry:
+  // it is closed here, so that the rays see the voxels of the volumes
+  G4GeometryManager* manager = G4GeometryManager::GetInstance();
+  G4bool was_closed = manager->IsGeometryClosed();
+  if (!was_closed) manager->CloseGeometry(true, false, world);
+
+  tuning.Run(*geometry_, benchmark_region_, nrays);
+
+  if (!was_closed) manager->OpenGeometry(world);
+
+  tuning.Print();
+
+  if (!benchmark_output_.empty()) tuning.Write(benchmark_output_);
+}
@@ -10,8 +10,10 @@
 #define DETECTOR_CONSTRUCTION_H
 
 #include <G4VUserDetectorConstruction.hh>
+#include <G4String.hh>
 
 #include <memory>
+#include <vector>
 
 class G4GenericMessenger;
 
@@ -36,10 +38,44 @@ namespace nexus {
     /// Get the detector geometry
     const GeometryBase* GetGeometry() const;
 
+    /// Time taken by the last construction of the geometry, in ms
+    G4double GetConstructionTime() const;
+
+    /// Trace the rays of the navigation benchmark
+    /// through the geometry and report their cost
+    void RunNavigationBenchmark(G4int nrays);
+
+  private:
+    /// Acquisition window of the sensors with a given SD name
+    struct DAQWindow
+    {
+      G4String sd_name; ///< Name of the sensor SD, or "all"
+      G4double start, length;
+      G4bool from_ionization; ///< Relative to the first ionization
+    };
+
+    /// Add a window, given as "sd_name start length unit [event|ionization]"
+    void AddDAQWindow(G4String);
+    /// Set the windows in the sensor SDs, once the geometry is built
+    void ApplyDAQWindows();
+
   private:
     std::unique_ptr<GeometryBase> geometry_;
+    G4double construction_time_; ///< Time taken to build the geometry (ms)
+
+    std::unique_ptr<G4GenericMessenger> msg_;
+    G4String settings_file_;   ///< Per-volume navigation settings
+    G4String benchmark_region_; ///< Region where the benchmark rays start
+    G4String benchmark_output_; ///< csv file with the benchmark results
+
+    std::unique_ptr<G4GenericMessenger> sensors_msg_;
+    std::vector<DAQWindow> daq_windows_;
   };
 
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4double DetectorConstruction::GetConstructionTime() const
+  { return construction_time_; }
 
 } // end namespace nexus
 
@@ -0,0 +1,293 @@
+// ----------------------------------------------------------------------------
+// nexus | NavigationTuning.cc
+//
+// Tools for tuning the navigation in a geometry. Smartless values (or no
+// voxel optimisation at all) can be set per logical volume from a text
+// file, and a fixed ray-tracing benchmark reports the navigation cost of
+// each logical volume for rays of geantinos and optical photons started
+// in a region of the geometry.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "NavigationTuning.h"
+
+#include "GeometryBase.h"
+
+#include <G4Navigator.hh>
+#include <G4LogicalVolume.hh>
+#include <G4LogicalVolumeStore.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4Material.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <G4RandomDirection.hh>
+#include <G4RandomTools.hh>
+#include <G4Exception.hh>
+#include <G4ios.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+namespace {
+
+  /// Seed of the rays, the same in every benchmark
+  const long NAVIGATION_SEED = 20240413;
+
+  /// Limits of a ray, in case it gets stuck
+  const G4int MAX_STEPS   = 10000;
+  /// Reflections of an optical photon before it is absorbed
+  const G4int MAX_BOUNCES = 30;
+
+  /// Optical photons are reflected off materials without
+  /// refractive index, and go through the others
+  G4bool IsTransparent(const G4VPhysicalVolume* volume)
+  {
+    const G4MaterialPropertiesTable* mpt =
+      volume->GetLogicalVolume()->GetMaterial()->GetMaterialPropertiesTable();
+    return mpt && mpt->GetProperty("RINDEX");
+  }
+
+}
+
+
+namespace nexus {
+
+  std::vector<std::pair<G4String, G4double>>
+  NavigationTuning::ParseSettings(std::istream& input)
+  {
+    std::vector<std::pair<G4String, G4double>> settings;
+
+    std::string line;
+    G4int nline = 0;
+    while (std::getline(input, line)) {
+      ++nline;
+      line = line.substr(0, line.find('#'));
+
+      std::istringstream fields(line);
+      std::string name, value, extra;
+      if (!(fields >> name)) continue;
+
+      G4double smartless = 0.;
+      char* end = nullptr;
+      if (fields >> value && value != "off")
+        smartless = std::strtod(value.c_str(), &end);
+
+      if (value.empty() || (end && (*end != '\0' || smartless <= 0.)) ||
+          fields >> extra)
+        G4Exception("[NavigationTuning]", "ParseSettings()", FatalException,
+                    ("Wrong navigation setting in line " + std::to_string(nline) +
+                     ": '" + line + "'").c_str());
+
+      settings.emplace_back(name, smartless);
+    }
+
+    return settings;
+  }
+
+
+
+  void NavigationTuning::ApplySettings(const G4String& filename)
+  {
+    std::ifstream file(filename);
+    if (!file)
+      G4Exception("[NavigationTuning]", "ApplySettings()", FatalException,
+                  ("Could not read the navigation settings file " + filename).c_str());
+
+    for (const auto& setting : ParseSettings(file)) {
+
+      G4LogicalVolume* volume =
+        G4LogicalVolumeStore::GetInstance()->GetVolume(setting.first, false);
+
+      if (!volume) {
+        G4Exception("[NavigationTuning]", "ApplySettings()", JustWarning,
+                    ("No logical volume named " + setting.first).c_str());
+        continue;
+      }
+
+      // Volumes with the same name get the same setting
+      for (auto lv : *G4LogicalVolumeStore::GetInstance()) {
+        if (lv->GetName() != setting.first) continue;
+        if (setting.second > 0.) lv->SetSmartless(setting.second);
+        else                     lv->SetOptimisation(false);
+      }
+    }
+  }
+
+
+
+  NavigationTuning::NavigationTuning(G4VPhysicalVolume* world):
+    navigator_(new G4Navigator()), nrays_(0)
+  {
+    if (!world)
+      G4Exception("[NavigationTuning]", "NavigationTuning()", FatalException,
+                  "The geometry is not built yet: the navigation benchmark "
+                  "must be run after the initialization (in a delayed macro).");
+
+    navigator_->SetWorldVolume(world);
+  }
+
+
+
+  NavigationTuning::~NavigationTuning()
+  {
+  }
+
+
+
+  void NavigationTuning::Run(const GeometryBase& geometry,
+                             const G4String& region, G4int nrays)
+  {
+    std::ostringstream rng_state;
+    G4Random::saveFullState(rng_state);
+    G4Random::setTheSeed(NAVIGATION_SEED);
+
+    for (G4int i=0; i<nrays; ++i) {
+      G4ThreeVector point = geometry.GenerateVertex(region);
+      TraceRay(point, G4RandomDirection(), GEANTINO);
+      TraceRay(point, G4RandomDirection(), OPTICAL);
+    }
+    nrays_ += nrays;
+
+    std::istringstream rng_restore(rng_state.str());
+    G4Random::restoreFullState(rng_restore);
+  }
+
+
+
+  void NavigationTuning::TraceRay(G4ThreeVector point, G4ThreeVector direction,
+                                  RayType type)
+  {
+    using clock = std::chrono::steady_clock;
+
+    G4VPhysicalVolume* volume =
+      navigator_->LocateGlobalPointAndSetup(point, &direction, false, false);
+
+    G4int bounces = 0;
+
+    for (G4int i=0; i<MAX_STEPS && volume; ++i) {
+
+      auto start = clock::now();
+
+      G4double safety = 0.;
+      G4double step = navigator_->ComputeStep(point, direction, kInfinity, safety);
+      if (step == kInfinity) break;
+
+      point += step * direction;
+      navigator_->SetGeometricallyLimitedStep();
+      G4VPhysicalVolume* next =
+        navigator_->LocateGlobalPointAndSetup(point, &direction, true);
+
+      // Reflection off an opaque volume, back into the one left
+      if (type == OPTICAL && next && !IsTransparent(next)) {
+        if (++bounces > MAX_BOUNCES) next = nullptr;
+        else {
+          G4bool valid = false;
+          G4ThreeVector normal = navigator_->GetGlobalExitNormal(point, &valid);
+          direction = valid ? G4LambertianRand(-normal) : -direction;
+          next = navigator_->LocateGlobalPointAndSetup(point, &direction, true);
+          if (next && !IsTransparent(next)) next = nullptr;
+        }
+      }
+
+      std::chrono::duration<G4double, std::nano> elapsed = clock::now() - start;
+
+      Cost& cost = costs_[volume->GetLogicalVolume()];
+      cost.steps[type] += 1;
+      cost.time [type] += elapsed.count();
+
+      volume = next;
+    }
+  }
+
+
+
+  G4long NavigationTuning::GetSteps(const G4LogicalVolume* volume) const
+  {
+    auto it = costs_.find(volume);
+    if (it == costs_.end()) return 0;
+    return it->second.steps[GEANTINO] + it->second.steps[OPTICAL];
+  }
+
+
+
+  std::vector<std::pair<const G4LogicalVolume*, NavigationTuning::Cost>>
+  NavigationTuning::SortedCosts() const
+  {
+    std::vector<std::pair<const G4LogicalVolume*, Cost>>
+      sorted(costs_.begin(), costs_.end());
+
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second.time[GEANTINO] + a.second.time[OPTICAL] >
+               b.second.time[GEANTINO] + b.second.time[OPTICAL]; });
+
+    return sorted;
+  }
+
+
+
+  void NavigationTuning::Print() const
+  {
+    auto per_step = [](const Cost& cost, G4int type) {
+      return cost.steps[type] ? cost.time[type] / cost.steps[type] : 0.; };
+
+    G4cout << "\n[NavigationTuning] Navigation cost of " << nrays_
+           << " geantinos and " << nrays_ << " optical photons\n"
+           << std::left << std::setw(32) << "logical volume" << std::right
+           << std::setw(10) << "daughters" << std::setw(10) << "smartless"
+           << std::setw(12) << "geant.steps" << std::setw(10) << "ns/step"
+           << std::setw(12) << "opt.steps"   << std::setw(10) << "ns/step"
+           << std::setw(12) << "total ms" << "\n";
+
+    for (const auto& entry : SortedCosts()) {
+      const G4LogicalVolume* lv = entry.first;
+      const Cost& cost = entry.second;
+
+      std::ostringstream smartless;
+      if (lv->IsToOptimise()) smartless << std::fixed << std::setprecision(1) << lv->GetSmartless();
+      else                    smartless << "off";
+
+      G4cout << std::left << std::setw(32) << lv->GetName() << std::right
+             << std::setw(10) << lv->GetNoDaughters()
+             << std::setw(10) << smartless.str()
+             << std::setw(12) << cost.steps[GEANTINO]
+             << std::setw(10) << std::fixed << std::setprecision(1) << per_step(cost, GEANTINO)
+             << std::setw(12) << cost.steps[OPTICAL]
+             << std::setw(10) << per_step(cost, OPTICAL)
+             << std::setw(12) << std::setprecision(3)
+             << (cost.time[GEANTINO] + cost.time[OPTICAL]) * 1.e-6 << "\n";
+    }
+
+    G4cout << std::defaultfloat << std::setprecision(6) << G4endl;
+  }
+
+
+
+  void NavigationTuning::Write(const G4String& filename) const
+  {
+    std::ofstream file(filename);
+    if (!file) {
+      G4Exception("[NavigationTuning]", "Write()", JustWarning,
+                  ("Cannot write the navigation benchmark to " + filename).c_str());
+      return;
+    }
+
+    file << "volume,daughters,smartless,geantino_steps,geantino_time_ns,"
+         << "optical_steps,optical_time_ns\n";
+
+    for (const auto& entry : SortedCosts()) {
+      const G4LogicalVolume* lv = entry.first;
+      const Cost& cost = entry.second;
+      file << lv->GetName() << ',' << lv->GetNoDaughters() << ','
+           << (lv->IsToOptimise() ? lv->GetSmartless() : 0.) << ','
+           << cost.steps[GEANTINO] << ',' << cost.time[GEANTINO] << ','
+           << cost.steps[OPTICAL]  << ',' << cost.time[OPTICAL]  << '\n';
+    }
+  }
+
+} // end namespace nexus
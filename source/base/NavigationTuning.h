@@ -0,0 +1,92 @@
+// ----------------------------------------------------------------------------
+// nexus | NavigationTuning.h
+//
+// Tools for tuning the navigation in a geometry. Smartless values (or no
+// voxel optimisation at all) can be set per logical volume from a text
+// file, and a fixed ray-tracing benchmark reports the navigation cost of
+// each logical volume for rays of geantinos and optical photons started
+// in a region of the geometry.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef NAVIGATION_TUNING_H
+#define NAVIGATION_TUNING_H
+
+#include <G4String.hh>
+#include <G4ThreeVector.hh>
+
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class G4LogicalVolume;
+class G4Navigator;
+class G4VPhysicalVolume;
+
+
+namespace nexus {
+
+  class GeometryBase;
+
+  class NavigationTuning
+  {
+  public:
+    /// Parses lines of the form '<logical volume> <smartless>', or
+    /// '<logical volume> off' to disable the voxel optimisation of
+    /// the volume (returned as a smartless of zero). Blank lines and
+    /// anything after a '#' are ignored.
+    static std::vector<std::pair<G4String, G4double>> ParseSettings(std::istream&);
+
+    /// Applies the settings of a file to the logical volumes built so
+    /// far. It must be called before the geometry is closed.
+    static void ApplySettings(const G4String& filename);
+
+    /// Constructor. Rays are traced with a navigator of their own,
+    /// so the state of the tracking is not altered.
+    NavigationTuning(G4VPhysicalVolume* world);
+
+    /// Destructor
+    ~NavigationTuning();
+
+    /// Traces nrays geantinos and nrays optical photons from random
+    /// points of a region of the geometry. The random engine is seeded
+    /// with a fixed value, so that the rays are the same in every
+    /// benchmark, and restored afterwards.
+    void Run(const GeometryBase& geometry, const G4String& region, G4int nrays);
+
+    /// Prints a table of the navigation cost per logical volume,
+    /// the most expensive first
+    void Print() const;
+
+    /// Writes the same table to a csv file
+    void Write(const G4String& filename) const;
+
+    /// Steps of the geantinos and of the optical photons
+    /// that start in a logical volume
+    G4long GetSteps(const G4LogicalVolume*) const;
+
+  private:
+    enum RayType { GEANTINO, OPTICAL };
+
+    /// Steps and time spent computing the steps that start in a volume
+    struct Cost
+    {
+      G4long   steps[2] = {0, 0};
+      G4double time [2] = {0., 0.};
+    };
+
+    void TraceRay(G4ThreeVector point, G4ThreeVector direction, RayType type);
+    std::vector<std::pair<const G4LogicalVolume*, Cost>> SortedCosts() const;
+
+  private:
+    std::unique_ptr<G4Navigator> navigator_;
+    std::map<const G4LogicalVolume*, Cost> costs_;
+    G4int nrays_;
+  };
+
+} // end namespace nexus
+
+#endif
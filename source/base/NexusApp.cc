@@ -15,6 +15,11 @@
 #include "DetectorConstruction.h"
 #include "PrimaryGeneration.h"
 #include "FactoryBase.h"
+#include "PerformanceMonitor.h"
+#include "PerformanceEventAction.h"
+#include "PerformanceTrackingAction.h"
+#include "PhysicsTableCache.h"
+#include "GeometryCache.h"
 
 #include <G4GenericPhysicsList.hh>
 #include <G4UImanager.hh>
@@ -26,6 +31,14 @@
 #include <G4UserTrackingAction.hh>
 #include <G4UserSteppingAction.hh>
 #include <G4UserStackingAction.hh>
+#include <G4MultiEventAction.hh>
+#include <G4MultiTrackingAction.hh>
+#include <G4Event.hh>
+#include <Randomize.hh>
+#include <CLHEP/Random/MixMaxRng.h>
+
+#include <chrono>
+#include <dlfcn.h>
 
 using namespace nexus;
 using std::make_unique;
@@ -36,7 +49,14 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
                                          geo_name_(""), pm_name_(""),
                                          runact_name_(""), evtact_name_(""),
                                          stepact_name_(""), trkact_name_(""),
-                                         stkact_name_(""), pman_(false)
+                                         stkact_name_(""), pman_(false),
+                                         perf_monitor_(false),
+                                         table_cache_dir_(""), geometry_cache_dir_(""),
+                                         tables_ready_(false),
+                                         seed_(0), seed_given_(false),
+                                         random_per_event_(false),
+                                         first_event_(0), resume_(false),
+                                         resumed_events_(0)
 {
   // Create and configure a generic messenger for the app
   msg_ = make_unique<G4GenericMessenger>(this, "/nexus/", "Nexus control commands.");
@@ -55,6 +75,20 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
   msg_->DeclareMethod("random_seed", &NexusApp::SetRandomSeed,
                       "Set a seed for the random number generator.");
 
+  // Define the commands to derive the random state of each event
+  // from the run seed and its global id, so that any range of events
+  // can be simulated on its own with identical results
+  msg_->DeclareProperty("random_per_event", random_per_event_,
+                        "Seed the random engine independently for each event.");
+  msg_->DeclareProperty("first_event", first_event_,
+                        "Global id of the first event, with random_per_event.");
+
+  // Define the command to load a plugin library. Its classes register
+  // themselves in the factories as soon as it is loaded, so it must come
+  // before the commands that choose them (e.g. RegisterPersistencyManager).
+  msg_->DeclareMethod("LoadPlugin", &NexusApp::LoadPlugin,
+                      "Load a shared library with user classes.");
+
 // Define the command to set the desired generator
   msg_->DeclareProperty("RegisterGenerator", gen_name_, "");
 
@@ -71,6 +105,18 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
   msg_->DeclareProperty("RegisterTrackingAction", trkact_name_, "");
   msg_->DeclareProperty("RegisterStackingAction", stkact_name_, "");
 
+  // Define the command to record per-event performance telemetry
+  msg_->DeclareProperty("performance_monitor", perf_monitor_,
+                        "Store per-event timing, step and memory statistics.");
+
+  // Define the command to keep the physics tables in a cache directory
+  msg_->DeclareProperty("physics_table_cache", table_cache_dir_,
+                        "Directory where physics tables are stored and retrieved.");
+
+  // Define the command to keep derived geometry quantities in a cache directory
+  msg_->DeclareProperty("geometry_cache", geometry_cache_dir_,
+                        "Directory where derived geometry quantities are stored and retrieved.");
+
 
   /////////////////////////////////////////////////////////
 
@@ -119,9 +165,9 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
     this->SetUserAction(runact.release());
   }
 
+  unique_ptr<G4UserEventAction> evtact;
   if (!evtact_name_.empty()) {
-    auto evtact = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
-    this->SetUserAction(evtact.release());
+    evtact = ObjFactory<G4UserEventAction>::Instance().CreateObject(evtact_name_);
   }
 
   if (!stkact_name_.empty()) {
@@ -129,11 +175,32 @@ NexusApp::NexusApp(G4String init_macro): G4RunManager(), gen_name_(""),
     this->SetUserAction(stkact.release());
   }
 
+  unique_ptr<G4UserTrackingAction> trkact;
   if (!trkact_name_.empty()) {
-    auto trkact = ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_);
-    this->SetUserAction(trkact.release());
+    trkact = ObjFactory<G4UserTrackingAction>::Instance().CreateObject(trkact_name_);
   }
 
+  // The performance monitor runs alongside the user actions, which
+  // are wrapped together with the monitoring ones. When it is disabled
+  // the user actions are set untouched, so there is no overhead.
+  // (It may also have been enabled beforehand by the benchmark program.)
+  if (perf_monitor_) PerformanceMonitor::Instance().Enable(true);
+
+  if (PerformanceMonitor::Instance().IsEnabled()) {
+    auto multi_evtact = make_unique<G4MultiEventAction>();
+    if (evtact) multi_evtact->push_back(std::move(evtact));
+    multi_evtact->push_back(make_unique<PerformanceEventAction>());
+    evtact = std::move(multi_evtact);
+
+    auto multi_trkact = make_unique<G4MultiTrackingAction>();
+    if (trkact) multi_trkact->push_back(std::move(trkact));
+    multi_trkact->push_back(make_unique<PerformanceTrackingAction>());
+    trkact = std::move(multi_trkact);
+  }
+
+  if (evtact) this->SetUserAction(evtact.release());
+  if (trkact) this->SetUserAction(trkact.release());
+
   if (!stepact_name_.empty()) {
     auto stepact = ObjFactory<G4UserSteppingAction>::Instance().CreateObject(stepact_name_);
     this->SetUserAction(stepact.release());
@@ -156,6 +223,14 @@ NexusApp::~NexusApp()
   if (pman_) {
     pm_->CloseFile();
   }
+
+  // Whole job, including the tables that the vertex samplers
+  // build when they generate their first vertex
+  const GeometryCache& cache = GeometryCache::Instance();
+  if (!cache.GetDirectory().empty())
+    G4cout << "[GeometryCache] " << cache.GetNumberOfReads()
+           << " entries read and " << cache.GetNumberOfWrites()
+           << " computed and stored in this job" << G4endl;
 }
 
 
@@ -176,6 +251,18 @@ void NexusApp::RegisterDelayedMacro(G4String macro)
 
 
 
+void NexusApp::LoadPlugin(G4String library)
+{
+  // The library is never unloaded, as the factories keep its classes.
+  // Its symbols are global so that it can use those of other plugins.
+  if (!dlopen(library.c_str(), RTLD_NOW | RTLD_GLOBAL)) {
+    G4String msg = "Cannot load plugin " + library + ": " + dlerror();
+    G4Exception("[NexusApp]", "LoadPlugin()", FatalException, msg);
+  }
+}
+
+
+
 void NexusApp::Initialize()
 {
   // Execute all command macro files before initializing the app
@@ -186,10 +273,24 @@ void NexusApp::Initialize()
     ExecuteMacroFile(macros_[i].data());
   }
 
+  // The geometry is constructed by the initialization
+  GeometryCache::Instance().SetDirectory(geometry_cache_dir_);
+
   G4RunManager::Initialize();
 
+  if (resume_ && !pman_)
+    G4Exception("[NexusApp]", "Initialize()", FatalException,
+                "A job can only be resumed with a persistency manager.");
+
   if (pman_) {
-    pm_->OpenFile();
+    if (resume_) {
+      // The checkpoint also restores the state of the random engine.
+      // Events with their own random stream go on from the next id.
+      resumed_events_ = pm_->ResumeFile();
+      first_event_ += resumed_events_;
+    }
+    else
+      pm_->OpenFile();
   }
 
   for (unsigned int j=0; j<delayed_.size(); j++) {
@@ -205,6 +306,43 @@ void NexusApp::Initialize()
 
 
 
+void NexusApp::RunInitialization()
+{
+  // Events of separate jobs are only the same if
+  // they all derive their streams from the same seed
+  if (random_per_event_ && !seed_given_)
+    G4Exception("[NexusApp]", "RunInitialization()", FatalException,
+                "Per-event random streams require a seed set with /nexus/random_seed.");
+
+  if (tables_ready_) {
+    G4RunManager::RunInitialization();
+    return;
+  }
+
+  // Physics tables are built (or retrieved) by the first
+  // run initialization, which dominates the startup time.
+  // The key of the table cache is computed right before, once
+  // the geometry, processes and delayed commands are all set.
+  if (!table_cache_dir_.empty()) {
+    table_cache_ = make_unique<PhysicsTableCache>(table_cache_dir_);
+    table_cache_->Setup(physicsList);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+
+  G4RunManager::RunInitialization();
+  tables_ready_ = true;
+
+  std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+  G4cout << "[NexusApp] Physics tables ready in " << elapsed.count() << " s"
+         << (table_cache_ && table_cache_->IsRetrieved() ? " (retrieved)" : "")
+         << G4endl;
+
+  if (table_cache_) table_cache_->Store(physicsList);
+}
+
+
+
 void NexusApp::ExecuteMacroFile(const char* filename)
 {
   G4UImanager* UI = G4UImanager::GetUIpointer();
@@ -216,11 +354,56 @@ void NexusApp::ExecuteMacroFile(const char* filename)
 
 
 
-void NexusApp::SetRandomSeed(G4int seed)
+void NexusApp::SetRandomSeed(G4long seed)
 {
   // Set the seed chosen by the user for the pseudo-random number
   // generator unless a negative number was provided, in which case
   // we will set as seed the system time.
-  if (seed < 0) CLHEP::HepRandom::setTheSeed(time(0));
-  else CLHEP::HepRandom::setTheSeed(seed);
+  if (seed < 0) seed_ = time(0);
+  else seed_ = seed;
+  seed_given_ = (seed >= 0);
+
+  CLHEP::HepRandom::setTheSeed(seed_);
+}
+
+
+
+G4Event* NexusApp::GenerateEvent(G4int i_event)
+{
+  if (!random_per_event_) return G4RunManager::GenerateEvent(i_event);
+
+  G4long event_id = first_event_ + i_event;
+  SeedEventEngine(event_id);
+
+  // The event carries its global id, which is also used in the output
+  G4Event* event = G4RunManager::GenerateEvent(i_event);
+  event->SetEventID(event_id);
+  return event;
+}
+
+
+
+void NexusApp::SeedEventEngine(G4long event_id)
+{
+  CLHEP::HepRandomEngine* engine = G4Random::getTheEngine();
+
+  // MixMax derives statistically independent streams
+  // from its four seeds by skipping ahead
+  static G4bool checked = false;
+  if (!checked) {
+    checked = true;
+    if (!dynamic_cast<CLHEP::MixMaxRng*>(engine))
+      G4Exception("[NexusApp]", "SeedEventEngine()", JustWarning,
+                  "The random engine is not MixMax, per-event streams may be correlated.");
+    G4cout << "[NexusApp] Per-event random streams from seed " << seed_
+           << ", first event " << first_event_ << G4endl;
+  }
+
+  const long mask = 0xffffffff;
+  long seeds[4] = {seed_ & mask, (seed_ >> 32) & mask,
+                   event_id & mask, (event_id >> 32) & mask};
+  engine->setSeeds(seeds, 4);
+
+  // Gaussian generators keep the second value of each pair
+  CLHEP::RandGauss::setFlag(false);
 }
@@ -20,6 +20,8 @@ class G4GenericMessenger;
 
 namespace nexus {
 
+  class PhysicsTableCache;
+
   class NexusApp: public G4RunManager
   {
   public:
@@ -30,19 +32,48 @@ namespace nexus {
 
     virtual void Initialize();
 
+    /// Builds (or retrieves) the physics tables at the start of a run
+    virtual void RunInitialization();
+
     /// Returns the number of events to be processed in the current run
     G4int GetNumberOfEventsToBeProcessed() const;
 
+    /// Simulate events with global ids starting from the given one,
+    /// each with its own random stream
+    void SetFirstEvent(G4long);
+
+    /// True if the random engine is seeded independently for each event
+    G4bool IsRandomPerEvent() const;
+
+    /// Continue the job from the last checkpoint of its output file
+    /// instead of overwriting it. Must be called before Initialize().
+    void SetResume(G4bool);
+
+    /// Number of events processed before the job was resumed
+    G4long GetNumberOfResumedEvents() const;
+
+  protected:
+    /// Seeds the random engine of the event, if needed, before
+    /// the generation of its primary particles
+    virtual G4Event* GenerateEvent(G4int i_event);
+
   private:
     void RegisterMacro(G4String);
 
     void RegisterDelayedMacro(G4String);
 
+    /// Load a shared library, so that the classes it
+    /// registers can be chosen by name in the same macro
+    void LoadPlugin(G4String);
+
     void ExecuteMacroFile(const char*);
 
     /// Set a seed for the G4 random number generator.
     /// If a negative value is chosen, the system time is set as seed.
-    void SetRandomSeed(G4int);
+    void SetRandomSeed(G4long);
+
+    /// Seed the random engine from the run seed and a global event id
+    void SeedEventEngine(G4long event_id);
 
   private:
     std::unique_ptr<G4GenericMessenger> msg_;
@@ -56,12 +87,26 @@ namespace nexus {
     G4String stkact_name_; ///< Name of the chosen stacking action
 
     G4bool pman_; ///< True if the persistency manager is set
+    G4bool perf_monitor_; ///< True if performance telemetry is recorded
+    G4String table_cache_dir_; ///< Directory of the physics table cache
+    G4String geometry_cache_dir_; ///< Directory of the geometry cache
+    G4bool tables_ready_; ///< True once the physics tables are built
+
+    G4long seed_; ///< Seed of the random engine for the run
+    G4bool seed_given_; ///< True if the seed was chosen by the user
+    G4bool random_per_event_; ///< True if each event has its own random stream
+    G4long first_event_; ///< Global id of the first event of the run
+
+    G4bool resume_; ///< True if the job continues from a checkpoint
+    G4long resumed_events_; ///< Events processed before the job was resumed
 
     std::vector<G4String> macros_;
     std::vector<G4String> delayed_;
 
     std::unique_ptr<PersistencyManagerBase> pm_;
 
+    std::unique_ptr<PhysicsTableCache> table_cache_;
+
   };
 
   // INLINE DEFINITIONS ////////////////////////////////////
@@ -69,6 +114,18 @@ namespace nexus {
   inline G4int NexusApp::GetNumberOfEventsToBeProcessed() const
   { return numberOfEventToBeProcessed; }
 
+  inline void NexusApp::SetFirstEvent(G4long first)
+  { first_event_ = first; random_per_event_ = true; }
+
+  inline G4bool NexusApp::IsRandomPerEvent() const
+  { return random_per_event_; }
+
+  inline void NexusApp::SetResume(G4bool resume)
+  { resume_ = resume; }
+
+  inline G4long NexusApp::GetNumberOfResumedEvents() const
+  { return resumed_events_; }
+
 } // namespace nexus
 
 #endif
@@ -34,6 +34,7 @@ namespace nexus {
     void SetGenerator(std::unique_ptr<G4VPrimaryGenerator> pg);
     /// Returns a pointer to the primary generator
     const G4VPrimaryGenerator* GetGenerator() const;
+    G4VPrimaryGenerator* GetGenerator();
 
   private:
     std::unique_ptr<G4VPrimaryGenerator> generator_; ///< Pointer to the primary generator
@@ -47,6 +48,9 @@ namespace nexus {
   inline const G4VPrimaryGenerator* PrimaryGeneration::GetGenerator() const
   { return generator_.get(); }
 
+  inline G4VPrimaryGenerator* PrimaryGeneration::GetGenerator()
+  { return generator_.get(); }
+
 } // end namespace nexus
 
 #endif
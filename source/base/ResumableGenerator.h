@@ -0,0 +1,40 @@
+// ----------------------------------------------------------------------------
+// nexus | ResumableGenerator.h
+//
+// Interface of the primary generators whose events depend on the events
+// generated before them, other than through the random engine (e.g. those
+// that read their input in sequence). Their state is saved in the
+// checkpoints of the job, so that a resumed job goes on from the same
+// place. Generators that do not implement it must depend on the random
+// engine only.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef RESUMABLE_GENERATOR_H
+#define RESUMABLE_GENERATOR_H
+
+#include <G4Types.hh>
+
+#include <map>
+#include <string>
+
+
+namespace nexus {
+
+  class ResumableGenerator
+  {
+  public:
+    virtual ~ResumableGenerator() {}
+
+    /// Add the state of the generator to the entries of a checkpoint
+    virtual void SaveState(std::map<std::string, std::string>& state) = 0;
+
+    /// Restore the state saved in a checkpoint. Returns false if the
+    /// generator cannot go on from it.
+    virtual G4bool RestoreState(const std::map<std::string, std::string>& state) = 0;
+  };
+
+} // end namespace nexus
+
+#endif
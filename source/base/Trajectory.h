@@ -93,6 +93,11 @@ namespace nexus {
     G4String GetFinalProcess() const;
     void SetFinalProcess(G4String);
 
+    // Statistical weight of the track, different from one
+    // only when variance reduction is active
+    G4double GetWeight() const;
+    void SetWeight(G4double);
+
 
     // Trajectory points
 
@@ -132,6 +137,7 @@ namespace nexus {
 
     G4double length_;
     G4double edep_;
+    G4double weight_;
 
     G4String creator_process_;
     G4String final_process_;
@@ -222,6 +228,12 @@ inline G4String nexus::Trajectory::GetFinalProcess() const
 inline void nexus::Trajectory::SetFinalProcess(G4String fp)
 { final_process_ = fp; }
 
+inline G4double nexus::Trajectory::GetWeight() const
+{ return weight_; }
+
+inline void nexus::Trajectory::SetWeight(G4double w)
+{ weight_ = w; }
+
 inline G4String nexus::Trajectory::GetInitialVolume() const
 { return initial_volume_; }
 
@@ -0,0 +1,29 @@
+#include "XenonProperties.h"
+
+#include <G4SystemOfUnits.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("XenonRefractiveIndex") {
+
+  G4double density = GetGasDensity(15.*bar, 295.*kelvin);
+
+  BENCHMARK("200 energies") {
+    G4double sum = 0.;
+    for (G4int i=0; i<200; ++i)
+      sum += XenonRefractiveIndex((1. + 0.04*i)*eV, density);
+    return sum;
+  };
+}
+
+
+TEST_CASE("GXeScintillation") {
+
+  BENCHMARK("200 energies") {
+    G4double sum = 0.;
+    for (G4int i=0; i<200; ++i)
+      sum += GXeScintillation((1. + 0.04*i)*eV, 15.*bar);
+    return sum;
+  };
+}
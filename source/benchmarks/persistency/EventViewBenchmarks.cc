@@ -0,0 +1,54 @@
+#include "EventView.h"
+#include "SummaryPersistencyManager.h"
+#include "IonizationHit.h"
+#include "SensorHit.h"
+
+#include <G4Event.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("SummaryPersistencyManager::Summarize") {
+
+  // Event of the size of a Kr decay in NEXT-100: a few hundred
+  // ionization hits and some thousand photons in each of 60 PMTs
+  G4Event event(0);
+  auto hce = new G4HCofThisEvent(2);
+
+  auto ionization = new nexus::IonizationHitsCollection("ACTIVE", "IonizationHitsCollection");
+  for (G4int i=0; i<300; i++) {
+    auto hit = new nexus::IonizationHit();
+    hit->SetEnergyDeposit(0.1*keV);
+    ionization->insert(hit);
+  }
+  hce->AddHitsCollection(0, ionization);
+
+  auto sensors = new SensorHitsCollection("PmtR11410", "SensorHitsCollection");
+  for (G4int i=0; i<60; i++) {
+    auto hit = new nexus::SensorHit(i, G4ThreeVector(), 25.*nanosecond);
+    for (G4int j=0; j<2000; j++)
+      hit->Fill(1.*ms + 5.*microsecond * G4UniformRand());
+    sensors->insert(hit);
+  }
+  hce->AddHitsCollection(1, sensors);
+
+  event.SetHCofThisEvent(hce);
+
+  nexus::SummaryPersistencyManager pm;
+  nexus::EventView view;
+  nexus::SummaryPersistencyManager::EventSummary summary;
+
+  BENCHMARK("View of the event") {
+    view.Fill(&event);
+    return view.GetSensorHits().size();
+  };
+
+  BENCHMARK("Summary of the event") {
+    view.Fill(&event);
+    pm.Summarize(view, summary);
+    return summary.light;
+  };
+}
@@ -0,0 +1,61 @@
+#include "UniformElectricDriftField.h"
+#include "Electroluminescence.h"
+#include "XenonProperties.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicsOrderedFreeVector.hh>
+#include <G4Track.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("UniformElectricDriftField::Drift") {
+
+  nexus::UniformElectricDriftField field(0., 120.*cm, kZAxis);
+  field.SetDriftVelocity(1.*mm/microsecond);
+  field.SetTransverseDiffusion(1.*mm/sqrt(m));
+  field.SetLongitudinalDiffusion(.3*mm/sqrt(m));
+  field.SetLifetime(10.*ms);
+
+  BENCHMARK("Drift") {
+    G4LorentzVector xyzt(10.*mm, -20.*mm, 60.*cm, 0.);
+    return field.Drift(xyzt);
+  };
+}
+
+
+TEST_CASE("Electroluminescence photon generation") {
+
+  // EL field of the NEXT-100 gate region
+  nexus::UniformElectricDriftField field(-1.*cm, 0., kZAxis);
+  field.SetDriftVelocity(2.5*mm/microsecond);
+  field.SetLightYield(XenonELLightYield(13.*kilovolt/cm, 10.*bar));
+
+  // Cumulative EL spectrum, computed as in Electroluminescence
+  G4PhysicsOrderedFreeVector spectrum_integral;
+  G4double sum = 0.;
+  G4double prev_e = 1.*eV;
+  G4double prev_y = GXeScintillation(prev_e, 10.*bar);
+  spectrum_integral.InsertValues(prev_e, sum);
+  for (G4int i=1; i<200; ++i) {
+    G4double e = (1. + 0.04*i)*eV;
+    G4double y = GXeScintillation(e, 10.*bar);
+    sum += 0.5 * (e - prev_e) * (y + prev_y);
+    spectrum_integral.InsertValues(e, sum);
+    prev_e = e;
+    prev_y = y;
+  }
+
+  G4LorentzVector initial_position(0., 0.,   0.,  0.);
+  G4LorentzVector final_position  (0., 0., -1.*cm, 4.*microsecond);
+
+  BENCHMARK("1000 photons") {
+    for (G4int i=0; i<1000; ++i) {
+      G4Track* photon =
+        nexus::Electroluminescence::GeneratePhoton(spectrum_integral, &field,
+                                                   initial_position, final_position);
+      delete photon;
+    }
+    return 1000;
+  };
+}
@@ -0,0 +1,30 @@
+#include "SensorHit.h"
+
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("SensorHit::Fill") {
+
+  // Photon arrival times spread over a typical S2 window
+  std::vector<G4double> times(10000);
+  for (auto& t : times) t = 1.*ms + 20.*microsecond * G4UniformRand();
+
+  BENCHMARK_ADVANCED("10000 photons, 1 mus bins")(Catch::Benchmark::Chronometer meter) {
+    nexus::SensorHit hit(0, G4ThreeVector(), 1.*microsecond);
+    meter.measure([&] {
+      for (auto t : times) hit.Fill(t);
+      return hit.GetHistogram().size();
+    });
+  };
+
+  BENCHMARK_ADVANCED("10000 photons, 25 ns bins")(Catch::Benchmark::Chronometer meter) {
+    nexus::SensorHit hit(0, G4ThreeVector(), 25.*nanosecond);
+    meter.measure([&] {
+      for (auto t : times) hit.Fill(t);
+      return hit.GetHistogram().size();
+    });
+  };
+}
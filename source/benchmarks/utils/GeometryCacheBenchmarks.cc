@@ -0,0 +1,82 @@
+#include "GeometryCache.h"
+#include "SolidPointSampler.h"
+
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4SubtractionSolid.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+
+namespace {
+
+  /// Boolean solid like those of the shieldings and field cages, created
+  /// anew every time so that Geant4 does not reuse its own estimates
+  G4VSolid* MakeSolid()
+  {
+    auto box  = new G4Box("BENCH_BOX", 50.*cm, 50.*cm, 50.*cm);
+    auto hole = new G4Tubs("BENCH_HOLE", 0., 30.*cm, 60.*cm, 0., twopi);
+    return new G4SubtractionSolid("BENCH_SUB", box, hole);
+  }
+
+
+  void RemoveCache(const G4String& path)
+  {
+    DIR* dir = opendir(path.c_str());
+    if (dir) {
+      while (dirent* entry = readdir(dir)) {
+        G4String name = entry->d_name;
+        if (name != "." && name != "..")
+          std::remove((path + "/" + name).c_str());
+      }
+      closedir(dir);
+    }
+    rmdir(path.c_str());
+  }
+
+}
+
+
+TEST_CASE("GeometryCache construction quantities") {
+
+  nexus::GeometryCache& cache = nexus::GeometryCache::Instance();
+
+  // Without a cache, as every job did before
+  cache.SetDirectory("");
+
+  BENCHMARK("cubic volume, no cache") {
+    return cache.GetCubicVolume(MakeSolid());
+  };
+
+  BENCHMARK("volume table, no cache") {
+    nexus::SolidPointSampler sampler(MakeSolid());
+    return sampler.GetPartialFraction();
+  };
+
+  // With the entries stored by a previous job
+  char dir_template[] = "/tmp/geometry_cache_XXXXXX";
+  G4String cache_dir = mkdtemp(dir_template);
+  cache.SetDirectory(cache_dir);
+  cache.GetCubicVolume(MakeSolid());
+  nexus::SolidPointSampler(MakeSolid()).GetPartialFraction();
+
+  BENCHMARK("cubic volume, cache") {
+    return cache.GetCubicVolume(MakeSolid());
+  };
+
+  BENCHMARK("volume table, cache") {
+    nexus::SolidPointSampler sampler(MakeSolid());
+    return sampler.GetPartialFraction();
+  };
+
+  cache.SetDirectory("");
+  RemoveCache(cache_dir);
+}
@@ -0,0 +1,27 @@
+#include "HexagonMeshModel.h"
+
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("HexagonMeshModel::Propagate") {
+
+  // NEXT-100 EL mesh, with the VUV reflectivity of steel
+  nexus::HexagonMeshModel mesh(2.5*mm, 2.63*mm, 0.13*mm);
+
+  G4ThreeVector incident = G4ThreeVector(0.3, -0.2, -1.).unit();
+
+  BENCHMARK("1000 photons") {
+    G4int ntransmitted = 0;
+    for (G4int i=0; i<1000; ++i) {
+      G4ThreeVector position(G4UniformRand() * 100.*mm, G4UniformRand() * 100.*mm, 0.);
+      G4ThreeVector direction = incident;
+      if (mesh.Propagate(position, direction, 0.2, 0.75) ==
+          nexus::HexagonMeshModel::TRANSMITTED)
+        ++ntransmitted;
+    }
+    return ntransmitted;
+  };
+}
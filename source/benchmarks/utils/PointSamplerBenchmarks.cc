@@ -0,0 +1,119 @@
+#include "BoxPointSampler.h"
+#include "CylinderPointSampler.h"
+#include "SpherePointSampler.h"
+#include "SegmentPointSampler.h"
+#include "PolygonPointSampler.h"
+#include "SolidPointSampler.h"
+#include "RandomUtils.h"
+
+#include <G4Tubs.hh>
+#include <G4Sphere.hh>
+#include <G4UnionSolid.hh>
+#include <G4SubtractionSolid.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+
+TEST_CASE("BoxPointSampler::GenerateVertex") {
+
+  auto sampler = nexus::BoxPointSampler(50.*cm, 60.*cm, 70.*cm, 5.*cm);
+
+  BENCHMARK("VOLUME") {
+    return sampler.GenerateVertex(nexus::VOLUME);
+  };
+
+  BENCHMARK("INSIDE") {
+    return sampler.GenerateVertex(nexus::INSIDE);
+  };
+}
+
+
+TEST_CASE("CylinderPointSampler::GenerateVertex") {
+
+  auto sampler = nexus::CylinderPointSampler(40.*cm, 50.*cm, 60.*cm, 0., twopi);
+
+  BENCHMARK("VOLUME") {
+    return sampler.GenerateVertex(nexus::VOLUME);
+  };
+
+  BENCHMARK("INNER_SURF") {
+    return sampler.GenerateVertex(nexus::INNER_SURF);
+  };
+
+  BENCHMARK("OUTER_SURF") {
+    return sampler.GenerateVertex(nexus::OUTER_SURF);
+  };
+}
+
+
+TEST_CASE("SpherePointSampler::GenerateVertex") {
+
+  auto sampler = nexus::SpherePointSampler(40.*cm, 50.*cm);
+
+  BENCHMARK("VOLUME") {
+    return sampler.GenerateVertex(nexus::VOLUME);
+  };
+
+  BENCHMARK("INSIDE") {
+    return sampler.GenerateVertex(nexus::INSIDE);
+  };
+}
+
+
+TEST_CASE("PolygonPointSampler::GenerateVertex") {
+
+  auto sampler = nexus::PolygonPointSampler(40.*cm, 50.*cm, 60.*cm, 8);
+
+  BENCHMARK("VOLUME") {
+    return sampler.GenerateVertex(nexus::VOLUME);
+  };
+
+  BENCHMARK("INSIDE") {
+    return sampler.GenerateVertex(nexus::INSIDE);
+  };
+}
+
+
+TEST_CASE("SolidPointSampler::GenerateVertex") {
+
+  // A vessel-like shell: a tube closed by two spherical caps
+  auto tube = new G4Tubs("TUBE", 0., 50.*cm, 60.*cm, 0., twopi);
+  auto cap  = new G4Sphere("CAP", 0., 80.*cm, 0., twopi, 0., 40.*deg);
+  G4VSolid* outer = new G4UnionSolid("OUTER", tube, cap, nullptr,
+                                     G4ThreeVector(0., 0., 60.*cm - 80.*cm*std::cos(40.*deg)));
+  G4VSolid* inner = new G4Tubs("INNER", 0., 49.*cm, 59.*cm, 0., twopi);
+  auto shell = new G4SubtractionSolid("SHELL", outer, inner);
+
+  auto sampler = nexus::SolidPointSampler(shell);
+
+  // Tables are built outside the measurements
+  sampler.GenerateVertex(nexus::VOLUME);
+  sampler.GenerateVertex(nexus::SURFACE);
+
+  BENCHMARK("VOLUME") {
+    return sampler.GenerateVertex(nexus::VOLUME);
+  };
+
+  BENCHMARK("SURFACE") {
+    return sampler.GenerateVertex(nexus::SURFACE);
+  };
+
+  BENCHMARK("G4VSolid::GetPointOnSurface") {
+    return shell->GetPointOnSurface();
+  };
+}
+
+
+TEST_CASE("SegmentPointSampler::Shoot") {
+
+  auto sampler = nexus::SegmentPointSampler(G4LorentzVector(0., 0., 0., 0.),
+                                            G4LorentzVector(1.*mm, 2.*mm, 3.*mm, 1.*microsecond));
+
+  BENCHMARK("Shoot") {
+    return sampler.Shoot();
+  };
+}
@@ -6,21 +6,25 @@
 // FORTRAN package, with nexus.
 // It provides the primary vertex of a Xe-136 double beta decay.
 // The possibility of reading a previously generated ascii file with the
-// electron momenta is also allowed.
+// electron momenta is also allowed, as well as reading events from a binary
+// pool produced with nexus-decay0-pool.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
 #include "Decay0Interface.h"
 
+#include "Decay0Pool.h"
 #include "DetectorConstruction.h"
 #include "GeometryBase.h"
 #include "FactoryBase.h"
+#include "NexusApp.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4RunManager.hh>
 #include <G4ParticleTable.hh>
 #include <G4ParticleDefinition.hh>
+#include <Randomize.hh>
 #include "decay0.h"
 #include <iostream>
 using namespace nexus;
@@ -30,16 +34,30 @@ REGISTER_CLASS(Decay0Interface, G4VPrimaryGenerator)
 
 Decay0Interface::Decay0Interface():
   G4VPrimaryGenerator(), msg_(0), decay_file_("th-e1-spectrum.dat"),
-  opened_(false), geom_(0)
+  table_cache_dir_(""), opened_(false), pool_(nullptr), pool_checked_(false),
+  pool_first_event_(-1), pool_event_(-1), restored_pool_event_(-1), restored_file_pos_(-1),
+  Xe136DecayMode_(1), Ba136FinalState_(0), geom_(0)
 {
 
   msg_ = new G4GenericMessenger(this, "/Generator/Decay0Interface/",
     "Control commands of the Decay0 interface.");
 
   msg_->DeclareMethod("inputFile", &Decay0Interface::OpenInputFile, "");
-  msg_->DeclareProperty("region", region_, "");
+  msg_->DeclareMethod("region", &Decay0Interface::SetRegion, "");
+  msg_->DeclareMethod("pool_file", &Decay0Interface::OpenPoolFile,
+                      "Binary pool of events produced with nexus-decay0-pool");
+  msg_->DeclareProperty("pool_first_event", pool_first_event_,
+                        "First event read from the pool. If negative, "
+                        "a random one is chosen so that jobs with different "
+                        "seeds read different parts of the pool. With "
+                        "per-event random streams, each event reads the pool "
+                        "entry given by its global id, shifted by this value "
+                        "if positive.");
   msg_->DeclareProperty("decay_file", decay_file_,
                         "Name of the file with the decay info");
+  msg_->DeclareProperty("table_cache_dir", table_cache_dir_,
+                        "Directory where the sampling tables of the decay "
+                        "energies are cached. No cache if empty (default).");
 
   msg_->DeclareMethod("EnergyThreshold", &Decay0Interface::SetEnergyThreshold, ""); // for electrons only.
   msg_->DeclareMethod("Xe136DecayMode", &Decay0Interface::SetXe136DecayMode, "");
@@ -61,6 +79,7 @@ Decay0Interface::~Decay0Interface()
   if (file_.is_open()) file_.close();
   if (fOutDebug_.is_open()) fOutDebug_.close();
   if (decay0_ != 0) delete decay0_;
+  delete pool_;
 }
 
 
@@ -87,16 +106,51 @@ void Decay0Interface::OpenInputFile(G4String filename)
 
 
 
+void Decay0Interface::OpenPoolFile(G4String filename)
+{
+  delete pool_;
+  pool_ = new Decay0PoolReader(filename);
+  pool_event_ = -1;
+  // The decay mode and final state may be set after the pool is opened:
+  // they are checked against the pool when the first event is read
+  pool_checked_ = false;
+
+  G4cout << "[Decay0Interface] Reading " << pool_->GetNumberOfEvents()
+         << " events (Xe136 decay mode " << pool_->GetDecayMode()
+         << ", Ba136 final state " << pool_->GetFinalState()
+         << ") from " << filename << G4endl;
+}
+
+
+
+void Decay0Interface::SetRegion(G4String region)
+{
+  region_ = region;
+  // Resolved into a sampler when the next vertex is generated,
+  // once the geometry has been constructed
+  vertex_sampler_ = nullptr;
+}
+
+
+
 /// Read an event from file and create primary particles and
 /// vertices accordingly
 void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
 {
+  ApplyRestoredState();
+
+  if (pool_) {
+    GeneratePoolVertex(event);
+    return;
+  }
+
   const bool runG4 = true;
 //  const bool runG4 = false;
   if (!opened_) {
      if (decay0_ == 0) {
        const std::string XeName("Xe136");
-       decay0_ = new decay0(XeName, Ba136FinalState_, Xe136DecayMode_, decay_file_);
+       decay0_ = new decay0(XeName, Ba136FinalState_, Xe136DecayMode_, decay_file_,
+                            0.0, 4.3, table_cache_dir_);
       // Temporary debugging file, just generate particle and dump them on a file
 //      std::ostringstream fOutStrStr; fOutStrStr << "./Decay0Out_" << Ba136FinalState_ << "_" << Xe136DecayMode_ << "_V1.txt";
 //      std::string fOutStr(fOutStrStr.str());
@@ -125,7 +179,8 @@ void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
         }
      }
      if (runG4 && keepEvt) {
-        particle_position = geom_->GenerateVertex(region_);
+        if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+        particle_position = vertex_sampler_();
         for (std::vector<decay0Part>::const_iterator itp = theParts.begin(); itp != theParts.end(); itp++) {
           G4ParticleDefinition* g4code =
              G4ParticleTable::GetParticleTable()->FindParticle(itp->pdgCode_);
@@ -163,7 +218,8 @@ void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
 
   // generate a position in the detector
   // (all primary particles will be generated there)
-  particle_position = geom_->GenerateVertex(region_);
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  particle_position = vertex_sampler_();
 
 
   // reading info for each particle in the event
@@ -198,6 +254,126 @@ void Decay0Interface::GeneratePrimaryVertex(G4Event* event)
 
 
 
+void Decay0Interface::GeneratePoolVertex(G4Event* event)
+{
+  G4long nevents = pool_->GetNumberOfEvents();
+  if (nevents == 0) {
+    G4Exception("[Decay0Interface]", "GeneratePoolVertex()", FatalException,
+                "The Decay0 pool is empty!");
+    return;
+  }
+
+  if (!pool_checked_) {
+    if (pool_->GetDecayMode() != Xe136DecayMode_ ||
+        pool_->GetFinalState() != Ba136FinalState_) {
+      G4String msg = "The Decay0 pool was generated with Xe136 decay mode " +
+        std::to_string(pool_->GetDecayMode()) + " and Ba136 final state " +
+        std::to_string(pool_->GetFinalState()) + ", but decay mode " +
+        std::to_string(Xe136DecayMode_) + " and final state " +
+        std::to_string(Ba136FinalState_) + " were requested.";
+      G4Exception("[Decay0Interface]", "GeneratePoolVertex()",
+                  FatalException, msg);
+    }
+    pool_checked_ = true;
+  }
+
+  NexusApp* app = (NexusApp*) G4RunManager::GetRunManager();
+  if (app->IsRandomPerEvent()) {
+    // Each event reads the same pool entry whichever job simulates it
+    G4long offset = (pool_first_event_ >= 0) ? pool_first_event_ : 0;
+    pool_event_ = (offset + event->GetEventID()) % nevents;
+  }
+  else if (pool_event_ < 0) {
+    // The starting point is drawn once the random seed has been set
+    pool_event_ = (pool_first_event_ >= 0) ?
+      pool_first_event_ % nevents : G4RandFlat::shootInt(nevents);
+  }
+  else if (pool_event_ >= nevents) {
+    G4Exception("[Decay0Interface]", "GeneratePoolVertex()", JustWarning,
+                "End of the Decay0 pool reached, events will be reused.");
+    pool_event_ = 0;
+  }
+
+  size_t nparticles;
+  const Decay0PoolParticle* parts = pool_->GetEvent(pool_event_++, nparticles);
+
+  // Keep the event only if the sum of the electron energies are above the threshold.
+  double eTotKin = 0.;
+  for (size_t i=0; i<nparticles; i++)
+    if (std::abs(parts[i].pdg_code) == 11) eTotKin += parts[i].energy;
+  if (eTotKin <= energyThreshold_) return;
+
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  G4ThreeVector particle_position = vertex_sampler_();
+
+  for (size_t i=0; i<nparticles; i++) {
+    G4ParticleDefinition* g4code =
+      G4ParticleTable::GetParticleTable()->FindParticle(parts[i].pdg_code);
+    G4PrimaryParticle* particle =
+      new G4PrimaryParticle(g4code, MeV*parts[i].px, MeV*parts[i].py, MeV*parts[i].pz);
+    // create a primary vertex for the particle
+    G4PrimaryVertex* vertex =
+      new G4PrimaryVertex(particle_position, parts[i].time*second);
+    vertex->SetPrimary(particle);
+    event->AddPrimaryVertex(vertex);
+  }
+}
+
+
+
+void Decay0Interface::SaveState(std::map<std::string, std::string>& state)
+{
+  // Events generated by decay0 itself depend on the random engine only
+  if (pool_) {
+    G4long next = (restored_pool_event_ >= 0) ? restored_pool_event_ : pool_event_;
+    state["pool_event"] = std::to_string(next);
+  }
+  else if (opened_) {
+    G4long pos = (restored_file_pos_ >= 0) ?
+      restored_file_pos_ : static_cast<G4long>(file_.tellg());
+    state["file_position"] = std::to_string(pos);
+  }
+}
+
+
+
+G4bool Decay0Interface::RestoreState(const std::map<std::string, std::string>& state)
+{
+  // The input file or the pool may be opened by the delayed macros,
+  // after the checkpoint has been read: the state is applied later
+  auto it = state.find("pool_event");
+  if (it != state.end()) restored_pool_event_ = std::stol(it->second);
+
+  it = state.find("file_position");
+  if (it != state.end()) restored_file_pos_ = std::stol(it->second);
+
+  return true;
+}
+
+
+
+void Decay0Interface::ApplyRestoredState()
+{
+  if (restored_pool_event_ >= 0) {
+    if (!pool_)
+      G4Exception("[Decay0Interface]", "ApplyRestoredState()", FatalException,
+                  "The resumed job read a Decay0 pool, but none is open.");
+    pool_event_ = restored_pool_event_;
+    restored_pool_event_ = -1;
+  }
+
+  if (restored_file_pos_ >= 0) {
+    if (!opened_)
+      G4Exception("[Decay0Interface]", "ApplyRestoredState()", FatalException,
+                  "The resumed job read a Decay0 input file, but none is open.");
+    file_.clear();
+    file_.seekg(restored_file_pos_);
+    restored_file_pos_ = -1;
+  }
+}
+
+
+
 void Decay0Interface::ProcessHeader()
 {
   G4String line;
@@ -5,7 +5,8 @@
 // interfacing the DECAY0 c++ code, translated from the original
 // FORTRAN package, with nexus.
 // The possibility of reading a previously generated ascii file with the
-// electron momenta is also allowed.
+// electron momenta is also allowed, as well as reading events from a binary
+// pool produced with nexus-decay0-pool.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -13,6 +14,9 @@
 #ifndef DECAY0_INTERFACE_H
 #define DECAY0_INTERFACE_H
 
+#include "GeometryBase.h"
+#include "ResumableGenerator.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <fstream>
 
@@ -23,14 +27,14 @@ class decay0;
 
 namespace nexus {
 
-  class GeometryBase;
+  class Decay0PoolReader;
 
 
   /// This primary generator sets the G4Event objects according to the
   /// information read from an ascii file produced by the Decay0
   /// Monte-Carlo event generator.
 
-  class Decay0Interface : public G4VPrimaryGenerator
+  class Decay0Interface : public G4VPrimaryGenerator, public ResumableGenerator
   {
   public:
     /// Constructor
@@ -42,11 +46,27 @@ namespace nexus {
     /// and primary vertices accordingly
     void GeneratePrimaryVertex(G4Event*);
 
+    /// Save and restore the position of the next event read from
+    /// the input file or the pool
+    void SaveState(std::map<std::string, std::string>&);
+    G4bool RestoreState(const std::map<std::string, std::string>&);
+
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
     /// Open the Decay0 input file selected by the user
     void OpenInputFile(G4String);
+    /// Map the binary pool of pre-generated events selected by the user
+    void OpenPoolFile(G4String);
+    /// Generate the primary particles of the next event in the pool
+    void GeneratePoolVertex(G4Event*);
     /// Parse information in the file header
     void ProcessHeader();
+    /// Move the input file or the pool to the position restored
+    /// from a checkpoint, once they have been opened
+    void ApplyRestoredState();
 
     /// Return the PDG code equivalent to a given GEANT3 particle code
     G4int G3toPDG(const G4int);
@@ -55,13 +75,21 @@ namespace nexus {
     G4GenericMessenger* msg_;
 
     G4String decay_file_;
+    G4String table_cache_dir_; ///< Cache of the decay0 sampling tables
 
     std::ifstream file_; ///< ASCII file produced by Decay0
     G4String region_; ///< region of generation of vertices in geometry
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
 
     G4bool opened_;
 
-    int myEventCounter_;
+    Decay0PoolReader* pool_; ///< Pool of pre-generated events
+    G4bool pool_checked_; ///< True once the pool settings match the requested decay
+    G4int pool_first_event_; ///< First event read from the pool (random if negative)
+    G4long pool_event_; ///< Next event to be read from the pool
+
+    G4long restored_pool_event_; ///< Pool event restored from a checkpoint (none if negative)
+    G4long restored_file_pos_;   ///< File position restored from a checkpoint (none if negative)
 
     decay0 *decay0_;
     int Xe136DecayMode_; // See method printDecayModeList  Default is 1
@@ -69,6 +97,8 @@ namespace nexus {
                           // Valid list: 0, 819,  1551, 1579, 2080, 2129, 2141, 2223, 2315, 2400)
 			  // default is 0 (ground state)
 
+    int myEventCounter_;
+
     double energyThreshold_;
 
     std::ofstream fOutDebug_; // for debugging...
@@ -0,0 +1,120 @@
+// ----------------------------------------------------------------------------
+// nexus | Decay0Pool.cc
+//
+// Writer and reader of pools of pre-generated Decay0 events, stored in a
+// compact binary file: a header, fixed-size particle records and an index
+// with the offset of the first particle of each event. The reader maps the
+// file in memory, so that events are accessed without copies.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "Decay0Pool.h"
+#include "decay0.h"
+
+#include <G4Exception.hh>
+
+#include <cstring>
+
+using namespace nexus;
+
+namespace {
+  const char     POOL_MAGIC[8] = {'N', 'X', 'D', '0', 'P', 'O', 'O', 'L'};
+  const uint32_t POOL_VERSION  = 1;
+}
+
+
+Decay0PoolWriter::Decay0PoolWriter(const G4String& filename,
+                                   G4int decay_mode, G4int final_state):
+  file_(filename, std::ios::binary)
+{
+  if (!file_.good())
+    G4Exception("[Decay0PoolWriter]", "Decay0PoolWriter()", FatalException,
+                ("Cannot open Decay0 pool file " + filename).c_str());
+
+  std::memset(&header_, 0, sizeof(header_));
+  std::memcpy(header_.magic, POOL_MAGIC, sizeof(POOL_MAGIC));
+  header_.version     = POOL_VERSION;
+  header_.decay_mode  = decay_mode;
+  header_.final_state = final_state;
+  header_.record_size = sizeof(Decay0PoolParticle);
+
+  // The header is rewritten once the number of events is known
+  file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+
+  index_.push_back(0);
+}
+
+
+
+Decay0PoolWriter::~Decay0PoolWriter()
+{
+  if (file_.is_open()) Close();
+}
+
+
+
+void Decay0PoolWriter::Write(const std::vector<decay0Part>& particles)
+{
+  for (const auto& part : particles) {
+    Decay0PoolParticle record;
+    record.pdg_code = part.pdgCode_;
+    record.px       = part.pmom_[0];
+    record.py       = part.pmom_[1];
+    record.pz       = part.pmom_[2];
+    record.energy   = part.energy_;
+    record.time     = part.time_;
+    file_.write(reinterpret_cast<const char*>(&record), sizeof(record));
+  }
+
+  header_.nparticles += particles.size();
+  header_.nevents++;
+  index_.push_back(header_.nparticles);
+}
+
+
+
+void Decay0PoolWriter::Close()
+{
+  header_.index_offset = file_.tellp();
+  file_.write(reinterpret_cast<const char*>(index_.data()),
+              index_.size() * sizeof(uint64_t));
+
+  file_.seekp(0);
+  file_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+  file_.close();
+}
+
+
+
+Decay0PoolReader::Decay0PoolReader(const G4String& filename):
+  header_(nullptr), particles_(nullptr), index_(nullptr)
+{
+  if (!mapping_.Open(filename))
+    G4Exception("[Decay0PoolReader]", "Decay0PoolReader()", FatalException,
+                ("Cannot map Decay0 pool file " + filename).c_str());
+
+  header_ = mapping_.At<Decay0PoolHeader>(0);
+
+  if (!header_ ||
+      std::memcmp(header_->magic, POOL_MAGIC, sizeof(POOL_MAGIC)) != 0 ||
+      header_->version != POOL_VERSION ||
+      header_->record_size != sizeof(Decay0PoolParticle) ||
+      !mapping_.At<Decay0PoolParticle>(sizeof(Decay0PoolHeader), header_->nparticles) ||
+      !mapping_.At<uint64_t>(header_->index_offset, header_->nevents + 1))
+    G4Exception("[Decay0PoolReader]", "Decay0PoolReader()", FatalException,
+                (filename + " is not a valid Decay0 pool file").c_str());
+
+  particles_ = mapping_.At<Decay0PoolParticle>(sizeof(Decay0PoolHeader), header_->nparticles);
+  index_ = mapping_.At<uint64_t>(header_->index_offset, header_->nevents + 1);
+
+  if (index_[header_->nevents] != header_->nparticles)
+    G4Exception("[Decay0PoolReader]", "Decay0PoolReader()", FatalException,
+                (filename + " is not a valid Decay0 pool file").c_str());
+}
+
+
+
+Decay0PoolReader::~Decay0PoolReader()
+{
+}
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// nexus | Decay0Pool.h
+//
+// Writer and reader of pools of pre-generated Decay0 events, stored in a
+// compact binary file: a header, fixed-size particle records and an index
+// with the offset of the first particle of each event. The reader maps the
+// file in memory, so that events are accessed without copies.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef DECAY0_POOL_H
+#define DECAY0_POOL_H
+
+#include "MappedFile.h"
+
+#include <G4String.hh>
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+
+struct decay0Part;
+
+
+namespace nexus {
+
+  /// Header at the beginning of a pool file
+  struct Decay0PoolHeader
+  {
+    char     magic[8];      ///< File signature ("NXD0POOL")
+    uint32_t version;       ///< Format version
+    int32_t  decay_mode;    ///< Xe136 decay mode used to generate the pool
+    int32_t  final_state;   ///< Ba136 final state used to generate the pool
+    uint32_t record_size;   ///< Size in bytes of a particle record
+    uint64_t nevents;       ///< Number of events
+    uint64_t nparticles;    ///< Total number of particles
+    uint64_t index_offset;  ///< Position in bytes of the event index
+  };
+
+  /// Particle record. Momenta and kinetic energy in MeV, time in seconds.
+  struct Decay0PoolParticle
+  {
+    int32_t pdg_code;
+    float   px, py, pz;
+    float   energy;
+    float   time;
+  };
+
+
+  class Decay0PoolWriter
+  {
+  public:
+    /// Constructor. Opens the output file.
+    Decay0PoolWriter(const G4String& filename,
+                     G4int decay_mode, G4int final_state);
+    /// Destructor. Closes the file if still open.
+    ~Decay0PoolWriter();
+
+    /// Appends an event to the pool
+    void Write(const std::vector<decay0Part>& particles);
+
+    /// Writes the event index and the final header
+    void Close();
+
+  private:
+    std::ofstream file_;
+    Decay0PoolHeader header_;
+    std::vector<uint64_t> index_; ///< First particle of each event
+  };
+
+
+  class Decay0PoolReader
+  {
+  public:
+    /// Constructor. Maps the pool file in memory.
+    Decay0PoolReader(const G4String& filename);
+    /// Destructor. Unmaps the file.
+    ~Decay0PoolReader();
+
+    uint64_t GetNumberOfEvents() const;
+    G4int GetDecayMode() const;
+    G4int GetFinalState() const;
+
+    /// Returns a pointer to the first particle of the given event
+    /// and sets the number of particles in it
+    const Decay0PoolParticle* GetEvent(uint64_t event, size_t& nparticles) const;
+
+  private:
+    MappedFile mapping_; ///< Mapped pool file
+
+    const Decay0PoolHeader* header_;
+    const Decay0PoolParticle* particles_;
+    const uint64_t* index_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline uint64_t Decay0PoolReader::GetNumberOfEvents() const
+  { return header_->nevents; }
+
+  inline G4int Decay0PoolReader::GetDecayMode() const
+  { return header_->decay_mode; }
+
+  inline G4int Decay0PoolReader::GetFinalState() const
+  { return header_->final_state; }
+
+  inline const Decay0PoolParticle*
+  Decay0PoolReader::GetEvent(uint64_t event, size_t& nparticles) const
+  {
+    nparticles = index_[event+1] - index_[event];
+    return particles_ + index_[event];
+  }
+
+} // end namespace nexus
+
+#endif
@@ -50,8 +50,8 @@ ECECGenerator::ECECGenerator():
 
   msg_->DeclareProperty("shell", shell_name_, "Shell from which the electron is captured.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where vertices will be generated.");
+  msg_->DeclareMethod("region", &ECECGenerator::SetRegion,
+                      "Region of the geometry where vertices will be generated.");
 
 }
 
@@ -125,13 +125,24 @@ G4PrimaryParticle* ECECGenerator::GetPrimaryParticle(G4DynamicParticle* dparticl
 }
 
 
+void ECECGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  // Resolved into a sampler when the next vertex is generated,
+  // once the geometry has been constructed
+  vertex_sampler_ = nullptr;
+}
+
+
+
 void ECECGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   if (!atom_) // First time only
     Initialize();
 
   // Generate an initial position for the ion using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  G4ThreeVector position = vertex_sampler_();
 
   // Ion generated at the start-of-event time
   G4double time = 0.;
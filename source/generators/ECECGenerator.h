@@ -12,6 +12,8 @@
 #ifndef ECEC_GENERATOR_H
 #define ECEC_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4AtomicShellEnumerator.hh>
 
@@ -26,8 +28,6 @@ class G4UAtomicDeexcitation;
 
 namespace nexus{
 
-  class GeometryBase;
-
   class ECECGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -40,6 +40,10 @@ namespace nexus{
     // setting a primary vertex that contains the chosen ion
     void GeneratePrimaryVertex(G4Event*);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
  private:
    void                    Initialize();
    G4AtomicShellEnumerator GetShellID(G4String);
@@ -49,6 +53,7 @@ namespace nexus{
     G4int    atomic_number_;
     G4String shell_name_;
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
     G4GenericMessenger* msg_;
 
     const GeometryBase* geom_;
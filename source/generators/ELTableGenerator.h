@@ -9,6 +9,8 @@
 #ifndef EL_TABLE_GENERATOR_H
 #define EL_TABLE_GENERATOR_H
 
+#include "ResumableGenerator.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -20,7 +22,7 @@ namespace nexus {
   class GeometryBase;
 
 
-  class ELTableGenerator: public G4VPrimaryGenerator
+  class ELTableGenerator: public G4VPrimaryGenerator, public ResumableGenerator
   {
   public:
     /// Constructor
@@ -33,6 +35,11 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+    /// The points of the table are taken in sequence by the geometry,
+    /// which keeps no checkpoint: jobs cannot be resumed
+    void SaveState(std::map<std::string, std::string>&);
+    G4bool RestoreState(const std::map<std::string, std::string>&);
+
   private:
     G4GenericMessenger* msg_; ///< Pointer to UI messenger
     const GeometryBase* geom_; ///< Pointer to the detector geometry
@@ -40,6 +47,12 @@ namespace nexus {
     G4int num_ie_;
   };
 
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void ELTableGenerator::SaveState(std::map<std::string, std::string>&) {}
+  inline G4bool ELTableGenerator::RestoreState(const std::map<std::string, std::string>&)
+  { return false; }
+
 } // end namespace nexus
 
 #endif
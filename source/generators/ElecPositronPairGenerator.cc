@@ -51,8 +51,8 @@ geom_(0)
   max_energy.SetParameterName("max_energy", false);
   max_energy.SetRange("max_energy>0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &ElecPositronPairGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
   DetectorConstruction* detconst = (DetectorConstruction*) G4RunManager::GetRunManager()->GetUserDetectorConstruction();
   geom_ = detconst->GetGeometry();
@@ -66,6 +66,16 @@ ElecPositronPairGenerator::~ElecPositronPairGenerator()
 }
 
 
+void ElecPositronPairGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  // Resolved into a sampler when the next vertex is generated,
+  // once the geometry has been constructed
+  vertex_sampler_ = nullptr;
+}
+
+
+
 void ElecPositronPairGenerator::GeneratePrimaryVertex(G4Event* event)
 {
 
@@ -73,7 +83,8 @@ void ElecPositronPairGenerator::GeneratePrimaryVertex(G4Event* event)
     G4ParticleTable::GetParticleTable()->FindParticle("e-");
 
   // Generate an initial position for the particle using the geometry
-  G4ThreeVector pos = geom_->GenerateVertex(region_);
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  G4ThreeVector pos = vertex_sampler_();
 
   // Particle generated at start-of-event
   G4double time = 0.;
@@ -10,6 +10,8 @@
 #ifndef ELEC_POSITRON_PAIR_GEN_H
 #define ELEC_POSITRON_PAIR_GEN_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -19,8 +21,6 @@ class G4ParticleDefinition;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class ElecPositronPairGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -34,6 +34,10 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
     G4GenericMessenger* msg_;
 
@@ -45,6 +49,7 @@ namespace nexus {
     const GeometryBase* geom_; ///< Pointer to the detector geometry
 
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
 
   };
 
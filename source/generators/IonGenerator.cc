@@ -55,8 +55,8 @@ IonGenerator::IonGenerator():
   msg_->DeclareProperty("decay_at_time_zero", decay_at_time_zero_,
                         "Set to true to make unstable ions decay at t=0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where vertices will be generated.");
+  msg_->DeclareMethod("region", &IonGenerator::SetRegion,
+                      "Region of the geometry where vertices will be generated.");
 
   // Load the detector geometry, which will be used for the generation of vertices
   const DetectorConstruction* detconst = dynamic_cast<const DetectorConstruction*>
@@ -94,6 +94,16 @@ G4ParticleDefinition* IonGenerator::IonDefinition()
 }
 
 
+void IonGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  // Resolved into a sampler when the next vertex is generated,
+  // once the geometry has been constructed
+  vertex_sampler_ = nullptr;
+}
+
+
+
 void IonGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   // Pointer declared as static so that it gets allocated only once
@@ -103,7 +113,8 @@ void IonGenerator::GeneratePrimaryVertex(G4Event* event)
   G4PrimaryParticle* ion = new G4PrimaryParticle(pdef);
 
   // Generate an initial position for the ion using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  G4ThreeVector position = vertex_sampler_();
   // Ion generated at the start-of-event time
   G4double time = 0.;
   // Create a new vertex
@@ -11,6 +11,8 @@
 #ifndef ION_GENERATOR_H
 #define ION_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4Event;
@@ -20,8 +22,6 @@ class G4ParticleDefinition;
 
 namespace nexus{
 
-  class GeometryBase;
-
   class IonGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -34,6 +34,10 @@ namespace nexus{
     // setting a primary vertex that contains the chosen ion
     void GeneratePrimaryVertex(G4Event*);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
     G4ParticleDefinition* IonDefinition();
 
@@ -42,6 +46,7 @@ namespace nexus{
     G4double energy_level_;
     G4bool decay_at_time_zero_;
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
     G4GenericMessenger* msg_;
     const GeometryBase* geom_;
   };
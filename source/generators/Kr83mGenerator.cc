@@ -88,9 +88,9 @@ namespace nexus {
      msg_ = new G4GenericMessenger(this, "/Generator/Kr83mGenerator/",
     "Control commands of Kr83 generator.");
 
-     msg_->DeclareProperty("region", region_,
+     msg_->DeclareMethod("region", &Kr83mGenerator::SetRegion,
 			   "Set the region of the geometry "
-                           "where the vertex will be generated.");
+                         "where the vertex will be generated.");
 
      // Set particle type searching in particle table by name
     particle_defgamma_ = G4ParticleTable::GetParticleTable()->
@@ -114,13 +114,24 @@ namespace nexus {
   {
   }
 
+  void Kr83mGenerator::SetRegion(G4String region)
+  {
+    region_ = region;
+    // Resolved into a sampler when the next vertex is generated,
+    // once the geometry has been constructed
+    vertex_sampler_ = nullptr;
+  }
+
+
+
   void Kr83mGenerator::GeneratePrimaryVertex(G4Event* evt)
   {
     // Add an Ascci ntuple to debug..
    // const int evtNum = evt->GetEventID();
 
     // Ask the geometry to generate a position for the particle
-    G4ThreeVector position = geom_->GenerateVertex(region_);
+    if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+    G4ThreeVector position = vertex_sampler_();
    //
    // First transition (32 kEv) Always one electron. Set it's kinetic energy.
    // Decide if we emit an X-ray..
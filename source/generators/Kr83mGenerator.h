@@ -10,6 +10,8 @@
 #ifndef Kr83m_GENERATOR_H
 #define Kr83m_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <vector>
 #include <G4VPrimaryGenerator.hh>
 
@@ -19,8 +21,6 @@ class G4GenericMessenger;
 
 namespace nexus {
 
-  class GeometryBase;
-
   /// This state decays into the fundamental state of Kr 83 in two steps,
   ///  (JP 1/2- --> Jp 7/2+ -> 9/2+), with transition energies of 32.15 and 9.4 keV
   ///  The life time of 83mKr is long, ~ 1.83 hours, so, infinite for us,
@@ -57,6 +57,10 @@ namespace nexus {
 
     void GeneratePrimaryVertex(G4Event* evt);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
 
     G4GenericMessenger* msg_;
@@ -71,6 +75,7 @@ namespace nexus {
                                             // We make cumulative, for easy access for random number.
 
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
     G4ParticleDefinition*  particle_defgamma_;
     G4ParticleDefinition*  particle_defelectron_;
   };
@@ -12,6 +12,8 @@
 #ifndef LAMBERTIAN_GENERATOR_H
 #define LAMBERTIAN_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -21,8 +23,6 @@ class G4ParticleDefinition;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class LambertianGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -36,6 +36,10 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
 
     void SetParticleDefinition(G4String);
@@ -51,6 +55,7 @@ namespace nexus {
     const GeometryBase* geom_; ///< Pointer to the detector geometry
 
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
 
     G4ThreeVector momentum_;
 
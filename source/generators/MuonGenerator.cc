@@ -13,6 +13,8 @@
 #include "FactoryBase.h"
 #include "RandomUtils.h"
 #include "IOUtils.h"
+#include "HistogramSampler.h"
+#include "PersistencyManagerBase.h"
 
 #include <G4Event.hh>
 #include <G4GenericMessenger.hh>
@@ -22,6 +24,12 @@
 #include <G4PrimaryVertex.hh>
 #include <G4Event.hh>
 #include <G4RandomDirection.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
+#include <G4PhysicalVolumeStore.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VSolid.hh>
 #include <Randomize.hh>
 
 #include "CLHEP/Units/SystemOfUnits.h"
@@ -34,7 +42,9 @@ MuonGenerator::MuonGenerator():
   G4VPrimaryGenerator(), msg_(0), particle_definition_(0),
   use_lsc_dist_(true), axis_rotation_(150), rPhi_(NULL), user_dir_{},
   energy_min_(0.), energy_max_(0.), dist_name_("za"), bInitialize_(false),
-  geom_(0), geom_solid_(0), gen_rad_(223.33*cm)
+  geom_(0), geom_solid_(0), muon_dist_(nullptr), fRandomGeneral_(nullptr),
+  gen_rad_(223.33*cm), acceptance_volume_(""), acceptance_margin_(0.),
+  max_rejections_(1000000)
 {
   msg_ = new G4GenericMessenger(this, "/Generator/MuonGenerator/",
 				"Control commands of muongenerator.");
@@ -78,6 +88,24 @@ MuonGenerator::MuonGenerator():
   generation_radius.SetParameterName("gen_rad", false);
   generation_radius.SetRange("gen_rad>0.");
 
+  msg_->DeclareProperty("acceptance_volume", acceptance_volume_,
+                        "Only muons whose line crosses this volume are simulated.");
+
+  G4GenericMessenger::Command& margin =
+    msg_->DeclareProperty("acceptance_margin", acceptance_margin_,
+                          "Margin around the bounding box of the acceptance volume. "
+                          "If set, the enlarged box is used instead of the exact shape.");
+  margin.SetUnitCategory("Length");
+  margin.SetParameterName("acceptance_margin", false);
+  margin.SetRange("acceptance_margin>=0.");
+
+  G4GenericMessenger::Command& rejections =
+    msg_->DeclareProperty("max_rejections", max_rejections_,
+                          "Muons missing the acceptance volume in a row "
+                          "before the job is stopped.");
+  rejections.SetParameterName("max_rejections", false);
+  rejections.SetRange("max_rejections>0");
+
   DetectorConstruction* detconst =
     (DetectorConstruction*) G4RunManager::GetRunManager()->GetUserDetectorConstruction();
   geom_ = detconst->GetGeometry();
@@ -88,6 +116,7 @@ MuonGenerator::MuonGenerator():
 MuonGenerator::~MuonGenerator()
 {
   delete msg_;
+  delete muon_dist_;
 }
 
 void MuonGenerator::LoadMuonDistribution()
@@ -112,27 +141,21 @@ void MuonGenerator::LoadMuonDistribution()
                   "with angle_dist=zae option selected, use angle_dist=za ");
   }
 
-  // Load in the data from csv file depending on 2D histogram sampling or 3D
+  // Load in the data from csv file (or its binary cache) depending
+  // on 2D histogram sampling or 3D. The flux is sampled per bin with
+  // an alias table.
   if (dist_name_ == "za")
-    LoadHistData2D(ang_file_, flux_, azimuths_, zeniths_, azimuth_smear_, zenith_smear_);
+    muon_dist_ = new HistogramSampler(ang_file_, 2);
 
   if (dist_name_ == "zae"){
-    LoadHistData3D(ang_file_, flux_, azimuths_, zeniths_, energies_,
-                   azimuth_smear_, zenith_smear_, energy_smear_);
+    muon_dist_ = new HistogramSampler(ang_file_, 3);
     
     // Check if the energy is in the desired range permitted
     // by the binning range in the data file
-    CheckVarBounds(ang_file_, energy_min_/GeV, energy_max_/GeV, "energy"); 
+    CheckVarBounds(*muon_dist_, energy_min_/GeV, energy_max_/GeV, "energy"); 
 
   }
 
-  // Convert flux vector to arr
-  auto arr_flux = flux_.data();
-
-  // Initialise the Random Number Generator based on the flux distribution
-  // (in bin index)
-  fRandomGeneral_ = new G4RandGeneral( arr_flux, flux_.size() );
-
 }
 
 void MuonGenerator::InitMuonZenithDist()
@@ -197,6 +220,10 @@ void MuonGenerator::GeneratePrimaryVertex(G4Event* event)
                    "direction " << std::endl;
     }
 
+    // Volume that muons must cross to be simulated
+    if (acceptance_volume_ != "")
+      SetupAcceptance();
+
     // Set Initialisation
     bInitialize_ = true;
 
@@ -225,42 +252,61 @@ void MuonGenerator::GeneratePrimaryVertex(G4Event* event)
   G4ThreeVector p_dir;
   G4double zenith;
   G4double azimuth;
+  G4ThreeVector position;
 
-  // Momentum, zenith, azimuth (and energy) from angular distribution file
-  if (use_lsc_dist_){
-    GetDirection(p_dir, zenith, azimuth, energy, kinetic_energy, mass);
-    //    position = geom_->GenerateVertex(region_);
-  }
-  else {
+  // Muons that cannot reach the acceptance volume, if any,
+  // are discarded here instead of being tracked
+  G4long rejected = -1;
 
-    // User specified muon direction in some fixed direction
-    if ( user_dir_ != G4ThreeVector{}) {
-      p_dir   = user_dir_.unit();
-      zenith  = p_dir.getTheta();
-      azimuth = p_dir.getPhi() + pi; // change azimuth interval to be between 0, twopi
-    }
+  do {
+
+    if (++rejected == max_rejections_)
+      G4Exception("[MuonGenerator]", "GeneratePrimaryVertex()",
+                  FatalException, " No muon crosses the acceptance volume, "
+                  "check acceptance_volume and the generation region");
 
-    // Sample direction via cos^2 distribution for zenith, uniform azimuth
+    // Momentum, zenith, azimuth (and energy) from angular distribution file
+    if (use_lsc_dist_){
+      GetDirection(p_dir, zenith, azimuth, energy, kinetic_energy, mass);
+    }
     else {
-      zenith  = GetZenith();
-      azimuth = GetAzimuth(); // Returns from 0 to 2pi
 
-      // Calculate the vector components of the muon
-      p_dir.setX(sin(zenith) * sin(azimuth));
-      p_dir.setY(-cos(zenith));
-      p_dir.setZ(-sin(zenith) * cos(azimuth));
+      // User specified muon direction in some fixed direction
+      if ( user_dir_ != G4ThreeVector{}) {
+        p_dir   = user_dir_.unit();
+        zenith  = p_dir.getTheta();
+        azimuth = p_dir.getPhi() + pi; // change azimuth interval to be between 0, twopi
+      }
+
+      // Sample direction via cos^2 distribution for zenith, uniform azimuth
+      else {
+        zenith  = GetZenith();
+        azimuth = GetAzimuth(); // Returns from 0 to 2pi
+
+        // Calculate the vector components of the muon
+        p_dir.setX(sin(zenith) * sin(azimuth));
+        p_dir.setY(-cos(zenith));
+        p_dir.setZ(-sin(zenith) * cos(azimuth));
 
-      // Rotate about the Y-Axis
-      p_dir *= *rPhi_;
+        // Rotate about the Y-Axis
+        p_dir *= *rPhi_;
 
+      }
     }
-  }
 
-  G4ThreeVector position;
-  if ((region_ == "HALLA_INNER") || (region_ == "HALLA_OUTER")) {
-    position = ProjectToVertex(p_dir);
-  } else {
-    position = geom_->GenerateVertex(region_);
+    if ((region_ == "HALLA_INNER") || (region_ == "HALLA_OUTER")) {
+      position = ProjectToVertex(p_dir);
+    } else {
+      position = geom_->GenerateVertex(region_);
+    }
+
+  } while (geom_solid_ && !CheckOverlap(position, p_dir));
+
+  // Rejected muons are needed to normalise the simulated exposure
+  if (geom_solid_) {
+    PersistencyManagerBase* pm = dynamic_cast<PersistencyManagerBase*>
+      (G4VPersistencyManager::GetPersistencyManager());
+    if (pm) pm->AddRunCounter("muons_rejected", rejected);
   }
 
   G4double pmod   = std::sqrt(energy*energy - mass*mass);
@@ -290,6 +336,99 @@ void MuonGenerator::GeneratePrimaryVertex(G4Event* event)
 }
 
 
+void MuonGenerator::SetupAcceptance()
+{
+  // Find the placement of the acceptance volume in the world
+  G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()->
+    GetNavigatorForTracking()->GetWorldVolume();
+
+  G4AffineTransform to_global;
+  if (!FindVolume(world->GetLogicalVolume(), G4AffineTransform(), to_global))
+    G4Exception("[MuonGenerator]", "SetupAcceptance()", FatalException,
+                (" Acceptance volume " + acceptance_volume_ + " not found").c_str());
+
+  to_local_ = to_global.Inverse();
+
+  G4VPhysicalVolume* volume =
+    G4PhysicalVolumeStore::GetInstance()->GetVolume(acceptance_volume_, false);
+  geom_solid_ = volume->GetLogicalVolume()->GetSolid();
+
+  geom_solid_->BoundingLimits(acceptance_min_, acceptance_max_);
+  G4ThreeVector margin(acceptance_margin_, acceptance_margin_, acceptance_margin_);
+  acceptance_min_ -= margin;
+  acceptance_max_ += margin;
+
+  std::cout << "[MuonGenerator]: Only muons crossing " << acceptance_volume_
+            << " are simulated" << std::endl;
+}
+
+
+G4bool MuonGenerator::FindVolume(const G4LogicalVolume* mother,
+                                 const G4AffineTransform& mother_to_global,
+                                 G4AffineTransform& to_global) const
+{
+  for (size_t i=0; i<mother->GetNoDaughters(); ++i) {
+    G4VPhysicalVolume* daughter = mother->GetDaughter(i);
+    // Same construction as the navigator: frame rotation and translation
+    G4AffineTransform daughter_to_global =
+      G4AffineTransform(daughter->GetRotation(),
+                        daughter->GetTranslation()) * mother_to_global;
+
+    G4bool found = (daughter->GetName() == acceptance_volume_);
+    if (found)
+      to_global = daughter_to_global;
+    else
+      found = FindVolume(daughter->GetLogicalVolume(), daughter_to_global, to_global);
+
+    if (!found) continue;
+
+    // The position of a replica or parameterised volume depends on its
+    // copy number, so that of the acceptance volume would not be known
+    if (daughter->IsReplicated())
+      G4Exception("[MuonGenerator]", "FindVolume()", FatalException,
+                  ("The acceptance volume " + acceptance_volume_ + " is, or is "
+                   "inside, the replicated or parameterised volume " +
+                   daughter->GetName()).c_str());
+
+    return true;
+  }
+
+  return false;
+}
+
+
+G4bool MuonGenerator::CheckOverlap(const G4ThreeVector& vtx, const G4ThreeVector& dir)
+{
+  // Muon ray in the frame of the acceptance volume
+  G4ThreeVector point     = to_local_.TransformPoint(vtx);
+  G4ThreeVector direction = to_local_.TransformAxis(dir);
+
+  // Slab test against the bounding box, which rejects most muons
+  G4double tmin = 0.;
+  G4double tmax = kInfinity;
+
+  for (G4int i=0; i<3; ++i) {
+    if (direction[i] == 0.) {
+      if (point[i] < acceptance_min_[i] || point[i] > acceptance_max_[i])
+        return false;
+      continue;
+    }
+    G4double t1 = (acceptance_min_[i] - point[i]) / direction[i];
+    G4double t2 = (acceptance_max_[i] - point[i]) / direction[i];
+    tmin = std::max(tmin, std::min(t1, t2));
+    tmax = std::min(tmax, std::max(t1, t2));
+    if (tmin > tmax) return false;
+  }
+
+  // With a margin, the enlarged box is the acceptance region
+  if (acceptance_margin_ > 0.) return true;
+
+  // Otherwise refine with the exact shape of the volume
+  return geom_solid_->Inside(point) != kOutside ||
+    geom_solid_->DistanceToIn(point, direction) != kInfinity;
+}
+
+
 G4String MuonGenerator::MuonCharge() const
 {
 
@@ -317,17 +456,17 @@ void MuonGenerator::GetDirection(G4ThreeVector& dir, G4double& zenith,
 
   while(invalid_evt){
 
-    // Generate random index weighted by the bin contents
-    // Scale by flux vec size, then round to nearest integer to get an index
-    G4int RN_indx = GetRandBinIndex(fRandomGeneral_, flux_);
+    // Generate random bin weighted by the bin contents,
+    // with its values corrected by Gaussian smearing
+    G4double values[3];
+    muon_dist_->Sample(values);
 
-    // Correct sampled values by Gaussian smearing
-    azimuth = Sample(azimuths_[RN_indx], true, azimuth_smear_[RN_indx]);
-    zenith  = Sample(zeniths_[RN_indx],  true, zenith_smear_[RN_indx]);
+    azimuth = values[0];
+    zenith  = values[1];
 
     // Sample and update the energy if angle + energy option specified
     if (dist_name_ == "zae"){
-      energy = Sample(energies_[RN_indx]*GeV, true, energy_smear_[RN_indx]*GeV);
+      energy = values[2]*GeV;
       kinetic_energy = energy - mass;
 
     }
@@ -11,6 +11,7 @@
 
 #include <G4VPrimaryGenerator.hh>
 #include <G4RotationMatrix.hh>
+#include <G4AffineTransform.hh>
 #include <Randomize.hh>
 
 
@@ -18,11 +19,13 @@ class G4GenericMessenger;
 class G4Event;
 class G4ParticleDefinition;
 class G4VSolid;
+class G4LogicalVolume;
 
 
 namespace nexus {
 
   class GeometryBase;
+  class HistogramSampler;
 
 
   class MuonGenerator: public G4VPrimaryGenerator
@@ -53,8 +56,18 @@ namespace nexus {
 
     G4ThreeVector ProjectToVertex(const G4ThreeVector& dir);
 
+    // Check whether the muon line crosses the acceptance volume
     G4bool CheckOverlap(const G4ThreeVector& vtx, const G4ThreeVector& dir);
 
+    // Find the acceptance volume and its bounding box
+    void SetupAcceptance();
+
+    // Find the transformation to the global frame of the
+    // acceptance volume among the daughters of a given one
+    G4bool FindVolume(const G4LogicalVolume* mother,
+                      const G4AffineTransform& mother_to_global,
+                      G4AffineTransform& to_global) const;
+
     /// Load in the Muon Angular/Energy Distribution from CSV file
     /// and initialise the discrete flux distribution
     void LoadMuonDistribution();
@@ -89,16 +102,19 @@ namespace nexus {
 
     const GeometryBase* geom_; ///< Pointer to the detector geometry
 
-    G4VSolid * geom_solid_;
+    G4VSolid * geom_solid_; ///< Solid of the acceptance volume
 
-    std::vector<G4double> flux_, azimuths_, zeniths_, energies_; ///< Values of flux, azimuth and zenith from file
-    std::vector<G4double> azimuth_smear_; ///< List of Azimuth bin smear values
-    std::vector<G4double> zenith_smear_;  ///< List of Zenith bin smear values
-    std::vector<G4double> energy_smear_;  ///< List of Energy bin smear values
-    G4RandGeneral *fRandomGeneral_; ///< Pointer to the RNG flux distribution
+    HistogramSampler* muon_dist_; ///< Flux in bins of azimuth, zenith (and energy) from file
+    G4RandGeneral *fRandomGeneral_; ///< Pointer to the RNG zenith distribution
 
     G4double gen_rad_; ///< Radius of disc for generation
 
+    G4String acceptance_volume_; ///< Volume that simulated muons must cross
+    G4double acceptance_margin_; ///< Margin around its bounding box
+    G4AffineTransform to_local_; ///< Global to acceptance volume frame
+    G4ThreeVector acceptance_min_, acceptance_max_; ///< Bounding box in its frame
+    G4long max_rejections_; ///< Consecutive rejections before giving up
+
   };
 
 } // end namespace nexus
@@ -37,8 +37,8 @@ namespace nexus {
      msg_ = new G4GenericMessenger(this, "/Generator/Na22Generator/",
     "Control commands of Na22 generator.");
 
-     msg_->DeclareProperty("region", region_,
-                           "Region of the geometry where the vertex will be generated.");
+     msg_->DeclareMethod("region", &Na22Generator::SetRegion,
+                         "Region of the geometry where the vertex will be generated.");
 
 
     DetectorConstruction* detconst = (DetectorConstruction*)
@@ -50,10 +50,21 @@ namespace nexus {
   {
   }
 
+  void Na22Generator::SetRegion(G4String region)
+  {
+    region_ = region;
+    // Resolved into a sampler when the next vertex is generated,
+    // once the geometry has been constructed
+    vertex_sampler_ = nullptr;
+  }
+
+
+
   void Na22Generator::GeneratePrimaryVertex(G4Event* evt)
   {
     // Ask the geometry to generate a position for the particle
-    G4ThreeVector position = geom_->GenerateVertex(region_);
+    if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+    G4ThreeVector position = vertex_sampler_();
     G4double time = 0.;
     G4PrimaryVertex* vertex =
         new G4PrimaryVertex(position, time);
@@ -11,6 +11,8 @@
 #ifndef NA22_GENERATOR_H
 #define NA22_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4Event;
@@ -18,8 +20,6 @@ class G4GenericMessenger;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class Na22Generator: public G4VPrimaryGenerator
   {
   public:
@@ -30,12 +30,17 @@ namespace nexus {
 
     void GeneratePrimaryVertex(G4Event* evt);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
 
     G4GenericMessenger* msg_;
     const GeometryBase* geom_;
 
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
 
   };
 
@@ -38,8 +38,8 @@ ScintillationGenerator::ScintillationGenerator() :
   msg_ = new G4GenericMessenger(this, "/Generator/ScintGenerator/",
     "Control commands of scintillation generator.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &ScintillationGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
   msg_->DeclareProperty("nphotons", nphotons_, "Number of photons");
 
@@ -56,11 +56,22 @@ ScintillationGenerator::~ScintillationGenerator()
   delete msg_;
 }
 
+void ScintillationGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  // Resolved into a sampler when the next vertex is generated,
+  // once the geometry has been constructed
+  vertex_sampler_ = nullptr;
+}
+
+
+
 void ScintillationGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   G4ParticleDefinition* particle_definition = G4OpticalPhoton::Definition();
   // Generate an initial position for the particle using the geometry and set time to 0.
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  G4ThreeVector position = vertex_sampler_();
   G4double time = 0.;
 
   // Energy is sampled from integral (like it is done in G4Scintillation)
@@ -11,6 +11,8 @@
 #ifndef SCINTILLATION_GENERATOR_H
 #define SCINTILLATION_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 #include <G4Navigator.hh>
 #include <G4TransportationManager.hh>
@@ -21,8 +23,6 @@ class G4Event;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class ScintillationGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -36,6 +36,10 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
 
     void ComputeCumulativeDistribution(const G4PhysicsOrderedFreeVector&,
@@ -46,6 +50,7 @@ namespace nexus {
     const GeometryBase* geom_; ///< Pointer to the detector geometry
 
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
     G4int    nphotons_;
 
   };
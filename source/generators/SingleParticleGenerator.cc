@@ -59,8 +59,8 @@ costheta_min_(-1.), costheta_max_(1.), phi_min_(0.), phi_max_(2.*pi)
   max_energy.SetParameterName("max_energy", false);
   max_energy.SetRange("max_energy>0.");
 
-  msg_->DeclareProperty("region", region_,
-                        "Region of the geometry where the vertex will be generated.");
+  msg_->DeclareMethod("region", &SingleParticleGenerator::SetRegion,
+                      "Region of the geometry where the vertex will be generated.");
 
 
   msg_->DeclarePropertyWithUnit("momentum", "mm",  momentum_, "Particle 3-momentum.");
@@ -100,6 +100,16 @@ void SingleParticleGenerator::SetParticleDefinition(G4String particle_name)
 
 
 
+void SingleParticleGenerator::SetRegion(G4String region)
+{
+  region_ = region;
+  // Resolved into a sampler when the next vertex is generated,
+  // once the geometry has been constructed
+  vertex_sampler_ = nullptr;
+}
+
+
+
 void SingleParticleGenerator::GeneratePrimaryVertex(G4Event* event)
 {
   // Generate uniform random energy in [E_min, E_max]
@@ -134,7 +144,8 @@ void SingleParticleGenerator::GeneratePrimaryVertex(G4Event* event)
   }
 
   // Generate an initial position for the particle using the geometry
-  G4ThreeVector position = geom_->GenerateVertex(region_);
+  if (!vertex_sampler_) vertex_sampler_ = geom_->GetVertexSampler(region_);
+  G4ThreeVector position = vertex_sampler_();
 
   // Particle generated at start-of-event
   G4double time = 0.;
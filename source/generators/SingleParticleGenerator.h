@@ -14,6 +14,8 @@
 #ifndef SINGLE_PARTICLE_GENERATOR_H
 #define SINGLE_PARTICLE_GENERATOR_H
 
+#include "GeometryBase.h"
+
 #include <G4VPrimaryGenerator.hh>
 
 class G4GenericMessenger;
@@ -23,8 +25,6 @@ class G4ParticleDefinition;
 
 namespace nexus {
 
-  class GeometryBase;
-
   class SingleParticleGenerator: public G4VPrimaryGenerator
   {
   public:
@@ -38,6 +38,10 @@ namespace nexus {
     /// in the event.
     void GeneratePrimaryVertex(G4Event*);
 
+  private:
+    /// Set the region of the geometry where vertices are generated
+    void SetRegion(G4String);
+
   private:
 
     void SetParticleDefinition(G4String);
@@ -54,6 +58,7 @@ namespace nexus {
     const GeometryBase* geom_; ///< Pointer to the detector geometry
 
     G4String region_;
+    GeometryBase::VertexSampler vertex_sampler_; ///< Sampler resolved from region_
 
     G4ThreeVector momentum_;
 
@@ -9,9 +9,15 @@
 // ----------------------------------------------------------------------------
 
 #include "decay0.h"
+#include "MappedFile.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
 #include <G4RandomDirection.hh>
 #include <Randomize.hh>
 #include <G4GenericMessenger.hh>
@@ -48,11 +54,12 @@ modebbOld_(0)
   ebb1_ = 0.;
   ebb2_ = 4.3; // original code, line 628
   gwk_=0;
+  tableSampling_ = true;
   fillInfo();
 }
 decay0::decay0(const std::string nuclide, int finalStateNumber,
                int decayModeNumber, std::string fname,
-               double eRangeLow, double eRangeHigh):
+               double eRangeLow, double eRangeHigh, std::string cacheDir):
   fname_(fname),
   ready_(false),
   emass_(0.51099906),
@@ -64,6 +71,8 @@ decay0::decay0(const std::string nuclide, int finalStateNumber,
   ebb1_ = eRangeLow;
   ebb2_ = eRangeHigh; // for mode 4, 2nbbdecay.
   gwk_=0;
+  tableSampling_ = true;
+  cacheDir_ = cacheDir;
   // Screwy stuff: The original author reorganized his decay mode table:
   // line 617
   if (decayModeNumber == 6) modebb_ = 14;
@@ -265,6 +274,10 @@ void decay0::initSpectrum() {
 	     break;
 	 }
    }
+   if (readSpectrumTables()) {
+     std::cout << " decay0::initSpectrum, spectrum tables read from "
+               << spectrumTablesFileName() << std::endl;
+   } else {
    std::cerr << " Filling spthe1_ ,size " << spthe1_.size() << std::endl;
    for(size_t i=0;  i != spthe1_.size(); i++) {
      e1_=static_cast<double>(1+i)/1000.;
@@ -301,6 +314,9 @@ void decay0::initSpectrum() {
 // 	  std::cerr << " e1 " << e1_ << "  spthe1_=  " << spthe1_[i] << std::endl;
      }
    }
+   buildSpectrumTables(params);
+   writeSpectrumTables();
+   }
 // Not needed, appropriatly sized
 //	do i=int(e0*1000.)+1,4300
 //	   spthe1(i)=0.
@@ -454,7 +470,8 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
   double e2=0.;
   int numThrow = 0;
 //  std::cerr << " ebb1 " << ebb1_  <<  " ebb2 " << ebb2_ << std::endl;
-  while(true) {
+  if (tableSampling_ && !cdfE1_.empty()) e1_ = sampleE1();
+  else while(true) {
      if (modebb_ != 10) e1_ = ebb2_*G4UniformRand();
      else e1_ = ebb1_ + (ebb2_ - ebb1_)*G4UniformRand();
 //     if ((e0_ - e1_) < 0.) continue; //not needed if energy range are set properly.
@@ -475,6 +492,9 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
             (modebb_ == 8) || (modebb_ == 13) || (modebb_ == 14) ||
             (modebb_ == 15) || (modebb_ == 16))  {
 // something else is emitted - energy of second e-/e+ is random
+      if (tableSampling_ && !cdfE2_.empty()) {
+        e2 = sampleE2(e1_);
+      } else {
 	double re2s = std::max(0., (ebb1_ - e1_));
 	double re2f = ebb2_ - e1_;
 	double f2max = -1;
@@ -537,6 +557,7 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
 	 }
 	 if ( f2max*G4UniformRand() < fe2) break;
         }
+      }
       } else if( modebb_ == 10) {
 // energy of X-ray is fixed; no angular correlation
            this->timedParticle(outPart, 2, e1_, e1_, 0., M_PI, 0., twopi, 0., 0.);
@@ -644,6 +665,187 @@ void decay0::decay0DoItbb(std::vector<decay0Part> &outPart) const {
       outPart.push_back(aP); // same particle id as above..
     //
 }
+//
+// Sampling of the energies from cumulative tables, built once in initSpectrum.
+// The first energy is drawn by inverting the cumulative spectrum of spthe1_, which is
+// constant within each 1 keV bin as in the rejection method. The second one is drawn from
+// the conditional spectrum tabulated at the two 1 keV nodes of e1 around the sampled value,
+// choosing one of them with a probability given by the distance to the other (linear
+// interpolation in e1). Within a row the spectrum is tabulated as a function of
+// s = sqrt((e2 - e2min)/(e2max - e2min)), so that the nodes are dense at low energy where
+// the Fermi function makes it steep, and it is inverted assuming it linear between nodes.
+//
+bool decay0::hasSecondSpectrum() const {
+  return (modebb_ == 4) || (modebb_ == 5) || (modebb_ == 6) || (modebb_ == 8) ||
+         (modebb_ == 13) || (modebb_ == 14) || (modebb_ == 15) || (modebb_ == 16);
+}
+double decay0::fe2(double e2, void *p) const {
+  switch(modebb_) {
+    case 4 :  return fe2_mod4(e2, p);
+    case 5 :  return fe2_mod5(e2, p);
+    case 6 :  return fe2_mod6(e2, p);
+    case 8 :  return fe2_mod8(e2, p);
+    case 13 : return fe2_mod13(e2, p);
+    case 14 : return fe2_mod14(e2, p);
+    case 15 : return fe2_mod15(e2, p);
+    case 16 : return fe2_mod16(e2, p);
+    default : return 0.;
+  }
+}
+void decay0::buildSpectrumTables(std::vector<double> &params) {
+  // e1 is sampled in [eLow, ebb2_] and bin k of spthe1_ spans [k+1, k+2] keV
+  const double eLow = (modebb_ == 10) ? ebb1_ : 0.;
+  cdfE1_.assign(spthe1_.size() + 1, 0.);
+  for (size_t k=0; k != spthe1_.size(); k++) {
+    const double binLow = std::max(eLow, static_cast<double>(k+1)/1000.);
+    const double binHigh = std::min(ebb2_, static_cast<double>(k+2)/1000.);
+    cdfE1_[k+1] = cdfE1_[k] + spthe1_[k] * std::max(0., binHigh - binLow);
+  }
+  if (cdfE1_.back() <= 0.) {
+    std::cerr << " decay0::buildSpectrumTables, empty spectrum for the first e-/e+ "
+              << " in the energy window " << ebb1_ << " " << ebb2_ << std::endl;
+    cdfE1_.clear();
+    return;
+  }
+  pdfE2_.clear();
+  cdfE2_.clear();
+  if (!hasSecondSpectrum()) return;
+  // Spectrum of e2 as a function of s, for each node of e1
+  const size_t nRows = spthe1_.size() + 1;
+  const double step = 1./static_cast<double>(nE2Nodes_ - 1);
+  pdfE2_.resize(nRows*nE2Nodes_);
+  cdfE2_.resize(nRows*nE2Nodes_);
+  for (size_t i=0; i != nRows; i++) {
+    const double e1 = static_cast<double>(i+1)/1000.;
+    params[3] = e1;
+    const double re2s = std::max(0., (ebb1_ - e1));
+    const double re2f = ebb2_ - e1;
+    double *pdf = &pdfE2_[i*nE2Nodes_];
+    double *cdf = &cdfE2_[i*nE2Nodes_];
+    for (size_t j=0; j != nE2Nodes_; j++) {
+      const double s = j*step;
+      pdf[j] = (re2f > re2s) ? 2.*s*fe2(re2s + (re2f - re2s)*s*s, &params[0]) : 0.;
+    }
+    cdf[0] = 0.;
+    for (size_t j=1; j != nE2Nodes_; j++) cdf[j] = cdf[j-1] + 0.5*(pdf[j-1] + pdf[j])*step;
+    if (cdf[nE2Nodes_-1] > 0.) continue;
+    // No allowed e2 for this e1: never used unless e1 is at the edge of the window
+    for (size_t j=0; j != nE2Nodes_; j++) {
+      pdf[j] = 2.*j*step;
+      cdf[j] = j*step*j*step;
+    }
+  }
+}
+std::string decay0::spectrumTablesFileName() const {
+  char name[256];
+  snprintf(name, sizeof(name), "/decay0_%s_mode%zu_fs%zu_%.3f-%.3fkeV.tbl",
+           nuclideName_.c_str(), modebb_, fsNum_, ebb1_*1000., ebb2_*1000.);
+  return cacheDir_ + name;
+}
+//
+// Cache file: signature, key of the tables (mode, final state, energy window and
+// energy release, so that a stale file is never used), spthe1_, spmax_ and the tables.
+//
+namespace {
+  const char decay0TablesMagic[8] = {'D', '0', 'T', 'A', 'B', 'L', 'E', 'S'};
+  const uint32_t decay0TablesVersion = 1;
+  void writeVector(std::ofstream &f, const std::vector<double> &v) {
+    const uint64_t n = v.size();
+    f.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    f.write(reinterpret_cast<const char*>(v.data()), n*sizeof(double));
+  }
+}
+void decay0::writeSpectrumTables() const {
+  if (cacheDir_.empty() || cdfE1_.empty()) return;
+  // Written to a temporary file and renamed, so that concurrent jobs
+  // or an interrupted one never leave a truncated table behind
+  const std::string fileName = spectrumTablesFileName();
+  const std::string tmpName = fileName + ".tmp" + std::to_string(getpid());
+  std::ofstream f(tmpName, std::ios::binary);
+  if (!f) {
+    std::cerr << " decay0::writeSpectrumTables, cannot write the cache file "
+              << fileName << std::endl;
+    return;
+  }
+  const uint64_t mode = modebb_;
+  const uint64_t fs = fsNum_;
+  f.write(decay0TablesMagic, sizeof(decay0TablesMagic));
+  f.write(reinterpret_cast<const char*>(&decay0TablesVersion), sizeof(decay0TablesVersion));
+  f.write(reinterpret_cast<const char*>(&mode), sizeof(mode));
+  f.write(reinterpret_cast<const char*>(&fs), sizeof(fs));
+  const double key[4] = {ebb1_, ebb2_, e0_, spmax_};
+  f.write(reinterpret_cast<const char*>(key), sizeof(key));
+  writeVector(f, spthe1_);
+  writeVector(f, cdfE1_);
+  writeVector(f, pdfE2_);
+  writeVector(f, cdfE2_);
+  f.close();
+  if (!f || std::rename(tmpName.c_str(), fileName.c_str()) != 0) {
+    std::remove(tmpName.c_str());
+    std::cerr << " decay0::writeSpectrumTables, cannot write the cache file "
+              << fileName << std::endl;
+  }
+}
+bool decay0::readSpectrumTables() {
+  if (cacheDir_.empty()) return false;
+  // Mapped, so that the jobs of a node read the tables from the same pages
+  nexus::MappedFile f;
+  if (!f.Open(spectrumTablesFileName())) return false;
+  char magic[8];
+  uint32_t version = 0;
+  uint64_t mode = 0;
+  uint64_t fs = 0;
+  double key[4];
+  size_t offset = 0;
+  if (!f.Read(offset, magic, sizeof(magic)) || !f.Read(offset, &version) ||
+      !f.Read(offset, &mode) || !f.Read(offset, &fs) || !f.Read(offset, key, 4)) return false;
+  if (std::memcmp(magic, decay0TablesMagic, sizeof(magic)) != 0 ||
+      version != decay0TablesVersion || mode != modebb_ || fs != fsNum_ ||
+      key[0] != ebb1_ || key[1] != ebb2_ || key[2] != e0_) return false;
+  std::vector<double> spthe1, cdfE1, pdfE2, cdfE2;
+  if (!f.ReadVector(offset, spthe1) || !f.ReadVector(offset, cdfE1) ||
+      !f.ReadVector(offset, pdfE2) || !f.ReadVector(offset, cdfE2)) return false;
+  if ((spthe1.size() != spthe1_.size()) || (cdfE1.size() != spthe1_.size() + 1) ||
+      (pdfE2.size() != (spthe1_.size() + 1)*nE2Nodes_) ||
+      (cdfE2.size() != pdfE2.size())) return false;
+  spmax_ = key[3];
+  spthe1_.swap(spthe1);
+  cdfE1_.swap(cdfE1);
+  pdfE2_.swap(pdfE2);
+  cdfE2_.swap(cdfE2);
+  return true;
+}
+double decay0::sampleE1() const {
+  const double u = cdfE1_.back()*G4UniformRand();
+  size_t k = std::upper_bound(cdfE1_.begin() + 1, cdfE1_.end(), u) - (cdfE1_.begin() + 1);
+  if (k >= spthe1_.size()) k = spthe1_.size() - 1;
+  const double eLow = (modebb_ == 10) ? ebb1_ : 0.;
+  const double binLow = std::max(eLow, static_cast<double>(k+1)/1000.);
+  const double binHigh = std::min(ebb2_, static_cast<double>(k+2)/1000.);
+  return binLow + (binHigh - binLow)*G4UniformRand();
+}
+double decay0::sampleE2(double e1) const {
+  // Row of the node of e1 below or above the sampled value
+  const size_t nRows = cdfE2_.size()/nE2Nodes_;
+  const double x = std::max(0., e1*1000. - 1.);
+  size_t row = std::min(static_cast<size_t>(x), nRows - 2);
+  if (G4UniformRand() < x - row) row++;
+  const double *pdf = &pdfE2_[row*nE2Nodes_];
+  const double *cdf = &cdfE2_[row*nE2Nodes_];
+  const double u = cdf[nE2Nodes_-1]*G4UniformRand();
+  size_t j = std::upper_bound(cdf + 1, cdf + nE2Nodes_, u) - (cdf + 1);
+  if (j > nE2Nodes_ - 2) j = nE2Nodes_ - 2;
+  // Invert the linear spectrum within the segment, in a form stable for a flat one
+  const double step = 1./static_cast<double>(nE2Nodes_ - 1);
+  const double slope = (pdf[j+1] - pdf[j])/step;
+  const double r = u - cdf[j];
+  const double den = pdf[j] + std::sqrt(std::max(0., pdf[j]*pdf[j] + 2.*slope*r));
+  const double ds = (den > 0.) ? std::min(step, 2.*r/den) : 0.;
+  const double s = j*step + ds;
+  const double re2s = std::max(0., (ebb1_ - e1));
+  const double re2f = ebb2_ - e1;
+  return re2s + (re2f - re2s)*s*s;
+}
 void decay0::Ba136low(std::vector<decay0Part> &outPart) const {   // Baryum 136 de-excitation.
 // Subroutine describes the deexcitation process in Ba136 nucleus
 // after 2b-decay of Xe136 or Ce136 to ground and excited 0+ and 2+ levels
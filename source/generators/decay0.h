@@ -56,7 +56,8 @@ class decay0 {
      decay0();
      decay0(const std::string nuclide, int finalStateNumber,
             int decayModeNumber, std::string fname, double eRangeLow=0.0,
-            double eRangeHigh=4.3); // no limits, be default. (for 2nbbdecay. )
+            double eRangeHigh=4.3, // no limits, be default. (for 2nbbdecay. )
+            std::string cacheDir=""); // directory where the spectrum tables are cached, none if empty
      ~decay0();
     void decay0DoIt(std::vector<decay0Part> &outPart) const ;
     void fillInfo(); // to be used if the Nuclide, final state or decay mode is changed...Not advised..
@@ -85,6 +86,19 @@ class decay0 {
 //                               (for modes 4,5,6,8,10 and 13).
     int mode_; //  in common/denrange/
     gsl_integration_workspace *gwk_;  // For integration..
+    //
+    // Cumulative tables used to sample the energies without rejection.
+    // cdfE1_ is the cumulative spectrum of the first e-/e+ over the 1 keV bins of spthe1_.
+    // pdfE2_ and cdfE2_ hold the spectrum of the second e-/e+ conditional to the energy
+    // of the first one, one row per 1 keV node of e1 and nE2Nodes_ nodes spanning the
+    // allowed range of e2 for that e1.
+    //
+    bool tableSampling_;
+    std::string cacheDir_;
+    static const size_t nE2Nodes_ = 201;
+    std::vector<double> cdfE1_;
+    std::vector<double> pdfE2_;
+    std::vector<double> cdfE2_;
 //    eta_nme  .. not supported yet...
     //
     // Internal variable, volatile all declared mutable. Filled and used in DoIt (subroutine bb in decay 0)
@@ -97,6 +111,14 @@ class decay0 {
 
     void initSpectrum(); // Called from fillInfo, initialize array for matrix element, kinematics and so forth.
     void decay0DoItbb(std::vector<decay0Part> &outPart) const; // Main method, generate the two electrons.
+    bool hasSecondSpectrum() const; // Modes where the energy of the second e-/e+ is random
+    double fe2(double e2, void *p) const; // Spectrum of the second e-/e+ for the current mode
+    void buildSpectrumTables(std::vector<double> &params); // Called from initSpectrum, once spthe1_ is filled
+    bool readSpectrumTables(); // From the cache, return false if not available
+    void writeSpectrumTables() const;
+    std::string spectrumTablesFileName() const;
+    double sampleE1() const; // Two table lookups, no rejection
+    double sampleE2(double e1) const;
     void Ba136low(std::vector<decay0Part> &outPart) const;  // Baryum 136 de-excitation.
 //    void Xe130low(std::vector<decay0Part> &outPart) const;  // Xenon de-excitation. // we (NEXT) don't care...
 
@@ -159,6 +181,9 @@ class decay0 {
     inline size_t GetFinalStateNumber() { return fsNum_;}
     inline size_t GetDecayModeNumber() { return modebb_;}
     inline double GetEffectiveRatioToOfEvents() {return toallevents_; }
+    // Energies sampled from the cumulative tables (default) or by rejection, as in the original code
+    inline void SetTableSampling(bool t) { tableSampling_ = t;}
+    inline bool GetTableSampling() const { return tableSampling_;}
 
 };
 #endif
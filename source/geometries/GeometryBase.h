@@ -10,8 +10,13 @@
 #define GEOMETRY_BASE_H
 
 #include <G4ThreeVector.hh>
+#include <G4String.hh>
 #include <CLHEP/Units/SystemOfUnits.h>
 
+#include <functional>
+#include <map>
+#include <vector>
+
 class G4LogicalVolume;
 
 namespace nexus {
@@ -23,6 +28,9 @@ namespace nexus {
   class GeometryBase
   {
   public:
+    /// Callable returning a point within a given region of the geometry
+    typedef std::function<G4ThreeVector()> VertexSampler;
+
     /// The volumes (solid, logical and physical) must be defined
     /// in this method, which will be invoked during the detector
     /// construction phase
@@ -34,6 +42,11 @@ namespace nexus {
     /// Returns a point within a given region of the geometry
     virtual G4ThreeVector GenerateVertex(const G4String&) const;
 
+    /// Resolves a region name into a sampler that can be called once
+    /// per event without further string comparisons. Regions not
+    /// registered by the geometry fall back to GenerateVertex.
+    VertexSampler GetVertexSampler(const G4String& region) const;
+
     /// Returns a point within a region projecting from a
     /// given point backwards along a line.
     virtual G4ThreeVector ProjectToRegion(const G4String&,
@@ -78,6 +91,18 @@ namespace nexus {
     /// Sets the 3 dimensions of the geometry (x, y, z)
     void SetDimensions(G4ThreeVector dim);
 
+    /// Associates a region name with its sampler. Meant to be called
+    /// from Construct(), once the volumes and point samplers exist.
+    void RegisterVertexSampler(const G4String& region, VertexSampler sampler);
+
+    /// Registers the given regions so that they are dispatched
+    /// directly to the samplers of a sub-geometry
+    void ForwardVertexSamplers(const GeometryBase* sub,
+                               const std::vector<G4String>& regions);
+
+    /// Returns the sampler registered for a region, or nullptr
+    const VertexSampler* FindVertexSampler(const G4String& region) const;
+
   private:
     /// Copy-constructor (hidden)
     GeometryBase(const GeometryBase&);
@@ -90,6 +115,7 @@ namespace nexus {
     G4ThreeVector dimensions_; ///< XYZ dimensions of a regular geometry
     G4double el_z_; ///< Starting point of EL generation in z
     G4ThreeVector coord_origin_; ///< Origin of coordinates of the mother volume
+    std::map<G4String, VertexSampler> samplers_; ///< Region samplers
   };
 
 
@@ -108,6 +134,32 @@ namespace nexus {
   inline G4ThreeVector GeometryBase::GenerateVertex(const G4String&) const
   { return G4ThreeVector(0., 0., 0.); }
 
+  inline GeometryBase::VertexSampler
+  GeometryBase::GetVertexSampler(const G4String& region) const
+  {
+    const VertexSampler* sampler = FindVertexSampler(region);
+    if (sampler) return *sampler;
+    return [this, region]() { return GenerateVertex(region); };
+  }
+
+  inline void GeometryBase::RegisterVertexSampler(const G4String& region,
+                                                  VertexSampler sampler)
+  { samplers_[region] = sampler; }
+
+  inline void GeometryBase::ForwardVertexSamplers(const GeometryBase* sub,
+                                                  const std::vector<G4String>& regions)
+  {
+    for (const auto& region : regions)
+      RegisterVertexSampler(region, sub->GetVertexSampler(region));
+  }
+
+  inline const GeometryBase::VertexSampler*
+  GeometryBase::FindVertexSampler(const G4String& region) const
+  {
+    auto it = samplers_.find(region);
+    return it == samplers_.end() ? nullptr : &it->second;
+  }
+
   inline G4ThreeVector GeometryBase::ProjectToRegion(const G4String&,
 						     const G4ThreeVector&,
 						     const G4ThreeVector&) const
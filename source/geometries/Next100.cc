@@ -202,89 +202,74 @@ namespace nexus {
         }
       }
     }
+
+    RegisterVertexSamplers();
   }
 
 
-  G4ThreeVector Next100::GenerateVertex(const G4String& region) const
+  void Next100::RegisterVertexSamplers()
   {
-    G4ThreeVector vertex(0.,0.,0.);
+    // Regions of the sub-geometries are resolved once into their own
+    // samplers and shifted to the global coordinate system
+    auto shifted = [this](const GeometryBase* sub,
+                          const std::vector<G4String>& regions) {
+      for (const auto& region : regions) {
+        VertexSampler sampler = sub->GetVertexSampler(region);
+        RegisterVertexSampler(region, [this, sampler]() {
+          return sampler() - coord_origin_;
+        });
+      }
+    };
 
     // Shielding regions
-    if ((region == "SHIELDING_LEAD")  ||
-        (region == "SHIELDING_STEEL") ||
-        (region == "INNER_AIR") ||
-        (region == "EXTERNAL") ||
-        (region == "SHIELDING_STRUCT") ||
-        (region == "PEDESTAL") ||
-        (region == "BUBBLE_SEAL") ||
-        (region == "EDPM_SEAL")) {
-      vertex = shielding_->GenerateVertex(region);
-    }
+    shifted(shielding_, {"SHIELDING_LEAD", "SHIELDING_STEEL", "INNER_AIR",
+                         "EXTERNAL", "SHIELDING_STRUCT", "PEDESTAL",
+                         "BUBBLE_SEAL", "EDPM_SEAL"});
 
     // Vessel regions
-    else if ((region == "VESSEL")  ||
-             (region == "PORT_1a") ||
-             (region == "PORT_2a") ||
-             (region == "PORT_1b") ||
-             (region == "PORT_2b")) {
-      vertex = vessel_->GenerateVertex(region);
-    }
+    shifted(vessel_, {"VESSEL", "VESSEL_INNER_SURF",
+                      "PORT_1a", "PORT_2a", "PORT_1b", "PORT_2b"});
 
     // Inner copper shielding
-    else if (region == "ICS"){
-      vertex = ics_->GenerateVertex(region);
-    }
+    shifted(ics_, {"ICS"});
 
     // Inner elements (photosensors' planes and field cage)
-    else if ((region == "CENTER") ||
-             (region == "ACTIVE") ||
-             (region == "CATHODE_RING") ||
-             (region == "BUFFER") ||
-             (region == "XENON") ||
-             (region == "LIGHT_TUBE") ||
-             (region == "HDPE_TUBE") ||
-             (region == "S2_PMT_LT") ||
-             (region == "S2_SIPM_PSF") ||
-             (region == "EP_COPPER_PLATE") ||
-             (region == "SAPPHIRE_WINDOW") ||
-             (region == "OPTICAL_PAD") ||
-             (region == "PMT_BODY") ||
-             (region == "PMT") ||
-             (region == "PMT_BASE") ||
-             (region == "TP_COPPER_PLATE") ||
-             (region == "SIPM_BOARD") ||
-             (region == "DB_PLUG") ||
-             (region == "FIELD_RING") ||
-             (region == "GATE_RING") ||
-             (region == "ANODE_RING") ||
-             (region == "RING_HOLDER")) {
-      vertex = inner_elements_->GenerateVertex(region);
-    }
+    shifted(inner_elements_,
+            {"CENTER", "ACTIVE", "CATHODE_RING", "BUFFER", "XENON",
+             "LIGHT_TUBE", "HDPE_TUBE", "S2_PMT_LT", "S2_SIPM_PSF",
+             "EP_COPPER_PLATE", "SAPPHIRE_WINDOW", "OPTICAL_PAD", "PMT_BODY",
+             "PMT", "PMT_BASE", "TP_COPPER_PLATE", "SIPM_BOARD", "DB_PLUG",
+             "FIELD_RING", "GATE_RING", "ANODE_RING", "RING_HOLDER"});
 
-    else if (region == "AD_HOC") {
-      // AD_HOC does not need to be shifted because it is passed by the user
-      vertex = specific_vertex_;
-      return vertex;
-    }
+    // AD_HOC does not need to be shifted because it is passed by the user
+    RegisterVertexSampler("AD_HOC", [this]() { return specific_vertex_; });
 
     // Lab walls
-    else if ((region == "HALLA_INNER") || (region == "HALLA_OUTER")){
-      if (!lab_walls_)
-        G4Exception("[Next100]", "GenerateVertex()", FatalException,
-                    "This vertex generation region must be used with lab_walls == true!");
-      vertex = hallA_walls_->GenerateVertex(region);
-      while (vertex[1]<(-shielding_->GetHeight()/2.)){
-        vertex = hallA_walls_->GenerateVertex(region);}
+    for (const G4String region : {"HALLA_INNER", "HALLA_OUTER"}) {
+      RegisterVertexSampler(region, [this, region]() {
+        if (!lab_walls_)
+          G4Exception("[Next100]", "GenerateVertex()", FatalException,
+                      "This vertex generation region must be used with lab_walls == true!");
+        G4ThreeVector vertex = hallA_walls_->GenerateVertex(region);
+        while (vertex[1]<(-shielding_->GetHeight()/2.)){
+          vertex = hallA_walls_->GenerateVertex(region);}
+        return vertex - coord_origin_;
+      });
     }
+  }
 
-    else {
+
+  G4ThreeVector Next100::GenerateVertex(const G4String& region) const
+  {
+    const VertexSampler* sampler = FindVertexSampler(region);
+
+    if (!sampler) {
       G4Exception("[Next100]", "GenerateVertex()", FatalException,
 		  "Unknown vertex generation region!");
+      return G4ThreeVector(0., 0., 0.);
     }
 
-    vertex = vertex - coord_origin_;
-
-    return vertex;
+    return (*sampler)();
   }
 
 
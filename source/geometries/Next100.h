@@ -46,6 +46,7 @@ namespace nexus {
   private:
     void BuildLab();
     void Construct();
+    void RegisterVertexSamplers();
 
 
   private:
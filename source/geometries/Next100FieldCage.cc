@@ -17,8 +17,10 @@
 #include "CylinderPointSampler.h"
 #include "BoxPointSampler.h"
 #include "HexagonMeshTools.h"
+#include "HexagonMeshModel.h"
+#include "MeshBoundaryProcess.h"
+#include "VoxelAcceptanceMap.h"
 
-#include <G4Navigator.hh>
 #include <G4SystemOfUnits.hh>
 #include <G4PhysicalConstants.hh>
 #include <G4GenericMessenger.hh>
@@ -39,9 +41,9 @@
 #include <G4UserLimits.hh>
 #include <G4SDManager.hh>
 #include <G4UnitsTable.hh>
-#include <G4TransportationManager.hh>
 
 #include <cassert>
+#include <memory>
 
 using namespace nexus;
 
@@ -112,6 +114,7 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
   grid_visibility_ (0),
   verbosity_(0),
   use_dielectric_grid_(0),
+  analytic_mesh_(0), cathode_mesh_model_(nullptr), el_mesh_model_(nullptr),
   // EL gap generation disk parameters
   el_gap_slice_min_(0.), el_gap_slice_max_(1.),
   sipm_pitch_(0),
@@ -122,10 +125,6 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
   new G4UnitDefinition("mm/sqrt(cm)","mm/sqrt(cm)","Diffusion", mm/sqrt(cm));
   new G4UnitDefinition("mm/microsecond","mm/microsecond","drift velocity", mm/microsecond);
 
-  /// Initializing the geometry navigator (used in vertex generation)
-  geom_navigator_ =
-    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
   /// Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/Next100/",
                                 "Control commands of geometry Next100.");
@@ -134,6 +133,8 @@ Next100FieldCage::Next100FieldCage(G4double grid_thickn):
   msg_->DeclareProperty("field_cage_verbosity", verbosity_, "Field Cage Verbosity");
 
   msg_->DeclareProperty("use_dielectric_grid", use_dielectric_grid_, "Switch on Fake Grids");
+  msg_->DeclareProperty("analytic_mesh", analytic_mesh_,
+                        "Replace the hexagon holes of the meshes by an analytic optical model\n(ignored with use_dielectric_grid).");
 
   G4GenericMessenger::Command& drift_transv_diff_cmd =
     msg_->DeclareProperty("drift_transv_diff", drift_transv_diff_,
@@ -262,6 +263,8 @@ void Next100FieldCage::Construct()
   BuildELRegion();
   BuildLightTube();
   BuildFieldCage();
+
+  RegisterVertexSamplers();
 }
 
 
@@ -449,11 +452,26 @@ void Next100FieldCage::BuildCathode()
       G4Tubs* grid_solid = new G4Tubs("CATHODE_GRID", 0., cathode_ext_diam_/2.0 , grid_thickn_/2., 0., twopi);
       cathode_grid_logic = new G4LogicalVolume(grid_solid, steel_, "CATHODE_MESH_LOGIC");
 
-      // Define a hexagonal prism
-      G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
-      cathode_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
-
-      PlaceHexagons(n_hex, cathode_mesh_diam_, grid_thickn_, cathode_grid_logic, cathode_hex_logic, cathode_int_diam_);
+      if (analytic_mesh_) {
+        // A single gas disk over the area with holes, through which
+        // the photons are transported by the mesh model
+        G4Tubs* mesh_gas_solid =
+          new G4Tubs("CATHODE_MESH_GAS", 0., cathode_int_diam_/2., grid_thickn_/2., 0., twopi);
+        cathode_hex_logic = new G4LogicalVolume(mesh_gas_solid, gas_, "CATHODE_MESH_GAS");
+        new G4PVPlacement(0, G4ThreeVector(), cathode_hex_logic, "CATHODE_MESH_GAS",
+                          cathode_grid_logic, false, 0, false);
+
+        cathode_mesh_model_ =
+          new HexagonMeshModel(cathode_mesh_diam_, cathode_mesh_diam_ + grid_thickn_, grid_thickn_);
+        MeshBoundaryProcess::AddMesh(cathode_hex_logic, cathode_mesh_model_, opticalprops::Steel());
+      }
+      else {
+        // Define a hexagonal prism
+        G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
+        cathode_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
+
+        PlaceHexagons(n_hex, cathode_mesh_diam_, grid_thickn_, cathode_grid_logic, cathode_hex_logic, cathode_int_diam_);
+      }
 
       new G4PVPlacement(0, G4ThreeVector(GetCoordOrigin().x(),
                                          GetCoordOrigin().y(), cathode_grid_zpos),
@@ -693,12 +711,28 @@ void Next100FieldCage::BuildELRegion()
     G4Tubs* grid_solid = new G4Tubs("EL_GRID", 0., gate_ext_diam_/2.0 , grid_thickn_/2., 0., twopi);
     el_grid_logic = new G4LogicalVolume(grid_solid, steel_, "EL_GRID");
 
-    // Define a hexagonal prism
-    G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
-    el_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
+    if (analytic_mesh_) {
+      // A single gas disk over the area with holes, through which
+      // the photons are transported by the mesh model. The rotation
+      // of the anode mesh comes with the frame of its placement.
+      G4Tubs* mesh_gas_solid =
+        new G4Tubs("EL_MESH_GAS", 0., gate_int_diam_/2., grid_thickn_/2., 0., twopi);
+      el_hex_logic = new G4LogicalVolume(mesh_gas_solid, gas_, "EL_MESH_GAS");
+      new G4PVPlacement(0, G4ThreeVector(), el_hex_logic, "EL_MESH_GAS",
+                        el_grid_logic, false, 0, false);
+
+      el_mesh_model_ =
+        new HexagonMeshModel(el_mesh_diam_, el_mesh_diam_ + grid_thickn_, grid_thickn_);
+      MeshBoundaryProcess::AddMesh(el_hex_logic, el_mesh_model_, opticalprops::Steel());
+    }
+    else {
+      // Define a hexagonal prism
+      G4ExtrudedSolid* hex_prism = CreateHexagon(grid_thickn_/2.0, hex_circumradius);
+      el_hex_logic  = new G4LogicalVolume(hex_prism, gas_, "MESH_HEX_GAS");
 
-    // Place GXe hexagons in the disk to make the mesh
-    PlaceHexagons(n_hex, el_mesh_diam_, grid_thickn_, el_grid_logic, el_hex_logic, gate_int_diam_);
+      // Place GXe hexagons in the disk to make the mesh
+      PlaceHexagons(n_hex, el_mesh_diam_, grid_thickn_, el_grid_logic, el_hex_logic, gate_int_diam_);
+    }
 
     // Add optical surface
     G4OpticalSurface* gas_mesh_opsur = new G4OpticalSurface("GAS_EL_MESH_OPSURF");
@@ -1070,6 +1104,10 @@ void Next100FieldCage::BuildFieldCage()
 
 Next100FieldCage::~Next100FieldCage()
 {
+  MeshBoundaryProcess::RemoveMeshes(cathode_mesh_model_);
+  MeshBoundaryProcess::RemoveMeshes(el_mesh_model_);
+  delete cathode_mesh_model_;
+  delete el_mesh_model_;
   delete active_gen_;
   delete buffer_gen_;
   delete xenon_gen_;
@@ -1085,116 +1123,82 @@ Next100FieldCage::~Next100FieldCage()
 }
 
 
-G4ThreeVector Next100FieldCage::GenerateVertex(const G4String& region) const
+void Next100FieldCage::RegisterVertexSamplers()
 {
-  G4ThreeVector vertex(0., 0., 0.);
-
-  if (region == "CENTER") {
-    vertex = G4ThreeVector(GetCoordOrigin().x(), GetCoordOrigin().y(),
-                           active_zpos_);
-  }
-
-  else if (region == "ACTIVE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = active_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
-  }
-
-  else if (region == "CATHODE_RING") {
-    vertex = cathode_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "BUFFER") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = buffer_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
-  }
-
-  else if (region == "XENON") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = xenon_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (
-    VertexVolume->GetName() != "ACTIVE" &&
-    VertexVolume->GetName() != "BUFFER" &&
-    VertexVolume->GetName() != "EL_GAP");
-  }
-
-  else if (region == "LIGHT_TUBE") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = teflon_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (
-    VertexVolume->GetName() != "LIGHT_TUBE_DRIFT" &&
-    VertexVolume->GetName() != "LIGHT_TUBE_BUFFER" );
-  }
-
-  else if (region == "HDPE_TUBE") {
-    vertex = hdpe_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "S2_PMT_LT") {
-    vertex = el_gap_pmt_gen_->GenerateVertex(VOLUME);
-  }
-
-  else if (region == "S2_SIPM_PSF") {
-    vertex = el_gap_sipm_gen_->GenerateVertex(INSIDE);
-  }
-
-  else if (region == "FIELD_RING") {
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = ring_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != region);
-  }
-
-  else if (region == "GATE_RING") {
-    vertex = gate_gen_->GenerateVertex(VOLUME);
-  }
+  // Samples a point with the given generator until it falls
+  // within one of the listed physical volumes. The acceptance map
+  // avoids calling the navigator away from the volume boundaries.
+  auto rejection = [this](CylinderPointSampler* gen,
+                          const std::vector<G4String>& volumes) {
+    G4ThreeVector min, max;
+    gen->GetBoundingBox(min, max);
+    auto acceptance = std::make_shared<VoxelAcceptanceMap>
+      (min, max, volumes, GetCoordOrigin());
+    return [gen, acceptance]() {
+      G4ThreeVector vertex;
+      do {
+        vertex = gen->GenerateVertex(VOLUME);
+      } while (!acceptance->Contains(vertex));
+      return vertex;
+    };
+  };
+
+  RegisterVertexSampler("CENTER", [this]() {
+    return G4ThreeVector(GetCoordOrigin().x(), GetCoordOrigin().y(),
+                         active_zpos_);
+  });
+
+  RegisterVertexSampler("ACTIVE", rejection(active_gen_, {"ACTIVE"}));
+
+  RegisterVertexSampler("CATHODE_RING", [this]() {
+    return cathode_gen_->GenerateVertex(VOLUME);
+  });
+
+  RegisterVertexSampler("BUFFER", rejection(buffer_gen_, {"BUFFER"}));
+
+  RegisterVertexSampler("XENON",
+    rejection(xenon_gen_, {"ACTIVE", "BUFFER", "EL_GAP"}));
+
+  RegisterVertexSampler("LIGHT_TUBE",
+    rejection(teflon_gen_, {"LIGHT_TUBE_DRIFT", "LIGHT_TUBE_BUFFER"}));
+
+  RegisterVertexSampler("HDPE_TUBE", [this]() {
+    return hdpe_gen_->GenerateVertex(VOLUME);
+  });
+
+  RegisterVertexSampler("S2_PMT_LT", [this]() {
+    return el_gap_pmt_gen_->GenerateVertex(VOLUME);
+  });
+
+  RegisterVertexSampler("S2_SIPM_PSF", [this]() {
+    return el_gap_sipm_gen_->GenerateVertex(INSIDE);
+  });
+
+  RegisterVertexSampler("FIELD_RING", rejection(ring_gen_, {"FIELD_RING"}));
+
+  RegisterVertexSampler("GATE_RING", [this]() {
+    return gate_gen_->GenerateVertex(VOLUME);
+  });
+
+  RegisterVertexSampler("ANODE_RING", [this]() {
+    return anode_gen_->GenerateVertex(VOLUME);
+  });
+
+  RegisterVertexSampler("RING_HOLDER", rejection(holder_gen_, {"STAVE"}));
+}
 
-  else if (region == "ANODE_RING") {
-    vertex = anode_gen_->GenerateVertex(VOLUME);
-  }
 
-  else if (region == "RING_HOLDER"){
-    G4VPhysicalVolume *VertexVolume;
-    do {
-      vertex = holder_gen_->GenerateVertex(VOLUME);
-      G4ThreeVector glob_vtx(vertex);
-      glob_vtx = glob_vtx - GetCoordOrigin();
-      VertexVolume =
-        geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-    } while (VertexVolume->GetName() != "STAVE");
- }
+G4ThreeVector Next100FieldCage::GenerateVertex(const G4String& region) const
+{
+  const VertexSampler* sampler = FindVertexSampler(region);
 
-  else {
+  if (!sampler) {
     G4Exception("[Next100FieldCage]", "GenerateVertex()", FatalException,
     "Unknown vertex generation region!");
+    return G4ThreeVector(0., 0., 0.);
   }
 
-  return vertex;
+  return (*sampler)();
 }
 
 
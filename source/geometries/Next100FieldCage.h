@@ -16,12 +16,12 @@ class G4Material;
 class G4LogicalVolume;
 class G4VPhysicalVolume;
 class G4GenericMessenger;
-class G4Navigator;
 
 namespace nexus {
 
   class CylinderPointSampler;
   class BoxPointSampler;
+  class HexagonMeshModel;
 
 
   class Next100FieldCage: public GeometryBase
@@ -47,6 +47,7 @@ namespace nexus {
     void BuildELRegion();
     void BuildLightTube();
     void BuildFieldCage();
+    void RegisterVertexSamplers();
 
     // Dimensions
     G4double gate_sapphire_wdw_dist_;
@@ -90,6 +91,10 @@ namespace nexus {
 
     // Use fake mesh
     G4bool use_dielectric_grid_;
+    // Use a gas disk with an analytic model of the hexagonal holes
+    G4bool analytic_mesh_;
+    HexagonMeshModel* cathode_mesh_model_;
+    HexagonMeshModel* el_mesh_model_;
 
     // Fraction of EL gap in which to generate points. e.g (0, 0.5)
     // would generate points in the first half of the EL gap
@@ -119,9 +124,6 @@ namespace nexus {
     // SiPM pitch for ELgap vertex generation
     G4double sipm_pitch_;
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
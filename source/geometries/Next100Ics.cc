@@ -9,7 +9,7 @@
 #include "Next100Ics.h"
 #include "MaterialsList.h"
 #include "Visibilities.h"
-#include "CylinderPointSampler.h"
+#include "SolidPointSampler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4SubtractionSolid.hh>
@@ -21,7 +21,6 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
 
 
 namespace nexus {
@@ -35,10 +34,6 @@ namespace nexus {
     ics_ep_lip_width_ (ics_ep_lip_width),
     visibility_ (0)
   {
-
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/Next100/", "Control commands of geometry Next100.");
     msg_->DeclareProperty("ics_vis", visibility_, "ICS Visibility");
@@ -193,9 +188,7 @@ namespace nexus {
 
     // VERTEX GENERATOR
     ics_gen_ =
-      new CylinderPointSampler(in_rad_, in_rad_ + thickness_, length/2.,
-                               0.*deg, 360.*deg,
-                               0, G4ThreeVector(0., 0., ics_z_pos));
+      new SolidPointSampler(ics_logic, nullptr, G4ThreeVector(0., 0., ics_z_pos));
   }
 
 
@@ -210,14 +203,7 @@ namespace nexus {
     G4ThreeVector vertex(0., 0., 0.);
 
     if (region=="ICS"){
-      G4VPhysicalVolume* VertexVolume;
-      do {
-        vertex = ics_gen_->GenerateVertex(VOLUME);
-
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != "ICS");
+      vertex = ics_gen_->GenerateVertex(VOLUME);
     }
 
     return vertex;
@@ -11,14 +11,12 @@
 
 #include "GeometryBase.h"
 
-#include <G4Navigator.hh>
-
 class G4GenericMessenger;
 
 
 namespace nexus {
 
-  class CylinderPointSampler;
+  class SolidPointSampler;
 
   class Next100Ics: public GeometryBase
   {
@@ -56,10 +54,7 @@ namespace nexus {
     G4bool visibility_;
 
     // Vertex generator
-    CylinderPointSampler* ics_gen_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
+    SolidPointSampler* ics_gen_;
 
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
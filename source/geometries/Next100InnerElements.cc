@@ -84,6 +84,18 @@ namespace nexus {
     tracking_plane_->Construct();
 
     tracking_plane_->GetSiPMPosInGas(sipm_pos_);
+
+    // Vertex generation regions
+    ForwardVertexSamplers(field_cage_,
+                          {"CENTER", "ACTIVE", "CATHODE_RING", "BUFFER",
+                           "XENON", "S2_PMT_LT", "S2_SIPM_PSF", "LIGHT_TUBE",
+                           "HDPE_TUBE", "FIELD_RING", "GATE_RING",
+                           "ANODE_RING", "RING_HOLDER"});
+    ForwardVertexSamplers(energy_plane_,
+                          {"EP_COPPER_PLATE", "SAPPHIRE_WINDOW", "OPTICAL_PAD",
+                           "PMT", "PMT_BODY", "PMT_BASE"});
+    ForwardVertexSamplers(tracking_plane_,
+                          {"TP_COPPER_PLATE", "SIPM_BOARD", "DB_PLUG"});
   }
 
 
@@ -97,45 +109,15 @@ namespace nexus {
 
   G4ThreeVector Next100InnerElements::GenerateVertex(const G4String& region) const
   {
-    G4ThreeVector vertex(0.,0.,0.);
-
-    // Field Cage regions
-    if ((region == "CENTER") ||
-        (region == "ACTIVE") ||
-        (region == "CATHODE_RING") ||
-        (region == "BUFFER") ||
-        (region == "XENON")  ||
-        (region == "S2_PMT_LT") ||
-        (region == "S2_SIPM_PSF") ||
-        (region == "LIGHT_TUBE") ||
-        (region == "HDPE_TUBE") ||
-        (region == "FIELD_RING") ||
-        (region == "GATE_RING") ||
-        (region == "ANODE_RING") ||
-        (region == "RING_HOLDER")) {
-      vertex = field_cage_->GenerateVertex(region);
-    }
-    // Energy Plane regions
-    else if ((region == "EP_COPPER_PLATE") ||
-             (region == "SAPPHIRE_WINDOW") ||
-             (region == "OPTICAL_PAD") ||
-             (region == "PMT") ||
-             (region == "PMT_BODY") ||
-             (region == "PMT_BASE")) {
-      vertex = energy_plane_->GenerateVertex(region);
-    }
-    // Tracking Plane regions
-    else if ((region == "TP_COPPER_PLATE") ||
-             (region == "SIPM_BOARD") ||
-             (region == "DB_PLUG")) {
-      vertex = tracking_plane_->GenerateVertex(region);
-    }
-    else {
+    const VertexSampler* sampler = FindVertexSampler(region);
+
+    if (!sampler) {
       G4Exception("[Next100InnerElements]", "GenerateVertex()", FatalException,
         "Unknown vertex generation region!");
+      return G4ThreeVector(0., 0., 0.);
     }
 
-    return vertex;
+    return (*sampler)();
   }
 
 } // end namespace nexus
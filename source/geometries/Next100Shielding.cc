@@ -9,7 +9,9 @@
 #include "Next100Shielding.h"
 #include "MaterialsList.h"
 #include "Visibilities.h"
+#include "GeometryCache.h"
 #include "BoxPointSampler.h"
+#include "VoxelAcceptanceMap.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4SubtractionSolid.hh>
@@ -22,12 +24,13 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
 #include <G4RotationMatrix.hh>
 #include <G4UserLimits.hh>
 
 #include <CLHEP/Units/SystemOfUnits.h>
 
+#include <memory>
+
 namespace nexus {
 
   using namespace CLHEP;
@@ -83,9 +86,6 @@ namespace nexus {
     msg_->DeclareProperty("shielding_vis", visibility_, "Shielding Visibility");
     msg_->DeclareProperty("shielding_verbosity", verbosity_, "Verbosity");
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
   }
 
 
@@ -453,10 +453,12 @@ namespace nexus {
                           G4ThreeVector(-front_x_separation_/2.,
                                         -lead_thickn_/2., front_beam_z), 0);
 
-    // Compute relative volumes
-    G4double roof_vol       = roof_beam_solid->GetCubicVolume();
-    G4double struct_top_vol = struct_solid   ->GetCubicVolume();
-    G4double lateral_vol    = lat_beam_solid ->GetCubicVolume();
+    // Compute relative volumes. Those of boolean solids are
+    // estimated by Monte Carlo, so they are kept in the cache
+    GeometryCache& cache = GeometryCache::Instance();
+    G4double roof_vol       = cache.GetCubicVolume(roof_beam_solid);
+    G4double struct_top_vol = cache.GetCubicVolume(struct_solid);
+    G4double lateral_vol    = cache.GetCubicVolume(lat_beam_solid);
     G4double total_vol      = roof_vol + struct_top_vol + (8*lateral_vol);
 
     perc_roof_vol_       = roof_vol/total_vol;
@@ -513,11 +515,11 @@ namespace nexus {
                           pedestal_roof_thickn_/2., 0.,
                           G4ThreeVector(0., ped_roof_gen_y, ped_roof_gen_z), 0);
     // Compute relative volumes
-    G4double ped_support_bottom_vol = pedestal_support_beam_bottom->GetCubicVolume();
-    G4double ped_support_top_vol = pedestal_support_beam_top->GetCubicVolume();
-    G4double ped_front_vol       = pedestal_beam_front->GetCubicVolume();
-    G4double ped_lateral_vol     = pedestal_beam_lateral->GetCubicVolume();
-    G4double ped_roof_vol        = pedestal_roof->GetCubicVolume();
+    G4double ped_support_bottom_vol = cache.GetCubicVolume(pedestal_support_beam_bottom);
+    G4double ped_support_top_vol    = cache.GetCubicVolume(pedestal_support_beam_top);
+    G4double ped_front_vol          = cache.GetCubicVolume(pedestal_beam_front);
+    G4double ped_lateral_vol        = cache.GetCubicVolume(pedestal_beam_lateral);
+    G4double ped_roof_vol           = cache.GetCubicVolume(pedestal_roof);
 
     G4double ped_total_vol = ped_roof_vol + 2*(ped_support_bottom_vol +
                                                ped_support_top_vol +
@@ -597,6 +599,8 @@ namespace nexus {
       std::cout << "LATERAL "<< perc_ped_lateral_vol_* 100 << std::endl;
       std::cout << "ROOF "   << perc_ped_roof_vol_   * 100 << std::endl;
     }
+
+    RegisterVertexSamplers();
   }
 
 
@@ -640,241 +644,277 @@ namespace nexus {
     return G4ThreeVector(0., -(steel_thickn_ + beam_thickn_2_)/2., 0.);
   }
 
-  G4ThreeVector Next100Shielding::GenerateVertex(const G4String& region) const
+  void Next100Shielding::RegisterVertexSamplers()
   {
-    G4ThreeVector vertex(0., 0., 0.);
-
-    if (region == "SHIELDING_LEAD") {
-        G4VPhysicalVolume *VertexVolume;
+    // Samples a point with the given generator until it falls
+    // within the named physical volume. The acceptance map avoids
+    // calling the navigator away from the volume boundaries.
+    auto rejection = [this](BoxPointSampler* gen, vtx_region gen_region,
+                            const G4String& volume) {
+      G4ThreeVector min, max;
+      gen->GetBoundingBox(min, max);
+      auto acceptance = std::make_shared<VoxelAcceptanceMap>
+        (min, max, std::vector<G4String>{volume}, GetCoordOrigin());
+      return [gen, gen_region, acceptance]() {
+        G4ThreeVector vertex;
         do {
-          vertex = lead_gen_->GenerateVertex(VOLUME);
-          G4ThreeVector glob_vtx(vertex);
-          glob_vtx = glob_vtx - GetCoordOrigin();
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-        } while (VertexVolume->GetName() != "LEAD_BOX");
-    }
+          vertex = gen->GenerateVertex(gen_region);
+        } while (!acceptance->Contains(vertex));
+        return vertex;
+      };
+    };
+
+    RegisterVertexSampler("SHIELDING_LEAD",
+                          rejection(lead_gen_, VOLUME, "LEAD_BOX"));
+    RegisterVertexSampler("SHIELDING_STEEL",
+                          rejection(steel_gen_, VOLUME, "STEEL_BOX"));
+    RegisterVertexSampler("INNER_AIR",
+                          rejection(inner_air_gen_, INSIDE, "INNER_AIR"));
+
+    RegisterVertexSampler("EXTERNAL", [this]() {
+      return external_gen_->GenerateVertex(VOLUME);
+    });
+
+    RegisterVertexSampler("SHIELDING_STRUCT",
+                          [this]() { return GenerateStructVertex(); });
+    RegisterVertexSampler("PEDESTAL",
+                          [this]() { return GeneratePedestalVertex(); });
+    // Note: BUBBLE_SEAL and EDPM_SEAL are not implemented as logical volumes,
+    // only their generators. They are placed in INNER_AIR volume.
+    RegisterVertexSampler("BUBBLE_SEAL",
+                          [this]() { return GenerateBubbleSealVertex(); });
+    RegisterVertexSampler("EDPM_SEAL",
+                          [this]() { return GenerateEdpmSealVertex(); });
+  }
 
-    else if (region == "SHIELDING_STEEL") {
-      G4VPhysicalVolume *VertexVolume;
-      do {
-        vertex = steel_gen_->GenerateVertex(VOLUME);
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != "STEEL_BOX");
-    }
 
-    else if (region == "INNER_AIR") {
-      G4VPhysicalVolume *VertexVolume;
-      do {
-        vertex = inner_air_gen_->GenerateVertex(INSIDE);
-        G4ThreeVector glob_vtx(vertex);
-        glob_vtx = glob_vtx - GetCoordOrigin();
-        VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-      } while (VertexVolume->GetName() != "INNER_AIR");
-    }
+  G4ThreeVector Next100Shielding::GenerateVertex(const G4String& region) const
+  {
+    const VertexSampler* sampler = FindVertexSampler(region);
 
-    else if (region == "EXTERNAL") {
-      vertex = external_gen_->GenerateVertex(VOLUME);
+    if (!sampler) {
+      G4Exception("[Next100Shielding]", "GenerateVertex()", FatalException,
+		  "Unknown vertex generation region!");
+      return G4ThreeVector(0., 0., 0.);
     }
 
-    else if(region=="SHIELDING_STRUCT"){
-        G4double rand = G4UniformRand();
-
-        if (rand < perc_roof_vol_) { //ROOF BEAM STRUCTURE
-          if (G4UniformRand() <  perc_front_roof_vol_){
-            vertex = front_roof_gen_->GenerateVertex(INSIDE);
-            if (G4UniformRand() < 0.5) {
-              vertex.setZ(vertex.z() +
-                          (shield_z_/2.+steel_thickn_+lead_thickn_/2.));
-            }
-            else {
-              vertex.setZ(vertex.z() -
-                          (shield_z_/2.+steel_thickn_+lead_thickn_/2.));
-            }
-          }
-          else {
-            vertex = lat_roof_gen_->GenerateVertex(INSIDE);
-            if (G4UniformRand() < 0.5) {
-              vertex.setX(vertex.x() +
-                          (shield_x_/2.+ steel_thickn_ +
-                           lead_thickn_/2.));
-            }
-            else {
-              vertex.setX(vertex.x() -
-                          (shield_x_/2.+ steel_thickn_ +
-                           lead_thickn_/2.));
-            }
-          }
-        }
+    return (*sampler)();
+  }
 
-        else if (rand < (perc_top_struct_vol_ + perc_roof_vol_)) {
-          //TOP BEAM STRUCTURE
-          G4double random = G4UniformRand();
-          if (random <  perc_struc_x_vol_){
-            G4double rand_beam = int (4* G4UniformRand());
-            vertex = struct_x_gen_->GenerateVertex(INSIDE);
-            if (rand_beam == 1) {
-              vertex.setZ(vertex.z()-roof_z_separation_);
-            }
-            else if (rand_beam == 2) {
-              vertex.setZ(vertex.z()-(roof_z_separation_ +
-                                      lateral_z_separation_));
-            }
-            else if (rand_beam == 3) {
-              vertex.setZ(vertex.z()-(2*roof_z_separation_ +
-                                      lateral_z_separation_));
-            }
-          }
-          else {
-            vertex = struct_z_gen_->GenerateVertex(INSIDE);
-            if (G4UniformRand() < 0.5) {
-              vertex.setX(vertex.x()+front_x_separation_);
-            }
-          }
-        }
 
-        else { //LATERAL BEAM STRUCTURE
-          G4double lat_prob = beam_thickn_1_/(beam_thickn_1_+beam_thickn_2_);
-          if (G4UniformRand()<lat_prob){ //lateral
-            G4double rand_beam = int (4 * G4UniformRand());
-            vertex = lat_beam_gen_->GenerateVertex(INSIDE);
-            if (rand_beam == 1){
-              vertex.setZ(vertex.z() - lateral_z_separation_);
-            }
-            else if (rand_beam == 2){
-              vertex.setX(vertex.x() - (shield_x_ + 2*steel_thickn_ +
-                                        lead_thickn_));
-            }
-            else if (rand_beam == 3){
-              vertex.setX(vertex.x() - (shield_x_ + 2*steel_thickn_ +
-                                        lead_thickn_));
-              vertex.setZ(vertex.z() - lateral_z_separation_);
-            }
-          }
-          else { // front
-            G4double rand_beam = int (4 * G4UniformRand());
-            vertex = front_beam_gen_->GenerateVertex(INSIDE);
-            if (rand_beam ==1){
-              vertex.setX(vertex.x() + front_x_separation_);
-            }
-            else if (rand_beam ==2){
-              vertex.setZ(vertex.z() - (shield_z_+2*steel_thickn_ +
-                                        lead_thickn_));
-            }
-            else if (rand_beam ==3){
-              vertex.setX(vertex.x() + front_x_separation_);
-              vertex.setZ(vertex.z() - (shield_z_+2*steel_thickn_ +
-                                        lead_thickn_));
-            }
-          }
-        }
-        
-    }
-    
-    else if(region=="PEDESTAL"){
-      G4double rand = G4UniformRand();
-      
-      if (rand < perc_ped_bottom_vol_) { //SUPPORT-BOTTOM
-        vertex = ped_support_bottom_gen_->GenerateVertex(INSIDE);
+  G4ThreeVector Next100Shielding::GenerateStructVertex() const
+  {
+    // Beams of the shielding structure, sampled according to their volume
+    G4ThreeVector vertex(0., 0., 0.);
+
+    G4double rand = G4UniformRand();
+
+    if (rand < perc_roof_vol_) { //ROOF BEAM STRUCTURE
+      if (G4UniformRand() <  perc_front_roof_vol_){
+        vertex = front_roof_gen_->GenerateVertex(INSIDE);
         if (G4UniformRand() < 0.5) {
-          vertex.setZ(vertex.z() - support_beam_dist_);
+          vertex.setZ(vertex.z() +
+                      (shield_z_/2.+steel_thickn_+lead_thickn_/2.));
         }
-      }
-      else if (rand < (perc_ped_bottom_vol_ + perc_ped_top_vol_)) {
-        //SUPPORT-TOP
-        vertex = ped_support_top_gen_->GenerateVertex(INSIDE);
-        if (G4UniformRand() < 0.5) {
-          vertex.setZ(vertex.z() - support_beam_dist_);
+        else {
+          vertex.setZ(vertex.z() -
+                      (shield_z_/2.+steel_thickn_+lead_thickn_/2.));
         }
       }
-      else if (rand < (perc_ped_bottom_vol_ + perc_ped_top_vol_ +
-                       perc_ped_front_vol_)){ //FRONT BEAM
-        vertex = ped_front_gen_->GenerateVertex(INSIDE);
+      else {
+        vertex = lat_roof_gen_->GenerateVertex(INSIDE);
         if (G4UniformRand() < 0.5) {
-          vertex.setZ(vertex.z() - (2.*support_front_dist_ +
-                                    support_beam_dist_));
+          vertex.setX(vertex.x() +
+                      (shield_x_/2.+ steel_thickn_ +
+                       lead_thickn_/2.));
+        }
+        else {
+          vertex.setX(vertex.x() -
+                      (shield_x_/2.+ steel_thickn_ +
+                       lead_thickn_/2.));
         }
       }
-      else if (rand < (perc_ped_bottom_vol_ + perc_ped_top_vol_ +
-                       perc_ped_front_vol_ + perc_ped_lateral_vol_)){
-        // LATERAL BEAM
-        vertex = ped_lateral_gen_->GenerateVertex(INSIDE);
-        if (G4UniformRand() < 0.5) {
-          vertex.setX(vertex.x() - (pedestal_x_ +
-                                    pedestal_lateral_beam_thickn_));
+    }
+
+    else if (rand < (perc_top_struct_vol_ + perc_roof_vol_)) {
+      //TOP BEAM STRUCTURE
+      G4double random = G4UniformRand();
+      if (random <  perc_struc_x_vol_){
+        G4double rand_beam = int (4* G4UniformRand());
+        vertex = struct_x_gen_->GenerateVertex(INSIDE);
+        if (rand_beam == 1) {
+          vertex.setZ(vertex.z()-roof_z_separation_);
+        }
+        else if (rand_beam == 2) {
+          vertex.setZ(vertex.z()-(roof_z_separation_ +
+                                  lateral_z_separation_));
+        }
+        else if (rand_beam == 3) {
+          vertex.setZ(vertex.z()-(2*roof_z_separation_ +
+                                  lateral_z_separation_));
         }
       }
-      else { // ROOF
+      else {
+        vertex = struct_z_gen_->GenerateVertex(INSIDE);
         if (G4UniformRand() < 0.5) {
-          vertex = ped_roof_lat_gen_->GenerateVertex(INSIDE);
-          if (G4UniformRand() < 0.5){
-            vertex.setX(vertex.x() - pedestal_top_x_ -
-                        pedestal_roof_thickn_);
-          }
-        }
-        else{
-          vertex = ped_roof_front_gen_->GenerateVertex(INSIDE);
-          if (G4UniformRand() < 0.5){
-            vertex.setZ(vertex.z() - pedestal_lateral_length_ +
-                        pedestal_roof_thickn_);
-          }
+          vertex.setX(vertex.x()+front_x_separation_);
         }
       }
     }
 
-    // Note: BUBBLE_SEAL and EDPM_SEAL are not implemented as logical volumes, 
-    // only their generators. They are placed in INNER_AIR volume.
-    else if (region=="BUBBLE_SEAL"){
-      G4double rand = G4UniformRand();
-      if (rand<perc_bubble_front_vol_){ // front
-        vertex = bubble_seal_front_gen_->GenerateVertex(INSIDE);
-        if (G4UniformRand() < 0.5){
-          vertex.setZ(vertex.z() + (support_beam_dist_/2. + support_front_dist_ +
-                                    pedestal_front_beam_thickn_/2. +
-                                    bubble_seal_thickn_/2.));
+    else { //LATERAL BEAM STRUCTURE
+      G4double lat_prob = beam_thickn_1_/(beam_thickn_1_+beam_thickn_2_);
+      if (G4UniformRand()<lat_prob){ //lateral
+        G4double rand_beam = int (4 * G4UniformRand());
+        vertex = lat_beam_gen_->GenerateVertex(INSIDE);
+        if (rand_beam == 1){
+          vertex.setZ(vertex.z() - lateral_z_separation_);
         }
-        else {
-          vertex.setZ(vertex.z() - (support_beam_dist_/2. + support_front_dist_ +
-                                    pedestal_front_beam_thickn_/2. +
-                                    bubble_seal_thickn_/2.));
+        else if (rand_beam == 2){
+          vertex.setX(vertex.x() - (shield_x_ + 2*steel_thickn_ +
+                                    lead_thickn_));
+        }
+        else if (rand_beam == 3){
+          vertex.setX(vertex.x() - (shield_x_ + 2*steel_thickn_ +
+                                    lead_thickn_));
+          vertex.setZ(vertex.z() - lateral_z_separation_);
         }
       }
-      else { // lateral
-        vertex = bubble_seal_lateral_gen_->GenerateVertex(INSIDE);
-        if (G4UniformRand() < 0.5){
-          vertex.setX(vertex.x() + (pedestal_x_/2. +
-                                    pedestal_lateral_beam_thickn_ +
-                                    bubble_seal_thickn_/2.));
+      else { // front
+        G4double rand_beam = int (4 * G4UniformRand());
+        vertex = front_beam_gen_->GenerateVertex(INSIDE);
+        if (rand_beam ==1){
+          vertex.setX(vertex.x() + front_x_separation_);
+        }
+        else if (rand_beam ==2){
+          vertex.setZ(vertex.z() - (shield_z_+2*steel_thickn_ +
+                                    lead_thickn_));
         }
-        else{
-          vertex.setX(vertex.x() - (pedestal_x_/2. +
-                                    pedestal_lateral_beam_thickn_ +
-                                    bubble_seal_thickn_/2.));
+        else if (rand_beam ==3){
+          vertex.setX(vertex.x() + front_x_separation_);
+          vertex.setZ(vertex.z() - (shield_z_+2*steel_thickn_ +
+                                    lead_thickn_));
         }
       }
     }
-    
-    else if(region=="EDPM_SEAL"){
-      G4double rand = G4UniformRand();
-      if (rand<perc_edpm_front_vol_){ // front
-        vertex = edpm_seal_front_gen_->GenerateVertex(INSIDE);
+
+    return vertex;
+  }
+
+
+  G4ThreeVector Next100Shielding::GeneratePedestalVertex() const
+  {
+    // Pedestal beams, sampled according to their volume
+    G4ThreeVector vertex(0., 0., 0.);
+
+    G4double rand = G4UniformRand();
+
+    if (rand < perc_ped_bottom_vol_) { //SUPPORT-BOTTOM
+      vertex = ped_support_bottom_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5) {
+        vertex.setZ(vertex.z() - support_beam_dist_);
+      }
+    }
+    else if (rand < (perc_ped_bottom_vol_ + perc_ped_top_vol_)) {
+      //SUPPORT-TOP
+      vertex = ped_support_top_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5) {
+        vertex.setZ(vertex.z() - support_beam_dist_);
+      }
+    }
+    else if (rand < (perc_ped_bottom_vol_ + perc_ped_top_vol_ +
+                     perc_ped_front_vol_)){ //FRONT BEAM
+      vertex = ped_front_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5) {
+        vertex.setZ(vertex.z() - (2.*support_front_dist_ +
+                                  support_beam_dist_));
+      }
+    }
+    else if (rand < (perc_ped_bottom_vol_ + perc_ped_top_vol_ +
+                     perc_ped_front_vol_ + perc_ped_lateral_vol_)){
+      // LATERAL BEAM
+      vertex = ped_lateral_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5) {
+        vertex.setX(vertex.x() - (pedestal_x_ +
+                                  pedestal_lateral_beam_thickn_));
+      }
+    }
+    else { // ROOF
+      if (G4UniformRand() < 0.5) {
+        vertex = ped_roof_lat_gen_->GenerateVertex(INSIDE);
         if (G4UniformRand() < 0.5){
-          vertex.setZ(vertex.z() + (shield_z_/2. - edpm_seal_thickn_/2.));
+          vertex.setX(vertex.x() - pedestal_top_x_ -
+                      pedestal_roof_thickn_);
         }
-        else{
-          vertex.setZ(vertex.z() - (shield_z_/2. - edpm_seal_thickn_/2.));
+      }
+      else{
+        vertex = ped_roof_front_gen_->GenerateVertex(INSIDE);
+        if (G4UniformRand() < 0.5){
+          vertex.setZ(vertex.z() - pedestal_lateral_length_ +
+                      pedestal_roof_thickn_);
         }
       }
-      else{ // lateral
-        vertex = edpm_seal_lateral_gen_->GenerateVertex(INSIDE);
-        vertex.setY(vertex.y() + (shield_y_/2. - edpm_seal_thickn_/2.));
+    }
+
+    return vertex;
+  }
+
+
+  G4ThreeVector Next100Shielding::GenerateBubbleSealVertex() const
+  {
+    // Front and lateral bubble seals, sampled according to their volume
+    G4ThreeVector vertex(0., 0., 0.);
+
+    G4double rand = G4UniformRand();
+    if (rand<perc_bubble_front_vol_){ // front
+      vertex = bubble_seal_front_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5){
+        vertex.setZ(vertex.z() + (support_beam_dist_/2. + support_front_dist_ +
+                                  pedestal_front_beam_thickn_/2. +
+                                  bubble_seal_thickn_/2.));
+      }
+      else {
+        vertex.setZ(vertex.z() - (support_beam_dist_/2. + support_front_dist_ +
+                                  pedestal_front_beam_thickn_/2. +
+                                  bubble_seal_thickn_/2.));
+      }
+    }
+    else { // lateral
+      vertex = bubble_seal_lateral_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5){
+        vertex.setX(vertex.x() + (pedestal_x_/2. +
+                                  pedestal_lateral_beam_thickn_ +
+                                  bubble_seal_thickn_/2.));
+      }
+      else{
+        vertex.setX(vertex.x() - (pedestal_x_/2. +
+                                  pedestal_lateral_beam_thickn_ +
+                                  bubble_seal_thickn_/2.));
       }
     }
 
-    else {
-      G4Exception("[Next100Shielding]", "GenerateVertex()", FatalException,
-		  "Unknown vertex generation region!");
+    return vertex;
+  }
+
+
+  G4ThreeVector Next100Shielding::GenerateEdpmSealVertex() const
+  {
+    // Front and lateral EDPM seals, sampled according to their volume
+    G4ThreeVector vertex(0., 0., 0.);
+
+    G4double rand = G4UniformRand();
+    if (rand<perc_edpm_front_vol_){ // front
+      vertex = edpm_seal_front_gen_->GenerateVertex(INSIDE);
+      if (G4UniformRand() < 0.5){
+        vertex.setZ(vertex.z() + (shield_z_/2. - edpm_seal_thickn_/2.));
+      }
+      else{
+        vertex.setZ(vertex.z() - (shield_z_/2. - edpm_seal_thickn_/2.));
+      }
+    }
+    else{ // lateral
+      vertex = edpm_seal_lateral_gen_->GenerateVertex(INSIDE);
+      vertex.setY(vertex.y() + (shield_y_/2. - edpm_seal_thickn_/2.));
     }
 
     return vertex;
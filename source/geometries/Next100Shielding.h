@@ -11,7 +11,6 @@
 
 #include "GeometryBase.h"
 
-#include <G4Navigator.hh>
 
 class G4GenericMessenger;
 
@@ -55,6 +54,11 @@ namespace nexus {
 
 
   private:
+    void RegisterVertexSamplers();
+    G4ThreeVector GenerateStructVertex() const;
+    G4ThreeVector GeneratePedestalVertex() const;
+    G4ThreeVector GenerateBubbleSealVertex() const;
+    G4ThreeVector GenerateEdpmSealVertex() const;
 
     // Dimensions
     const G4double shield_x_, shield_y_, shield_z_;
@@ -115,9 +119,6 @@ namespace nexus {
     G4double perc_edpm_lateral_vol_;
 
 
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
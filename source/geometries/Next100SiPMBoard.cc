@@ -15,12 +15,14 @@
 #include "BoxPointSampler.h"
 #include "Visibilities.h"
 #include "Next100SiPM.h"
+#include "TransformParameterisation.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Box.hh>
 #include <G4Tubs.hh>
 #include <G4LogicalVolume.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVParameterised.hh>
 #include <G4Material.hh>
 #include <G4NistManager.hh>
 #include <G4OpticalSurface.hh>
@@ -41,6 +43,7 @@ Next100SiPMBoard::Next100SiPMBoard():
   time_binning_    (1. * microsecond),
   visibility_      (true),
   sipm_visibility_ (false),
+  parameterised_   (false),
   mpv_             (nullptr),
   vtxgen_          (nullptr),
   sipm_            (new Next100SiPM())
@@ -58,6 +61,10 @@ Next100SiPMBoard::Next100SiPMBoard():
   time_binning_cmd.SetParameterName("sipm_time_binning", false);
   time_binning_cmd.SetUnitCategory("Time");
   time_binning_cmd.SetRange("sipm_time_binning>0.");
+
+  msg_->DeclareProperty("sipm_board_parameterised", parameterised_,
+                        "Place the SiPMs of each board in a parameterised volume "
+                        "instead of one placement per SiPM.");
 }
 
 
@@ -104,9 +111,19 @@ void Next100SiPMBoard::Construct()
 
   G4String mask_name = "SIPM_BOARD_MASK";
   G4double mask_zpos = board_thickness_/2.;
+  G4double wls_thickness = 1. * um;
+
+  // A parameterised volume must be the only daughter of its mother,
+  // so in that case the WLS coating is placed on top of the mask
+  // instead of inside it
+  G4double mask_body_thickness = mask_thickness_;
+  if (parameterised_) {
+    mask_body_thickness -= wls_thickness;
+    mask_zpos           -= wls_thickness/2.;
+  }
 
   G4Box* mask_solid_vol =
-    new G4Box(mask_name, size_/2., size_/2., mask_thickness_/2.);
+    new G4Box(mask_name, size_/2., size_/2., mask_body_thickness/2.);
 
   G4Material* teflon = G4NistManager::Instance()->FindOrBuildMaterial("G4_TEFLON");
   // teflon is the material used in the sipm-board masks which are covered by
@@ -131,8 +148,13 @@ void Next100SiPMBoard::Construct()
   // WLS COATING /////////////////////////////////////////////////////
 
   G4String mask_wls_name = "SIPM_BOARD_MASK_WLS";
-  G4double wls_thickness = 1. * um;
   G4double mask_wls_zpos = mask_thickness_/2. - wls_thickness/2.;
+  G4LogicalVolume* mask_wls_mother = mask_logic_vol;
+
+  if (parameterised_) {
+    mask_wls_zpos   = board_thickness_/2. + mask_wls_zpos;
+    mask_wls_mother = board_logic_vol;
+  }
 
   G4Box* mask_wls_solid_vol =
     new G4Box(mask_wls_name, size_/2., size_/2., wls_thickness/2.);
@@ -145,7 +167,7 @@ void Next100SiPMBoard::Construct()
 
   G4VPhysicalVolume* mask_wls_phys_vol =
     new G4PVPlacement(nullptr, G4ThreeVector(0., 0., mask_wls_zpos),
-                      mask_wls_logic_vol, mask_wls_name, mask_logic_vol, false, 0, false);
+                      mask_wls_logic_vol, mask_wls_name, mask_wls_mother, false, 0, false);
 
   G4OpticalSurface* mask_wls_opsurf =
     new G4OpticalSurface(mask_wls_name+"_OPSURF",
@@ -160,7 +182,7 @@ void Next100SiPMBoard::Construct()
 
   G4String mask_hole_name   = "SIPM_BOARD_MASK_HOLE";
   G4double mask_hole_length = mask_thickness_ - wls_thickness;
-  G4double mask_hole_zpos   = - mask_thickness_/2. + mask_hole_length/2.;
+  G4double mask_hole_zpos   = - mask_body_thickness/2. + mask_hole_length/2.;
   G4double mask_hole_x = 6.0 * mm;
   G4double mask_hole_y = 5.0 * mm;
 
@@ -244,6 +266,8 @@ void Next100SiPMBoard::Construct()
   G4double zpos = board_thickness_ + sipm_thickn/2.;
   G4VPhysicalVolume* mask_hole_phys_vol;
 
+  std::vector<G4ThreeVector> hole_positions;
+
   G4int counter = 0;
 
   for (auto i=0; i<8; i++) {
@@ -257,6 +281,10 @@ void Next100SiPMBoard::Construct()
       G4ThreeVector sipm_position(xpos, ypos, zpos);
       sipm_positions_.push_back(sipm_position);
 
+      hole_positions.push_back(G4ThreeVector(xpos, ypos, 0.));
+
+      if (parameterised_) continue;
+
       // Placement of the WLS gas hole
       new G4PVPlacement(nullptr, G4ThreeVector(xpos, ypos, 0.),
                         mask_wls_hole_logic_vol, mask_wls_hole_name,
@@ -278,6 +306,29 @@ void Next100SiPMBoard::Construct()
     }
   }
 
+  // The copy number of each hole, which gives the SiPM ID,
+  // is its index in the same order as above
+  if (parameterised_) {
+    TransformParameterisation* hole_param =
+      new TransformParameterisation(hole_positions);
+
+    new G4PVParameterised(mask_wls_hole_name, mask_wls_hole_logic_vol,
+                          mask_wls_logic_vol, kUndefined,
+                          hole_param->GetNumberOfCopies(), hole_param, false);
+
+    mask_hole_phys_vol =
+      new G4PVParameterised(mask_hole_name, mask_hole_logic_vol,
+                            mask_logic_vol, kUndefined,
+                            hole_param->GetNumberOfCopies(), hole_param, false);
+
+    new G4LogicalBorderSurface(mask_wall_wls_name+"_OPSURF",
+                               mask_hole_phys_vol, wall_wls_phys_vol,
+                               mask_wls_opsurf);
+    new G4LogicalBorderSurface(mask_wls_name+"_OPSURF",
+                               wall_wls_phys_vol, mask_hole_phys_vol,
+                               mask_wls_opsurf);
+  }
+
   // VERTEX GENERATOR ////////////////////////////////////////////////
 
   vtxgen_ = new BoxPointSampler(size_/2., size_/2., (board_thickness_+mask_thickness_)/2.,
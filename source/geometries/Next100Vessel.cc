@@ -12,6 +12,7 @@
 #include "OpticalMaterialProperties.h"
 #include "CylinderPointSampler.h"
 #include "SpherePointSampler.h"
+#include "SolidPointSampler.h"
 #include "Next100Th228Source.h"
 #include "CalibrationSource.h"
 
@@ -25,7 +26,6 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
 #include <G4UnitsTable.hh>
 #include <G4SubtractionSolid.hh>
 
@@ -92,10 +92,6 @@ namespace nexus {
     /// This way, the inner part of the EP flange emerges as the part of
     // the inner volume of the vessel which is not occupied by xenon.
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ =
-      G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ =
       new G4GenericMessenger(this, "/Geometry/Next100/", "Control commands of Next100 geometry.");
@@ -445,53 +441,16 @@ namespace nexus {
     }
 
     // VERTEX GENERATORS   //////////
-    body_gen_  = new CylinderPointSampler(vessel_in_rad_, vessel_out_rad, body_length_/2.,
-                                          0., 360.*deg, 0, G4ThreeVector(0., 0., 0.));
-
-    energy_endcap_gen_ =
-      new SpherePointSampler(endcap_in_rad_, endcap_in_rad_+vessel_thickness_,
-                             0., twopi, 0., endcap_theta_, energy_endcap_pos, 0);
-
-    tracking_endcap_gen_ =
-      new SpherePointSampler(endcap_in_rad_, endcap_in_rad_+vessel_thickness_,
-                             0., twopi, 0., endcap_theta_, tracking_endcap_pos, xRot);
-
-    tracking_flange_gen_ =
-      new CylinderPointSampler(vessel_in_rad_, flange_out_rad, flange_tp_length/2.,
-                               0., 360.*deg, 0, tracking_flange_pos);
-
-    energy_flange_gen_ =
-      new CylinderPointSampler(ep_int_flange_in_rad, flange_out_rad, flange_ep_length/2.,
-                               0., 360.*deg, 0, energy_flange_pos);
-
-    // Calculating some prob
-    G4UnionSolid* ep_int_flange_solid =
-      new G4UnionSolid("VESSEL_EP_INT_FLANGE", ep_int_flange_short_solid,
-                       ep_int_flange_long_solid, 0,
-                       G4ThreeVector(0., 0., -ep_int_flange_short_length/2.
-                                     - ics_ep_lip_width_/2. ));
-    G4double body_vol = vessel_body_solid  ->GetCubicVolume() -
-      vessel_gas_body_solid  ->GetCubicVolume();
-    G4double endcap_vol = vessel_endcap_solid->GetCubicVolume() -
-      vessel_gas_endcap_solid->GetCubicVolume();
-    G4double flange_ep_vol = vessel_ep_flange_solid->GetCubicVolume() +
-      ep_int_flange_solid->GetCubicVolume();
-    G4double flange_tp_vol = vessel_tp_flange_solid->GetCubicVolume();
-    G4double vessel_vol = body_vol + 2.*endcap_vol + flange_ep_vol + flange_tp_vol;
-
-    perc_endcap_vol_    = 2.*endcap_vol / vessel_vol;
-    perc_ep_flange_vol_ = flange_ep_vol / vessel_vol;
-    perc_tp_flange_vol_ = flange_tp_vol / vessel_vol;
+    // The steel of the vessel is the vessel solid minus the gas
+    vessel_gen_       = new SolidPointSampler(vessel_logic);
+    vessel_inner_gen_ = new SolidPointSampler(vessel_gas_final_solid);
   }
 
 
   Next100Vessel::~Next100Vessel()
   {
-    delete body_gen_;
-    delete tracking_endcap_gen_;
-    delete energy_endcap_gen_;
-    delete tracking_flange_gen_;
-    delete energy_flange_gen_;
+    delete vessel_gen_;
+    delete vessel_inner_gen_;
   }
 
 
@@ -516,40 +475,12 @@ namespace nexus {
 
     // Vertex in the whole VESSEL volume
     if (region == "VESSEL") {
-      G4double rand = G4UniformRand();
-      if (rand < perc_endcap_vol_) { // Endcaps
-        if (G4UniformRand()<0.5){ // Tracking endcap
-          vertex = tracking_endcap_gen_->GenerateVertex(VOLUME);
-        }
-        else{ // Energy endcap
-          vertex = energy_endcap_gen_->GenerateVertex(VOLUME);
-        }
-      }
-      else if (rand < (perc_endcap_vol_ + perc_ep_flange_vol_)){//Energy flange
-        G4VPhysicalVolume* VertexVolume;
-        do {
-          vertex = energy_flange_gen_->GenerateVertex(VOLUME);
-
-          G4ThreeVector glob_vtx(vertex);
-          // this->GetCoordOrigin() only has x and y set
-          glob_vtx = glob_vtx - GetCoordOrigin() - G4ThreeVector(0, 0, gate_z_pos_);
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-        } while (VertexVolume->GetName() != "VESSEL");
-      }
-      else if (rand < (perc_endcap_vol_ + perc_ep_flange_vol_ + perc_tp_flange_vol_)){// Tracking flange
-        vertex = tracking_flange_gen_->GenerateVertex(VOLUME);
-      }
-      else {// Body
-        G4VPhysicalVolume* VertexVolume;
-        do {
-          vertex = body_gen_->GenerateVertex(VOLUME);
-
-          G4ThreeVector glob_vtx(vertex);
-          // this->GetCoordOrigin() only has x and y set
-          glob_vtx = glob_vtx - GetCoordOrigin() - G4ThreeVector(0, 0, gate_z_pos_);
-          VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-        } while (VertexVolume->GetName() != "VESSEL");
-      }
+      vertex = vessel_gen_->GenerateVertex(VOLUME);
+    }
+
+    // Vertex on the inner surface of the vessel, in contact with the gas
+    else if (region == "VESSEL_INNER_SURF") {
+      vertex = vessel_inner_gen_->GenerateVertex(SURFACE);
     }
 
     else if (region == "PORT_1a"){
@@ -11,8 +11,6 @@
 
 #include "GeometryBase.h"
 
-#include <G4Navigator.hh>
-
 
 class G4GenericMessenger;
 class G4VPhysicalVolume;
@@ -21,6 +19,7 @@ namespace nexus {
 
   class CylinderPointSampler;
   class SpherePointSampler;
+  class SolidPointSampler;
 
   class Next100Vessel: public GeometryBase
   {
@@ -82,21 +81,11 @@ namespace nexus {
     G4VPhysicalVolume* internal_phys_vol_;
 
     // Vertex generators
-    CylinderPointSampler* body_gen_;
-    SpherePointSampler*   tracking_endcap_gen_;
-    SpherePointSampler*   energy_endcap_gen_;
-    CylinderPointSampler* tracking_flange_gen_;
-    CylinderPointSampler* energy_flange_gen_;
+    SolidPointSampler* vessel_gen_;
+    SolidPointSampler* vessel_inner_gen_;
     SpherePointSampler* th_port_gen_;
     CylinderPointSampler* th_white_port_gen_;
 
-    G4double perc_endcap_vol_;
-    G4double perc_ep_flange_vol_;
-    G4double perc_tp_flange_vol_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -63,6 +63,8 @@ void NextDemo::Construct()
   inner_geom_->SetMotherLogicalVolume(vessel_geom_->GetGasPhysicalVolume()->GetLogicalVolume());
   inner_geom_->SetMotherPhysicalVolume(vessel_geom_->GetGasPhysicalVolume());
   inner_geom_->Construct();
+
+  RegisterVertexSamplers();
 }
 
 
@@ -94,30 +96,36 @@ void NextDemo::ConstructLab()
 }
 
 
-G4ThreeVector NextDemo::GenerateVertex(const G4String& region) const
+void NextDemo::RegisterVertexSamplers()
 {
-  G4ThreeVector vtx;
+  RegisterVertexSampler("AD_HOC", [this]() { return specific_vertex_; });
 
-  if (region == "AD_HOC") {
-    vtx = specific_vertex_;
-  }
-  else if (region == "CALIBRATION_SOURCE") {
-    vtx = vessel_geom_->GenerateVertex("CALIBRATION_SOURCE");
-    G4ThreeVector displacement = G4ThreeVector(0., 0., -vessel_geom_->GetGateEndcapDistance());
-    vtx = vtx + displacement;
-  }
-  else if ((region == "ACTIVE")  ||
-           (region == "TP_PLATE") ||
-           (region == "SIPM_BOARD") ||
-           (region == "EL_GAP")) {
-    vtx = inner_geom_->GenerateVertex(region);
-    G4ThreeVector displacement = G4ThreeVector(0., 0., -vessel_geom_->GetGateEndcapDistance());
-    vtx = vtx + displacement;
+  G4ThreeVector displacement =
+    G4ThreeVector(0., 0., -vessel_geom_->GetGateEndcapDistance());
+
+  VertexSampler source = vessel_geom_->GetVertexSampler("CALIBRATION_SOURCE");
+  RegisterVertexSampler("CALIBRATION_SOURCE", [source, displacement]() {
+    return source() + displacement;
+  });
+
+  for (const G4String region : {"ACTIVE", "TP_PLATE", "SIPM_BOARD", "EL_GAP"}) {
+    VertexSampler inner = inner_geom_->GetVertexSampler(region);
+    RegisterVertexSampler(region, [inner, displacement]() {
+      return inner() + displacement;
+    });
   }
-  else {
+}
+
+
+G4ThreeVector NextDemo::GenerateVertex(const G4String& region) const
+{
+  const VertexSampler* sampler = FindVertexSampler(region);
+
+  if (!sampler) {
     G4Exception("[NextDemo]", "GenerateVertex()", FatalException,
                 "Unknown vertex generation region.");
+    return G4ThreeVector();
   }
 
-  return vtx;
+  return (*sampler)();
 }
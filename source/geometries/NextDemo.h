@@ -29,6 +29,7 @@ namespace nexus {
 
   private:
     void ConstructLab();
+    void RegisterVertexSamplers();
 
   private:
     const G4double lab_size_;
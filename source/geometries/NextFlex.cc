@@ -240,6 +240,9 @@ void NextFlex::Construct()
   // The ICS
   BuildICS(gas_logic_vol);
 
+  // Vertex generation regions
+  RegisterVertexSamplers();
+
   // Verbosity
   if(verbosity_) G4cout << G4endl;
 }
@@ -290,46 +293,36 @@ void NextFlex::BuildICS(G4LogicalVolume* mother_logic) {
 
 
 
-G4ThreeVector NextFlex::GenerateVertex(const G4String& region) const
+void NextFlex::RegisterVertexSamplers()
 {
-  G4ThreeVector vertex;
-
-  if (region == "AD_HOC") {
-    vertex = specific_vertex_;
-  }
+  RegisterVertexSampler("AD_HOC", [this]() { return specific_vertex_; });
 
   // ICS region
-  else if (region == "ICS") {
-    vertex = copper_gen_->GenerateVertex(VOLUME);
-  }
+  RegisterVertexSampler("ICS", [this]() {
+    return copper_gen_->GenerateVertex(VOLUME);
+  });
 
   // Field Cage regions
-  else if (
-    (region == "ACTIVE") ||
-    (region == "BUFFER") ||
-    (region == "EL_GAP") ||
-    (region == "LIGHT_TUBE") ||
-    (region == "FIBER_CORE")) {
-    vertex = field_cage_->GenerateVertex(region);
-  }
+  ForwardVertexSamplers(field_cage_, {"ACTIVE", "BUFFER", "EL_GAP",
+                                      "LIGHT_TUBE", "FIBER_CORE"});
 
   // Energy Plane regions
-  else if (
-    (region == "EP_COPPER") ||
-    (region == "EP_WINDOWS")) {
-    vertex = energy_plane_->GenerateVertex(region);
-  }
+  ForwardVertexSamplers(energy_plane_, {"EP_COPPER", "EP_WINDOWS"});
 
   // Tracking Plane regions
-  else if (
-    (region == "TP_COPPER")) {
-    vertex = tracking_plane_->GenerateVertex(region);
-  }
+  ForwardVertexSamplers(tracking_plane_, {"TP_COPPER"});
+}
+
+
+G4ThreeVector NextFlex::GenerateVertex(const G4String& region) const
+{
+  const VertexSampler* sampler = FindVertexSampler(region);
 
-  else {
+  if (!sampler) {
     G4Exception("[NextFlex]", "GenerateVertex()", FatalException,
       "Unknown vertex generation region!");
+    return G4ThreeVector();
   }
 
-  return vertex;
+  return (*sampler)();
 }
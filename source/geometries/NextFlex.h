@@ -57,6 +57,9 @@ namespace nexus {
     // Different builders
     void BuildICS(G4LogicalVolume* mother_logic);
 
+    // Maps the vertex generation regions to their samplers
+    void RegisterVertexSamplers();
+
   private:
 
     const G4int FIRST_ENERGY_SENSOR_ID      =      0;
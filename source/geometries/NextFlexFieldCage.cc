@@ -17,6 +17,7 @@
 #include "GenericPhotosensor.h"
 #include "SensorSD.h"
 #include "Visibilities.h"
+#include "TransformParameterisation.h"
 
 #include <G4UnitsTable.hh>
 #include <G4GenericMessenger.hh>
@@ -28,12 +29,15 @@
 #include <G4SDManager.hh>
 #include <G4VisAttributes.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVParameterised.hh>
 #include <G4OpticalSurface.hh>
 #include <G4LogicalSkinSurface.hh>
 #include <G4LogicalBorderSurface.hh>
 #include <G4UserLimits.hh>
 #include <G4Transform3D.hh>
 
+#include <cmath>
+
 
 using namespace nexus;
 
@@ -64,6 +68,7 @@ NextFlexFieldCage::NextFlexFieldCage():
   photoe_prob_             (0),                  // OpticalPhotoElectric Probability
   fiber_claddings_         (2),                  // Number of fiber claddings (0, 1 or 2)
   fiber_sensor_binning_    (100. * ns),          // Size of fiber sensors time binning
+  fiber_sensor_parameterised_ (false),           // One placement per fiber sensor
   wls_mat_name_            ("TPB"),              // UV wls material name
   fiber_mat_name_          ("EJ280"),            // Fiber core material name
   el_gap_gen_disk_diam_    (0.),                 // EL_GAP generator diameter
@@ -239,6 +244,9 @@ void NextFlexFieldCage::DefineConfigurationParameters()
   fiber_sensor_binning_cmd.SetUnitCategory("Time");
   fiber_sensor_binning_cmd.SetRange("fiber_sensor_time_binning>=0.");
 
+  msg_->DeclareProperty("fiber_sensor_parameterised", fiber_sensor_parameterised_,
+                        "Place each ring of fiber sensors as a parameterised volume.");
+
   // EL_GAP GENERATOR
   G4GenericMessenger::Command& el_gap_gen_disk_diam_cmd =
     msg_->DeclareProperty("el_gap_gen_disk_diam", el_gap_gen_disk_diam_,
@@ -970,6 +978,8 @@ void NextFlexFieldCage::BuildFiberSensors()
   G4RotationMatrix sensor_right_rot;
   sensor_right_rot.rotateY(pi);
 
+  std::vector<G4Transform3D> left_transforms, right_transforms;
+
   for (G4int sensor_id=0; sensor_id < num_fiber_sensors_; sensor_id++) {
 
     G4double phi = sensor_id * fiber_sensor_phi;
@@ -984,10 +994,6 @@ void NextFlexFieldCage::BuildFiberSensors()
     if (verbosity_) G4cout << "* Left  fiber sensor " << first_left_sensor_id_ + sensor_id
                            << " position: " << case_left_pos << G4endl;
 
-    new G4PVPlacement(G4Transform3D(sensor_left_rot, case_left_pos), left_sensor_logic,
-                      left_sensor_logic->GetName(), mother_logic_, true,
-                      first_left_sensor_id_ + sensor_id, false);
-
     // Right Sensors
     if (sensor_id > 0) sensor_right_rot.rotateZ(-fiber_sensor_phi);
 
@@ -998,11 +1004,59 @@ void NextFlexFieldCage::BuildFiberSensors()
     if (verbosity_) G4cout << "* Right fiber sensor " << first_right_sensor_id_ + sensor_id
                            << " position: " << case_right_pos << G4endl;
 
+    if (fiber_sensor_parameterised_) {
+      // Positions relative to the ring containing the sensors
+      left_transforms .push_back(G4Transform3D(sensor_left_rot,
+                                               case_left_pos  - G4ThreeVector(0., 0., sensor_left_posZ)));
+      right_transforms.push_back(G4Transform3D(sensor_right_rot,
+                                               case_right_pos - G4ThreeVector(0., 0., sensor_right_posZ)));
+      continue;
+    }
+
+    new G4PVPlacement(G4Transform3D(sensor_left_rot, case_left_pos), left_sensor_logic,
+                      left_sensor_logic->GetName(), mother_logic_, true,
+                      first_left_sensor_id_ + sensor_id, false);
+
     new G4PVPlacement(G4Transform3D(sensor_right_rot, case_right_pos), right_sensor_logic,
                                     right_sensor_logic->GetName(), mother_logic_, true,
                                     first_right_sensor_id_ + sensor_id, false);
   }
 
+  if (fiber_sensor_parameterised_) {
+    // Each ring of sensors is a parameterised volume inside a gas ring,
+    // as it must be the only daughter of its mother. The copy number of
+    // the ring is the first sensor ID, added to the copy number of each
+    // sensor (its index) through the mother depth and naming order above.
+    G4double ring_outer_rad = std::hypot(fiber_inner_rad_ + fiber_sensor_size_,
+                                         fiber_sensor_size_/2.);
+
+    G4Tubs* ring_solid =
+      new G4Tubs("F_SENSORS", fiber_inner_rad_, ring_outer_rad,
+                 fiber_sensor_thickness_/2., 0., twopi);
+
+    G4LogicalVolume* left_ring_logic =
+      new G4LogicalVolume(ring_solid, xenon_gas_, "F_SENSORS_L");
+    G4LogicalVolume* right_ring_logic =
+      new G4LogicalVolume(ring_solid, xenon_gas_, "F_SENSORS_R");
+
+    new G4PVPlacement(nullptr, G4ThreeVector(0., 0., sensor_left_posZ),
+                      left_ring_logic, left_ring_logic->GetName(), mother_logic_,
+                      false, first_left_sensor_id_, verbosity_);
+    new G4PVPlacement(nullptr, G4ThreeVector(0., 0., sensor_right_posZ),
+                      right_ring_logic, right_ring_logic->GetName(), mother_logic_,
+                      false, first_right_sensor_id_, verbosity_);
+
+    new G4PVParameterised(left_sensor_logic->GetName(), left_sensor_logic,
+                          left_ring_logic, kUndefined, num_fiber_sensors_,
+                          new TransformParameterisation(left_transforms), verbosity_);
+    new G4PVParameterised(right_sensor_logic->GetName(), right_sensor_logic,
+                          right_ring_logic, kUndefined, num_fiber_sensors_,
+                          new TransformParameterisation(right_transforms), verbosity_);
+
+    left_ring_logic ->SetVisAttributes(G4VisAttributes::GetInvisible());
+    right_ring_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
+  }
+
   /// Verbosity
   if (verbosity_) {
     G4cout << "* Num fiber sensors   : " << num_fiber_sensors_ << " * 2" << G4endl;
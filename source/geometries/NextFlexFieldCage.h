@@ -151,6 +151,7 @@ namespace nexus {
     G4double fiber_sensor_thickness_;
     G4double fiber_sensor_binning_;
     G4int    num_fiber_sensors_;
+    G4bool   fiber_sensor_parameterised_;
 
 
     // Materials
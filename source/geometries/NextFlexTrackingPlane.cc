@@ -17,6 +17,7 @@
 #include "GenericPhotosensor.h"
 #include "SensorSD.h"
 #include "Visibilities.h"
+#include "TransformParameterisation.h"
 
 #include <G4UnitsTable.hh>
 #include <G4GenericMessenger.hh>
@@ -32,12 +33,15 @@
 #include <G4VisAttributes.hh>
 #include <G4MultiUnion.hh>
 #include <G4PVPlacement.hh>
+#include <G4PVParameterised.hh>
 #include <G4OpticalSurface.hh>
 #include <G4LogicalSkinSurface.hh>
 #include <G4LogicalBorderSurface.hh>
 #include <G4UserLimits.hh>
 #include <Randomize.hh>
 
+#include <cmath>
+
 
 using namespace nexus;
 
@@ -60,7 +64,8 @@ NextFlexTrackingPlane::NextFlexTrackingPlane():
   SiPM_binning_      ( 1.  * us),   // SiPMs time binning size
   copper_thickness_  (12.  * cm),   // Thickness of the copper plate
   teflon_thickness_  ( 5.  * mm),   // Thickness of the teflon mask
-  teflon_hole_diam_  ( 7.  * mm)    // Diameter of teflon mask holes
+  teflon_hole_diam_  ( 7.  * mm),   // Diameter of teflon mask holes
+  SiPM_parameterised_(false)
 {
   // Messenger
   msg_ = new G4GenericMessenger(this, "/Geometry/NextFlex/",
@@ -178,6 +183,10 @@ void NextFlexTrackingPlane::DefineConfigurationParameters()
   sipm_binning_cmd.SetParameterName("tp_sipm_time_binning", false);
   sipm_binning_cmd.SetUnitCategory("Time");
   sipm_binning_cmd.SetRange("tp_sipm_time_binning>=0.");
+
+  msg_->DeclareProperty("tp_sipm_parameterised", SiPM_parameterised_,
+                        "Place the SiPMs in a parameterised volume of teflon "
+                        "holes instead of subtracting the holes from the mask.");
 }
 
 
@@ -248,12 +257,14 @@ void NextFlexTrackingPlane::Construct()
   // Copper
   BuildCopper();
 
+  // SiPMs
+  BuildSiPMs();
+
   // Teflon
   if (teflon_thickness_) {
-    BuildTeflon();
+    if (SiPM_parameterised_) BuildParameterisedTeflon();
+    else                     BuildTeflon();
   }
-  // SiPMs
-  BuildSiPMs();
 }
 
 
@@ -394,6 +405,126 @@ void NextFlexTrackingPlane::BuildTeflon()
 
 
 
+void NextFlexTrackingPlane::BuildParameterisedTeflon()
+{
+  // Same mask as BuildTeflon, but with the holes (and the SiPMs inside them)
+  // placed as a parameterised daughter of a plain disk instead of subtracted
+  // from it, which makes the optical navigation much cheaper. A parameterised
+  // volume must be the only daughter of its mother, so the WLS coating is
+  // placed next to the teflon rather than inside it.
+
+  G4double hole_length = teflon_thickness_ - wls_thickness_;
+
+  if (SiPM_size_z_ > hole_length ||
+      std::hypot(SiPM_size_x_, SiPM_size_y_) > teflon_hole_diam_)
+    G4Exception("[NextFlexTrackingPlane]", "BuildParameterisedTeflon()", FatalException,
+                "SiPMs do not fit inside the teflon holes.");
+
+  TransformParameterisation* hole_param =
+    new TransformParameterisation(SiPM_positions_);
+
+  /// The TEFLON ///
+  G4String teflon_name = "TP_TEFLON";
+
+  G4double teflon_posZ = teflon_iniZ_ + hole_length/2.;
+
+  G4Tubs* teflon_solid =
+    new G4Tubs(teflon_name, 0., diameter_/2., hole_length/2., 0, twopi);
+
+  G4LogicalVolume* teflon_logic =
+    new G4LogicalVolume(teflon_solid, teflon_mat_, teflon_name);
+
+  G4OpticalSurface* teflon_optSurf =
+    new G4OpticalSurface(teflon_name, unified, ground, dielectric_metal);
+  teflon_optSurf->SetMaterialPropertiesTable(opticalprops::PTFE());
+
+  new G4LogicalSkinSurface(teflon_name, teflon_logic, teflon_optSurf);
+
+  new G4PVPlacement(nullptr, G4ThreeVector(0., 0., teflon_posZ), teflon_logic,
+                    teflon_name, mother_logic_, false, 0, verbosity_);
+
+  // Holes, each containing one SiPM sitting on the copper
+  G4String hole_name = "TP_TEFLON_HOLE";
+
+  G4Tubs* hole_solid =
+    new G4Tubs(hole_name, 0., teflon_hole_diam_/2., hole_length/2., 0, twopi);
+
+  G4LogicalVolume* hole_logic =
+    new G4LogicalVolume(hole_solid, xenon_gas_, hole_name);
+
+  new G4PVParameterised(hole_name, hole_logic, teflon_logic, kUndefined,
+                        num_SiPMs_, hole_param, verbosity_);
+
+  // The copy number of the holes gives the SiPM ID
+  G4LogicalVolume* SiPM_logic = SiPM_->GetLogicalVolume();
+
+  new G4PVPlacement(nullptr, G4ThreeVector(0., 0., -hole_length/2. + SiPM_size_z_/2.),
+                    SiPM_logic, SiPM_logic->GetName(), hole_logic,
+                    false, first_sensor_id_, sipm_verbosity_);
+
+
+  /// The UV WLS in TEFLON ///
+  G4String teflon_wls_name = "TP_TEFLON_WLS";
+
+  G4double teflon_wls_posZ = teflon_iniZ_ + teflon_thickness_ - wls_thickness_/2.;
+
+  G4Tubs* teflon_wls_solid =
+    new G4Tubs(teflon_wls_name, 0., diameter_/2., wls_thickness_/2., 0, twopi);
+
+  G4LogicalVolume* teflon_wls_logic =
+    new G4LogicalVolume(teflon_wls_solid, wls_mat_, teflon_wls_name);
+
+  G4VPhysicalVolume* teflon_wls_phys =
+    new G4PVPlacement(nullptr, G4ThreeVector(0., 0., teflon_wls_posZ), teflon_wls_logic,
+                      teflon_wls_name, mother_logic_, false, 0, verbosity_);
+
+  G4String wls_hole_name = "TP_TEFLON_WLS_HOLE";
+
+  G4Tubs* wls_hole_solid =
+    new G4Tubs(wls_hole_name, 0., teflon_hole_diam_/2., wls_thickness_/2., 0, twopi);
+
+  G4LogicalVolume* wls_hole_logic =
+    new G4LogicalVolume(wls_hole_solid, xenon_gas_, wls_hole_name);
+
+  G4VPhysicalVolume* wls_hole_phys =
+    new G4PVParameterised(wls_hole_name, wls_hole_logic, teflon_wls_logic, kUndefined,
+                          num_SiPMs_, hole_param, verbosity_);
+
+  // The walls of the WLS holes keep the surface they had against the gas
+  G4OpticalSurface* teflon_wls_optSurf =
+    new G4OpticalSurface("TEFLON_WLS_OPSURF", glisur, ground,
+                         dielectric_dielectric, .01);
+
+  new G4LogicalBorderSurface("TEFLON_WLS_GAS_OPSURF", teflon_wls_phys,
+                             neigh_gas_phys_, teflon_wls_optSurf);
+  new G4LogicalBorderSurface("GAS_TEFLON_WLS_OPSURF", neigh_gas_phys_,
+                             teflon_wls_phys, teflon_wls_optSurf);
+  new G4LogicalBorderSurface("TEFLON_WLS_HOLE_OPSURF", teflon_wls_phys,
+                             wls_hole_phys, teflon_wls_optSurf);
+  new G4LogicalBorderSurface("HOLE_TEFLON_WLS_OPSURF", wls_hole_phys,
+                             teflon_wls_phys, teflon_wls_optSurf);
+
+  /// Verbosity ///
+  if (verbosity_)
+    G4cout << "* Teflon Z positions: " << teflon_iniZ_
+           << " to " << teflon_iniZ_ + teflon_thickness_ << G4endl;
+
+  if (sipm_verbosity_)
+    for (G4int i=0; i<num_SiPMs_; i++)
+      G4cout << "* TP_SiPM " << first_sensor_id_ + i << " position: "
+             << SiPM_positions_[i] + G4ThreeVector(0., 0., teflon_iniZ_ + SiPM_size_z_/2.)
+             << G4endl;
+
+  /// Visibilities ///
+  if (visibility_) teflon_logic->SetVisAttributes(nexus::LightBlue());
+  else             teflon_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
+  hole_logic      ->SetVisAttributes(G4VisAttributes::GetInvisible());
+  teflon_wls_logic->SetVisAttributes(G4VisAttributes::GetInvisible());
+  wls_hole_logic  ->SetVisAttributes(G4VisAttributes::GetInvisible());
+}
+
+
+
 void NextFlexTrackingPlane::BuildSiPMs()
 {
   /// Constructing the TP SiPM ///
@@ -426,6 +557,9 @@ void NextFlexTrackingPlane::BuildSiPMs()
   SiPM_->Construct();
   G4LogicalVolume* SiPM_logic = SiPM_->GetLogicalVolume();
 
+  // Otherwise, they are placed inside the teflon holes
+  if (SiPM_parameterised_ && teflon_thickness_) return;
+
   /// Placing the TP SiPMs ///
   G4double SiPM_pos_z = teflon_iniZ_ + SiPM_size_z_/2.;
   if (verbosity_)
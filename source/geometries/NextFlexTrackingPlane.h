@@ -76,6 +76,7 @@ namespace nexus {
     // Different builders
     void BuildCopper();
     void BuildTeflon();
+    void BuildParameterisedTeflon();
     void BuildSiPMs();
 
   private:
@@ -134,6 +135,9 @@ namespace nexus {
 
     G4double wls_thickness_;
 
+    // SiPMs placed inside a parameterised volume of teflon holes
+    G4bool SiPM_parameterised_;
+
     // Sensor IDs
     G4int first_sensor_id_;
 
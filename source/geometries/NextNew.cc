@@ -443,160 +443,146 @@ namespace nexus {
       source_gen_random_ = new CylinderPointSamplerLegacy(0., source_thick, source_diam/2., 0., random_pos_gen, up_rot);
     }
 
+    RegisterVertexSamplers();
   }
 
 
 
-  G4ThreeVector NextNew::GenerateVertex(const G4String& region) const
+  void NextNew::RegisterVertexSamplers()
   {
-    G4ThreeVector vertex(0.,0.,0.);
+    // First rotate, then shift
+    auto transformed = [this](VertexSampler sampler) -> VertexSampler {
+      return [this, sampler]() {
+        G4ThreeVector vertex = sampler();
+        vertex.rotate(rot_angle_, G4ThreeVector(0., 1., 0.));
+        return vertex + displ_;
+      };
+    };
+
+    // Regions of the sub-geometries are resolved once into their own samplers
+    auto forward = [this, transformed](const GeometryBase* sub,
+                                       const std::vector<G4String>& regions) {
+      for (const auto& region : regions)
+        RegisterVertexSampler(region, transformed(sub->GetVertexSampler(region)));
+    };
 
     //AIR AROUND SHIELDING
-    if (region == "LAB") {
-      vertex = lab_gen_->GenerateVertex("INSIDE");
-    }
+    RegisterVertexSampler("LAB", transformed([this]() {
+      return lab_gen_->GenerateVertex("INSIDE");
+    }));
+
     /// Calibration source in capsule, placed inside Jordi's lead,
     /// at the end (lateral and axial ports).
-    else if (region == "EXTERNAL_PORT_ANODE") {
-      if (lead_block_) {
-        vertex =  lat_source_gen_->GenerateVertex("BODY_VOL");
-      } else {
+    RegisterVertexSampler("EXTERNAL_PORT_ANODE", transformed([this]() {
+      if (!lead_block_)
         G4Exception("[NextNew]", "GenerateVertex()", FatalException,
                     "This vertex generation region must be used together with lead_block == true!");
-      }
-    }
-    else if (region == "EXTERNAL_PORT_AXIAL") {
-      if (lead_block_) {
-        vertex =  axial_source_gen_->GenerateVertex("BODY_VOL");
-      } else {
+      return lat_source_gen_->GenerateVertex("BODY_VOL");
+    }));
+    RegisterVertexSampler("EXTERNAL_PORT_AXIAL", transformed([this]() {
+      if (!lead_block_)
         G4Exception("[NextNew]", "GenerateVertex()", FatalException,
                     "This vertex generation region must be used together with lead_block == true!");
-      }
-    }
+      return axial_source_gen_->GenerateVertex("BODY_VOL");
+    }));
+
     // Vertex just outside the axial port
-    else if (region == "SOURCE_PORT_AXIAL_EXT") {
-      vertex = vessel_->GetAxialExtSourcePosition();
-    }
+    RegisterVertexSampler("SOURCE_PORT_AXIAL_EXT", transformed([this]() {
+      return vessel_->GetAxialExtSourcePosition();
+    }));
     // Vertex just outside the lateral port
-    else if (region == "SOURCE_PORT_LATERAL_EXT") {
-      vertex = vessel_->GetLatExtSourcePosition();
-    }
+    RegisterVertexSampler("SOURCE_PORT_LATERAL_EXT", transformed([this]() {
+      return vessel_->GetLatExtSourcePosition();
+    }));
+
     // Extended sources with the shape of a disk outside port
-    else if (region == "SOURCE_PORT_LATERAL_DISK") {
-      vertex =  source_gen_lat_->GenerateVertex("BODY_VOL");
-    }
-    else if (region == "SOURCE_PORT_UP_DISK") {
-      vertex =  source_gen_up_->GenerateVertex("BODY_VOL");
-    }
-     else if (region == "SOURCE_DISK") {
-      vertex =  source_gen_random_->GenerateVertex("BODY_VOL");
-    }
-    else if ( (region == "SHIELDING_LEAD") || (region == "SHIELDING_STEEL") ||
-	          (region == "INNER_AIR")  || (region == "SHIELDING_STRUCT") ||
-	          (region == "EXTERNAL") ) {
-      vertex = shielding_->GenerateVertex(region);
-    }
+    RegisterVertexSampler("SOURCE_PORT_LATERAL_DISK", transformed([this]() {
+      return source_gen_lat_->GenerateVertex("BODY_VOL");
+    }));
+    RegisterVertexSampler("SOURCE_PORT_UP_DISK", transformed([this]() {
+      return source_gen_up_->GenerateVertex("BODY_VOL");
+    }));
+    RegisterVertexSampler("SOURCE_DISK", transformed([this]() {
+      return source_gen_random_->GenerateVertex("BODY_VOL");
+    }));
+
+    forward(shielding_, {"SHIELDING_LEAD", "SHIELDING_STEEL", "INNER_AIR",
+                         "SHIELDING_STRUCT", "EXTERNAL"});
+
     //PEDESTAL
-    else if (region == "PEDESTAL_BOARD") {
-      vertex = pedestal_->GenerateVertex(region);
-    }
+    forward(pedestal_, {"PEDESTAL_BOARD"});
+
     // EXTRA ELEMENTS
-    else if (region == "EXTRA_VESSEL") {
-      G4ThreeVector ini_vertex = extra_->GenerateVertex(region);
+    VertexSampler extra = extra_->GetVertexSampler("EXTRA_VESSEL");
+    RegisterVertexSampler("EXTRA_VESSEL", transformed([this, extra]() {
+      G4ThreeVector ini_vertex = extra();
       ini_vertex.rotate(pi/2., G4ThreeVector(1., 0., 0.));
-      vertex = ini_vertex + extra_pos_;
-    }
-    // Lab walls
-    else if ((region == "HALLA_INNER") || (region == "HALLA_OUTER")){
-      if (!lab_walls_)
-        G4Exception("[NextNew]", "GenerateVertex()", FatalException,
-                    "This vertex generation region must be used with lab_walls == true!");
-      vertex = hallA_walls_->GenerateVertex(region);
-      while (vertex[1]<(-shielding_->GetHeight()/2.)){
-        vertex = hallA_walls_->GenerateVertex(region);}
-      vertex = displ_ + vertex;
+      return ini_vertex + extra_pos_;
+    }));
+
+    // Lab walls.
+    // The LSC HallA vertices are already corrected so no need to rotate.
+    for (const G4String region : {"HALLA_INNER", "HALLA_OUTER"}) {
+      RegisterVertexSampler(region, [this, region]() {
+        if (!lab_walls_)
+          G4Exception("[NextNew]", "GenerateVertex()", FatalException,
+                      "This vertex generation region must be used with lab_walls == true!");
+        G4ThreeVector vertex = hallA_walls_->GenerateVertex(region);
+        while (vertex[1]<(-shielding_->GetHeight()/2.)){
+          vertex = hallA_walls_->GenerateVertex(region);}
+        return displ_ + vertex;
+      });
     }
 
     //  MINI CASTLE and RADON
     // on the inner lead surface (SHIELDING_GAS) and on the outer mini lead castle surface (RN_MINI_CASTLE)
-    else if ((region == "MINI_CASTLE") ||
-             (region == "RN_MINI_CASTLE") ||
-             (region == "MINI_CASTLE_STEEL")) {
-      vertex = mini_castle_->GenerateVertex(region);
-    }
+    forward(mini_castle_, {"MINI_CASTLE", "RN_MINI_CASTLE", "MINI_CASTLE_STEEL"});
+
     //VESSEL REGIONS
-    else if ((region == "VESSEL") ||
-             (region == "SOURCE_PORT_ANODE") ||
-             (region == "SOURCE_PORT_UP") ||
-             (region == "SOURCE_PORT_AXIAL") ||
-             (region == "INTERNAL_PORT_ANODE") ||
-             (region == "INTERNAL_PORT_UPPER") ||
-             (region == "INTERNAL_PORT_AXIAL")){
-      vertex = vessel_->GenerateVertex(region);
-    }
+    forward(vessel_, {"VESSEL", "SOURCE_PORT_ANODE", "SOURCE_PORT_UP",
+                      "SOURCE_PORT_AXIAL", "INTERNAL_PORT_ANODE",
+                      "INTERNAL_PORT_UPPER", "INTERNAL_PORT_AXIAL"});
+
     // ICS REGIONS
-    else if (region == "ICS") {
-      vertex = ics_->GenerateVertex(region);
-    }
-    //INNER ELEMENTS
-    else if ((region == "CENTER") ||
-             (region == "CARRIER_PLATE") ||
-             (region == "ENCLOSURE_BODY") ||
-             (region == "ENCLOSURE_WINDOW") ||
-             (region == "OPTICAL_PAD") ||
-             (region == "PMT_BODY") ||
-             (region == "PMT_BASE") ||
-             (region == "INT_ENCLOSURE_SURF") ||
-             (region == "PMT_SURF") ||
-             (region == "DRIFT_TUBE") ||
-             (region == "ANODE_QUARTZ")||
-             (region == "HDPE_TUBE") ||
-             (region == "XENON") ||
-             (region == "ACTIVE") ||
-             (region == "BUFFER") ||
-             (region == "EL_GAP") ||
-             (region == "EL_TABLE") ||
-             (region == "CATHODE")||
-             (region == "TRACKING_FRAMES") ||
-             (region == "SUPPORT_PLATE") ||
-             (region == "DICE_BOARD") ||
-             (region == "DB_PLUG")) {
-      vertex = inner_elements_->GenerateVertex(region);
-    }
-    // AD_HOC is not rotated and shifted because it is passed by the user
-    else if (region == "AD_HOC") {
-      return specific_vertex_;
-    }
-    else {
-      G4Exception("[NextNew]", "GenerateVertex()", FatalException,
-		  "Unknown vertex generation region!");
-    }
+    forward(ics_, {"ICS"});
 
-    // The LSC HallA vertices are already corrected so no need.
-    if ((region == "HALLA_OUTER") ||
-        (region == "HALLA_INNER"))
-      return vertex;
+    //INNER ELEMENTS
+    forward(inner_elements_,
+            {"CENTER", "CARRIER_PLATE", "ENCLOSURE_BODY", "ENCLOSURE_WINDOW",
+             "OPTICAL_PAD", "PMT_BODY", "PMT_BASE", "INT_ENCLOSURE_SURF",
+             "PMT_SURF", "DRIFT_TUBE", "ANODE_QUARTZ", "HDPE_TUBE", "XENON",
+             "ACTIVE", "BUFFER", "EL_TABLE", "CATHODE", "TRACKING_FRAMES",
+             "SUPPORT_PLATE", "DICE_BOARD", "DB_PLUG"});
 
     // In EL_GAP, x and y coordinates are passed by the user,
     // but the z coordinate is not. Therefore, rotation + displacement
     // must be applied to get the correct z, but x and y must be left
     // unchanged.
-    if (region == "EL_GAP") {
-      // First rotate, then shift to return the correct z coordinate
-      vertex.rotate(rot_angle_, G4ThreeVector(0., 1., 0.));
-      vertex = vertex + displ_;
-
+    VertexSampler el_gap =
+      transformed(inner_elements_->GetVertexSampler("EL_GAP"));
+    RegisterVertexSampler("EL_GAP", [el_gap]() {
+      G4ThreeVector vertex = el_gap();
       // Change back x coordinate alone (y is not touched).
       vertex.setX(-vertex.x());
-
       return vertex;
-    }
+    });
 
-    // First rotate, then shift
-    vertex.rotate(rot_angle_, G4ThreeVector(0., 1., 0.));
-    vertex = vertex + displ_;
+    // AD_HOC is not rotated and shifted because it is passed by the user
+    RegisterVertexSampler("AD_HOC", [this]() { return specific_vertex_; });
+  }
+
+
+  G4ThreeVector NextNew::GenerateVertex(const G4String& region) const
+  {
+    const VertexSampler* sampler = FindVertexSampler(region);
+
+    if (!sampler) {
+      G4Exception("[NextNew]", "GenerateVertex()", FatalException,
+		  "Unknown vertex generation region!");
+      return G4ThreeVector(0., 0., 0.);
+    }
 
-    return vertex;
+    return (*sampler)();
   }
 
   G4ThreeVector NextNew::ProjectToRegion(const G4String& region,
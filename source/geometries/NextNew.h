@@ -55,6 +55,7 @@ namespace nexus {
   private:
     void BuildExtScintillator(G4ThreeVector pos, const G4RotationMatrix& rot);
     void Construct();
+    void RegisterVertexSamplers();
 
   private:
 
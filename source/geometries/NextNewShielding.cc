@@ -9,6 +9,7 @@
 #include "NextNewShielding.h"
 #include "MaterialsList.h"
 #include "Visibilities.h"
+#include "GeometryCache.h"
 #include "BoxPointSamplerLegacy.h"
 
 #include <G4GenericMessenger.hh>
@@ -270,11 +271,11 @@ namespace nexus {
 
 
     // Calculating some probs
-    G4double roof_vol = roof_beam_solid->GetCubicVolume();
+    G4double roof_vol = GeometryCache::Instance().GetCubicVolume(roof_beam_solid);
     //std::cout<<"ROOF BEAM VOLUME "<<roof_vol<<std::endl;
-    G4double struct_top_vol = struct_solid->GetCubicVolume();
+    G4double struct_top_vol = GeometryCache::Instance().GetCubicVolume(struct_solid);
     //std::cout<<"TOP STRUCT VOLUME "<<struct_top_vol<<std::endl;
-    G4double lateral_vol = lat_beam_solid->GetCubicVolume();
+    G4double lateral_vol = GeometryCache::Instance().GetCubicVolume(lat_beam_solid);
     //std::cout<<"LAT BEAM STRUCT VOLUME "<<lateral_vol<<"\t TOTAL LATERAL BEAMS VOL "<<8*lateral_vol<<std::endl;
     G4double total_vol = roof_vol+struct_top_vol+(8*lateral_vol);
     //std::cout<<"TOTAL STRUCTURE VOLUME "<<total_vol<<std::endl;
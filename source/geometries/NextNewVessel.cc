@@ -12,7 +12,7 @@
 #include "Visibilities.h"
 #include "CalibrationSource.h"
 #include "CylinderPointSamplerLegacy.h"
-#include "SpherePointSampler.h"
+#include "SolidPointSampler.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4LogicalVolume.hh>
@@ -24,7 +24,6 @@
 #include <G4NistManager.hh>
 #include <G4Material.hh>
 #include <Randomize.hh>
-#include <G4TransportationManager.hh>
 #include <G4RotationMatrix.hh>
 #include <G4UnitsTable.hh>
 #include <G4Transform3D.hh>
@@ -121,9 +120,6 @@ namespace nexus {
     /// 3) Bear in mind that visualizing this geometry could take to a crash of OpenGL, because of its complexity. Don't worry, geant4 tracking is being done correctly.
     /// 4) The source that fits inside the tube with a screw is a piece of aluminum with a disk of 2 mm thickness, 6 mm diameter placed at 0.5 mm from the bottom of the piece
 
-    // Initializing the geometry navigator (used in vertex generation)
-    geom_navigator_ = G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
-
     /// Messenger
     msg_ = new G4GenericMessenger(this, "/Geometry/NextNew/", "Control commands of geometry NextNew.");
     msg_->DeclareProperty("vessel_vis", visibility_, "Vessel Visibility");
@@ -765,32 +761,13 @@ void NextNewVessel::Construct()
 
 
   //// VERTEX GENERATORS   //
-  body_gen_   = new CylinderPointSamplerLegacy(vessel_in_diam_/2., vessel_tube_length_, vessel_thickness_, 0.);
-  flange_gen_ = new CylinderPointSamplerLegacy(vessel_out_diam/2., flange_length_,
-					 flange_out_diam_/2.-vessel_out_diam/2., 0., G4ThreeVector(0.,0.,0.));
-  //trick to avoid vertex the vessel_gas-vessel interface -1*mm thickness
-  tracking_endcap_gen_ = new SpherePointSampler(endcap_in_rad_+1*mm, endcap_in_rad_+endcap_thickness_, 0., twopi, 0., endcap_theta_, tracking_endcap_pos, 0);
-  energy_endcap_gen_ =
-    new SpherePointSampler(endcap_in_rad_+1*mm, endcap_in_rad_+endcap_thickness_, 0., twopi, 180.*deg - endcap_theta_, endcap_theta_, energy_endcap_pos, 0);
-
-
-
-  /// Calculating some prob
-  G4double body_vol = vessel_tube_solid->GetCubicVolume() - vessel_gas_tube_solid->GetCubicVolume();
-  G4double flange_vol = vessel_flange_solid->GetCubicVolume();
-  G4double endcap_vol = vessel_tracking_endcap_solid->GetCubicVolume() - vessel_gas_tracking_endcap_solid->GetCubicVolume();
-  G4double vol_tot = body_vol+ 2*flange_vol+ 2*endcap_vol;
-
-  perc_tube_vol_ = body_vol/vol_tot;
-  perc_endcap_vol_ = endcap_vol /vol_tot;
+  // The steel of the vessel is the vessel solid minus the gas and the air of the ports
+  vessel_gen_ = new SolidPointSampler(vessel_logic);
   }
 
   NextNewVessel::~NextNewVessel()
   {
-    delete body_gen_;
-    delete flange_gen_;
-    delete tracking_endcap_gen_;
-    delete energy_endcap_gen_;
+    delete vessel_gen_;
     delete screw_gen_lat_;
     delete screw_gen_axial_;
   }
@@ -848,56 +825,7 @@ void NextNewVessel::Construct()
     G4ThreeVector vertex(0., 0., 0.);
     // Vertex in the VESSEL volume
     if (region == "VESSEL") {
-      G4double rand = G4UniformRand();
-      if (rand < perc_tube_vol_) { //VESSEL_TUBE
-	G4VPhysicalVolume *VertexVolume;
-	do {
-	  // std::cout<< "vessel tube \t"<< rand <<"\t"<< perc_tube_vol_ << std::endl;
-	  vertex = body_gen_->GenerateVertex("BODY_VOL");
-	  // To check its volume, one needs to rotate and shift the vertex
-	  // because the check is done using global coordinates
-	  G4ThreeVector glob_vtx(vertex);
-	  // First rotate, then shift
-	  glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
-	  glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-	  VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-	  // std::cout<<vertex<<std::endl;
-	} while (VertexVolume->GetName() != "VESSEL");
-      }
-      //Vertex in ENDCAPS
-      else if (rand < (perc_tube_vol_+2*perc_endcap_vol_)){
-	G4VPhysicalVolume *VertexVolume;
-	do {
-	  if (G4UniformRand() < 0.5){
-	    //std::cout<< "tracking endcap "<< rand <<"\t"<< perc_tube_vol_+2*perc_endcap_vol_<< std::endl;
-	    vertex = tracking_endcap_gen_->GenerateVertex(VOLUME);  // Tracking
-	  }
-	  else {
-	    //std::cout<< "energy endcap " << rand <<"\t"<< perc_tube_vol_+2*perc_endcap_vol_<< std::endl;
-	    vertex = energy_endcap_gen_->GenerateVertex(VOLUME);  // Energy endcap
-	  }
-	  // To check its volume, one needs to rotate and shift the vertex
-	  // because the check is done using global coordinates
-	  G4ThreeVector glob_vtx(vertex);
-	  // First rotate, then shift
-	  glob_vtx.rotate(pi, G4ThreeVector(0., 1., 0.));
-	  glob_vtx = glob_vtx + G4ThreeVector(0, 0, GetELzCoord());
-	  VertexVolume = geom_navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
-	  //std::cout<<vertex<<std::endl;
-	} while (VertexVolume->GetName() != "VESSEL");
-      }
-      else { //FLANGES
-   	if (G4UniformRand() < 0.5) {
-	  vertex = flange_gen_->GenerateVertex("BODY_VOL");
-	  vertex.setZ(vertex.z() + flange_z_pos_);
-	  //std::cout<< "flange tracking \t"<<vertex.z() <<"\t"<< rand << std::endl;
-    	}
-    	else {
-	  vertex = flange_gen_->GenerateVertex("BODY_VOL");
-    	  vertex.setZ(vertex.z() - flange_z_pos_);
-	  //std::cout<< "flange energy \t"<<vertex.z() <<"\t"<<rand<< std::endl;
-   	}
-      }
+      vertex = vessel_gen_->GenerateVertex(VOLUME);
     }
     /// Vertex inside lateral feedthrough, most internal position
     else if (region =="SOURCE_PORT_ANODE") {
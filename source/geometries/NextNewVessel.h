@@ -11,15 +11,14 @@
 
 #include "GeometryBase.h"
 
-#include <G4Navigator.hh>
-
 class G4GenericMessenger;
+class G4VPhysicalVolume;
 
 namespace nexus {
 
   class CalibrationSource;
   class CylinderPointSamplerLegacy;
-  class SpherePointSampler;
+  class SolidPointSampler;
 
   class NextNewVessel: public GeometryBase
   {
@@ -89,20 +88,11 @@ namespace nexus {
     G4VPhysicalVolume* internal_phys_vol_;
 
     // Vertex generators
-    CylinderPointSamplerLegacy* body_gen_;
-    SpherePointSampler*   tracking_endcap_gen_;
-    SpherePointSampler*   energy_endcap_gen_;
-    CylinderPointSamplerLegacy* flange_gen_;
+    SolidPointSampler* vessel_gen_;
     CylinderPointSamplerLegacy* screw_gen_lat_;
     CylinderPointSamplerLegacy* screw_gen_up_;
     CylinderPointSamplerLegacy* screw_gen_axial_;
 
-    G4double perc_endcap_vol_;
-    G4double perc_tube_vol_;
-
-    // Geometry Navigator
-    G4Navigator* geom_navigator_;
-
     // Messenger for the definition of control commands
     G4GenericMessenger* msg_;
 
@@ -104,6 +104,8 @@ void NextTonScale::Construct()
   mother_logic_vol = ConstructWaterTank(mother_logic_vol);
   mother_logic_vol = ConstructVesselAndICS(mother_logic_vol);
   mother_logic_vol = ConstructFieldCageAndReadout(mother_logic_vol);
+
+  RegisterVertexSamplers();
 }
 
 
@@ -406,46 +408,41 @@ G4LogicalVolume* NextTonScale::ConstructFieldCageAndReadout(G4LogicalVolume* mot
 }
 
 
+void NextTonScale::RegisterVertexSamplers()
+{
+  RegisterVertexSampler("AD_HOC", [this]() { return specific_vertex_; });
+  RegisterVertexSampler("ACTIVE", [this]() {
+    return active_gen_->GenerateVertex("BODY_VOL"); });
+  RegisterVertexSampler("FIELD_CAGE", [this]() {
+    return field_cage_gen_->GenerateVertex("BODY_VOL"); });
+  RegisterVertexSampler("CATHODE", [this]() {
+    return cathode_gen_->GenerateVertex("ENDCAP_VOL"); });
+  RegisterVertexSampler("READOUT_PLANE", [this]() {
+    return readout_plane_gen_->GenerateVertex("BODY_VOL"); });
+  RegisterVertexSampler("INNER_SHIELDING", [this]() {
+    return ics_gen_->GenerateVertex("WHOLE_VOL"); });
+  RegisterVertexSampler("OUTER_PLANE", [this]() {
+    return outer_plane_gen_->GenerateVertex("BODY_VOL"); });
+  RegisterVertexSampler("VESSEL", [this]() {
+    return vessel_gen_->GenerateVertex("WHOLE_VOL"); });
+  RegisterVertexSampler("MUONS", [this]() {
+    return muon_gen_->GenerateVertex("INSIDE"); });
+  RegisterVertexSampler("EXTERNAL", [this]() {
+    return external_gen_->GenerateVertex("WHOLE_VOL"); });
+}
+
+
 G4ThreeVector NextTonScale::GenerateVertex(const G4String& region) const
 {
-  G4ThreeVector vertex;
+  const VertexSampler* sampler = FindVertexSampler(region);
 
-  if (region == "AD_HOC") {
-    vertex = specific_vertex_;
-  }
-  else if (region == "ACTIVE") {
-    vertex = active_gen_->GenerateVertex("BODY_VOL");
-  }
-  else if (region == "FIELD_CAGE") {
-    vertex = field_cage_gen_->GenerateVertex("BODY_VOL");
-  }
-  else if (region == "CATHODE") {
-    vertex = cathode_gen_->GenerateVertex("ENDCAP_VOL");
-  }
-  else if (region == "READOUT_PLANE") {
-    vertex = readout_plane_gen_->GenerateVertex("BODY_VOL");
-  }
-  else if (region == "INNER_SHIELDING") {
-    vertex = ics_gen_->GenerateVertex("WHOLE_VOL");
-  }
-  else if (region == "OUTER_PLANE") {
-    vertex = outer_plane_gen_->GenerateVertex("BODY_VOL");
-  }
-  else if (region == "VESSEL") {
-    vertex = vessel_gen_->GenerateVertex("WHOLE_VOL");
-  }
-  else if (region == "MUONS") {
-    vertex = muon_gen_->GenerateVertex("INSIDE");
-  }
-  else if (region == "EXTERNAL") {
-    vertex = external_gen_->GenerateVertex("WHOLE_VOL");
-  }
-  else {
+  if (!sampler) {
     G4cerr << "Unknown detector region " << region << "."
            << "Event generated by default at origin of coordinates." << G4endl;
+    return G4ThreeVector();
   }
 
-  return vertex;
+  return (*sampler)();
 }
 
 
@@ -41,6 +41,8 @@ namespace nexus {
     void DefineConfigurationParameters();
     //
     void DefineGas();
+    //
+    void RegisterVertexSamplers();
 
   private:
     G4GenericMessenger* msg_; // Messenger for configuration parameters
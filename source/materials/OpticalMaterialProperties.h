@@ -1,7 +1,9 @@
 // ----------------------------------------------------------------------------
 // nexus | OpticalMaterialProperties.h
 //
-// Optical properties of relevant materials.
+// Optical properties of relevant materials. Each table is built once for
+// a given set of parameters and shared by all callers, so the returned
+// tables must not be modified.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -0,0 +1,230 @@
+// ----------------------------------------------------------------------------
+// nexus | nexus-bench.cc
+//
+// This is the throughput benchmark program of nexus. It runs a simulation
+// in batch mode from a fixed-seed reference macro and writes a JSON file with
+// the initialization time, events/second, steps/second, peak resident memory
+// and output bytes/event, so that performance can be tracked across releases.
+// Optionally, it also measures the vertex generation rate in given regions
+// of the geometry, and the time taken to build the geometry with or
+// without a geometry cache.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "NexusApp.h"
+#include "PerformanceMonitor.h"
+#include "DetectorConstruction.h"
+#include "GeometryBase.h"
+#include "GeometryCache.h"
+
+#include <G4UImanager.hh>
+#include <G4Version.hh>
+
+#include <getopt.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+using namespace nexus;
+
+
+void PrintUsage()
+{
+  G4cerr  << "\nUsage: ./nexus-bench [-n number] [-o output] [-r region] [-g dir] <init_macro>\n" << G4endl;
+  G4cerr  << "Available options:" << G4endl;
+  G4cerr  << "   -n, --nevents         : Number of events to simulate\n"
+          << "   -o, --output          : Base name of the output files (.h5 and .json)\n"
+          << "   -r, --region          : Region where to measure the vertex generation rate (repeatable)\n"
+          << "   -s, --samples         : Number of vertices generated per region\n"
+          << "   -g, --geometry-cache  : Directory of the geometry cache"
+          << G4endl;
+  exit(EXIT_FAILURE);
+}
+
+
+G4double PeakRSS()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / (1024. * 1024.); // bytes
+#else
+  return usage.ru_maxrss / 1024.; // kilobytes
+#endif
+}
+
+
+G4int main(int argc, char** argv)
+{
+  ////////////////////////////////////////////////////////////////////
+  // PARSE COMMAND-LINE OPTIONS
+
+  if (argc < 2) PrintUsage();
+
+  G4int nevents = 100;
+  G4String output = "nexus_bench";
+  std::vector<G4String> regions;
+  G4int nsamples = 100000;
+  G4String geometry_cache = "";
+
+  static struct option long_options[] =
+  {
+    {"nevents", required_argument, 0, 'n'},
+    {"output",  required_argument, 0, 'o'},
+    {"region",  required_argument, 0, 'r'},
+    {"samples", required_argument, 0, 's'},
+    {"geometry-cache", required_argument, 0, 'g'},
+    {0, 0, 0, 0}
+  };
+
+  int c;
+
+  while (true) {
+
+    opterr = 0;
+    c = getopt_long(argc, argv, "n:o:r:s:g:", long_options, 0);
+
+    if (c==-1) break; // Exit if we are done reading options
+
+    switch (c) {
+
+      case 'n':
+        nevents = atoi(optarg);
+        break;
+
+      case 'o':
+        output = optarg;
+        break;
+
+      case 'r':
+        regions.push_back(optarg);
+        break;
+
+      case 's':
+        nsamples = atoi(optarg);
+        break;
+
+      case 'g':
+        geometry_cache = optarg;
+        break;
+
+      case '?':
+        break;
+
+      default:
+        abort();
+    }
+  }
+
+  if (optind == argc) PrintUsage();
+
+  G4String macro_filename = argv[optind];
+
+  if (macro_filename == "" || nevents <= 0 || nsamples <= 0) PrintUsage();
+
+  ////////////////////////////////////////////////////////////////////
+
+  // Steps and tracks are counted by the performance monitor,
+  // which must be enabled before the actions are set up.
+  PerformanceMonitor& perf = PerformanceMonitor::Instance();
+  perf.Enable(true);
+
+  auto init_start = std::chrono::steady_clock::now();
+
+  NexusApp* app = new NexusApp(macro_filename);
+
+  // The reference macros do not set the output file,
+  // so that the one chosen here is used
+  G4UImanager* UI = G4UImanager::GetUIpointer();
+  UI->ApplyCommand("/nexus/persistency/output_file " + output);
+  // Running twice with the same cache gives the construction
+  // time without and with the cached geometry quantities
+  if (!geometry_cache.empty())
+    UI->ApplyCommand("/nexus/geometry_cache " + geometry_cache);
+
+  app->Initialize();
+
+  auto run_start = std::chrono::steady_clock::now();
+  std::clock_t cpu_start = std::clock();
+
+  app->BeamOn(nevents);
+
+  auto run_end = std::chrono::steady_clock::now();
+  std::clock_t cpu_end = std::clock();
+
+  G4double peak_rss = PeakRSS();
+
+  // Vertex generation rate, measured once the geometry is closed.
+  // The first vertex is generated outside the timed loop, so that
+  // one-off initializations (e.g., acceptance maps) are not included.
+  std::vector<G4double> vertex_rates;
+  const DetectorConstruction* detector = static_cast<const DetectorConstruction*>
+    (app->GetUserDetectorConstruction());
+  const GeometryBase* geom = detector->GetGeometry();
+  for (const auto& region : regions) {
+    GeometryBase::VertexSampler sampler = geom->GetVertexSampler(region);
+    sampler();
+    auto vtx_start = std::chrono::steady_clock::now();
+    for (G4int i=0; i<nsamples; ++i) sampler();
+    auto vtx_end = std::chrono::steady_clock::now();
+    G4double vtx_time =
+      std::chrono::duration<G4double>(vtx_end - vtx_start).count();
+    vertex_rates.push_back(vtx_time > 0. ? nsamples / vtx_time : 0.);
+  }
+
+  G4double geometry_time = detector->GetConstructionTime();
+  const GeometryCache& cache = GeometryCache::Instance();
+
+  // The output file is only complete once closed
+  delete app;
+
+  G4double init_time =
+    std::chrono::duration<G4double>(run_start - init_start).count();
+  G4double wall_time =
+    std::chrono::duration<G4double>(run_end - run_start).count();
+  G4double cpu_time = G4double(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+
+  G4long events = perf.GetTotalEvents();
+
+  struct stat file_stat;
+  G4String h5file = output + ".h5";
+  G4long output_bytes = 0;
+  if (stat(h5file.c_str(), &file_stat) == 0) output_bytes = file_stat.st_size;
+
+  ////////////////////////////////////////////////////////////////////
+  // WRITE RESULTS
+
+  std::ofstream json(output + ".json");
+  json << "{\n"
+       << "  \"macro\": \"" << macro_filename << "\",\n"
+       << "  \"geant4_version\": " << G4VERSION_NUMBER << ",\n"
+       << "  \"events\": " << events << ",\n"
+       << "  \"tracks\": " << perf.GetTotalTracks() << ",\n"
+       << "  \"steps\": " << perf.GetTotalSteps() << ",\n"
+       << "  \"init_time_s\": " << init_time << ",\n"
+       << "  \"geometry_time_ms\": " << geometry_time << ",\n"
+       << "  \"geometry_cache_reads\": " << cache.GetNumberOfReads() << ",\n"
+       << "  \"geometry_cache_writes\": " << cache.GetNumberOfWrites() << ",\n"
+       << "  \"wall_time_s\": " << wall_time << ",\n"
+       << "  \"cpu_time_s\": " << cpu_time << ",\n"
+       << "  \"events_per_second\": " << (wall_time > 0. ? events / wall_time : 0.) << ",\n"
+       << "  \"steps_per_second\": " << (wall_time > 0. ? perf.GetTotalSteps() / wall_time : 0.) << ",\n"
+       << "  \"peak_rss_mb\": " << peak_rss << ",\n"
+       << "  \"output_bytes\": " << output_bytes << ",\n"
+       << "  \"output_bytes_per_event\": " << (events > 0 ? G4double(output_bytes) / events : 0.) << ",\n"
+       << "  \"vertices_per_second\": {";
+  for (size_t i=0; i<regions.size(); ++i)
+    json << (i ? "," : "") << "\n    \"" << regions[i] << "\": " << vertex_rates[i];
+  json << (regions.empty() ? "}\n" : "\n  }\n")
+       << "}\n";
+  json.close();
+
+  G4cout << "Benchmark results written to " << output << ".json" << G4endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+// ----------------------------------------------------------------------------
+// nexus | nexus-decay0-pool.cc
+//
+// This program pre-generates Xe136 double beta decay events with the C++
+// translation of DECAY0 and stores them in a binary pool file, which can
+// then be read by the Decay0Interface generator without paying the cost
+// of the generation at simulation time.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "Decay0Pool.h"
+#include "decay0.h"
+
+#include <G4Types.hh>
+#include <G4String.hh>
+#include <G4ios.hh>
+#include <Randomize.hh>
+
+#include <getopt.h>
+
+#include <vector>
+
+using namespace nexus;
+
+
+void PrintUsage()
+{
+  G4cerr << "\nUsage: ./nexus-decay0-pool -n number -o output [options]\n" << G4endl;
+  G4cerr << "Available options:" << G4endl;
+  G4cerr << "   -n, --nevents         : Number of events to generate\n"
+         << "   -o, --output          : Name of the output pool file\n"
+         << "   -m, --mode            : Xe136 decay mode (default: 1, bb0nu)\n"
+         << "   -f, --final-state     : Ba136 final state (default: 0)\n"
+         << "   -s, --seed            : Random seed\n"
+         << "   -d, --dump            : File where DECAY0 dumps the sampled spectrum\n"
+         << "   -c, --cache           : Directory where the sampling tables are cached (no cache by default)"
+         << G4endl;
+  exit(EXIT_FAILURE);
+}
+
+
+G4int main(int argc, char** argv)
+{
+  ////////////////////////////////////////////////////////////////////
+  // PARSE COMMAND-LINE OPTIONS
+
+  G4long nevents = 0;
+  G4String output = "";
+  G4int decay_mode = 1;
+  G4int final_state = 0;
+  G4long seed = -1;
+  G4String dump_file = "th-e1-spectrum.dat";
+  G4String cache_dir = "";
+
+  static struct option long_options[] =
+  {
+    {"nevents",     required_argument, 0, 'n'},
+    {"output",      required_argument, 0, 'o'},
+    {"mode",        required_argument, 0, 'm'},
+    {"final-state", required_argument, 0, 'f'},
+    {"seed",        required_argument, 0, 's'},
+    {"dump",        required_argument, 0, 'd'},
+    {"cache",       required_argument, 0, 'c'},
+    {0, 0, 0, 0}
+  };
+
+  int c;
+
+  while (true) {
+
+    opterr = 0;
+    c = getopt_long(argc, argv, "n:o:m:f:s:d:c:", long_options, 0);
+
+    if (c==-1) break; // Exit if we are done reading options
+
+    switch (c) {
+
+      case 'n':
+        nevents = atol(optarg);
+        break;
+
+      case 'o':
+        output = optarg;
+        break;
+
+      case 'm':
+        decay_mode = atoi(optarg);
+        break;
+
+      case 'f':
+        final_state = atoi(optarg);
+        break;
+
+      case 's':
+        seed = atol(optarg);
+        break;
+
+      case 'd':
+        dump_file = optarg;
+        break;
+
+      case 'c':
+        cache_dir = optarg;
+        break;
+
+      case '?':
+        break;
+
+      default:
+        abort();
+    }
+  }
+
+  if (nevents <= 0 || output == "") PrintUsage();
+
+  ////////////////////////////////////////////////////////////////////
+
+  if (seed >= 0) G4Random::setTheSeed(seed);
+
+  decay0 generator("Xe136", final_state, decay_mode, dump_file,
+                   0.0, 4.3, cache_dir);
+  Decay0PoolWriter writer(output, decay_mode, final_state);
+
+  std::vector<decay0Part> particles;
+
+  for (G4long i=0; i<nevents; i++) {
+    particles.clear();
+    generator.decay0DoIt(particles);
+    writer.Write(particles);
+  }
+
+  writer.Close();
+
+  G4cout << "Wrote " << nevents << " events to " << output << G4endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,9 @@
+// Microbenchmarks of the hot nexus utility kernels, built on Catch's
+// BENCHMARK blocks. Run ./nexus-microbench to get the timing of all of them.
+
+// Let Catch provide main():
+#define CATCH_CONFIG_MAIN
+
+#include <catch.hpp>
+
+// That's it
@@ -16,18 +16,23 @@
 #include <G4SteppingVerbose.hh>
 
 #include <getopt.h>
+#include <algorithm>
 
 using namespace nexus;
 
 
 void PrintUsage()
 {
-  G4cerr  << "\nUsage: ./nexus [-b|i] [-n number] <init_macro>\n" << G4endl;
+  G4cerr  << "\nUsage: ./nexus [-b|i] [-r] [-n number | -e first:count] <init_macro>\n" << G4endl;
   G4cerr  << "Available options:" << G4endl;
   G4cerr  << "   -b, --batch           : Run in batch mode (default)\n"
           << "   -i, --interactive     : Run in interactive mode\n"
           << "   -o, --overlap-check   : Turn warnings into exceptions and increase precision in overlap check\n"
           << "   -n, --nevents         : Number of events to simulate\n"
+          << "   -e, --events          : Range of global event ids to simulate (first:count),\n"
+          << "                           each event with its own random stream\n"
+          << "   -r, --resume          : Continue an interrupted job from the last checkpoint\n"
+          << "                           of its output file\n"
           << "   -p, --precision       : Number of significant figures in verbosity"
           << G4endl;
   exit(EXIT_FAILURE);
@@ -47,6 +52,9 @@ G4int main(int argc, char** argv)
   G4bool overlap_check = false;
   G4int nevents = 0;
   G4int precision = -1;
+  G4bool event_range = false;
+  G4long first_event = 0;
+  G4bool resume = false;
 
   static struct option long_options[] =
   {
@@ -55,6 +63,8 @@ G4int main(int argc, char** argv)
     {"overlaps",    no_argument,       0, 'o'},
     {"precision",   required_argument, 0, 'p'},
     {"nevents",     required_argument, 0, 'n'},
+    {"events",      required_argument, 0, 'e'},
+    {"resume",      no_argument,       0, 'r'},
     {0, 0, 0, 0}
   };
 
@@ -64,7 +74,7 @@ G4int main(int argc, char** argv)
 
     //  int option_index = 0;
     opterr = 0;
-    c = getopt_long(argc, argv, "biop:n:", long_options, 0);
+    c = getopt_long(argc, argv, "biorp:n:e:", long_options, 0);
 
     if (c==-1) break; // Exit if we are done reading options
 
@@ -82,6 +92,10 @@ G4int main(int argc, char** argv)
         overlap_check = true;
         break;
 
+      case 'r':
+        resume = true;
+        break;
+
       case 'p':
         precision = atoi(optarg);
         break;
@@ -90,6 +104,16 @@ G4int main(int argc, char** argv)
         nevents = atoi(optarg);
         break;
 
+      case 'e': {
+        G4String range = optarg;
+        size_t colon = range.find(':');
+        if (colon == std::string::npos) PrintUsage();
+        first_event = atol(range.substr(0, colon).c_str());
+        nevents     = atoi(range.substr(colon+1).c_str());
+        event_range = true;
+        break;
+      }
+
       case '?':
         break;
 
@@ -121,8 +145,16 @@ G4int main(int argc, char** argv)
   }
 
   NexusApp* app = new NexusApp(macro_filename);
+  app->SetResume(resume);
   app->Initialize();
 
+  // Events processed before the job was interrupted are not simulated again
+  G4long resumed_events = app->GetNumberOfResumedEvents();
+  nevents = std::max<G4long>(nevents - resumed_events, 0);
+
+  // Set after the configuration macros, so that they do not override it
+  if (event_range) app->SetFirstEvent(first_event + resumed_events);
+
   G4UImanager* UI = G4UImanager::GetUIpointer();
 
   if (overlap_check) {
@@ -0,0 +1,64 @@
+// ----------------------------------------------------------------------------
+// nexus | EventView.cc
+//
+// Read-only view of a simulated event for the persistency managers. It
+// points to the hits and trajectories kept by Geant4 for the event, which
+// are not copied, and is only valid while the event is being stored.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "EventView.h"
+#include "IonizationHit.h"
+#include "SensorHit.h"
+
+#include <G4Event.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4TrajectoryContainer.hh>
+
+
+namespace nexus {
+
+  EventView::EventView(): event_id_(-1)
+  {
+  }
+
+
+
+  void EventView::Fill(const G4Event* event)
+  {
+    event_id_ = event->GetEventID();
+
+    // The vectors keep their capacity from one event to the next
+    ionization_.clear();
+    sensors_.clear();
+    trajectories_ = Span<const G4VTrajectory*>();
+
+    G4TrajectoryContainer* tc = event->GetTrajectoryContainer();
+    if (tc) {
+      TrajectoryVector* trajectories = tc->GetVector();
+      trajectories_ = Span<const G4VTrajectory*>(trajectories->data(),
+                                                 trajectories->size());
+    }
+
+    G4HCofThisEvent* hce = event->GetHCofThisEvent();
+    if (!hce) return;
+
+    for (G4int i=0; i<hce->GetNumberOfCollections(); i++) {
+      G4VHitsCollection* hc = hce->GetHC(i);
+      if (!hc) continue;
+
+      if (auto hits = dynamic_cast<IonizationHitsCollection*>(hc)) {
+        std::vector<IonizationHit*>* vector = hits->GetVector();
+        ionization_.push_back({hits->GetSDname(),
+              Span<const IonizationHit*>(vector->data(), vector->size())});
+      }
+      else if (auto hits = dynamic_cast<SensorHitsCollection*>(hc)) {
+        std::vector<SensorHit*>* vector = hits->GetVector();
+        sensors_.push_back({hits->GetSDname(),
+              Span<const SensorHit*>(vector->data(), vector->size())});
+      }
+    }
+  }
+
+} // end namespace nexus
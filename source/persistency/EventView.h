@@ -0,0 +1,101 @@
+// ----------------------------------------------------------------------------
+// nexus | EventView.h
+//
+// Read-only view of a simulated event for the persistency managers. It
+// points to the hits and trajectories kept by Geant4 for the event, which
+// are not copied, and is only valid while the event is being stored.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef EVENT_VIEW_H
+#define EVENT_VIEW_H
+
+#include <G4String.hh>
+
+#include <cstddef>
+#include <vector>
+
+class G4Event;
+class G4VTrajectory;
+
+
+namespace nexus {
+
+  class IonizationHit;
+  class SensorHit;
+
+  /// Contiguous range of elements owned by someone else
+  template <typename T>
+  class Span
+  {
+  public:
+    Span(): data_(nullptr), size_(0) {}
+    Span(const T* data, size_t size): data_(data), size_(size) {}
+
+    const T* begin() const { return data_; }
+    const T* end() const { return data_ + size_; }
+    const T& operator[](size_t i) const { return data_[i]; }
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+  private:
+    const T* data_;
+    size_t size_;
+  };
+
+
+  class EventView
+  {
+  public:
+    /// Hits of a sensitive detector
+    template <typename Hit>
+    struct Collection
+    {
+      G4String sd_name;
+      Span<const Hit*> hits;
+    };
+
+    /// Constructor
+    EventView();
+
+    /// Points the view to the hits and trajectories of an event
+    void Fill(const G4Event*);
+
+    G4int GetEventID() const;
+
+    /// Collections of ionization hits, one per sensitive detector
+    const std::vector<Collection<IonizationHit>>& GetIonizationHits() const;
+    /// Collections of sensor hits, one per sensitive detector. The
+    /// histogram of photons of each sensor is read from its hit.
+    const std::vector<Collection<SensorHit>>& GetSensorHits() const;
+    /// Trajectories of the particles of the event, if they were stored
+    Span<const G4VTrajectory*> GetTrajectories() const;
+
+  private:
+    G4int event_id_;
+    std::vector<Collection<IonizationHit>> ionization_;
+    std::vector<Collection<SensorHit>> sensors_;
+    Span<const G4VTrajectory*> trajectories_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4int EventView::GetEventID() const
+  { return event_id_; }
+
+  inline const std::vector<EventView::Collection<IonizationHit>>&
+  EventView::GetIonizationHits() const
+  { return ionization_; }
+
+  inline const std::vector<EventView::Collection<SensorHit>>&
+  EventView::GetSensorHits() const
+  { return sensors_; }
+
+  inline Span<const G4VTrajectory*> EventView::GetTrajectories() const
+  { return trajectories_; }
+
+} // end namespace nexus
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "HDF5Writer.h"
 
+#include <fstream>
 #include <sstream>
 #include <cstring>
 #include <stdlib.h>
@@ -20,8 +21,9 @@ using namespace nexus;
 
 
 HDF5Writer::HDF5Writer():
-  file_(0), irun_(0), ismp_(0), ihit_(0),
-  ipart_(0), ipos_(0), istep_(0), istrmap_(0)
+  file_(0), checkpointTables_{0, 0}, checkpointGeneration_(0), irun_(0), ismp_(0), idigit_(0), ihit_(0),
+  ipart_(0), ipos_(0), istep_(0), istrmap_(0),
+  iperf_(0), iperfpart_(0)
 {
 }
 
@@ -29,51 +31,185 @@ HDF5Writer::~HDF5Writer()
 {
 }
 
-void HDF5Writer::Open(std::string fileName, bool debug, bool save_str)
+void HDF5Writer::Open(std::string fileName, bool debug, bool save_str, bool perf,
+                      bool digits)
 {
   firstEvent_= true;
+  checkpointGeneration_ = 0;
 
   file_ = H5Fcreate( fileName.c_str(), H5F_ACC_TRUNC,
                       H5P_DEFAULT, H5P_DEFAULT );
 
+  CreateTables(debug, save_str, perf, digits);
+
+  isOpen_ = true;
+}
+
+bool HDF5Writer::Resume(std::string fileName, bool debug, bool save_str, bool perf,
+                        bool digits, std::map<std::string, std::string>& checkpoint)
+{
+  checkpoint.clear();
+
+  if (!std::ifstream(fileName).good()) return false;
+
+  hid_t file = H5Fopen(fileName.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  if (file < 0) return false;
+
+  if (H5Lexists(file, "/MC", H5P_DEFAULT) <= 0 ||
+      (H5Lexists(file, "/MC/checkpoint_0", H5P_DEFAULT) <= 0 &&
+       H5Lexists(file, "/MC/checkpoint_1", H5P_DEFAULT) <= 0)) {
+    H5Fclose(file);
+    return false;
+  }
+
+  firstEvent_ = false;
+  file_ = file;
+
+  // Tables missing from the file, e.g. because the debug output
+  // was not enabled before, are created empty
+  CreateTables(debug, save_str, perf, digits);
+
+  // The newest checkpoint is taken, unless the job
+  // was stopped before it was complete
+  std::map<std::string, std::string> entries[2];
+  int64_t generation[2];
+  for (int i=0; i<2; ++i)
+    generation[i] = ReadCheckpoint(checkpointTables_[i], entries[i]);
+
+  int newest = (generation[1] > generation[0]) ? 1 : 0;
+  if (generation[newest] < 0) {
+    H5Fclose(file_);
+    file_ = 0;
+    return false;
+  }
+  checkpoint = entries[newest];
+  checkpointGeneration_ = generation[newest];
+
+  // Anything written after the checkpoint belongs to events
+  // that will be simulated again
+  RestoreTable(runTable_, "configuration", irun_, checkpoint);
+  RestoreTable(snsDataTable_, "sns_response", ismp_, checkpoint);
+  if (digits_)
+    RestoreTable(snsDigitTable_, "sns_digits", idigit_, checkpoint);
+  RestoreTable(hitInfoTable_, "hits", ihit_, checkpoint);
+  RestoreTable(particleInfoTable_, "particles", ipart_, checkpoint);
+  RestoreTable(snsPosTable_, "sns_positions", ipos_, checkpoint);
+  if (debug_)
+    RestoreTable(stepTable_, "steps", istep_, checkpoint);
+  if (!saveStr_)
+    RestoreTable(stringMapTable_, "string_map", istrmap_, checkpoint);
+  if (perf_) {
+    RestoreTable(perfTable_, "performance", iperf_, checkpoint);
+    RestoreTable(perfParticleTable_, "performance_particles", iperfpart_, checkpoint);
+  }
+
+  isOpen_ = true;
+  return true;
+}
+
+void HDF5Writer::CreateTables(bool debug, bool save_str, bool perf, bool digits)
+{
+  debug_   = debug;
+  saveStr_ = save_str;
+  perf_    = perf;
+  digits_  = digits;
+
   std::string group_name = "/MC";
-  size_t group = createGroup(file_, group_name);
+  group_ = openOrCreateGroup(file_, group_name);
 
   std::string run_table_name = "configuration";
   memtypeRun_ = createRunType();
-  runTable_ = createTable(group, run_table_name, memtypeRun_);
+  runTable_ = openOrCreateTable(group_, run_table_name, memtypeRun_);
 
   std::string sns_data_table_name = "sns_response";
   memtypeSnsData_ = createSensorDataType();
-  snsDataTable_ = createTable(group, sns_data_table_name, memtypeSnsData_);
+  snsDataTable_ = openOrCreateTable(group_, sns_data_table_name, memtypeSnsData_);
+
+  if (digits) {
+    std::string sns_digit_table_name = "sns_digits";
+    memtypeSnsDigit_ = createSensorDigitType();
+    snsDigitTable_ = openOrCreateTable(group_, sns_digit_table_name, memtypeSnsDigit_);
+  }
 
   std::string hit_info_table_name = "hits";
   memtypeHitInfo_ = createHitInfoType(save_str);
-  hitInfoTable_ = createTable(group, hit_info_table_name, memtypeHitInfo_);
+  hitInfoTable_ = openOrCreateTable(group_, hit_info_table_name, memtypeHitInfo_);
 
   std::string particle_info_table_name = "particles";
   memtypeParticleInfo_ = createParticleInfoType(save_str);
-  particleInfoTable_ = createTable(group, particle_info_table_name, memtypeParticleInfo_);
+  particleInfoTable_ = openOrCreateTable(group_, particle_info_table_name, memtypeParticleInfo_);
 
   std::string sns_pos_table_name = "sns_positions";
   memtypeSnsPos_ = createSensorPosType();
-  snsPosTable_ = createTable(group, sns_pos_table_name, memtypeSnsPos_);
+  snsPosTable_ = openOrCreateTable(group_, sns_pos_table_name, memtypeSnsPos_);
 
   if (!save_str) {
     std::string str_map_table_name = "string_map";
     memtypeStringMap_ = createStringMapType();
-    stringMapTable_ = createTable(group, str_map_table_name, memtypeStringMap_);
+    stringMapTable_ = openOrCreateTable(group_, str_map_table_name, memtypeStringMap_);
+  }
+
+  if (perf) {
+    std::string perf_table_name = "performance";
+    memtypePerf_ = createPerformanceType();
+    perfTable_ = openOrCreateTable(group_, perf_table_name, memtypePerf_);
+
+    std::string perf_particle_table_name = "performance_particles";
+    memtypePerfParticle_ = createPerformanceParticleType();
+    perfParticleTable_ = openOrCreateTable(group_, perf_particle_table_name, memtypePerfParticle_);
   }
 
   if (debug) {
     std::string debug_group_name = "/DEBUG";
-    size_t debug_group = createGroup(file_, debug_group_name);
+    size_t debug_group = openOrCreateGroup(file_, debug_group_name);
     std::string step_table_name = "steps";
     memtypeStep_ = createStepType();
-    stepTable_   = createTable(debug_group, step_table_name, memtypeStep_);
+    stepTable_   = openOrCreateTable(debug_group, step_table_name, memtypeStep_);
   }
 
-  isOpen_ = true;
+  // The checkpoint tables are only created by the first checkpoints
+  for (int i=0; i<2; ++i) {
+    std::string checkpoint_table_name = "checkpoint_" + std::to_string(i);
+    checkpointTables_[i] = 0;
+    if (H5Lexists(group_, checkpoint_table_name.c_str(), H5P_DEFAULT) > 0)
+      checkpointTables_[i] = H5Dopen2(group_, checkpoint_table_name.c_str(), H5P_DEFAULT);
+  }
+}
+
+int64_t HDF5Writer::ReadCheckpoint(size_t table,
+                                   std::map<std::string, std::string>& checkpoint)
+{
+  checkpoint.clear();
+  if (!table) return -1;
+
+  std::vector<run_info_t> rows(getTableSize(table));
+  readTable(rows.data(), table, memtypeRun_);
+
+  // The first row holds the generation of the checkpoint, which is
+  // complete once a row closes it with the same generation. Rows
+  // left over from an older, longer checkpoint may follow.
+  if (rows.empty() || std::string(rows[0].param_key) != "generation")
+    return -1;
+  std::string generation = rows[0].param_value;
+
+  for (size_t i=1; i<rows.size(); ++i) {
+    if (std::string(rows[i].param_key) == "complete")
+      return (generation == rows[i].param_value) ? std::stoll(generation) : -1;
+
+    // Rows with the same key are pieces of a single value
+    checkpoint[rows[i].param_key] += rows[i].param_value;
+  }
+
+  checkpoint.clear();
+  return -1;
+}
+
+void HDF5Writer::RestoreTable(size_t table, const std::string& name, size_t& counter,
+                              const std::map<std::string, std::string>& checkpoint)
+{
+  auto it = checkpoint.find("rows_" + name);
+  counter = (it == checkpoint.end()) ? 0 : std::stoul(it->second);
+  resizeTable(table, counter);
 }
 
 void HDF5Writer::Close()
@@ -82,6 +218,93 @@ void HDF5Writer::Close()
   H5Fclose(file_);
 }
 
+int64_t HDF5Writer::GetFileSize() const
+{
+  hsize_t size = 0;
+  H5Fget_filesize(file_, &size);
+  return size;
+}
+
+void HDF5Writer::WriteCheckpoint(const std::vector<std::pair<std::string, std::string>>& entries)
+{
+  // The previous checkpoint is left untouched in the other table
+  checkpointGeneration_++;
+  size_t& table = checkpointTables_[checkpointGeneration_ % 2];
+  if (!table) {
+    std::string checkpoint_table_name = "checkpoint_" + std::to_string(checkpointGeneration_ % 2);
+    table = createTable(group_, checkpoint_table_name, memtypeRun_);
+  }
+
+  std::vector<std::pair<std::string, std::string>> rows;
+  rows.emplace_back("generation", std::to_string(checkpointGeneration_));
+  rows.insert(rows.end(), entries.begin(), entries.end());
+  rows.emplace_back("rows_configuration", std::to_string(irun_));
+  rows.emplace_back("rows_sns_response", std::to_string(ismp_));
+  if (digits_)
+    rows.emplace_back("rows_sns_digits", std::to_string(idigit_));
+  rows.emplace_back("rows_hits", std::to_string(ihit_));
+  rows.emplace_back("rows_particles", std::to_string(ipart_));
+  rows.emplace_back("rows_sns_positions", std::to_string(ipos_));
+  if (debug_)
+    rows.emplace_back("rows_steps", std::to_string(istep_));
+  if (!saveStr_)
+    rows.emplace_back("rows_string_map", std::to_string(istrmap_));
+  if (perf_) {
+    rows.emplace_back("rows_performance", std::to_string(iperf_));
+    rows.emplace_back("rows_performance_particles", std::to_string(iperfpart_));
+  }
+
+  size_t irow = 0;
+  auto write = [&](const std::string& key, const std::string& value) {
+    size_t pos = 0;
+    do {
+      run_info_t row;
+      memset(row.param_key,   0, CONFLEN);
+      memset(row.param_value, 0, CONFLEN);
+      strncpy(row.param_key, key.c_str(), CONFLEN-1);
+      strcpy(row.param_value, value.substr(pos, CONFLEN-1).c_str());
+      writeRun(&row, table, memtypeRun_, irow);
+      irow++;
+      pos += CONFLEN-1;
+    } while (pos < value.size());
+  };
+
+  for (const auto& entry : rows)
+    write(entry.first, entry.second);
+
+  // The events and the entries are on disk before the checkpoint
+  // is marked as complete
+  H5Fflush(file_, H5F_SCOPE_GLOBAL);
+  write("complete", std::to_string(checkpointGeneration_));
+
+  // Drop the rows left over from a longer previous checkpoint
+  resizeTable(table, irow);
+
+  H5Fflush(file_, H5F_SCOPE_GLOBAL);
+}
+
+void HDF5Writer::ReadSensorIDs(std::vector<int>& sensor_ids)
+{
+  std::vector<sns_pos_t> rows(ipos_);
+  readTable(rows.data(), snsPosTable_, memtypeSnsPos_);
+
+  sensor_ids.clear();
+  for (const auto& row : rows)
+    sensor_ids.push_back(row.sensor_id);
+}
+
+void HDF5Writer::ReadStringMap(std::vector<std::pair<std::string, int>>& str_map)
+{
+  str_map.clear();
+  if (saveStr_) return;
+
+  std::vector<string_map_t> rows(istrmap_);
+  readTable(rows.data(), stringMapTable_, memtypeStringMap_);
+
+  for (const auto& row : rows)
+    str_map.emplace_back(row.name, row.name_id);
+}
+
 void HDF5Writer::WriteRunInfo(const char* param_key, const char* param_value)
 {
   run_info_t runData;
@@ -107,7 +330,19 @@ void HDF5Writer::WriteSensorDataInfo(int64_t evt_number, unsigned int sensor_id,
   ismp_++;
 }
 
-void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label_str, int label)
+void HDF5Writer::WriteSensorDigitInfo(int64_t evt_number, unsigned int sensor_id, int64_t time_bin, float charge)
+{
+  sns_digit_t snsDigit;
+  snsDigit.event_id = evt_number;
+  snsDigit.sensor_id = sensor_id;
+  snsDigit.time_bin = time_bin;
+  snsDigit.charge = charge;
+  writeSnsDigit(&snsDigit, snsDigitTable_, memtypeSnsDigit_, idigit_);
+
+  idigit_++;
+}
+
+void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, float weight, const char* label_str, int label)
 {
   hit_info_t trueInfo;
   trueInfo.event_id = evt_number;
@@ -116,6 +351,7 @@ void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, i
   trueInfo.z = hit_position_z;
   trueInfo.time = hit_time;
   trueInfo.energy = hit_energy;
+  trueInfo.weight = weight;
   if (str) {
     memset(trueInfo.label_str, 0, STRLEN);
     strcpy(trueInfo.label_str, label_str);
@@ -129,7 +365,7 @@ void HDF5Writer::WriteHitInfo(bool str, int64_t evt_number, int particle_indx, i
   ihit_++;
 }
 
-void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc)
+void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc, float weight)
 {
   particle_info_t trueInfo;
   trueInfo.event_id = evt_number;
@@ -176,6 +412,7 @@ void HDF5Writer::WriteParticleInfo(bool str, int64_t evt_number, int particle_in
     trueInfo.creator_proc = creator_proc;
     trueInfo.final_proc = final_proc;
   }
+  trueInfo.weight = weight;
   writeParticle(&trueInfo,  particleInfoTable_, memtypeParticleInfo_, ipart_);
 
   ipart_++;
@@ -240,3 +477,40 @@ void HDF5Writer::WriteStringMapInfo(const char* name, int name_id)
   writeStringMap(&strmap, stringMapTable_, memtypeStringMap_, istrmap_);
   istrmap_++;
 }
+
+void HDF5Writer::WritePerformanceInfo(int64_t evt_number,
+                                      float wall_tracking, float cpu_tracking,
+                                      float wall_drift,    float cpu_drift,
+                                      float wall_optical,  float cpu_optical,
+                                      int64_t clustering_secondaries,
+                                      int64_t el_secondaries, float peak_rss)
+{
+  performance_t perf;
+  perf.event_id               = evt_number;
+  perf.wall_time_tracking     = wall_tracking;
+  perf.cpu_time_tracking      = cpu_tracking;
+  perf.wall_time_drift        = wall_drift;
+  perf.cpu_time_drift         = cpu_drift;
+  perf.wall_time_optical      = wall_optical;
+  perf.cpu_time_optical       = cpu_optical;
+  perf.clustering_secondaries = clustering_secondaries;
+  perf.el_secondaries         = el_secondaries;
+  perf.peak_rss               = peak_rss;
+
+  writePerformance(&perf, perfTable_, memtypePerf_, iperf_);
+  iperf_++;
+}
+
+void HDF5Writer::WritePerformanceParticleInfo(int64_t evt_number, const char* particle_name,
+                                              int64_t tracks, int64_t steps)
+{
+  performance_particle_t perf;
+  perf.event_id = evt_number;
+  memset(perf.particle_name, 0, STRLEN);
+  strcpy(perf.particle_name, particle_name);
+  perf.tracks = tracks;
+  perf.steps  = steps;
+
+  writePerformanceParticle(&perf, perfParticleTable_, memtypePerfParticle_, iperfpart_);
+  iperfpart_++;
+}
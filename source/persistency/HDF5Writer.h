@@ -13,6 +13,10 @@
 
 #include <hdf5.h>
 #include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace nexus {
 
@@ -25,15 +29,37 @@ namespace nexus {
     ~HDF5Writer();
 
     /// open file
-    void Open(std::string filename, bool debug, bool save_str);
+    void Open(std::string filename, bool debug, bool save_str, bool perf=false,
+              bool digits=false);
+
+    /// Reopen the file of an interrupted job for appending. The tables
+    /// are cut back to their size at the last complete checkpoint, whose
+    /// entries are returned. Returns false if the file holds none.
+    bool Resume(std::string filename, bool debug, bool save_str, bool perf,
+                bool digits, std::map<std::string, std::string>& checkpoint);
 
     /// close file
     void Close();
 
+    /// Size of the file written so far, in bytes
+    int64_t GetFileSize() const;
+
+    /// Save a checkpoint of the job with the given entries, together
+    /// with the current size of each table, and flush the file to disk.
+    /// Values longer than a table cell are split over consecutive rows.
+    /// Checkpoints go alternately to two tables, so that the previous
+    /// one is still whole if the job is stopped while writing.
+    void WriteCheckpoint(const std::vector<std::pair<std::string, std::string>>& entries);
+
+    /// Read back the sensor ids and the string map written so far
+    void ReadSensorIDs(std::vector<int>& sensor_ids);
+    void ReadStringMap(std::vector<std::pair<std::string, int>>& str_map);
+
     void WriteRunInfo(const char* param_key, const char* param_value);
     void WriteSensorDataInfo(int64_t evt_number, unsigned int sensor_id, unsigned int time_bin, unsigned int charge);
-    void WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, const char* label_str, int label);
-    void WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc);
+    void WriteSensorDigitInfo(int64_t evt_number, unsigned int sensor_id, int64_t time_bin, float charge);
+    void WriteHitInfo(bool str, int64_t evt_number, int particle_indx, int hit_indx, float hit_position_x, float hit_position_y, float hit_position_z, float hit_time, float hit_energy, float weight, const char* label_str, int label);
+    void WriteParticleInfo(bool str, int64_t evt_number, int particle_indx, const char* particle_name_str, int particle_name, char primary, int mother_id, float initial_vertex_x, float initial_vertex_y, float initial_vertex_z, float initial_vertex_t, float final_vertex_x, float final_vertex_y, float final_vertex_z, float final_vertex_t, const char* initial_volume_str, const char* final_volume_str, int initial_volume, int final_volume, float ini_momentum_x, float ini_momentum_y, float ini_momentum_z, float final_momentum_x, float final_momentum_y, float final_momentum_z, float kin_energy, float length, const char* creator_proc_str, const char* final_proc_str, int creator_proc, int final_proc, float weight);
     void WriteSensorPosInfo(unsigned int sensor_id, const char* sensor_name, float x, float y, float z);
     void WriteStep(int64_t evt_number,
                    int particle_id, const char* particle_name,
@@ -45,37 +71,69 @@ namespace nexus {
                    float   final_x, float   final_y, float   final_z,
                    float time);
     void WriteStringMapInfo(const char* name, int name_id);
+    void WritePerformanceInfo(int64_t evt_number,
+                              float wall_tracking, float cpu_tracking,
+                              float wall_drift,    float cpu_drift,
+                              float wall_optical,  float cpu_optical,
+                              int64_t clustering_secondaries,
+                              int64_t el_secondaries, float peak_rss);
+    void WritePerformanceParticleInfo(int64_t evt_number, const char* particle_name,
+                                      int64_t tracks, int64_t steps);
+
+  private:
+    void CreateTables(bool debug, bool save_str, bool perf, bool digits);
+    void RestoreTable(size_t table, const std::string& name, size_t& counter,
+                      const std::map<std::string, std::string>& checkpoint);
+    /// Entries of the checkpoint in a table and its generation,
+    /// or -1 if the table holds no complete checkpoint
+    int64_t ReadCheckpoint(size_t table, std::map<std::string, std::string>& checkpoint);
 
   private:
     size_t file_; ///< HDF5 file
+    size_t group_; ///< MC group
 
     bool isOpen_;
     bool firstEvent_; ///< First event
+    bool debug_;
+    bool saveStr_;
+    bool perf_;
+    bool digits_;
 
     //Datasets
     size_t runTable_;
     size_t snsDataTable_;
+    size_t snsDigitTable_;
     size_t hitInfoTable_;
     size_t particleInfoTable_;
     size_t snsPosTable_;
     size_t stepTable_;
     size_t stringMapTable_;
+    size_t perfTable_;
+    size_t perfParticleTable_;
+    size_t checkpointTables_[2];
+    int64_t checkpointGeneration_; ///< number of the last checkpoint
 
     size_t memtypeRun_;
     size_t memtypeSnsData_;
+    size_t memtypeSnsDigit_;
     size_t memtypeHitInfo_;
     size_t memtypeParticleInfo_;
     size_t memtypeSnsPos_;
     size_t memtypeStep_;
     size_t memtypeStringMap_;
+    size_t memtypePerf_;
+    size_t memtypePerfParticle_;
 
     size_t irun_; ///< counter for configuration parameters
     size_t ismp_; ///< counter for written waveform samples
+    size_t idigit_; ///< counter for written digitized samples
     size_t ihit_; ///< counter for true information
     size_t ipart_; ///< counter for particle information
     size_t ipos_; ///< counter for sensor positions
     size_t istep_; ///< counter for steps
     size_t istrmap_;  ///< counter for string map
+    size_t iperf_; ///< counter for performance records
+    size_t iperfpart_; ///< counter for per-particle performance records
 
   };
 
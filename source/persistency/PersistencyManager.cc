@@ -13,6 +13,7 @@
 #include "TrajectoryMap.h"
 #include "IonizationSD.h"
 #include "SensorSD.h"
+#include "SensorDigitizer.h"
 #include "NexusApp.h"
 #include "DetectorConstruction.h"
 #include "SaveAllSteppingAction.h"
@@ -20,6 +21,9 @@
 #include "HDF5Writer.h"
 #include "PersistencyManagerBase.h"
 #include "FactoryBase.h"
+#include "PerformanceMonitor.h"
+#include "PrimaryGeneration.h"
+#include "ResumableGenerator.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4Event.hh>
@@ -29,15 +33,35 @@
 #include <G4HCtable.hh>
 #include <G4RunManager.hh>
 #include <G4Run.hh>
+#include <G4ParticleDefinition.hh>
+#include <Randomize.hh>
 
+#include <algorithm>
+#include <set>
 #include <string>
 #include <sstream>
 #include <iostream>
+#include <iomanip>
 #include <string>
 
 using namespace nexus;
 
 
+namespace {
+
+  /// Primary generator of the job if its state has to be kept in the
+  /// checkpoints, null otherwise
+  ResumableGenerator* GetResumableGenerator()
+  {
+    PrimaryGeneration* pg = (PrimaryGeneration*)
+      G4RunManager::GetRunManager()->GetUserPrimaryGeneratorAction();
+    if (!pg) return nullptr;
+    return dynamic_cast<ResumableGenerator*>(pg->GetGenerator());
+  }
+
+}
+
+
 REGISTER_CLASS(PersistencyManager, PersistencyManagerBase)
 
 
@@ -46,8 +70,12 @@ PersistencyManagerBase(), msg_(0), output_file_("nexus_out"), ready_(false),
   store_evt_(true), store_steps_(false),
   interacting_evt_(false), save_ie_numb_(false), event_type_("other"),
   saved_evts_(0), interacting_evts_(0), pmt_bin_size_(-1), sipm_bin_size_(-1),
-  nevt_(0), start_id_(0), first_evt_(true), h5writer_(0),
-  str_counter_(0), save_str_(true), particles_(true)
+  nevt_(0), start_id_(0), first_evt_(true),
+  processed_evts_(0), resumed_evts_(0), checkpoint_interval_(0),
+  max_file_evts_(0), max_file_size_(0.), file_index_(0),
+  file_processed_evts_(0), file_saved_evts_(0), file_interacting_evts_(0),
+  file_finished_(false), h5writer_(0), digitizer_(0),
+  str_counter_(0), str_stored_(0), save_str_(true), particles_(true)
 {
   msg_ = new G4GenericMessenger(this, "/nexus/persistency/");
   msg_->DeclareProperty("output_file", output_file_, "Path of output file.");
@@ -59,6 +87,16 @@ PersistencyManagerBase(), msg_(0), output_file_("nexus_out"), ready_(false),
                         "True if volume, process... names are saved as strings.");
   msg_->DeclareProperty("save_particles", particles_,
                         "True if particles table is saved.");
+  msg_->DeclareProperty("checkpoint_interval", checkpoint_interval_,
+                        "Number of events between checkpoints of the job (0 to disable).");
+  msg_->DeclareProperty("max_file_events", max_file_evts_,
+                        "Number of saved events after which the output goes on "
+                        "in a new numbered file (0 for no limit).");
+  msg_->DeclareProperty("max_file_size", max_file_size_,
+                        "Size in MB after which the output goes on "
+                        "in a new numbered file (0 for no limit).");
+
+  digitizer_ = new SensorDigitizer();
 
   init_macro_ = "";
   macros_.clear();
@@ -72,6 +110,7 @@ PersistencyManager::~PersistencyManager()
 {
   delete msg_;
   delete h5writer_;
+  delete digitizer_;
 }
 
 
@@ -81,8 +120,10 @@ void PersistencyManager::OpenFile()
   // If the output file was not set yet, do so
   if (!h5writer_) {
     h5writer_ = new HDF5Writer();
-    G4String hdf5file = output_file_ + ".h5";
-    h5writer_->Open(hdf5file, store_steps_, save_str_);
+    G4String hdf5file = FileName(file_index_);
+    h5writer_->Open(hdf5file, store_steps_, save_str_,
+                    PerformanceMonitor::Instance().IsEnabled(),
+                    digitizer_->GetOutput() != SensorDigitizer::NONE);
     return;
   } else {
     G4Exception("[PersistencyManager]", "OpenFile()",
@@ -92,6 +133,59 @@ void PersistencyManager::OpenFile()
 
 
 
+G4long PersistencyManager::ResumeFile()
+{
+  if (h5writer_) {
+    G4Exception("[PersistencyManager]", "ResumeFile()",
+		JustWarning, "An output file was previously opened.");
+    return 0;
+  }
+
+  h5writer_ = new HDF5Writer();
+  std::map<std::string, std::string> checkpoint;
+
+  // Rotated output goes on from the last file with a checkpoint
+  file_index_ = 0;
+  if (IsRotating())
+    while (std::ifstream(FileName(file_index_ + 1)).good()) file_index_++;
+
+  G4String hdf5file = FileName(file_index_);
+  while (!h5writer_->Resume(hdf5file, store_steps_, save_str_,
+                            PerformanceMonitor::Instance().IsEnabled(),
+                            digitizer_->GetOutput() != SensorDigitizer::NONE,
+                            checkpoint)) {
+    if (file_index_ > 0) {
+      hdf5file = FileName(--file_index_);
+      continue;
+    }
+
+    // The job was stopped before its first checkpoint, or never started
+    G4Exception("[PersistencyManager]", "ResumeFile()", JustWarning,
+                ("No checkpoint found in " + hdf5file +
+                 ", the job starts from the beginning.").c_str());
+    delete h5writer_;
+    h5writer_ = 0;
+    OpenFile();
+    return 0;
+  }
+
+  RestoreCheckpoint(checkpoint);
+
+  G4cout << "[PersistencyManager] Resuming " << hdf5file << " after "
+         << processed_evts_ << " events (" << saved_evts_ << " saved)" << G4endl;
+
+  // The job was stopped right after filling the file, or after
+  // finishing it but before the first checkpoint of the next one
+  if (file_finished_)
+    OpenNextFile();
+  else if (IsRotating() && IsFileFull())
+    RotateFile();
+
+  return processed_evts_;
+}
+
+
+
 void PersistencyManager::CloseFile()
 {
   if (!h5writer_) return;
@@ -103,17 +197,24 @@ void PersistencyManager::CloseFile()
 
 G4bool PersistencyManager::Store(const G4Event* event)
 {
+  processed_evts_++;
+
   if (interacting_evt_) {
     interacting_evts_++;
   }
 
   if (!store_evt_) {
+    // Filtered-out events are accounted for in the performance table too
+    if (PerformanceMonitor::Instance().IsEnabled())
+      StorePerformance(-1);
     TrajectoryMap::Clear();
     if (store_steps_) {
       SaveAllSteppingAction* sa = (SaveAllSteppingAction*)
         G4RunManager::GetRunManager()->GetUserSteppingAction();
       sa->Reset();
     }
+    if (checkpoint_interval_ > 0 && processed_evts_ % checkpoint_interval_ == 0)
+      WriteCheckpoint();
     return false;
   }
 
@@ -124,6 +225,14 @@ G4bool PersistencyManager::Store(const G4Event* event)
     nevt_ = start_id_;
   }
 
+  // With per-event random streams, events keep their global id
+  // so that any of them can be simulated again on its own
+  NexusApp* app = (NexusApp*) G4RunManager::GetRunManager();
+  if (app->IsRandomPerEvent()) nevt_ = event->GetEventID();
+
+  if (PerformanceMonitor::Instance().IsEnabled())
+    StorePerformance(nevt_);
+
   if (store_steps_)
     StoreSteps();
 
@@ -142,6 +251,14 @@ G4bool PersistencyManager::Store(const G4Event* event)
   TrajectoryMap::Clear();
   StoreCurrentEvent(true);
 
+  if (checkpoint_interval_ > 0 && processed_evts_ % checkpoint_interval_ == 0)
+    WriteCheckpoint();
+
+  // No new file is left empty after the last event of the run
+  if (IsRotating() && IsFileFull() &&
+      processed_evts_ < app->GetNumberOfEventsToBeProcessed() + resumed_evts_)
+    RotateFile();
+
   return true;
 }
 
@@ -210,7 +327,8 @@ void PersistencyManager::StoreTrajectories(G4TrajectoryContainer* tc)
                                  (float)final_mom.y(), (float)final_mom.z(),
 				 kin_energy, length, creator_proc.c_str(),
                                  final_proc.c_str(),
-                                 (int)creatpr_id, (int)finpr_id);
+                                 (int)creatpr_id, (int)finpr_id,
+                                 (float)trj->GetWeight());
 
   }
 }
@@ -281,7 +399,7 @@ void PersistencyManager::StoreIonizationHits(G4VHitsCollection* hc)
     G4ThreeVector xyz = hit->GetPosition();
     h5writer_->WriteHitInfo(save_str_, nevt_, trackid,  ihits_->size() - 1,
 			    xyz[0], xyz[1], xyz[2],
-			    hit->GetTime(), hit->GetEnergyDeposit(),
+			    hit->GetTime(), hit->GetEnergyDeposit(), hit->GetWeight(),
                             sdname.c_str(), sdname_id);
   }
 }
@@ -306,6 +424,35 @@ void PersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
     }
   }
 
+  // Sensors are digitized in the acquisition window of their sensitive
+  // detector or, without one, in the time span of all their hits
+  G4bool digitize = digitizer_->GetOutput() != SensorDigitizer::NONE;
+  G4double window_start = kInfinity, window_end = -kInfinity;
+
+  SensorSD* sensdet = nullptr;
+  for (SensorSD* sd : SensorSD::GetSensors())
+    if (sd->GetName() == sdname) {
+      sensdet = sd;
+      break;
+    }
+
+  if (digitize) {
+    G4bool daq_window = sensdet && sensdet->GetDAQWindow(window_start, window_end);
+
+    if (!daq_window) {
+      for (size_t j=0; j<hits->entries(); j++) {
+        SensorHit* hit = dynamic_cast<SensorHit*>(hits->GetHit(j));
+        if (!hit || hit->GetHistogram().empty()) continue;
+        const std::map<G4double, G4int>& wvfm = hit->GetHistogram();
+        window_start = std::min(window_start, wvfm.begin()->first);
+        window_end   = std::max(window_end, wvfm.rbegin()->first + hit->GetBinSize());
+      }
+    }
+  }
+
+  const SensorDigitizer::Response& response = digitizer_->GetResponse(sdname);
+  std::vector<SensorDigitizer::Sample> digits;
+
   for (size_t i=0; i<hits->entries(); i++) {
 
     SensorHit* hit = dynamic_cast<SensorHit*>(hits->GetHit(i));
@@ -326,8 +473,16 @@ void PersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
       data.push_back(std::make_pair(time_bin, charge));
       amplitude = amplitude + (*it).second;
 
-      h5writer_->WriteSensorDataInfo(nevt_, (unsigned int)hit->GetSensorID(),
-                                     time_bin, charge);
+      if (!digitize || digitizer_->KeepRaw())
+        h5writer_->WriteSensorDataInfo(nevt_, (unsigned int)hit->GetSensorID(),
+                                       time_bin, charge);
+    }
+
+    if (digitize && window_end > window_start) {
+      digitizer_->Digitize(*hit, response, window_start, window_end, digits);
+      for (const auto& digit : digits)
+        h5writer_->WriteSensorDigitInfo(nevt_, (unsigned int)hit->GetSensorID(),
+                                        digit.time_bin, digit.charge);
     }
 
     std::vector<G4int>::iterator pos_it =
@@ -339,6 +494,59 @@ void PersistencyManager::StoreSensorHits(G4VHitsCollection* hc)
     }
 
   }
+
+  // Dark counts are added to every sensor of the detector,
+  // whether it has detected photons or not
+  if (!digitize || response.dark_rate <= 0. || !sensdet ||
+      window_end <= window_start)
+    return;
+
+  std::set<G4int> hit_ids;
+  for (size_t i=0; i<hits->entries(); i++)
+    if (SensorHit* hit = dynamic_cast<SensorHit*>(hits->GetHit(i)))
+      hit_ids.insert(hit->GetSensorID());
+
+  for (const auto& sensor : sensdet->GetSensorPositions()) {
+    if (hit_ids.count(sensor.first)) continue;
+
+    SensorHit empty(sensor.first, sensor.second, sensdet->GetTimeBinning());
+    digitizer_->Digitize(empty, response, window_start, window_end, digits);
+    if (digits.empty()) continue;
+
+    for (const auto& digit : digits)
+      h5writer_->WriteSensorDigitInfo(nevt_, (unsigned int)sensor.first,
+                                      digit.time_bin, digit.charge);
+
+    if (std::find(sns_posvec_.begin(), sns_posvec_.end(), sensor.first) == sns_posvec_.end()) {
+      const G4ThreeVector& xyz = sensor.second;
+      h5writer_->WriteSensorPosInfo((unsigned int)sensor.first, sdname.c_str(),
+                                    (float)xyz.x(), (float)xyz.y(), (float)xyz.z());
+      sns_posvec_.push_back(sensor.first);
+    }
+  }
+}
+
+
+void PersistencyManager::StorePerformance(int64_t evt_id)
+{
+  const PerformanceMonitor& perf = PerformanceMonitor::Instance();
+
+  h5writer_->WritePerformanceInfo(evt_id,
+                                  perf.GetWallTime(PerformanceMonitor::TRACKING),
+                                  perf.GetCpuTime (PerformanceMonitor::TRACKING),
+                                  perf.GetWallTime(PerformanceMonitor::DRIFT),
+                                  perf.GetCpuTime (PerformanceMonitor::DRIFT),
+                                  perf.GetWallTime(PerformanceMonitor::OPTICAL),
+                                  perf.GetCpuTime (PerformanceMonitor::OPTICAL),
+                                  perf.GetClusteringSecondaries(),
+                                  perf.GetELSecondaries(),
+                                  perf.GetPeakRSS());
+
+  for (const auto& p : perf.GetParticleCounts()) {
+    h5writer_->WritePerformanceParticleInfo(evt_id,
+                                            p.first->GetParticleName().c_str(),
+                                            p.second.tracks, p.second.steps);
+  }
 }
 
 
@@ -378,23 +586,57 @@ void PersistencyManager::StoreSteps()
 }
 
 G4bool PersistencyManager::Store(const G4Run*)
+{
+  // A last checkpoint lets the job be extended with more events later
+  if (checkpoint_interval_ > 0)
+    WriteCheckpoint();
+
+  StoreRunInfo();
+
+  // Summary of the counters filled by other components in the run
+  for (const auto& counter : run_counters_)
+    G4cout << "[PersistencyManager] " << counter.first << ": "
+           << counter.second << G4endl;
+
+  return true;
+}
+
+
+
+void PersistencyManager::StoreRunInfo()
 {
   // Store the event type
   G4String key = "event_type";
   h5writer_->WriteRunInfo(key, event_type_.c_str());
 
-  // Store the number of events to be processed
+  // Store the number of events to be processed, or those
+  // processed in this file when the output is rotated
   NexusApp* app = (NexusApp*) G4RunManager::GetRunManager();
-  G4int num_events = app->GetNumberOfEventsToBeProcessed();
+  int64_t num_events = app->GetNumberOfEventsToBeProcessed() + resumed_evts_;
+  if (IsRotating()) {
+    num_events = processed_evts_ - file_processed_evts_;
+    key = "file_index";
+    h5writer_->WriteRunInfo(key,  std::to_string(file_index_).c_str());
+  }
 
   key = "num_events";
   h5writer_->WriteRunInfo(key,  std::to_string(num_events).c_str());
   key = "saved_events";
-  h5writer_->WriteRunInfo(key,  std::to_string(saved_evts_).c_str());
+  h5writer_->WriteRunInfo(key,  std::to_string(saved_evts_ - file_saved_evts_).c_str());
 
   if (save_ie_numb_) {
     key = "interacting_events";
-    h5writer_->WriteRunInfo(key,  std::to_string(interacting_evts_).c_str());
+    h5writer_->WriteRunInfo(key,  std::to_string(interacting_evts_ -
+                                                 file_interacting_evts_).c_str());
+  }
+
+  // Store counters filled during the run
+  CollectRunCounters();
+  for (const auto& counter : run_counters_) {
+    auto previous = file_counters_.find(counter.first);
+    int64_t value = counter.second;
+    if (previous != file_counters_.end()) value -= previous->second;
+    h5writer_->WriteRunInfo(counter.first.c_str(), std::to_string(value).c_str());
   }
 
   // Store sensor time binning
@@ -405,6 +647,7 @@ G4bool PersistencyManager::Store(const G4Run*)
   }
 
   // Store configuration parameters
+  secondary_macros_.clear();
   SaveConfigurationInfo(init_macro_);
   for (unsigned long i=0; i<macros_.size(); i++) {
     SaveConfigurationInfo(macros_[i]);
@@ -417,21 +660,241 @@ G4bool PersistencyManager::Store(const G4Run*)
   }
 
   // Store map with string --> int correspondence
-  if (!save_str_) {
-    std::map<G4int, G4String> inv_map;
-    for (const auto& n : str_map_) {
+  StoreStringMap();
+}
+
+
+
+void PersistencyManager::StoreStringMap()
+{
+  if (save_str_) return;
+
+  std::map<G4int, G4String> inv_map;
+  for (const auto& n : str_map_) {
+    if (n.second >= str_stored_)
       inv_map[n.second] = n.first;
-    }
+  }
+
+  for (const auto& p : inv_map) {
+    h5writer_->WriteStringMapInfo(p.second, p.first);
+  }
+
+  str_stored_ = str_counter_;
+}
+
+
+
+void PersistencyManager::WriteCheckpoint()
+{
+  // The string map is written up to now, so that it covers
+  // all the events in the file
+  StoreStringMap();
+
+  std::vector<std::pair<std::string, std::string>> entries;
+  entries.emplace_back("events_processed", std::to_string(processed_evts_));
+  entries.emplace_back("saved_events", std::to_string(saved_evts_));
+  entries.emplace_back("interacting_events", std::to_string(interacting_evts_));
+  entries.emplace_back("next_event_id", std::to_string(first_evt_ ? start_id_ : nevt_));
+
+  CollectRunCounters();
+  for (const auto& counter : run_counters_)
+    entries.emplace_back("counter:" + counter.first, std::to_string(counter.second));
+
+  if (IsRotating()) {
+    entries.emplace_back("file_processed_events", std::to_string(file_processed_evts_));
+    entries.emplace_back("file_saved_events", std::to_string(file_saved_evts_));
+    entries.emplace_back("file_interacting_events", std::to_string(file_interacting_evts_));
+    for (const auto& counter : file_counters_)
+      entries.emplace_back("file_counter:" + counter.first, std::to_string(counter.second));
+    entries.emplace_back("file_finished", file_finished_ ? "1" : "0");
+  }
+
+  for (const auto& bin : sensdet_bin_) {
+    std::ostringstream value;
+    value << std::setprecision(17) << bin.second;
+    entries.emplace_back("binning:" + bin.first, value.str());
+  }
+
+  // Engine status and cached values of the distributions, so that
+  // the resumed job continues the same random sequence
+  std::ostringstream rng_state;
+  G4Random::saveFullState(rng_state);
+  entries.emplace_back("rng_state", rng_state.str());
+
+  // Position of the generators that read their events in sequence
+  ResumableGenerator* generator = GetResumableGenerator();
+  if (generator) {
+    std::map<std::string, std::string> state;
+    generator->SaveState(state);
+    for (const auto& s : state)
+      entries.emplace_back("generator:" + s.first, s.second);
+  }
 
-    for (const auto& p : inv_map) {
-      h5writer_->WriteStringMapInfo(p.second, p.first);
+  h5writer_->WriteCheckpoint(entries);
+}
+
+
+
+void PersistencyManager::RestoreCheckpoint(const std::map<std::string, std::string>& checkpoint)
+{
+  std::map<std::string, std::string> generator_state;
+
+  for (const auto& entry : checkpoint) {
+    const std::string& key = entry.first;
+    const std::string& value = entry.second;
+
+    if (key == "events_processed")
+      processed_evts_ = std::stoll(value);
+    else if (key == "saved_events")
+      saved_evts_ = std::stoll(value);
+    else if (key == "interacting_events")
+      interacting_evts_ = std::stoll(value);
+    else if (key == "next_event_id")
+      nevt_ = std::stoll(value);
+    else if (key.rfind("counter:", 0) == 0)
+      run_counters_[key.substr(8)] = std::stoll(value);
+    else if (key == "file_processed_events")
+      file_processed_evts_ = std::stoll(value);
+    else if (key == "file_saved_events")
+      file_saved_evts_ = std::stoll(value);
+    else if (key == "file_interacting_events")
+      file_interacting_evts_ = std::stoll(value);
+    else if (key.rfind("file_counter:", 0) == 0)
+      file_counters_[key.substr(13)] = std::stoll(value);
+    else if (key == "file_finished")
+      file_finished_ = (value == "1");
+    else if (key.rfind("binning:", 0) == 0)
+      sensdet_bin_[key.substr(8)] = std::stod(value);
+    else if (key.rfind("generator:", 0) == 0)
+      generator_state[key.substr(10)] = value;
+    else if (key == "rng_state") {
+      std::istringstream rng_state(value);
+      G4Random::restoreFullState(rng_state);
+      if (rng_state.bad())
+        G4Exception("[PersistencyManager]", "RestoreCheckpoint()", FatalException,
+                    "The random engine state of the checkpoint cannot be restored.");
     }
   }
 
+  // Without its state, a generator reading its events in sequence
+  // would start over and the resumed job would repeat them
+  ResumableGenerator* generator = GetResumableGenerator();
+  if (generator) {
+    if (!generator->RestoreState(generator_state))
+      G4Exception("[PersistencyManager]", "RestoreCheckpoint()", FatalException,
+                  "The primary generator of the job cannot be resumed.");
+  }
+  else if (!generator_state.empty()) {
+    G4Exception("[PersistencyManager]", "RestoreCheckpoint()", FatalException,
+                "The state of the primary generator cannot be restored.");
+  }
 
-  return true;
+  resumed_evts_ = processed_evts_;
+  first_evt_ = false;
+
+  h5writer_->ReadSensorIDs(sns_posvec_);
+
+  std::vector<std::pair<std::string, int>> str_map;
+  h5writer_->ReadStringMap(str_map);
+  for (const auto& n : str_map)
+    str_map_[n.first] = n.second;
+  str_counter_ = str_stored_ = str_map_.size();
+}
+
+
+
+void PersistencyManager::RegisterRunCounter(const G4String& key, int64_t* counter)
+{
+  // A resumed job goes on from the value at the checkpoint. A counter
+  // registered again in a later run keeps its own value instead.
+  auto restored = run_counters_.find(key);
+  if (restored != run_counters_.end() && !registered_counters_.count(key))
+    *counter = restored->second;
+
+  registered_counters_[key] = counter;
+}
+
+
+
+void PersistencyManager::CollectRunCounters()
+{
+  for (const auto& counter : registered_counters_)
+    run_counters_[counter.first] = *counter.second;
+}
+
+
+
+G4String PersistencyManager::FileName(G4int index) const
+{
+  if (!IsRotating()) return output_file_ + ".h5";
+
+  std::ostringstream name;
+  name << output_file_ << "." << std::setw(4) << std::setfill('0') << index << ".h5";
+  return name.str();
 }
 
+
+
+G4bool PersistencyManager::IsFileFull() const
+{
+  if (max_file_evts_ > 0 && saved_evts_ - file_saved_evts_ >= max_file_evts_)
+    return true;
+
+  return max_file_size_ > 0. && h5writer_->GetFileSize() >= max_file_size_ * 1.e6;
+}
+
+
+
+void PersistencyManager::RotateFile()
+{
+  // The finished file gets its own configuration, so that
+  // it can be processed while the job goes on. A job stopped
+  // while it is written resumes from the checkpoint before it.
+  if (checkpoint_interval_ > 0)
+    WriteCheckpoint();
+  StoreRunInfo();
+
+  // A job stopped before the first checkpoint of the next file resumes
+  // from this one, which is then left as it is
+  file_finished_ = true;
+  if (checkpoint_interval_ > 0)
+    WriteCheckpoint();
+
+  OpenNextFile();
+}
+
+
+
+void PersistencyManager::OpenNextFile()
+{
+  h5writer_->Close();
+  delete h5writer_;
+  h5writer_ = 0;
+
+  file_index_++;
+  file_processed_evts_   = processed_evts_;
+  file_saved_evts_       = saved_evts_;
+  file_interacting_evts_ = interacting_evts_;
+  file_counters_         = run_counters_;
+  file_finished_         = false;
+
+  // Sensor positions and the whole string map are written again,
+  // while event ids and string ids go on from the previous file
+  sns_posvec_.clear();
+  str_stored_ = 0;
+
+  OpenFile();
+
+  // A job stopped before the next checkpoint resumes in the new file
+  if (checkpoint_interval_ > 0)
+    WriteCheckpoint();
+
+  G4cout << "[PersistencyManager] Output goes on in "
+         << FileName(file_index_) << G4endl;
+}
+
+
+
 void PersistencyManager::SaveConfigurationInfo(G4String file_name)
 {
   std::ifstream history(file_name, std::ifstream::in);
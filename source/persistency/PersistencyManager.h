@@ -25,6 +25,7 @@ class G4VHitsCollection;
 namespace nexus {
   class HDF5Writer;
   class IonizationHit;
+  class SensorDigitizer;
 }
 
 namespace nexus {
@@ -41,10 +42,13 @@ namespace nexus {
     //                       std::vector<G4String>& delayed_macros);
 
     /// Set whether to store or not the current event
-    void StoreCurrentEvent(G4bool);
-    void InteractingEvent(G4bool);
-    void StoreSteps(G4bool);
-    void SaveNumbOfInteractingEvents(G4bool);
+    virtual void StoreCurrentEvent(G4bool);
+    virtual void InteractingEvent(G4bool);
+    virtual void StoreSteps(G4bool);
+    virtual void SaveNumbOfInteractingEvents(G4bool);
+    /// Add to a counter stored in the configuration table at the end of the run
+    virtual void AddRunCounter(const G4String& key, int64_t increment);
+    virtual void RegisterRunCounter(const G4String& key, int64_t* counter);
 
     ///
     virtual G4bool Store(const G4Event*);
@@ -58,6 +62,7 @@ namespace nexus {
   public:
     void OpenFile();
     void CloseFile();
+    G4long ResumeFile();
 
 
   private:
@@ -66,8 +71,31 @@ namespace nexus {
     void StoreIonizationHits(G4VHitsCollection*);
     void StoreSensorHits(G4VHitsCollection*);
     void StoreSteps();
+    void StorePerformance(int64_t evt_id);
 
     void SaveConfigurationInfo(G4String history);
+    /// Write the configuration of the run, or of the part
+    /// of it in the current file when the output is rotated
+    void StoreRunInfo();
+
+    /// Path of an output file, numbered when the output is rotated
+    G4String FileName(G4int index) const;
+    /// True if the output is split in several files
+    G4bool IsRotating() const;
+    /// True if the current file has reached its maximum size or events
+    G4bool IsFileFull() const;
+    /// Close the current file and go on in the next one
+    void RotateFile();
+    /// Open the file that follows a finished one
+    void OpenNextFile();
+
+    /// Write the string map entries added since the last call
+    void StoreStringMap();
+    /// Save the state of the job in the output file and flush it
+    void WriteCheckpoint();
+    void RestoreCheckpoint(const std::map<std::string, std::string>& checkpoint);
+    /// Read the counters registered by other components
+    void CollectRunCounters();
 
     G4int FindStringIDInMap(std::map<G4String, G4int>& vmap, G4String vol, G4int& counter);
 
@@ -94,7 +122,21 @@ namespace nexus {
     int64_t start_id_; ///< ID for the first event in file
     G4bool first_evt_; ///< true only for the first event of the run
 
+    int64_t processed_evts_; ///< number of events processed, saved or not
+    int64_t resumed_evts_; ///< number of events processed before resuming
+    G4int checkpoint_interval_; ///< events between checkpoints (0 to disable)
+
+    G4int max_file_evts_; ///< saved events per output file (0 for no limit)
+    G4double max_file_size_; ///< size of an output file in MB (0 for no limit)
+    G4int file_index_; ///< number of the current output file
+    int64_t file_processed_evts_; ///< events processed before the current file
+    int64_t file_saved_evts_; ///< events saved before the current file
+    int64_t file_interacting_evts_; ///< interacting events before the current file
+    std::map<G4String, int64_t> file_counters_; ///< run counters before the current file
+    G4bool file_finished_; ///< has the current file got its configuration?
+
     HDF5Writer* h5writer_;  ///< Event writer to hdf5 file
+    SensorDigitizer* digitizer_; ///< Digitization of the sensor hits
 
     std::vector<G4int>* ihits_;
     std::map<G4int, std::vector<G4int>* > hit_map_;
@@ -102,10 +144,14 @@ namespace nexus {
     std::map<G4String, G4int> str_map_; ///< map with string-int correspondence
 
     G4int str_counter_; ///< incrementing counter for string map
+    G4int str_stored_; ///< number of string map entries already written
     G4bool save_str_; ///< Should we store strings as volume names etc.?
     G4bool particles_; ///< Store particles table
 
     std::map<G4String, G4double> sensdet_bin_;
+
+    std::map<G4String, int64_t> run_counters_; ///< Counters filled by other components
+    std::map<G4String, int64_t*> registered_counters_; ///< Counters kept by other components
   };
 
 
@@ -119,6 +165,10 @@ namespace nexus {
   { interacting_evt_ = ie; }
   inline void PersistencyManager::SaveNumbOfInteractingEvents(G4bool sie)
   {save_ie_numb_ = sie;}
+  inline void PersistencyManager::AddRunCounter(const G4String& key, int64_t increment)
+  { run_counters_[key] += increment; }
+  inline G4bool PersistencyManager::IsRotating() const
+  { return max_file_evts_ > 0 || max_file_size_ > 0.; }
   inline G4bool PersistencyManager::Store(const G4VPhysicalVolume*)
   { return false; }
   inline G4bool PersistencyManager::Retrieve(G4Event*&)
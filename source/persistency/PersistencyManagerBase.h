@@ -1,9 +1,12 @@
 #ifndef BASE_PERSISTENCY_MANAGER_H
 #define BASE_PERSISTENCY_MANAGER_H
 
+#include "EventView.h"
+
 #include <G4VPersistencyManager.hh>
 #include <G4String.hh>
 
+#include <cstdint>
 #include <vector>
 
 
@@ -13,6 +16,20 @@ class PersistencyManagerBase: public G4VPersistencyManager
 
     virtual void OpenFile() = 0;
     virtual void CloseFile() = 0;
+    /// Reopen the output file of an interrupted job at its last checkpoint.
+    /// Returns the number of events already processed.
+    virtual G4long ResumeFile() = 0;
+
+    /// Selection of the events and extra information set by the
+    /// user actions. Managers that make no use of them ignore them.
+    virtual void StoreCurrentEvent(G4bool) {}
+    virtual void InteractingEvent(G4bool) {}
+    virtual void StoreSteps(G4bool) {}
+    virtual void SaveNumbOfInteractingEvents(G4bool) {}
+    virtual void AddRunCounter(const G4String&, int64_t) {}
+    /// Counter kept by another component, read whenever the run counters
+    /// are written. A resumed job sets it to its value at the checkpoint.
+    virtual void RegisterRunCounter(const G4String&, int64_t*) {}
 
     G4String init_macro_;
     std::vector<G4String> macros_;
@@ -21,6 +38,15 @@ class PersistencyManagerBase: public G4VPersistencyManager
     inline void SetMacros(G4String init, std::vector<G4String> mcrs, std::vector<G4String> delayed)
     {init_macro_ = init; macros_ = mcrs; delayed_macros_ = delayed;}
 
+  protected:
+    /// Read-only view of the hits and trajectories of an event, with no
+    /// copies of them. Meant to be called from Store(const G4Event*),
+    /// and valid until it returns.
+    inline const nexus::EventView& GetEventView(const G4Event* event)
+    {event_view_.Fill(event); return event_view_;}
+
+  private:
+    nexus::EventView event_view_;
 
   };
 
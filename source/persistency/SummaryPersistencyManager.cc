@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+// nexus | SummaryPersistencyManager.cc
+//
+// Persistency manager that keeps in memory a summary of each event (the
+// deposited energy and the light detected by the sensors) instead of
+// writing an output file. It reads the events through their read-only
+// view and serves as an example of in-process consumer of the simulation.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SummaryPersistencyManager.h"
+
+#include "IonizationHit.h"
+#include "SensorHit.h"
+#include "TrajectoryMap.h"
+#include "SaveAllSteppingAction.h"
+#include "FactoryBase.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4Event.hh>
+#include <G4RunManager.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <algorithm>
+
+using namespace nexus;
+
+
+REGISTER_CLASS(SummaryPersistencyManager, PersistencyManagerBase)
+
+
+SummaryPersistencyManager::SummaryPersistencyManager():
+  PersistencyManagerBase(), msg_(0), sensor_sd_(""), verbose_(false),
+  store_evt_(true), store_steps_(false), processed_evts_(0),
+  consumer_time_(0)
+{
+  msg_ = new G4GenericMessenger(this, "/nexus/summary/",
+                                "Control commands of the in-memory event summaries.");
+  msg_->DeclareProperty("sensor_sd", sensor_sd_,
+                        "Name of the sensitive detector of the summarized sensors "
+                        "(all the sensors if not set).");
+  msg_->DeclareProperty("verbose", verbose_,
+                        "Print the summary of every event.");
+}
+
+
+
+SummaryPersistencyManager::~SummaryPersistencyManager()
+{
+  delete msg_;
+}
+
+
+
+void SummaryPersistencyManager::OpenFile()
+{
+  // Nothing is written
+  summaries_.clear();
+  processed_evts_ = 0;
+  consumer_time_ = std::chrono::steady_clock::duration(0);
+}
+
+
+
+void SummaryPersistencyManager::CloseFile()
+{
+}
+
+
+
+G4long SummaryPersistencyManager::ResumeFile()
+{
+  // There is no file to resume from
+  G4Exception("[SummaryPersistencyManager]", "ResumeFile()", JustWarning,
+              "Summaries are kept in memory only, the job starts from the beginning.");
+  OpenFile();
+  return 0;
+}
+
+
+
+G4bool SummaryPersistencyManager::Store(const G4Event* event)
+{
+  if (processed_evts_ == 0) start_ = std::chrono::steady_clock::now();
+  processed_evts_++;
+
+  G4bool stored = store_evt_;
+
+  if (store_evt_) {
+    auto start = std::chrono::steady_clock::now();
+
+    EventSummary summary;
+    Summarize(GetEventView(event), summary);
+    summaries_.push_back(summary);
+
+    consumer_time_ += std::chrono::steady_clock::now() - start;
+
+    if (verbose_)
+      G4cout << "[SummaryPersistencyManager] Event " << summary.event_id
+             << ": energy " << summary.energy / keV << " keV, light "
+             << summary.light << " photons in " << summary.light_sensors
+             << " sensors, from " << summary.light_start / microsecond << " to "
+             << summary.light_end / microsecond << " us" << G4endl;
+  }
+
+  // Same bookkeeping as the default persistency manager,
+  // so that the user actions behave the same
+  TrajectoryMap::Clear();
+  if (store_steps_) {
+    SaveAllSteppingAction* sa = (SaveAllSteppingAction*)
+      G4RunManager::GetRunManager()->GetUserSteppingAction();
+    sa->Reset();
+  }
+  StoreCurrentEvent(true);
+
+  return stored;
+}
+
+
+
+G4bool SummaryPersistencyManager::Store(const G4Run*)
+{
+  std::chrono::duration<G4double> elapsed =
+    std::chrono::steady_clock::now() - start_;
+  std::chrono::duration<G4double, std::micro> consumer = consumer_time_;
+
+  G4double energy = 0., light = 0.;
+  for (const auto& summary : summaries_) {
+    energy += summary.energy;
+    light  += summary.light;
+  }
+  size_t n = std::max<size_t>(summaries_.size(), 1);
+
+  G4cout << "[SummaryPersistencyManager] " << summaries_.size() << " of "
+         << processed_evts_ << " events summarized in " << elapsed.count()
+         << " s (" << processed_evts_ / std::max(elapsed.count(), 1.e-9)
+         << " events/s, " << consumer.count() / n << " us per event in the summaries)"
+         << G4endl;
+  G4cout << "[SummaryPersistencyManager] Mean energy " << energy / n / keV
+         << " keV, mean light " << light / n << " photons" << G4endl;
+
+  return true;
+}
+
+
+
+void SummaryPersistencyManager::Summarize(const EventView& view,
+                                          EventSummary& summary) const
+{
+  summary.event_id        = view.GetEventID();
+  summary.energy          = 0.;
+  summary.light           = 0.;
+  summary.light_start     = 0.;
+  summary.light_end       = 0.;
+  summary.light_mean_time = 0.;
+  summary.light_sensors   = 0;
+
+  for (const auto& collection : view.GetIonizationHits())
+    for (const IonizationHit* hit : collection.hits)
+      summary.energy += hit->GetEnergyDeposit();
+
+  G4double start = kInfinity, end = -kInfinity;
+
+  for (const auto& collection : view.GetSensorHits()) {
+    if (!sensor_sd_.empty() && collection.sd_name != sensor_sd_) continue;
+
+    for (const SensorHit* hit : collection.hits) {
+      const std::map<G4double, G4int>& histogram = hit->GetHistogram();
+      if (histogram.empty()) continue;
+
+      G4double bin_size = hit->GetBinSize();
+      for (const auto& bin : histogram) {
+        summary.light           += bin.second;
+        summary.light_mean_time += bin.second * (bin.first + 0.5 * bin_size);
+      }
+      start = std::min(start, histogram.begin()->first);
+      end   = std::max(end, histogram.rbegin()->first + bin_size);
+      summary.light_sensors++;
+    }
+  }
+
+  if (summary.light > 0.) {
+    summary.light_mean_time /= summary.light;
+    summary.light_start = start;
+    summary.light_end   = end;
+  }
+}
@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------------
+// nexus | SummaryPersistencyManager.h
+//
+// Persistency manager that keeps in memory a summary of each event (the
+// deposited energy and the light detected by the sensors) instead of
+// writing an output file. It reads the events through their read-only
+// view and serves as an example of in-process consumer of the simulation.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SUMMARY_PERSISTENCY_MANAGER_H
+#define SUMMARY_PERSISTENCY_MANAGER_H
+
+#include "PersistencyManagerBase.h"
+
+#include <chrono>
+#include <vector>
+
+class G4GenericMessenger;
+
+
+namespace nexus {
+
+  class SummaryPersistencyManager: public PersistencyManagerBase
+  {
+  public:
+    /// Summary of an event
+    struct EventSummary
+    {
+      G4int event_id;
+      G4double energy;       ///< Energy deposited in the ionization detectors
+      G4double light;           ///< Photons detected by the sensors
+      G4double light_start;     ///< Start of the first time bin with photons
+      G4double light_end;       ///< End of the last time bin with photons
+      G4double light_mean_time; ///< Mean time of the photons
+      G4int light_sensors;      ///< Number of sensors with photons
+    };
+
+    SummaryPersistencyManager();
+    ~SummaryPersistencyManager();
+
+    virtual void StoreCurrentEvent(G4bool);
+    virtual void StoreSteps(G4bool);
+
+    virtual G4bool Store(const G4Event*);
+    virtual G4bool Store(const G4Run*);
+    virtual G4bool Store(const G4VPhysicalVolume*);
+
+    virtual G4bool Retrieve(G4Event*&);
+    virtual G4bool Retrieve(G4Run*&);
+    virtual G4bool Retrieve(G4VPhysicalVolume*&);
+
+    void OpenFile();
+    void CloseFile();
+    G4long ResumeFile();
+
+    /// Summaries of the events stored so far
+    const std::vector<EventSummary>& GetSummaries() const;
+
+    /// Summary of an event computed from its view
+    void Summarize(const EventView&, EventSummary&) const;
+
+  private:
+    G4GenericMessenger* msg_;
+
+    G4String sensor_sd_; ///< Sensitive detector of the sensors, all if empty
+    G4bool verbose_;     ///< Print the summary of every event
+    G4bool store_evt_;   ///< Should we keep the current event?
+    G4bool store_steps_; ///< Are the steps of the events recorded?
+
+    std::vector<EventSummary> summaries_;
+
+    int64_t processed_evts_;
+    std::chrono::steady_clock::time_point start_;   ///< First event stored
+    std::chrono::steady_clock::duration consumer_time_; ///< Spent summarizing
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline void SummaryPersistencyManager::StoreCurrentEvent(G4bool sce)
+  { store_evt_ = sce; }
+  inline void SummaryPersistencyManager::StoreSteps(G4bool ss)
+  { store_steps_ = ss; }
+  inline G4bool SummaryPersistencyManager::Store(const G4VPhysicalVolume*)
+  { return false; }
+  inline G4bool SummaryPersistencyManager::Retrieve(G4Event*&)
+  { return false; }
+  inline G4bool SummaryPersistencyManager::Retrieve(G4Run*&)
+  { return false; }
+  inline G4bool SummaryPersistencyManager::Retrieve(G4VPhysicalVolume*&)
+  { return false; }
+  inline const std::vector<SummaryPersistencyManager::EventSummary>&
+  SummaryPersistencyManager::GetSummaries() const
+  { return summaries_; }
+
+} // namespace nexus
+
+#endif
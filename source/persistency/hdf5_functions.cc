@@ -32,6 +32,17 @@ hsize_t createSensorDataType()
   return memtype;
 }
 
+hsize_t createSensorDigitType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof (sns_digit_t));
+  H5Tinsert (memtype, "event_id", HOFFSET (sns_digit_t, event_id), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "sensor_id", HOFFSET (sns_digit_t, sensor_id), H5T_NATIVE_UINT);
+  H5Tinsert (memtype, "time_bin", HOFFSET (sns_digit_t, time_bin), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "charge", HOFFSET (sns_digit_t, charge), H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
 
 hsize_t createHitInfoType(bool str)
 {
@@ -46,6 +57,7 @@ hsize_t createHitInfoType(bool str)
   H5Tinsert (memtype, "z", HOFFSET (hit_info_t, z), H5T_NATIVE_FLOAT);
   H5Tinsert (memtype, "time", HOFFSET (hit_info_t, time), H5T_NATIVE_FLOAT);
   H5Tinsert (memtype, "energy", HOFFSET (hit_info_t, energy), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "weight", HOFFSET (hit_info_t, weight), H5T_NATIVE_FLOAT);
   if (str) {
     H5Tinsert (memtype, "label", HOFFSET (hit_info_t, label_str), strtype);
   } else {
@@ -109,6 +121,7 @@ hsize_t createParticleInfoType(bool str)
     H5Tinsert (memtype, "creator_proc", HOFFSET (particle_info_t, creator_proc), H5T_NATIVE_INT);
     H5Tinsert (memtype, "final_proc", HOFFSET (particle_info_t, final_proc), H5T_NATIVE_INT);
   }
+  H5Tinsert (memtype, "weight", HOFFSET (particle_info_t, weight), H5T_NATIVE_FLOAT);
   return memtype;
 }
 
@@ -169,6 +182,39 @@ hsize_t createStringMapType()
   return memtype;
 }
 
+
+hsize_t createPerformanceType()
+{
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(performance_t));
+  H5Tinsert (memtype, "event_id"              , HOFFSET(performance_t, event_id              ), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "wall_time_tracking"    , HOFFSET(performance_t, wall_time_tracking    ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "cpu_time_tracking"     , HOFFSET(performance_t, cpu_time_tracking     ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "wall_time_drift"       , HOFFSET(performance_t, wall_time_drift       ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "cpu_time_drift"        , HOFFSET(performance_t, cpu_time_drift        ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "wall_time_optical"     , HOFFSET(performance_t, wall_time_optical     ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "cpu_time_optical"      , HOFFSET(performance_t, cpu_time_optical      ), H5T_NATIVE_FLOAT);
+  H5Tinsert (memtype, "clustering_secondaries", HOFFSET(performance_t, clustering_secondaries), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "el_secondaries"        , HOFFSET(performance_t, el_secondaries        ), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "peak_rss"              , HOFFSET(performance_t, peak_rss              ), H5T_NATIVE_FLOAT);
+  return memtype;
+}
+
+
+hsize_t createPerformanceParticleType()
+{
+  hid_t strtype = H5Tcopy(H5T_C_S1);
+  H5Tset_size (strtype, STRLEN);
+
+  //Create compound datatype for the table
+  hsize_t memtype = H5Tcreate (H5T_COMPOUND, sizeof(performance_particle_t));
+  H5Tinsert (memtype, "event_id"     , HOFFSET(performance_particle_t, event_id     ), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "particle_name", HOFFSET(performance_particle_t, particle_name), strtype         );
+  H5Tinsert (memtype, "tracks"       , HOFFSET(performance_particle_t, tracks       ), H5T_NATIVE_INT64);
+  H5Tinsert (memtype, "steps"        , HOFFSET(performance_particle_t, steps        ), H5T_NATIVE_INT64);
+  return memtype;
+}
+
 hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype)
 {
   //Create 1D dataspace (evt number). First dimension is unlimited (initially 0)
@@ -204,6 +250,41 @@ hid_t createGroup(hid_t file, std::string& groupName)
   return wfgroup;
 }
 
+hid_t openOrCreateTable(hid_t group, std::string& table_name, hsize_t memtype)
+{
+  if (H5Lexists(group, table_name.c_str(), H5P_DEFAULT) > 0)
+    return H5Dopen2(group, table_name.c_str(), H5P_DEFAULT);
+  return createTable(group, table_name, memtype);
+}
+
+hid_t openOrCreateGroup(hid_t file, std::string& groupName)
+{
+  if (H5Lexists(file, groupName.c_str(), H5P_DEFAULT) > 0)
+    return H5Gopen2(file, groupName.c_str(), H5P_DEFAULT);
+  return createGroup(file, groupName);
+}
+
+hsize_t getTableSize(hid_t dataset)
+{
+  hsize_t dims[1] = {0};
+  hid_t file_space = H5Dget_space(dataset);
+  H5Sget_simple_extent_dims(file_space, dims, NULL);
+  H5Sclose(file_space);
+  return dims[0];
+}
+
+void resizeTable(hid_t dataset, hsize_t size)
+{
+  hsize_t dims[1] = {size};
+  H5Dset_extent(dataset, dims);
+}
+
+void readTable(void* buffer, hid_t dataset, hid_t memtype)
+{
+  if (getTableSize(dataset) == 0) return;
+  H5Dread(dataset, memtype, H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer);
+}
+
 void writeRun(run_info_t* runData, hid_t dataset, hid_t memtype, hsize_t counter)
 {
   hid_t memspace, file_space;
@@ -246,6 +327,26 @@ void writeSnsData(sns_data_t* snsData, hid_t dataset, hid_t memtype, hsize_t cou
   H5Sclose(memspace);
 }
 
+void writeSnsDigit(sns_digit_t* snsDigit, hid_t dataset, hid_t memtype, hsize_t counter)
+{
+  hid_t memspace, file_space;
+
+  const hsize_t n_dims = 1;
+  hsize_t dims[n_dims] = {1};
+  memspace = H5Screate_simple(n_dims, dims, NULL);
+
+  dims[0] = counter + 1;
+  H5Dset_extent(dataset, dims);
+
+  file_space = H5Dget_space(dataset);
+  hsize_t start[1] = {counter};
+  hsize_t count[1] = {1};
+  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, snsDigit);
+  H5Sclose(file_space);
+  H5Sclose(memspace);
+}
+
 void writeHit(hit_info_t* hitInfo, hid_t dataset, hid_t memtype, hsize_t counter)
 {
   hid_t memspace, file_space;
@@ -347,3 +448,43 @@ void writeStringMap(string_map_t* strmap, hid_t dataset, hid_t memtype, hsize_t
   H5Sclose(file_space);
   H5Sclose(memspace);
 }
+
+void writePerformance(performance_t* perf, hid_t dataset, hid_t memtype, hsize_t counter)
+{
+  hid_t memspace, file_space;
+
+  const hsize_t n_dims = 1;
+  hsize_t dims[n_dims] = {1};
+  memspace = H5Screate_simple(n_dims, dims, NULL);
+
+  dims[0] = counter + 1;
+  H5Dset_extent(dataset, dims);
+
+  file_space = H5Dget_space(dataset);
+  hsize_t start[1] = {counter};
+  hsize_t count[1] = {1};
+  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, perf);
+  H5Sclose(file_space);
+  H5Sclose(memspace);
+}
+
+void writePerformanceParticle(performance_particle_t* perf, hid_t dataset, hid_t memtype, hsize_t counter)
+{
+  hid_t memspace, file_space;
+
+  const hsize_t n_dims = 1;
+  hsize_t dims[n_dims] = {1};
+  memspace = H5Screate_simple(n_dims, dims, NULL);
+
+  dims[0] = counter + 1;
+  H5Dset_extent(dataset, dims);
+
+  file_space = H5Dget_space(dataset);
+  hsize_t start[1] = {counter};
+  hsize_t count[1] = {1};
+  H5Sselect_hyperslab(file_space, H5S_SELECT_SET, start, NULL, count, NULL);
+  H5Dwrite(dataset, memtype, memspace, file_space, H5P_DEFAULT, perf);
+  H5Sclose(file_space);
+  H5Sclose(memspace);
+}
@@ -27,6 +27,13 @@
     unsigned int charge;
   } sns_data_t;
 
+  typedef struct{
+    int64_t event_id;
+    unsigned int sensor_id;
+    int64_t time_bin;
+    float charge;
+  } sns_digit_t;
+
   typedef struct{
         int64_t event_id;
 	float x;
@@ -34,6 +41,7 @@
 	float z;
 	float time;
 	float energy;
+	float weight;
         char label_str[STRLEN];
         int label;
         int particle_id;
@@ -71,6 +79,7 @@
 	char final_proc_str[STRLEN];
         int creator_proc;
         int final_proc;
+	float weight;
   } particle_info_t;
 
   typedef struct{
@@ -103,24 +112,57 @@ typedef struct{
   int32_t name_id;
 } string_map_t;
 
+typedef struct{
+  int64_t event_id;
+  float   wall_time_tracking;
+  float   cpu_time_tracking;
+  float   wall_time_drift;
+  float   cpu_time_drift;
+  float   wall_time_optical;
+  float   cpu_time_optical;
+  int64_t clustering_secondaries;
+  int64_t el_secondaries;
+  float   peak_rss;
+} performance_t;
+
+typedef struct{
+  int64_t event_id;
+  char    particle_name[STRLEN];
+  int64_t tracks;
+  int64_t steps;
+} performance_particle_t;
+
   hsize_t createRunType();
   hsize_t createSensorDataType();
+  hsize_t createSensorDigitType();
   hsize_t createHitInfoType(bool str);
   hsize_t createParticleInfoType(bool str);
   hsize_t createSensorPosType();
   hsize_t createStepType();
   hsize_t createStringMapType();
+  hsize_t createPerformanceType();
+  hsize_t createPerformanceParticleType();
 
   hid_t createTable(hid_t group, std::string& table_name, hsize_t memtype);
   hid_t createGroup(hid_t file, std::string& groupName);
 
+  // Used to reopen the tables of an existing file, e.g. when resuming a job
+  hid_t openOrCreateTable(hid_t group, std::string& table_name, hsize_t memtype);
+  hid_t openOrCreateGroup(hid_t file, std::string& groupName);
+  hsize_t getTableSize(hid_t dataset);
+  void resizeTable(hid_t dataset, hsize_t size);
+  void readTable(void* buffer, hid_t dataset, hid_t memtype);
+
   void writeRun(run_info_t* runData, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeSnsData(sns_data_t* snsData, hid_t dataset, hid_t memtype, hsize_t counter);
+  void writeSnsDigit(sns_digit_t* snsDigit, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeHit(hit_info_t* hitInfo, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeParticle(particle_info_t* particleInfo, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeSnsPos(sns_pos_t* snsPos, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeStep(step_info_t* step, hid_t dataset, hid_t memtype, hsize_t counter);
   void writeStringMap(string_map_t* strmap, hid_t dataset, hid_t memtype, hsize_t counter);
+  void writePerformance(performance_t* perf, hid_t dataset, hid_t memtype, hsize_t counter);
+  void writePerformanceParticle(performance_particle_t* perf, hid_t dataset, hid_t memtype, hsize_t counter);
 
 
 #endif
@@ -129,62 +129,70 @@ Electroluminescence::PostStepDoIt(const G4Track& track, const G4Step& step)
     (G4PhysicsOrderedFreeVector*)(*theFastIntegralTable_)(mat->GetIndex());
 
 
-  G4double sc_max = spectrum_integral->GetMaxValue();
-
   for (G4int i=0; i<num_photons; i++) {
-    // Generate a random direction for the photon
-    // (EL is supposed isotropic)
-    G4double cos_theta = 1. - 2.*G4UniformRand();
-    G4double sin_theta = sqrt((1.-cos_theta)*(1.+cos_theta));
+    G4Track* secondary = GeneratePhoton(*spectrum_integral, field,
+                                        initial_position, final_position);
+    secondary->SetParentID(track.GetTrackID());
+    ParticleChange_->AddSecondary(secondary);
+  }
 
-    G4double phi = twopi * G4UniformRand();
-    G4double sin_phi = sin(phi);
-    G4double cos_phi = cos(phi);
+  return G4VDiscreteProcess::PostStepDoIt(track, step);
+}
 
-    G4double px = sin_theta * cos_phi;
-    G4double py = sin_theta * sin_phi;
-    G4double pz = cos_theta;
 
-    G4ThreeVector momentum(px, py, pz);
 
-    // Determine photon polarization accordingly
-    G4double sx = cos_theta * cos_phi;
-    G4double sy = cos_theta * sin_phi;
-    G4double sz = -sin_theta;
+G4Track* Electroluminescence::GeneratePhoton(const G4PhysicsOrderedFreeVector& spectrum_integral,
+                                             BaseDriftField* field,
+                                             const G4LorentzVector& initial_position,
+                                             const G4LorentzVector& final_position)
+{
+  // Generate a random direction for the photon
+  // (EL is supposed isotropic)
+  G4double cos_theta = 1. - 2.*G4UniformRand();
+  G4double sin_theta = sqrt((1.-cos_theta)*(1.+cos_theta));
 
-    G4ThreeVector polarization(sx, sy, sz);
-    G4ThreeVector perp = momentum.cross(polarization);
+  G4double phi = twopi * G4UniformRand();
+  G4double sin_phi = sin(phi);
+  G4double cos_phi = cos(phi);
 
-    phi = twopi * G4UniformRand();
-    sin_phi = sin(phi);
-    cos_phi = cos(phi);
+  G4double px = sin_theta * cos_phi;
+  G4double py = sin_theta * sin_phi;
+  G4double pz = cos_theta;
 
-    polarization = cos_phi * polarization + sin_phi * perp;
-    polarization = polarization.unit();
+  G4ThreeVector momentum(px, py, pz);
 
-    // Generate a new photon and set properties
-    G4DynamicParticle* photon =
-      new G4DynamicParticle(G4OpticalPhoton::Definition(), momentum);
+  // Determine photon polarization accordingly
+  G4double sx = cos_theta * cos_phi;
+  G4double sy = cos_theta * sin_phi;
+  G4double sz = -sin_theta;
 
-    photon->
-      SetPolarization(polarization.x(), polarization.y(), polarization.z());
+  G4ThreeVector polarization(sx, sy, sz);
+  G4ThreeVector perp = momentum.cross(polarization);
 
-    // Determine photon energy
-    G4double sc_value = G4UniformRand()*sc_max;
-    G4double sampled_energy = spectrum_integral->GetEnergy(sc_value);
-    photon->SetKineticEnergy(sampled_energy);
+  phi = twopi * G4UniformRand();
+  sin_phi = sin(phi);
+  cos_phi = cos(phi);
 
-    G4LorentzVector xyzt =
-      field->GeneratePointAlongDriftLine(initial_position, final_position);
+  polarization = cos_phi * polarization + sin_phi * perp;
+  polarization = polarization.unit();
 
-    // Create the track
-    G4Track* secondary = new G4Track(photon, xyzt.t(), xyzt.v());
-    secondary->SetParentID(track.GetTrackID());
-    ParticleChange_->AddSecondary(secondary);
+  // Generate a new photon and set properties
+  G4DynamicParticle* photon =
+    new G4DynamicParticle(G4OpticalPhoton::Definition(), momentum);
 
-  }
+  photon->
+    SetPolarization(polarization.x(), polarization.y(), polarization.z());
 
-  return G4VDiscreteProcess::PostStepDoIt(track, step);
+  // Determine photon energy
+  G4double sc_value = G4UniformRand()*spectrum_integral.GetMaxValue();
+  G4double sampled_energy = spectrum_integral.GetEnergy(sc_value);
+  photon->SetKineticEnergy(sampled_energy);
+
+  G4LorentzVector xyzt =
+    field->GeneratePointAlongDriftLine(initial_position, final_position);
+
+  // Create the track
+  return new G4Track(photon, xyzt.t(), xyzt.v());
 }
 
 
@@ -11,6 +11,7 @@
 
 #include <G4VDiscreteProcess.hh>
 #include <G4PhysicsOrderedFreeVector.hh>
+#include <G4LorentzVector.hh>
 
 class G4ParticleChange;
 class G4GenericMessenger;
@@ -18,6 +19,8 @@ class G4GenericMessenger;
 
 namespace nexus {
 
+  class BaseDriftField;
+
   class Electroluminescence: public G4VDiscreteProcess
   {
   public:
@@ -36,6 +39,14 @@ namespace nexus {
     /// secondaries at the end of the step.
     G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
 
+    /// Generates an EL photon with isotropic direction, random
+    /// polarization, energy sampled from the given cumulative spectrum
+    /// and position along the drift line between the two 4D points
+    static G4Track* GeneratePhoton(const G4PhysicsOrderedFreeVector& spectrum_integral,
+                                   BaseDriftField* field,
+                                   const G4LorentzVector& initial_position,
+                                   const G4LorentzVector& final_position);
+
   private:
 
     /// Returns infinity; i.e., the process does not limit the step,
@@ -0,0 +1,168 @@
+// ----------------------------------------------------------------------------
+// nexus | MeshBoundaryProcess.cc
+//
+// Optical process that applies a HexagonMeshModel to the photons entering
+// the thin gas volumes registered as analytic meshes, in place of the
+// navigation through an explicit mesh of hexagonal holes.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "MeshBoundaryProcess.h"
+
+#include "HexagonMeshModel.h"
+
+#include <G4OpticalPhoton.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <G4AffineTransform.hh>
+#include <G4NavigationHistory.hh>
+#include <G4TouchableHandle.hh>
+#include <G4Step.hh>
+#include <G4Track.hh>
+
+
+namespace nexus {
+
+
+  using namespace CLHEP;
+
+  MeshBoundaryProcess::MeshBoundaryProcess(const G4String& process_name,
+                                           G4ProcessType type):
+    G4VDiscreteProcess(process_name, type), particle_change_(0)
+  {
+    // Create particle change object
+    particle_change_ = new G4ParticleChange();
+    pParticleChange = particle_change_;
+  }
+
+
+
+  MeshBoundaryProcess::~MeshBoundaryProcess()
+  {
+    delete particle_change_;
+  }
+
+
+
+  G4bool MeshBoundaryProcess::IsApplicable(const G4ParticleDefinition& pdef)
+  {
+    return pdef == *G4OpticalPhoton::Definition();
+  }
+
+
+
+  std::map<const G4LogicalVolume*, MeshBoundaryProcess::Mesh>&
+  MeshBoundaryProcess::Meshes()
+  {
+    static std::map<const G4LogicalVolume*, Mesh> meshes;
+    return meshes;
+  }
+
+
+
+  void MeshBoundaryProcess::AddMesh(const G4LogicalVolume* volume,
+                                    const HexagonMeshModel* model,
+                                    const G4MaterialPropertiesTable* surface)
+  {
+    Meshes()[volume] = {model, surface};
+  }
+
+
+
+  void MeshBoundaryProcess::RemoveMeshes(const HexagonMeshModel* model)
+  {
+    for (auto it = Meshes().begin(); it != Meshes().end(); ) {
+      if (it->second.model == model) it = Meshes().erase(it);
+      else ++it;
+    }
+  }
+
+
+
+  G4bool MeshBoundaryProcess::HasMeshes()
+  {
+    return !Meshes().empty();
+  }
+
+
+
+  G4VParticleChange*
+  MeshBoundaryProcess::PostStepDoIt(const G4Track& track, const G4Step& step)
+  {
+    G4StepPoint* pre  = step.GetPreStepPoint();
+    G4StepPoint* post = step.GetPostStepPoint();
+
+    // Only photons entering a mesh from outside are affected. The
+    // other steps, nearly all of them, leave the track as it is
+    // through the base particle change, which is cheaper to reset.
+    const G4VPhysicalVolume* volume = post->GetPhysicalVolume();
+    auto it = Meshes().end();
+    if (post->GetStepStatus() == fGeomBoundary && volume &&
+        volume != pre->GetPhysicalVolume())
+      it = Meshes().find(volume->GetLogicalVolume());
+
+    if (it == Meshes().end()) {
+      ClearNumberOfInteractionLengthLeft();
+      aParticleChange.Initialize(track);
+      return &aParticleChange;
+    }
+
+    // Initialize particle change with current track values
+    particle_change_->Initialize(track);
+
+    const Mesh& mesh = it->second;
+
+    G4double energy = track.GetDynamicParticle()->GetTotalMomentum();
+
+    G4MaterialPropertyVector* refl = mesh.surface->GetProperty("REFLECTIVITY");
+    G4double reflectivity = refl ? refl->Value(energy) : 0.;
+
+    // Specular spike and lobe are the same for the flat metal of
+    // a mesh; the rest of the reflected light is Lambertian
+    G4double specular = 0.;
+    for (const auto& name : {"SPECULARSPIKECONSTANT", "SPECULARLOBECONSTANT"}) {
+      G4MaterialPropertyVector* prob = mesh.surface->GetProperty(name);
+      if (prob) specular += prob->Value(energy);
+    }
+
+    // The model works in the frame of the mesh, which
+    // includes the rotation of its placement
+    const G4AffineTransform& transform =
+      post->GetTouchableHandle()->GetHistory()->GetTopTransform();
+
+    G4ThreeVector position  = transform.TransformPoint(post->GetPosition());
+    G4ThreeVector direction = transform.TransformAxis(track.GetMomentumDirection());
+
+    HexagonMeshModel::Outcome outcome =
+      mesh.model->Propagate(position, direction, reflectivity, specular);
+
+    if (outcome == HexagonMeshModel::ABSORBED) {
+      particle_change_->ProposeTrackStatus(fStopAndKill);
+      return particle_change_;
+    }
+
+    direction = transform.Inverse().TransformAxis(direction).unit();
+
+    // Keep the polarization perpendicular to the new direction
+    G4ThreeVector polarization = track.GetPolarization();
+    polarization -= polarization.dot(direction) * direction;
+    if (polarization.mag2() < 1.e-12) polarization = direction.orthogonal();
+
+    particle_change_->ProposeMomentumDirection(direction);
+    particle_change_->ProposePolarization(polarization.unit());
+
+    return particle_change_;
+  }
+
+
+
+  G4double MeshBoundaryProcess::GetMeanFreePath(const G4Track&, G4double,
+                                                G4ForceCondition* condition)
+  {
+    *condition = Forced;
+    return DBL_MAX;
+  }
+
+} // end namespace nexus
@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------------
+// nexus | MeshBoundaryProcess.h
+//
+// Optical process that applies a HexagonMeshModel to the photons entering
+// the thin gas volumes registered as analytic meshes, in place of the
+// navigation through an explicit mesh of hexagonal holes.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef MESH_BOUNDARY_PROCESS_H
+#define MESH_BOUNDARY_PROCESS_H
+
+#include <G4VDiscreteProcess.hh>
+
+#include <map>
+
+class G4LogicalVolume;
+class G4MaterialPropertiesTable;
+
+namespace nexus {
+
+  class HexagonMeshModel;
+
+  class MeshBoundaryProcess: public G4VDiscreteProcess
+  {
+  public:
+    /// Constructor
+    MeshBoundaryProcess(const G4String& process_name="MeshBoundary",
+                        G4ProcessType type = fOptical);
+    /// Destructor
+    ~MeshBoundaryProcess();
+
+    /// Whether a particle is sensitive to this physics.
+    /// Only optical photons apply
+    G4bool IsApplicable(const G4ParticleDefinition&);
+
+    /// Applies the mesh model to photons entering a registered volume
+    G4VParticleChange* PostStepDoIt(const G4Track&, const G4Step&);
+
+    /// Declare a volume as an analytic mesh. The metal of the mesh
+    /// is described by the REFLECTIVITY and SPECULARSPIKECONSTANT
+    /// properties of the surface table.
+    static void AddMesh(const G4LogicalVolume*, const HexagonMeshModel*,
+                        const G4MaterialPropertiesTable* surface);
+    /// Remove the meshes described by a model, e.g. when it is deleted
+    static void RemoveMeshes(const HexagonMeshModel*);
+    /// Whether any volume is declared as an analytic mesh
+    static G4bool HasMeshes();
+
+  private:
+    /// Returns infinity; i. e. the process does not limit the step,
+    /// but sets the 'Forced' condition for the PostStepDoIt
+    /// to be invoked at every step
+    G4double GetMeanFreePath(const G4Track&, G4double, G4ForceCondition*);
+
+  private:
+    struct Mesh
+    {
+      const HexagonMeshModel* model;
+      const G4MaterialPropertiesTable* surface;
+    };
+
+    static std::map<const G4LogicalVolume*, Mesh>& Meshes();
+
+    G4ParticleChange* particle_change_;
+  };
+
+} // end namespace nexus
+
+#endif
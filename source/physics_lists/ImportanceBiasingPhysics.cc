@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+// nexus | ImportanceBiasingPhysics.cc
+//
+// This class sets up geometry-importance biasing (splitting and Russian
+// roulette at volume boundaries) for the chosen particles, using the
+// importance sampling machinery of Geant4 in the mass geometry. It is meant
+// to speed up the simulation of external backgrounds through the shielding.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "ImportanceBiasingPhysics.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4GeometrySampler.hh>
+#include <G4GeometryCell.hh>
+#include <G4IStore.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
+#include <G4PhysicsConstructorFactory.hh>
+
+#include <sstream>
+
+
+namespace nexus {
+
+  /// Macro that allows the use of this physics constructor
+  /// with the generic physics list
+  G4_DECLARE_PHYSCONSTR_FACTORY(ImportanceBiasingPhysics);
+
+
+
+  ImportanceBiasingPhysics::ImportanceBiasingPhysics():
+    G4VPhysicsConstructor("ImportanceBiasingPhysics"),
+    particles_({"gamma", "neutron"})
+  {
+    msg_ = new G4GenericMessenger(this, "/PhysicsList/Importance/",
+      "Control commands of the geometry-importance biasing.");
+
+    msg_->DeclareMethod("particles", &ImportanceBiasingPhysics::SetParticles,
+      "Names of the biased particles, separated by spaces.");
+
+    msg_->DeclareMethod("volume", &ImportanceBiasingPhysics::SetVolumeImportance,
+      "Importance of a physical volume, given as 'name value'. "
+      "Volumes not set inherit the importance of their mother.");
+  }
+
+
+
+  ImportanceBiasingPhysics::~ImportanceBiasingPhysics()
+  {
+    delete msg_;
+  }
+
+
+
+  void ImportanceBiasingPhysics::SetParticles(G4String names)
+  {
+    particles_.clear();
+
+    std::istringstream iss(names);
+    G4String name;
+    while (iss >> name) particles_.push_back(name);
+  }
+
+
+
+  void ImportanceBiasingPhysics::SetVolumeImportance(G4String command)
+  {
+    std::istringstream iss(command);
+    G4String name;
+    G4double importance = -1.;
+    iss >> name >> importance;
+
+    if (iss.fail() || importance < 0.)
+      G4Exception("[ImportanceBiasingPhysics]", "SetVolumeImportance()",
+                  FatalException, ("Wrong volume importance: " + command).c_str());
+
+    importances_[name] = importance;
+  }
+
+
+
+  void ImportanceBiasingPhysics::ConstructParticle()
+  {
+  }
+
+
+
+  void ImportanceBiasingPhysics::ConstructProcess()
+  {
+    if (importances_.empty()) {
+      G4Exception("[ImportanceBiasingPhysics]", "ConstructProcess()",
+                  JustWarning, "No volume importances given, biasing is off.");
+      return;
+    }
+
+    // The geometry is already built when the processes are constructed
+    G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()->
+      GetNavigatorForTracking()->GetWorldVolume();
+
+    G4IStore* istore = G4IStore::GetInstance();
+    FillImportanceStore(istore, world);
+
+    for (const auto& imp : importances_) {
+      if (found_.find(imp.first) == found_.end())
+        G4Exception("[ImportanceBiasingPhysics]", "ConstructProcess()",
+                    JustWarning, ("Volume " + imp.first +
+                                  " not found in the geometry.").c_str());
+    }
+
+    // One sampler per particle, which places the importance
+    // process in its process manager
+    for (const auto& particle : particles_) {
+      auto sampler = std::make_unique<G4GeometrySampler>(world, particle);
+      sampler->SetParallel(false);
+      sampler->PrepareImportanceSampling(istore, nullptr);
+      sampler->Configure();
+      samplers_.push_back(std::move(sampler));
+    }
+  }
+
+
+
+  void ImportanceBiasingPhysics::FillImportanceStore(G4IStore* istore,
+                                                     G4VPhysicalVolume* world)
+  {
+    G4double importance = 1.;
+    auto it = importances_.find(world->GetName());
+    if (it != importances_.end()) {
+      importance = it->second;
+      found_.insert(it->first);
+    }
+
+    AddCell(istore, importance, *world, 0);
+
+    std::set<const G4LogicalVolume*> visited;
+    AddDaughterCells(istore, world->GetLogicalVolume(), importance, visited);
+  }
+
+
+
+  void ImportanceBiasingPhysics::AddDaughterCells(G4IStore* istore,
+                                                  const G4LogicalVolume* mother,
+                                                  G4double mother_importance,
+                                                  std::set<const G4LogicalVolume*>& visited)
+  {
+    // Daughters of a logical volume placed more than once
+    // are the same physical volumes, so they are added only once
+    if (!visited.insert(mother).second) return;
+
+    for (size_t i=0; i<mother->GetNoDaughters(); ++i) {
+      G4VPhysicalVolume* daughter = mother->GetDaughter(i);
+
+      G4double importance = mother_importance;
+      auto it = importances_.find(daughter->GetName());
+      if (it != importances_.end()) {
+        importance = it->second;
+        found_.insert(it->first);
+      }
+
+      // The importance process identifies cells by the replica
+      // number of the touchable, which is the copy number of placements
+      if (daughter->IsReplicated()) {
+        for (G4int r=0; r<daughter->GetMultiplicity(); ++r)
+          AddCell(istore, importance, *daughter, r);
+      }
+      else {
+        AddCell(istore, importance, *daughter, daughter->GetCopyNo());
+      }
+
+      AddDaughterCells(istore, daughter->GetLogicalVolume(), importance, visited);
+    }
+  }
+
+
+
+  void ImportanceBiasingPhysics::AddCell(G4IStore* istore, G4double importance,
+                                         const G4VPhysicalVolume& volume,
+                                         G4int replica)
+  {
+    if (istore->IsKnown(G4GeometryCell(volume, replica))) return;
+    istore->AddImportanceGeometryCell(importance, volume, replica);
+  }
+
+} // end namespace nexus
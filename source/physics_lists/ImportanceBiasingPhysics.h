@@ -0,0 +1,71 @@
+// ----------------------------------------------------------------------------
+// nexus | ImportanceBiasingPhysics.h
+//
+// This class sets up geometry-importance biasing (splitting and Russian
+// roulette at volume boundaries) for the chosen particles, using the
+// importance sampling machinery of Geant4 in the mass geometry. It is meant
+// to speed up the simulation of external backgrounds through the shielding.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef IMPORTANCE_BIASING_PHYSICS_H
+#define IMPORTANCE_BIASING_PHYSICS_H
+
+#include <G4VPhysicsConstructor.hh>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+class G4GenericMessenger;
+class G4GeometrySampler;
+class G4IStore;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+
+namespace nexus {
+
+  class ImportanceBiasingPhysics: public G4VPhysicsConstructor
+  {
+  public:
+    /// Constructor
+    ImportanceBiasingPhysics();
+    /// Destructor
+    ~ImportanceBiasingPhysics();
+
+    /// Construct all required particles (Geant4 mandatory method)
+    virtual void ConstructParticle();
+    /// Construct all required physics processes (Geant4 mandatory method)
+    virtual void ConstructProcess();
+
+  private:
+    /// Set the list of biased particles (names separated by spaces)
+    void SetParticles(G4String);
+    /// Set the importance of a physical volume ("name value")
+    void SetVolumeImportance(G4String);
+
+    /// Register an importance for every cell of the geometry.
+    /// Volumes without an explicit value inherit that of their mother.
+    void FillImportanceStore(G4IStore*, G4VPhysicalVolume* world);
+    void AddDaughterCells(G4IStore*, const G4LogicalVolume* mother,
+                          G4double mother_importance,
+                          std::set<const G4LogicalVolume*>& visited);
+    void AddCell(G4IStore*, G4double importance,
+                 const G4VPhysicalVolume&, G4int replica);
+
+  private:
+    std::vector<G4String> particles_; ///< Names of the biased particles
+    std::map<G4String, G4double> importances_; ///< Importance per volume name
+    std::set<G4String> found_; ///< Configured volumes present in the geometry
+
+    std::vector<std::unique_ptr<G4GeometrySampler>> samplers_;
+
+    G4GenericMessenger* msg_;
+  };
+
+} // end namespace nexus
+
+#endif
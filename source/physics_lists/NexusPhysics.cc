@@ -13,6 +13,7 @@
 #include "IonizationDrift.h"
 #include "Electroluminescence.h"
 #include "OpPhotoelectricEffect.h"
+#include "MeshBoundaryProcess.h"
 
 #include <G4GenericMessenger.hh>
 #include <G4OpticalPhoton.hh>
@@ -135,6 +136,15 @@ namespace nexus {
         }
       }
     }
+
+    // Add the model of the analytic meshes to optical photons, only if the
+    // geometry, which is already built, declares such meshes, since it is
+    // invoked at every optical step
+    if (MeshBoundaryProcess::HasMeshes()) {
+      MeshBoundaryProcess* mesh = new MeshBoundaryProcess();
+      pmanager = G4OpticalPhoton::Definition()->GetProcessManager();
+      if (pmanager) pmanager->AddDiscreteProcess(mesh);
+    }
   }
 
 } // end namespace nexus
@@ -0,0 +1,203 @@
+// ----------------------------------------------------------------------------
+// nexus | PhysicsTableCache.cc
+//
+// This class keeps the physics tables of Geant4 in a cache directory, so that
+// later jobs with the same configuration retrieve them instead of building
+// them. Tables are stored in a subdirectory named after a hash of the
+// processes of every particle, the production cuts, the EM parameters and
+// the materials, including their optical properties.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "PhysicsTableCache.h"
+
+#include <G4VUserPhysicsList.hh>
+#include <G4ParticleTable.hh>
+#include <G4ProcessManager.hh>
+#include <G4ProcessVector.hh>
+#include <G4VProcess.hh>
+#include <G4RegionStore.hh>
+#include <G4ProductionCuts.hh>
+#include <G4Material.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <G4EmParameters.hh>
+#include <G4Version.hh>
+#include <G4ios.hh>
+
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+
+namespace {
+
+  /// 64-bit FNV-1a hash of a string
+  uint64_t Hash(const std::string& text)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  G4bool DirectoryExists(const G4String& path)
+  {
+    struct stat dir_stat;
+    return stat(path.c_str(), &dir_stat) == 0 && S_ISDIR(dir_stat.st_mode);
+  }
+
+  /// Removes a directory and the files in it
+  void RemoveDirectory(const G4String& path)
+  {
+    DIR* dir = opendir(path.c_str());
+    if (dir) {
+      while (dirent* entry = readdir(dir)) {
+        G4String name = entry->d_name;
+        if (name != "." && name != "..")
+          std::remove((path + "/" + name).c_str());
+      }
+      closedir(dir);
+    }
+    rmdir(path.c_str());
+  }
+
+}
+
+
+namespace nexus {
+
+  PhysicsTableCache::PhysicsTableCache(const G4String& cache_dir):
+    cache_dir_(cache_dir), retrieved_(false), stored_(false)
+  {
+  }
+
+
+
+  PhysicsTableCache::~PhysicsTableCache()
+  {
+  }
+
+
+
+  void PhysicsTableCache::Setup(G4VUserPhysicsList* physics_list)
+  {
+    std::ostringstream dir;
+    dir << cache_dir_ << "/physics_" << std::hex << std::setw(16)
+        << std::setfill('0') << ComputeKey(physics_list);
+    table_dir_ = dir.str();
+
+    // Directories are only renamed to their final name once complete
+    retrieved_ = DirectoryExists(table_dir_);
+
+    if (retrieved_) {
+      physics_list->SetPhysicsTableRetrieved(table_dir_);
+      G4cout << "[PhysicsTableCache] Retrieving physics tables from "
+             << table_dir_ << G4endl;
+    }
+    else {
+      G4cout << "[PhysicsTableCache] Physics tables will be stored in "
+             << table_dir_ << G4endl;
+    }
+  }
+
+
+
+  void PhysicsTableCache::Store(G4VUserPhysicsList* physics_list)
+  {
+    if (retrieved_ || stored_ || table_dir_.empty()) return;
+    stored_ = true;
+
+    mkdir(cache_dir_.c_str(), 0755);
+
+    // Tables are written to a temporary directory and renamed,
+    // so that concurrent jobs never read an incomplete set
+    G4String tmp_dir = table_dir_ + ".tmp" + std::to_string(getpid());
+
+    if (mkdir(tmp_dir.c_str(), 0755) != 0 ||
+        !physics_list->StorePhysicsTable(tmp_dir) ||
+        (rename(tmp_dir.c_str(), table_dir_.c_str()) != 0 &&
+         !DirectoryExists(table_dir_))) {
+      G4cout << "[PhysicsTableCache] Cannot store the physics tables in "
+             << table_dir_ << G4endl;
+    }
+
+    // Left over if another job stored the same tables first
+    if (DirectoryExists(tmp_dir)) RemoveDirectory(tmp_dir);
+  }
+
+
+
+  uint64_t PhysicsTableCache::ComputeKey(const G4VUserPhysicsList* physics_list)
+  {
+    std::ostringstream config;
+    config << std::setprecision(17);
+
+    config << "geant4 " << G4VERSION_NUMBER << "\n";
+
+    // Processes attached to each particle
+    G4ParticleTable::G4PTblDicIterator* particles =
+      G4ParticleTable::GetParticleTable()->GetIterator();
+    particles->reset();
+    while ((*particles)()) {
+      G4ParticleDefinition* particle = particles->value();
+      config << particle->GetParticleName() << ":";
+
+      G4ProcessManager* pmanager = particle->GetProcessManager();
+      if (!pmanager) continue;
+
+      G4ProcessVector* processes = pmanager->GetProcessList();
+      for (size_t i=0; i<processes->size(); ++i)
+        config << " " << (*processes)[i]->GetProcessName();
+      config << "\n";
+    }
+
+    // Production cuts
+    config << "cut " << physics_list->GetDefaultCutValue() << "\n";
+    for (const auto region : *G4RegionStore::GetInstance()) {
+      config << region->GetName();
+      G4ProductionCuts* cuts = region->GetProductionCuts();
+      if (cuts) {
+        for (const auto cut : cuts->GetProductionCuts())
+          config << " " << cut;
+      }
+      config << "\n";
+    }
+
+    // EM options set by commands
+    G4EmParameters::Instance()->StreamInfo(config);
+
+    // Materials, including their optical properties
+    for (const auto material : *G4Material::GetMaterialTable()) {
+      config << *material << "\n";
+
+      G4MaterialPropertiesTable* mpt = material->GetMaterialPropertiesTable();
+      if (!mpt) continue;
+
+      std::vector<G4String> names = mpt->GetMaterialPropertyNames();
+      for (const auto& name : names) {
+        G4MaterialPropertyVector* property = mpt->GetProperty(name);
+        if (!property) continue;
+        config << name;
+        for (size_t i=0; i<property->GetVectorLength(); ++i)
+          config << " " << property->Energy(i) << " " << (*property)[i];
+        config << "\n";
+      }
+
+      std::vector<G4String> const_names = mpt->GetMaterialConstPropertyNames();
+      for (const auto& name : const_names) {
+        if (mpt->ConstPropertyExists(name))
+          config << name << " " << mpt->GetConstProperty(name) << "\n";
+      }
+    }
+
+    return Hash(config.str());
+  }
+
+} // end namespace nexus
@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// nexus | PhysicsTableCache.h
+//
+// This class keeps the physics tables of Geant4 in a cache directory, so that
+// later jobs with the same configuration retrieve them instead of building
+// them. Tables are stored in a subdirectory named after a hash of the
+// processes of every particle, the production cuts, the EM parameters and
+// the materials, including their optical properties.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef PHYSICS_TABLE_CACHE_H
+#define PHYSICS_TABLE_CACHE_H
+
+#include <G4String.hh>
+
+#include <cstdint>
+
+class G4VUserPhysicsList;
+
+
+namespace nexus {
+
+  class PhysicsTableCache
+  {
+  public:
+    /// Constructor
+    PhysicsTableCache(const G4String& cache_dir);
+    /// Destructor
+    ~PhysicsTableCache();
+
+    /// Computes the key of the current configuration and, if tables
+    /// exist for it, asks the physics list to retrieve them.
+    /// It must be called after the initialization of the run manager.
+    void Setup(G4VUserPhysicsList*);
+
+    /// Stores the tables, unless they were retrieved.
+    /// It must be called once the physics tables are built.
+    void Store(G4VUserPhysicsList*);
+
+    /// Hash of the configuration that determines the physics tables
+    static uint64_t ComputeKey(const G4VUserPhysicsList*);
+
+    const G4String& GetDirectory() const;
+    G4bool IsRetrieved() const;
+
+  private:
+    G4String cache_dir_; ///< Directory that holds the cached tables
+    G4String table_dir_; ///< Subdirectory of the current configuration
+    G4bool retrieved_;   ///< True if the tables are read from the cache
+    G4bool stored_;      ///< True once the tables are in the cache
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline const G4String& PhysicsTableCache::GetDirectory() const
+  { return table_dir_; }
+
+  inline G4bool PhysicsTableCache::IsRetrieved() const
+  { return retrieved_; }
+
+} // end namespace nexus
+
+#endif
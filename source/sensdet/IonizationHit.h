@@ -40,23 +40,28 @@ namespace nexus {
     void operator delete(void*);
 
   public:
-    G4int GetTrackID();
+    G4int GetTrackID() const;
     void SetTrackID(G4int);
 
-    G4double GetTime();
+    G4double GetTime() const;
     void SetTime(G4double);
 
-    G4double GetEnergyDeposit();
+    G4double GetEnergyDeposit() const;
     void SetEnergyDeposit(G4double);
 
-    G4ThreeVector GetPosition();
+    G4ThreeVector GetPosition() const;
     void SetPosition(G4ThreeVector);
 
+    /// Statistical weight of the track while it left the deposit
+    G4double GetWeight() const;
+    void SetWeight(G4double);
+
   private:
     G4int track_id_;
     G4double time_;
     G4double energy_dep_;
     G4ThreeVector position_;
+    G4double weight_;
   };
 
 
@@ -72,20 +77,23 @@ namespace nexus {
   inline void IonizationHit::operator delete(void* aHit)
   { IonizationHitAllocator.FreeSingle((IonizationHit*) aHit); }
 
-  inline G4int IonizationHit::GetTrackID() { return track_id_; }
+  inline G4int IonizationHit::GetTrackID() const { return track_id_; }
   inline void IonizationHit::SetTrackID(G4int id) { track_id_ = id; }
 
-  inline G4double IonizationHit::GetTime() { return time_; }
+  inline G4double IonizationHit::GetTime() const { return time_; }
   inline void IonizationHit::SetTime(G4double t) { time_ = t; }
 
-  inline G4double IonizationHit::GetEnergyDeposit() { return energy_dep_; }
+  inline G4double IonizationHit::GetEnergyDeposit() const { return energy_dep_; }
   inline void IonizationHit::SetEnergyDeposit(G4double edep)
   { energy_dep_ = edep; }
 
-  inline G4ThreeVector IonizationHit::GetPosition() { return position_; }
+  inline G4ThreeVector IonizationHit::GetPosition() const { return position_; }
   inline void IonizationHit::SetPosition(G4ThreeVector xyz)
   { position_ = xyz; }
 
+  inline G4double IonizationHit::GetWeight() const { return weight_; }
+  inline void IonizationHit::SetWeight(G4double w) { weight_ = w; }
+
 
 } // end namespace nexus
 
@@ -16,12 +16,22 @@
 #include <G4SDManager.hh>
 #include <G4Step.hh>
 #include <G4OpticalPhoton.hh>
+#include <geomdefs.hh>
+
+#include <algorithm>
 
 
 
 using namespace nexus;
 
 
+namespace {
+  /// Global time of the earliest hit of all the
+  /// ionization SDs in the current event
+  G4double first_hit_time = kInfinity;
+}
+
+
 
 IonizationSD::IonizationSD(const G4String& name):
   G4VSensitiveDetector(name), include_(true)
@@ -37,6 +47,13 @@ IonizationSD::~IonizationSD()
 
 
 
+G4double IonizationSD::GetFirstHitTime()
+{
+  return first_hit_time;
+}
+
+
+
 G4String IonizationSD::GetCollectionUniqueName()
 {
   G4String name = "IonizationHitsCollection";
@@ -57,6 +74,7 @@ void IonizationSD::Initialize(G4HCofThisEvent* hce)
     G4SDManager::GetSDMpointer()->GetCollectionID(SensitiveDetectorName+"/"+collectionName[0]);
   hce->AddHitsCollection(hcid, IHC_);
 
+  first_hit_time = kInfinity;
 }
 
 
@@ -78,8 +96,11 @@ G4bool IonizationSD::ProcessHits(G4Step* step, G4TouchableHistory*)
   IonizationHit* hit = new IonizationHit();
   hit->SetTrackID(step->GetTrack()->GetTrackID());
   hit->SetTime(step->GetTrack()->GetGlobalTime());
+  first_hit_time = std::min(first_hit_time, hit->GetTime());
   hit->SetEnergyDeposit(edep);
   hit->SetPosition(step->GetPostStepPoint()->GetPosition());
+  // Biasing may change the weight of the track at the end of the step
+  hit->SetWeight(step->GetPreStepPoint()->GetWeight());
 
   // Add hit to collection
   IHC_->insert(hit);
@@ -40,6 +40,10 @@ namespace nexus {
     /// manager to fetch the collection from the G4HCofThisEvent object.
     static G4String GetCollectionUniqueName();
 
+    /// Return the global time of the earliest hit of all the ionization
+    /// SDs in the current event, or kInfinity if there is none yet
+    static G4double GetFirstHitTime();
+
     void IncludeInTotalEnergyDeposit(G4bool);
 
   private:
@@ -0,0 +1,279 @@
+// ----------------------------------------------------------------------------
+// nexus | SensorDigitizer.cc
+//
+// This class digitizes the photon histograms of the photosensors before they
+// are written: dark counts and gain fluctuations are added, the histogram is
+// convolved with the single-photoelectron response of each type of sensor
+// and the result is stored either as a zero-suppressed waveform or as an
+// integrated charge per sensor.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SensorDigitizer.h"
+#include "SensorHit.h"
+
+#include <G4GenericMessenger.hh>
+#include <G4UIcommand.hh>
+#include <G4UnitsTable.hh>
+#include <G4Poisson.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+
+namespace nexus {
+
+  SensorDigitizer::SensorDigitizer():
+    output_(NONE), keep_raw_(true)
+  {
+    msg_ = new G4GenericMessenger(this, "/nexus/digitization/",
+                                  "Control commands of the digitization of the sensors.");
+
+    msg_->DeclareMethod("output", &SensorDigitizer::SetOutputName,
+                        "Digitized output of the sensors: none, waveform "
+                        "(zero-suppressed) or charge (integrated per sensor).");
+    msg_->DeclareProperty("keep_raw", keep_raw_,
+                          "Store the photon histograms of the sensors too.");
+
+    msg_->DeclareMethod("kernel", &SensorDigitizer::SetKernel,
+                        "Single-photoelectron response of the sensors of a "
+                        "sensitive detector: 'sd_name file', with one value "
+                        "per time bin of the sensor. The detector is named with "
+                        "or without its path, or 'all' for every sensor.");
+    msg_->DeclareMethod("gain_spread", &SensorDigitizer::SetGainSpread,
+                        "Relative width of the charge of a photoelectron: "
+                        "'sd_name value'.");
+    msg_->DeclareMethod("dark_rate", &SensorDigitizer::SetDarkRate,
+                        "Rate of dark counts of each sensor: 'sd_name value unit'.");
+    msg_->DeclareMethod("threshold", &SensorDigitizer::SetThreshold,
+                        "Zero suppression threshold, in photoelectrons per "
+                        "sample or per sensor: 'sd_name value'.");
+  }
+
+
+
+  SensorDigitizer::~SensorDigitizer()
+  {
+    delete msg_;
+  }
+
+
+
+  const SensorDigitizer::Response&
+  SensorDigitizer::GetResponse(const G4String& sd_name) const
+  {
+    auto it = responses_.find(sd_name);
+    if (it != responses_.end()) return it->second;
+
+    // The settings for all the sensors are overridden
+    // by those given for the sensitive detector
+    Response response = ideal_;
+    for (const G4String& name : {G4String("all"), sd_name}) {
+      auto settings = settings_.find(name);
+      if (settings == settings_.end()) continue;
+
+      const Settings& given = settings->second;
+      if (given.kernel)      response.kernel      = given.response.kernel;
+      if (given.gain_spread) response.gain_spread = given.response.gain_spread;
+      if (given.dark_rate)   response.dark_rate   = given.response.dark_rate;
+      if (given.threshold)   response.threshold   = given.response.threshold;
+    }
+
+    return responses_.emplace(sd_name, response).first->second;
+  }
+
+
+
+  void SensorDigitizer::SetResponse(const G4String& sd_name, const Response& response)
+  {
+    settings_[sd_name] = {response, true, true, true, true};
+    responses_.clear();
+  }
+
+
+
+  void SensorDigitizer::Digitize(const SensorHit& hit, const Response& response,
+                                 G4double start, G4double end,
+                                 std::vector<Sample>& samples)
+  {
+    samples.clear();
+
+    G4double bin_size = hit.GetBinSize();
+    int64_t first_bin = std::floor(start / bin_size);
+    int64_t last_bin  = std::ceil (end   / bin_size);
+    if (last_bin <= first_bin) return;
+    size_t nbins = last_bin - first_bin;
+
+    // The sparse histogram is spread over a dense array of the window
+    photons_.assign(nbins, 0.f);
+    for (const auto& bin : hit.GetHistogram()) {
+      int64_t i = std::llround(bin.first / bin_size) - first_bin;
+      if (i >= 0 && i < static_cast<int64_t>(nbins)) photons_[i] += bin.second;
+    }
+
+    // Dark counts, uniform in the window
+    if (response.dark_rate > 0.) {
+      G4long ndark = G4Poisson(response.dark_rate * nbins * bin_size);
+      for (G4long i=0; i<ndark; ++i)
+        photons_[std::min<size_t>(G4UniformRand() * nbins, nbins - 1)] += 1.f;
+    }
+
+    // Fluctuations of the gain, added up for all the
+    // photoelectrons of a time bin
+    if (response.gain_spread > 0.) {
+      for (auto& n : photons_)
+        if (n > 0.f)
+          n = std::max(0., G4RandGauss::shoot(n, response.gain_spread * std::sqrt(n)));
+    }
+
+    // Convolution with the response. Only the bins with photoelectrons
+    // contribute, and the loop over the kernel runs over contiguous
+    // arrays so that the compiler vectorizes it.
+    if (response.kernel.empty()) {
+      waveform_.swap(photons_);
+    }
+    else {
+      const float* kernel = response.kernel.data();
+      size_t nkernel = response.kernel.size();
+
+      waveform_.assign(nbins + nkernel - 1, 0.f);
+      for (size_t i=0; i<nbins; ++i) {
+        const float n = photons_[i];
+        if (n == 0.f) continue;
+        float* signal = waveform_.data() + i;
+        for (size_t j=0; j<nkernel; ++j) signal[j] += n * kernel[j];
+      }
+    }
+
+    if (output_ == CHARGE) {
+      float charge = std::accumulate(waveform_.begin(), waveform_.end(), 0.f);
+      if (charge > response.threshold) samples.push_back({first_bin, charge});
+      return;
+    }
+
+    for (size_t i=0; i<waveform_.size(); ++i)
+      if (waveform_[i] > response.threshold)
+        samples.push_back({first_bin + static_cast<int64_t>(i), waveform_[i]});
+  }
+
+
+
+  void SensorDigitizer::SetOutputName(G4String output)
+  {
+    if      (output == "none")     output_ = NONE;
+    else if (output == "waveform") output_ = WAVEFORM;
+    else if (output == "charge")   output_ = CHARGE;
+    else
+      G4Exception("[SensorDigitizer]", "SetOutputName()", FatalErrorInArgument,
+                  ("Unknown digitized output " + output +
+                   ". Possible are none, waveform and charge.").c_str());
+  }
+
+
+
+  SensorDigitizer::Settings&
+  SensorDigitizer::EditSettings(std::istringstream& command, const G4String& method)
+  {
+    G4String sd_name;
+    if (!(command >> sd_name))
+      G4Exception("[SensorDigitizer]", method.c_str(), FatalErrorInArgument,
+                  "The name of a sensitive detector is needed.");
+
+    // Hits collections know the name of their detector without its path
+    sd_name = sd_name.substr(sd_name.rfind('/') + 1);
+
+    // The responses are resolved again from the new settings
+    responses_.clear();
+    return settings_[sd_name];
+  }
+
+
+
+  void SensorDigitizer::SetKernel(G4String command)
+  {
+    std::istringstream iss(command);
+    Settings& settings = EditSettings(iss, "SetKernel()");
+
+    G4String filename;
+    iss >> filename;
+    std::ifstream file(filename);
+    if (!file)
+      G4Exception("[SensorDigitizer]", "SetKernel()", FatalException,
+                  ("Could not read the response file " + filename).c_str());
+
+    std::vector<float> kernel;
+    std::string line;
+    while (std::getline(file, line)) {
+      std::istringstream values(line.substr(0, line.find('#')));
+      float value;
+      while (values >> value) {
+        kernel.push_back(value);
+        if (values.peek() == ',') values.ignore();
+      }
+    }
+
+    G4double total = std::accumulate(kernel.begin(), kernel.end(), 0.);
+    if (kernel.empty() || total <= 0.)
+      G4Exception("[SensorDigitizer]", "SetKernel()", FatalException,
+                  ("No response found in " + filename).c_str());
+
+    for (auto& value : kernel) value /= total;
+    settings.response.kernel = kernel;
+    settings.kernel = true;
+  }
+
+
+
+  void SensorDigitizer::SetGainSpread(G4String command)
+  {
+    std::istringstream iss(command);
+    Settings& settings = EditSettings(iss, "SetGainSpread()");
+    Response& response = settings.response;
+
+    if (!(iss >> response.gain_spread) || response.gain_spread < 0.)
+      G4Exception("[SensorDigitizer]", "SetGainSpread()", FatalErrorInArgument,
+                  ("Wrong gain spread: " + command).c_str());
+
+    settings.gain_spread = true;
+  }
+
+
+
+  void SensorDigitizer::SetDarkRate(G4String command)
+  {
+    std::istringstream iss(command);
+    Settings& settings = EditSettings(iss, "SetDarkRate()");
+    Response& response = settings.response;
+
+    // An unknown unit would give a null rate
+    G4String unit;
+    if (!(iss >> response.dark_rate >> unit) || response.dark_rate < 0. ||
+        !G4UnitDefinition::IsUnitDefined(unit))
+      G4Exception("[SensorDigitizer]", "SetDarkRate()", FatalErrorInArgument,
+                  ("Wrong dark count rate: " + command).c_str());
+
+    response.dark_rate *= G4UIcommand::ValueOf(unit);
+    settings.dark_rate = true;
+  }
+
+
+
+  void SensorDigitizer::SetThreshold(G4String command)
+  {
+    std::istringstream iss(command);
+    Settings& settings = EditSettings(iss, "SetThreshold()");
+    Response& response = settings.response;
+
+    if (!(iss >> response.threshold))
+      G4Exception("[SensorDigitizer]", "SetThreshold()", FatalErrorInArgument,
+                  ("Wrong threshold: " + command).c_str());
+
+    settings.threshold = true;
+  }
+
+} // end namespace nexus
@@ -0,0 +1,127 @@
+// ----------------------------------------------------------------------------
+// nexus | SensorDigitizer.h
+//
+// This class digitizes the photon histograms of the photosensors before they
+// are written: dark counts and gain fluctuations are added, the histogram is
+// convolved with the single-photoelectron response of each type of sensor
+// and the result is stored either as a zero-suppressed waveform or as an
+// integrated charge per sensor.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SENSOR_DIGITIZER_H
+#define SENSOR_DIGITIZER_H
+
+#include <G4String.hh>
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+class G4GenericMessenger;
+
+
+namespace nexus {
+
+  class SensorHit;
+
+  class SensorDigitizer
+  {
+  public:
+    enum Output { NONE, WAVEFORM, CHARGE };
+
+    /// Response of a type of sensor
+    struct Response
+    {
+      /// Signal of one photoelectron in consecutive time bins of the
+      /// sensor, normalised to one. A single bin if empty.
+      std::vector<float> kernel;
+      G4double gain_spread = 0.; ///< Relative width of the charge of a photoelectron
+      G4double dark_rate   = 0.; ///< Rate of dark counts of a sensor
+      G4double threshold   = 0.; ///< Zero suppression threshold, in photoelectrons
+    };
+
+    /// Digitized charge in a time bin of a sensor
+    struct Sample
+    {
+      int64_t time_bin;
+      float   charge;
+    };
+
+    /// Constructor
+    SensorDigitizer();
+    /// Destructor
+    ~SensorDigitizer();
+
+    /// Return whether the hits are digitized and how they are stored
+    Output GetOutput() const;
+    void SetOutput(Output);
+
+    /// Return whether the raw photon histograms are stored too
+    G4bool KeepRaw() const;
+
+    /// Return the response of the sensors of a sensitive detector. Each
+    /// setting not given for the detector is the one given for all of
+    /// them, whatever the order of the commands, or the ideal one.
+    const Response& GetResponse(const G4String& sd_name) const;
+    void SetResponse(const G4String& sd_name, const Response&);
+
+    /// Digitizes the histogram of a hit in the acquisition window
+    /// [start, end) and fills the samples above threshold: all of them
+    /// for waveforms, or a single one with the total charge, in the
+    /// first bin of the window, for integrated charges
+    void Digitize(const SensorHit& hit, const Response& response,
+                  G4double start, G4double end, std::vector<Sample>& samples);
+
+  private:
+    /// Settings given for the sensors of a sensitive detector
+    /// or for all of them, and which of them were given
+    struct Settings
+    {
+      Response response;
+      G4bool kernel      = false;
+      G4bool gain_spread = false;
+      G4bool dark_rate   = false;
+      G4bool threshold   = false;
+    };
+
+    void SetOutputName(G4String);
+    void SetKernel(G4String);
+    void SetGainSpread(G4String);
+    void SetDarkRate(G4String);
+    void SetThreshold(G4String);
+
+    /// Settings of the sensitive detector given at the start of a
+    /// command, by its name with or without its path, or 'all'
+    Settings& EditSettings(std::istringstream& command, const G4String& method);
+
+  private:
+    G4GenericMessenger* msg_;
+
+    Output output_;
+    G4bool keep_raw_;
+
+    std::map<G4String, Settings> settings_;
+    mutable std::map<G4String, Response> responses_; ///< Resolved from the settings
+    Response ideal_;
+
+    std::vector<float> photons_;  ///< Photoelectrons per time bin
+    std::vector<float> waveform_; ///< Response to them
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline SensorDigitizer::Output SensorDigitizer::GetOutput() const
+  { return output_; }
+
+  inline void SensorDigitizer::SetOutput(Output output)
+  { output_ = output; }
+
+  inline G4bool SensorDigitizer::KeepRaw() const
+  { return keep_raw_; }
+
+} // end namespace nexus
+
+#endif
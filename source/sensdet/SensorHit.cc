@@ -80,3 +80,12 @@ void SensorHit::Fill(G4double time, G4int counts)
   G4double time_bin = floor(time/bin_size_) * bin_size_;
   histogram_[time_bin] += counts;
 }
+
+
+
+void SensorHit::Trim(G4double start, G4double end)
+{
+  // Bins are keyed by their lower edge
+  histogram_.erase(histogram_.lower_bound(end), histogram_.end());
+  histogram_.erase(histogram_.begin(), histogram_.upper_bound(start - bin_size_));
+}
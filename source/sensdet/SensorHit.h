@@ -58,6 +58,9 @@ namespace nexus {
     /// Adds counts to a given time bin
     void Fill(G4double time, G4int counts=1);
 
+    /// Removes the time bins that do not overlap with [start, end)
+    void Trim(G4double start, G4double end);
+
     const std::map<G4double, G4int>& GetHistogram() const;
 
   private:
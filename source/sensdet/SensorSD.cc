@@ -2,19 +2,41 @@
 // nexus | SensorSD.cc
 //
 // This class is the sensitive detector that allows for the registration
-// of the charge detected by a photosensor.
+// of the charge detected by a photosensor. Only the photons detected in the
+// acquisition window of the sensor, if one is set, are recorded.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
 #include "SensorSD.h"
+#include "IonizationSD.h"
 
 #include <G4OpticalPhoton.hh>
 #include <G4SDManager.hh>
 #include <G4ProcessManager.hh>
 #include <G4OpBoundaryProcess.hh>
 #include <G4RunManager.hh>
-#include <G4RunManager.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4VPVParameterisation.hh>
+#include <geomdefs.hh>
+
+#include <algorithm>
+
+
+namespace {
+
+  /// Sensor sensitive detectors that exist, to find
+  /// the end of the latest acquisition window
+  std::vector<nexus::SensorSD*>& Sensors()
+  {
+    static std::vector<nexus::SensorSD*> sensors;
+    return sensors;
+  }
+
+}
 
 
 namespace nexus {
@@ -22,16 +44,153 @@ namespace nexus {
 
   SensorSD::SensorSD(G4String sdname):
     G4VSensitiveDetector(sdname),
-    naming_order_(0), sensor_depth_(0), mother_depth_(0)
+    naming_order_(0), sensor_depth_(0), mother_depth_(0),
+    daq_start_(0.), daq_length_(0.), daq_reference_(EVENT_START),
+    positions_found_(false)
   {
     // Register the name of the collection of hits
     collectionName.insert(GetCollectionUniqueName());
+
+    Sensors().push_back(this);
   }
 
 
 
   SensorSD::~SensorSD()
   {
+    auto& sensors = Sensors();
+    sensors.erase(std::remove(sensors.begin(), sensors.end(), this), sensors.end());
+  }
+
+
+
+  const std::vector<SensorSD*>& SensorSD::GetSensors()
+  {
+    return Sensors();
+  }
+
+
+
+  void SensorSD::SetDAQWindow(G4double start, G4double length,
+                              DAQReference reference)
+  {
+    if (length < 0.)
+      G4Exception("[SensorSD]", "SetDAQWindow()", FatalErrorInArgument,
+                  ("Negative acquisition window for " + GetName()).c_str());
+
+    daq_start_     = start;
+    daq_length_    = length;
+    daq_reference_ = reference;
+  }
+
+
+
+  G4double SensorSD::GetDAQReferenceTime() const
+  {
+    if (daq_reference_ == FIRST_IONIZATION)
+      return IonizationSD::GetFirstHitTime();
+    return 0.;
+  }
+
+
+
+  G4bool SensorSD::GetDAQWindow(G4double& start, G4double& end) const
+  {
+    if (!HasDAQWindow()) return false;
+
+    // Events without ionization keep the window
+    // relative to the start of the event
+    start = GetDAQReferenceTime();
+    if (start == kInfinity) start = 0.;
+    start += daq_start_;
+    end = start + daq_length_;
+    return true;
+  }
+
+
+
+  G4double SensorSD::GetLatestDAQTime()
+  {
+    G4double latest = 0.;
+    for (const auto sensor : Sensors()) {
+      if (!sensor->isActive()) continue;
+      if (!sensor->HasDAQWindow()) return kInfinity;
+      latest = std::max(latest, sensor->GetDAQReferenceTime() +
+                        sensor->daq_start_ + sensor->daq_length_);
+    }
+    return Sensors().empty() ? kInfinity : latest;
+  }
+
+
+
+  const std::map<G4int, G4ThreeVector>& SensorSD::GetSensorPositions()
+  {
+    if (positions_found_) return positions_;
+
+    G4VPhysicalVolume* world = G4TransportationManager::GetTransportationManager()
+      ->GetNavigatorForTracking()->GetWorldVolume();
+    if (!world) return positions_;
+
+    std::vector<G4int> copies = {world->GetCopyNo()};
+    std::map<const G4LogicalVolume*, G4bool> has_sensors;
+    FindSensors(world, copies, world->GetObjectTranslation(),
+                world->GetObjectRotationValue(), has_sensors);
+
+    positions_found_ = true;
+    return positions_;
+  }
+
+
+
+  void SensorSD::FindSensors(const G4VPhysicalVolume* pv, std::vector<G4int>& copies,
+                             const G4ThreeVector& position, const G4RotationMatrix& rotation,
+                             std::map<const G4LogicalVolume*, G4bool>& has_sensors)
+  {
+    G4LogicalVolume* logic = pv->GetLogicalVolume();
+
+    // Copy numbers and positions as in the touchables of the hits
+    G4int depth = copies.size() - 1;
+    if (logic->GetSensitiveDetector() == this &&
+        depth >= sensor_depth_ && depth >= mother_depth_) {
+      G4int id = copies[depth - sensor_depth_];
+      if (naming_order_ != 0) id += naming_order_ * copies[depth - mother_depth_];
+      positions_[id] = position;
+    }
+
+    for (size_t i=0; i<logic->GetNoDaughters(); ++i) {
+      G4VPhysicalVolume* daughter = logic->GetDaughter(i);
+      if (!HasSensors(daughter->GetLogicalVolume(), has_sensors)) continue;
+
+      // Copies of a parameterised volume are placed one at a time
+      G4VPVParameterisation* param = daughter->GetParameterisation();
+      G4int ncopies = param ? daughter->GetMultiplicity() : 1;
+
+      for (G4int copy=0; copy<ncopies; ++copy) {
+        if (param) param->ComputeTransformation(copy, daughter);
+
+        copies.push_back(param ? copy : daughter->GetCopyNo());
+        FindSensors(daughter, copies,
+                    position + rotation * daughter->GetObjectTranslation(),
+                    rotation * daughter->GetObjectRotationValue(), has_sensors);
+        copies.pop_back();
+      }
+    }
+  }
+
+
+
+  G4bool SensorSD::HasSensors(const G4LogicalVolume* logic,
+                              std::map<const G4LogicalVolume*, G4bool>& has_sensors) const
+  {
+    auto it = has_sensors.find(logic);
+    if (it != has_sensors.end()) return it->second;
+
+    G4bool found = (logic->GetSensitiveDetector() == this);
+    for (size_t i=0; i<logic->GetNoDaughters() && !found; ++i)
+      found = HasSensors(logic->GetDaughter(i)->GetLogicalVolume(), has_sensors);
+
+    has_sensors[logic] = found;
+    return found;
   }
 
 
@@ -62,6 +221,16 @@ namespace nexus {
     G4ParticleDefinition* pdef = step->GetTrack()->GetDefinition();
     if (pdef != G4OpticalPhoton::Definition()) return false;
 
+    // Photons after the acquisition window are rejected straight away.
+    // The first ionization can only move the window earlier, so the
+    // photons before it are only known at the end of the event.
+    G4double time = step->GetPostStepPoint()->GetGlobalTime();
+    if (HasDAQWindow()) {
+      G4double window_start = GetDAQReferenceTime() + daq_start_;
+      if (time >= window_start + daq_length_) return false;
+      if (daq_reference_ == EVENT_START && time < window_start) return false;
+    }
+
     const G4VTouchable* touchable =
       step->GetPostStepPoint()->GetTouchable();
 
@@ -85,7 +254,6 @@ namespace nexus {
       HC_->insert(hit);
     }
 
-    G4double time = step->GetPostStepPoint()->GetGlobalTime();
     hit->Fill(time);
 
     return true;
@@ -111,7 +279,20 @@ namespace nexus {
     //  // }
     // HCE->AddHitsCollection(HCID, HC_);
 
-
+    G4double window_start, window_end;
+    if (daq_reference_ == EVENT_START ||
+        !GetDAQWindow(window_start, window_end)) return;
+
+    // Sensors left without any photon in the window are dropped
+    std::vector<SensorHit*>* hits = HC_->GetVector();
+    for (auto& hit : *hits) {
+      hit->Trim(window_start, window_end);
+      if (hit->GetHistogram().empty()) {
+        delete hit;
+        hit = nullptr;
+      }
+    }
+    hits->erase(std::remove(hits->begin(), hits->end(), nullptr), hits->end());
   }
 
 
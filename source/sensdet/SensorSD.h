@@ -2,7 +2,8 @@
 // nexus | SensorSD.h
 //
 // This class is the sensitive detector that allows for the registration
-// of the charge detected by a photosensor.
+// of the charge detected by a photosensor. Only the photons detected in the
+// acquisition window of the sensor, if one is set, are recorded.
 //
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
@@ -13,10 +14,17 @@
 #include <G4VSensitiveDetector.hh>
 #include "SensorHit.h"
 
+#include <G4RotationMatrix.hh>
+
+#include <map>
+#include <vector>
+
 class G4Step;
 class G4HCofThisEvent;
 class G4TouchableHistory;
 class G4OpBoundaryProcess;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
 
 
 namespace nexus {
@@ -24,6 +32,9 @@ namespace nexus {
   class SensorSD: public G4VSensitiveDetector
   {
   public:
+    /// Time origin of the acquisition window
+    enum DAQReference { EVENT_START, FIRST_IONIZATION };
+
     /// Constructor providing names for the sensitive detector
     /// and the collection of hits
     SensorSD(G4String sdname);
@@ -56,6 +67,30 @@ namespace nexus {
     /// Set a time binning for the pmt hits
     void SetTimeBinning(G4double);
 
+    /// Set the acquisition window: only the photons detected between
+    /// start and start+length after the reference time are recorded.
+    /// The window is disabled with a null length.
+    void SetDAQWindow(G4double start, G4double length,
+                      DAQReference reference = EVENT_START);
+    /// Return true if the sensor has an acquisition window
+    G4bool HasDAQWindow() const;
+    /// Set the global times of the acquisition window in the current
+    /// event, once the event is over. Returns false if there is none.
+    G4bool GetDAQWindow(G4double& start, G4double& end) const;
+
+    /// Latest global time at which any sensor may still record a photon
+    /// in the current event, given the ionization seen so far. It is
+    /// infinite if a sensor has no acquisition window.
+    static G4double GetLatestDAQTime();
+
+    /// Return all the sensor sensitive detectors created
+    static const std::vector<SensorSD*>& GetSensors();
+
+    /// Return the position of every sensor of the detector, by sensor
+    /// ID, including those without hits. They are found in the geometry
+    /// the first time they are requested, once it is built.
+    const std::map<G4int, G4ThreeVector>& GetSensorPositions();
+
     /// Return the unique name of the hits collection created
     /// by this sensitive detector. This will be used by the
     /// persistency manager to select the collection.
@@ -67,13 +102,33 @@ namespace nexus {
 
     G4int FindSensorID(const G4VTouchable*);
 
+    /// Adds the sensors placed below a volume, given the copy numbers
+    /// of its ancestors and its global position and rotation
+    void FindSensors(const G4VPhysicalVolume*, std::vector<G4int>& copies,
+                     const G4ThreeVector& position, const G4RotationMatrix& rotation,
+                     std::map<const G4LogicalVolume*, G4bool>& has_sensors);
+    /// Whether the sensitive detector is attached to a logical volume
+    /// or to any of its descendants
+    G4bool HasSensors(const G4LogicalVolume*,
+                      std::map<const G4LogicalVolume*, G4bool>& has_sensors) const;
+
+    /// Time origin of the window in the current event, as far as known
+    G4double GetDAQReferenceTime() const;
+
     G4int naming_order_; ///< Order of the naming scheme
     G4int sensor_depth_; ///< Depth of the SD in the geometry tree
     G4int mother_depth_; ///< Depth of the SD's mother in the geometry tree
 
     G4double timebinning_; ///< Time bin width
 
+    G4double daq_start_;  ///< Start of the acquisition window
+    G4double daq_length_; ///< Length of the acquisition window
+    DAQReference daq_reference_; ///< Time origin of the acquisition window
+
     SensorHitsCollection* HC_; ///< Pointer to the collection of hits
+
+    std::map<G4int, G4ThreeVector> positions_; ///< Sensor positions by ID
+    G4bool positions_found_; ///< Have the sensors been looked for?
   };
 
   // INLINE METHODS //////////////////////////////////////////////////
@@ -90,6 +145,8 @@ namespace nexus {
   inline G4double SensorSD::GetTimeBinning() const { return timebinning_; }
   inline void SensorSD::SetTimeBinning(G4double tb) { timebinning_ = tb; }
 
+  inline G4bool SensorSD::HasDAQWindow() const { return daq_length_ > 0.; }
+
 } // end namespace nexus
 
 #endif
@@ -0,0 +1,102 @@
+#include "NavigationTuning.h"
+#include "GeometryBase.h"
+
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4GeometryManager.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <sstream>
+
+
+TEST_CASE("Navigation settings file") {
+
+  std::istringstream input("# Settings for the tracking plane\n"
+                           "\n"
+                           "SIPM_BOARD_MASK   4     # many holes\n"
+                           "  FIELD_RING 0.5\n"
+                           "LIGHT_TUBE off\n");
+
+  auto settings = nexus::NavigationTuning::ParseSettings(input);
+
+  REQUIRE(settings.size() == 3);
+  REQUIRE(settings[0].first  == "SIPM_BOARD_MASK");
+  REQUIRE(settings[0].second == 4.);
+  REQUIRE(settings[1].first  == "FIELD_RING");
+  REQUIRE(settings[1].second == 0.5);
+  REQUIRE(settings[2].first  == "LIGHT_TUBE");
+  REQUIRE(settings[2].second == 0.);
+}
+
+
+
+namespace {
+
+  /// Box with a smaller box inside, where the rays start
+  class NavigationTestGeometry: public nexus::GeometryBase
+  {
+  public:
+    void Construct() {}
+
+    G4ThreeVector GenerateVertex(const G4String&) const
+    {
+      return G4ThreeVector((2.*G4UniformRand() - 1.) * 5.*cm,
+                           (2.*G4UniformRand() - 1.) * 5.*cm,
+                           (2.*G4UniformRand() - 1.) * 5.*cm);
+    }
+  };
+
+}
+
+
+TEST_CASE("Navigation benchmark") {
+
+  G4Material* air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+  auto world_logic = new G4LogicalVolume(new G4Box("NAV_WORLD", 1.*m, 1.*m, 1.*m),
+                                         air, "NAV_WORLD");
+  auto world = new G4PVPlacement(nullptr, G4ThreeVector(), world_logic,
+                                 "NAV_WORLD", nullptr, false, 0);
+
+  auto box_logic = new G4LogicalVolume(new G4Box("NAV_BOX", 10.*cm, 10.*cm, 10.*cm),
+                                       air, "NAV_BOX");
+  new G4PVPlacement(nullptr, G4ThreeVector(), box_logic, "NAV_BOX", world_logic, false, 0);
+
+  auto inner_logic = new G4LogicalVolume(new G4Box("NAV_INNER", 1.*cm, 1.*cm, 1.*cm),
+                                         air, "NAV_INNER");
+  for (G4int i=0; i<4; ++i)
+    new G4PVPlacement(nullptr, G4ThreeVector((2*i - 3) * 2.*cm, 0., 0.),
+                      inner_logic, "NAV_INNER", box_logic, false, i);
+
+  G4GeometryManager::GetInstance()->CloseGeometry(true, false, world);
+
+  NavigationTestGeometry geometry;
+
+  G4Random::setTheSeed(1234);
+  G4double expected = G4UniformRand();
+
+  nexus::NavigationTuning tuning(world);
+  G4Random::setTheSeed(1234);
+  tuning.Run(geometry, "BOX", 50);
+
+  // The random sequence of the job is not altered
+  REQUIRE(G4UniformRand() == expected);
+
+  // The rays go through the voxelised box and leave it
+  REQUIRE(tuning.GetSteps(box_logic)   > 0);
+  REQUIRE(tuning.GetSteps(inner_logic) > 0);
+  REQUIRE(tuning.GetSteps(world_logic) > 0);
+
+  // The rays are the same in every benchmark
+  nexus::NavigationTuning again(world);
+  again.Run(geometry, "BOX", 50);
+  REQUIRE(again.GetSteps(box_logic)   == tuning.GetSteps(box_logic));
+  REQUIRE(again.GetSteps(inner_logic) == tuning.GetSteps(inner_logic));
+
+  G4GeometryManager::GetInstance()->OpenGeometry(world);
+}
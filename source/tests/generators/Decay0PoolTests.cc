@@ -0,0 +1,54 @@
+#include "Decay0Pool.h"
+#include "decay0.h"
+
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <cstdio>
+
+TEST_CASE("Decay0 pool round trip") {
+
+  // Writes a few events with a variable number of particles
+  // and checks that they are read back unchanged
+  G4String filename = "decay0_pool_test.pool";
+
+  std::vector<std::vector<decay0Part>> events(10);
+  {
+    nexus::Decay0PoolWriter writer(filename, 4, 1);
+    for (size_t i=0; i<events.size(); i++) {
+      for (size_t j=0; j<i%3+1; j++) {
+        decay0Part part;
+        part.pdgCode_ = (j == 2) ? 22 : 11;
+        for (auto& p : part.pmom_) p = 2 * G4UniformRand() - 1;
+        part.energy_ = G4UniformRand();
+        part.time_   = 1.e-9 * j;
+        events[i].push_back(part);
+      }
+      writer.Write(events[i]);
+    }
+    writer.Close();
+  }
+
+  nexus::Decay0PoolReader reader(filename);
+
+  REQUIRE(reader.GetNumberOfEvents() == events.size());
+  REQUIRE(reader.GetDecayMode()  == 4);
+  REQUIRE(reader.GetFinalState() == 1);
+
+  for (size_t i=0; i<events.size(); i++) {
+    size_t nparticles;
+    const nexus::Decay0PoolParticle* parts = reader.GetEvent(i, nparticles);
+    REQUIRE(nparticles == events[i].size());
+    for (size_t j=0; j<nparticles; j++) {
+      REQUIRE(parts[j].pdg_code == events[i][j].pdgCode_);
+      REQUIRE(parts[j].px     == Approx(events[i][j].pmom_[0]));
+      REQUIRE(parts[j].py     == Approx(events[i][j].pmom_[1]));
+      REQUIRE(parts[j].pz     == Approx(events[i][j].pmom_[2]));
+      REQUIRE(parts[j].energy == Approx(events[i][j].energy_));
+      REQUIRE(parts[j].time   == Approx(events[i][j].time_));
+    }
+  }
+
+  std::remove(filename.c_str());
+}
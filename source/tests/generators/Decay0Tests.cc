@@ -0,0 +1,112 @@
+#include "decay0.h"
+
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+  // Two-sample Kolmogorov-Smirnov statistic
+  double KSDistance(std::vector<double> a, std::vector<double> b)
+  {
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    size_t i = 0, j = 0;
+    double d = 0.;
+    while (i < a.size() && j < b.size()) {
+      double x = std::min(a[i], b[j]);
+      while (i < a.size() && a[i] <= x) i++;
+      while (j < b.size() && b[j] <= x) j++;
+      d = std::max(d, std::abs(double(i)/a.size() - double(j)/b.size()));
+    }
+    return d;
+  }
+
+
+  void Generate(const decay0& generator, size_t nevents,
+                std::vector<double>& e1, std::vector<double>& e2,
+                std::vector<double>& esum)
+  {
+    std::vector<decay0Part> particles;
+    for (size_t i=0; i<nevents; i++) {
+      generator.decay0DoIt(particles);
+      // The two electrons come first, followed by the de-excitation gammas
+      REQUIRE(particles.size() >= 2);
+      e1.push_back(particles[0].energy_);
+      e2.push_back(particles[1].energy_);
+      esum.push_back(particles[0].energy_ + particles[1].energy_);
+    }
+  }
+
+}
+
+
+TEST_CASE("Decay0 table sampling") {
+
+  // Compares the energies sampled from the cumulative tables
+  // with those of the original rejection method
+  auto mode = GENERATE(1, 4);
+
+  const size_t nevents = 3000;
+  // Kolmogorov-Smirnov critical distance for a significance of 0.001
+  const double dmax = 1.95 * std::sqrt(2. / nevents);
+
+  std::string dump = "decay0_test_spectrum.dat";
+
+  decay0 tables   ("Xe136", 0, mode, dump);
+  decay0 rejection("Xe136", 0, mode, dump);
+  rejection.SetTableSampling(false);
+
+  REQUIRE(tables.GetTableSampling());
+
+  std::vector<double> t1, t2, tsum, r1, r2, rsum;
+  Generate(tables,    nevents, t1, t2, tsum);
+  Generate(rejection, nevents, r1, r2, rsum);
+
+  REQUIRE(KSDistance(t1, r1) < dmax);
+  REQUIRE(KSDistance(t2, r2) < dmax);
+  if (mode == 4) REQUIRE(KSDistance(tsum, rsum) < dmax);
+
+  std::remove(dump.c_str());
+}
+
+
+TEST_CASE("Decay0 table cache") {
+
+  // The tables read from the cache give the same events
+  // as those computed from scratch
+  std::string dump = "decay0_test_spectrum.dat";
+
+  // A fresh directory, so that no table of an earlier run is read
+  char cache_dir[] = "/tmp/decay0_cache_XXXXXX";
+  REQUIRE(mkdtemp(cache_dir));
+  std::string cache = cache_dir;
+  std::string table = cache + "/decay0_Xe136_mode4_fs0_1000.000-2457.830keV.tbl";
+
+  decay0 computed("Xe136", 0, 4, dump, 1.0, 4.3, cache);
+  REQUIRE(std::ifstream(table).good());
+  decay0 cached  ("Xe136", 0, 4, dump, 1.0, 4.3, cache);
+
+  std::vector<double> c1, c2, csum, r1, r2, rsum;
+  G4Random::setTheSeed(12345);
+  Generate(computed, 100, c1, c2, csum);
+  G4Random::setTheSeed(12345);
+  Generate(cached,   100, r1, r2, rsum);
+
+  REQUIRE(c1 == r1);
+  REQUIRE(c2 == r2);
+
+  // The energy window is honoured
+  for (auto e : csum) REQUIRE(e >= 1.0);
+
+  std::remove(dump.c_str());
+  std::remove(table.c_str());
+  rmdir(cache_dir);
+}
@@ -0,0 +1,25 @@
+#include "OpticalMaterialProperties.h"
+
+#include <G4MaterialPropertiesTable.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("OpticalMaterialProperties::Cache") {
+  // Tables built with the same parameters are shared,
+  // while different parameters give different tables
+
+  G4MaterialPropertiesTable* gxe = opticalprops::GXe(10 * bar, 300 * kelvin);
+
+  REQUIRE(opticalprops::GXe(10 * bar, 300 * kelvin) == gxe);
+  REQUIRE(opticalprops::GXe(15 * bar, 300 * kelvin) != gxe);
+  REQUIRE(opticalprops::GXe(10 * bar, 300 * kelvin, 10000/MeV) != gxe);
+
+  REQUIRE(opticalprops::TPB() == opticalprops::TPB());
+  REQUIRE(opticalprops::FakeGrid(10 * bar) != opticalprops::FakeGrid(10 * bar, STP_Temperature, .8));
+
+  // Tables built from others keep their contents
+  G4MaterialPropertiesTable* grid = opticalprops::FakeGrid(10 * bar);
+  REQUIRE(grid->GetProperty("RINDEX") == gxe->GetProperty("RINDEX"));
+}
@@ -0,0 +1,62 @@
+#include "EventView.h"
+#include "SummaryPersistencyManager.h"
+#include "IonizationHit.h"
+#include "SensorHit.h"
+
+#include <G4Event.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4SystemOfUnits.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("EventView") {
+
+  G4Event event(7);
+  auto hce = new G4HCofThisEvent(2);
+
+  auto ionization = new nexus::IonizationHitsCollection("ACTIVE", "IonizationHitsCollection");
+  for (G4int i=0; i<3; i++) {
+    auto hit = new nexus::IonizationHit();
+    hit->SetEnergyDeposit(100.*keV);
+    ionization->insert(hit);
+  }
+  hce->AddHitsCollection(0, ionization);
+
+  auto sensors = new SensorHitsCollection("PmtR11410", "SensorHitsCollection");
+  auto sensor = new nexus::SensorHit(1, G4ThreeVector(), 1.*microsecond);
+  sensor->Fill(10.5*microsecond, 4);
+  sensor->Fill(12.5*microsecond, 6);
+  sensors->insert(sensor);
+  hce->AddHitsCollection(1, sensors);
+
+  event.SetHCofThisEvent(hce);
+
+  nexus::EventView view;
+  view.Fill(&event);
+
+  REQUIRE(view.GetEventID() == 7);
+  REQUIRE(view.GetTrajectories().empty());
+
+  // The view points to the hits of the event, not to copies
+  REQUIRE(view.GetIonizationHits().size() == 1);
+  REQUIRE(view.GetIonizationHits()[0].sd_name == "ACTIVE");
+  REQUIRE(view.GetIonizationHits()[0].hits.size() == 3);
+  REQUIRE(view.GetIonizationHits()[0].hits[0] == (*ionization)[0]);
+
+  REQUIRE(view.GetSensorHits().size() == 1);
+  REQUIRE(view.GetSensorHits()[0].sd_name == "PmtR11410");
+  REQUIRE(view.GetSensorHits()[0].hits[0] == sensor);
+
+  nexus::SummaryPersistencyManager pm;
+  nexus::SummaryPersistencyManager::EventSummary summary;
+  pm.Summarize(view, summary);
+
+  REQUIRE(summary.event_id        == 7);
+  REQUIRE(summary.energy          == Approx(300.*keV));
+  REQUIRE(summary.light           == Approx(10.));
+  REQUIRE(summary.light_sensors   == 1);
+  REQUIRE(summary.light_start     == Approx(10.*microsecond));
+  REQUIRE(summary.light_end       == Approx(13.*microsecond));
+  REQUIRE(summary.light_mean_time == Approx(11.7*microsecond));
+}
@@ -0,0 +1,74 @@
+#include "HDF5Writer.h"
+#include "hdf5_functions.h"
+
+#include <catch.hpp>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <map>
+#include <string>
+
+
+namespace {
+
+  void Checkpoint(nexus::HDF5Writer& writer, int events)
+  {
+    // Long enough to be split over several rows
+    std::string state(1000, 'a' + events);
+    writer.WriteCheckpoint({{"events_processed", std::to_string(events)},
+                            {"rng_state", state}});
+  }
+
+}
+
+
+TEST_CASE("HDF5Writer checkpoints") {
+
+  std::string filename = "/tmp/hdf5writer_checkpoints_" + std::to_string(getpid()) + ".h5";
+
+  nexus::HDF5Writer writer;
+  writer.Open(filename, false, true);
+  writer.WriteRunInfo("key", "value");
+  Checkpoint(writer, 1);
+  writer.WriteRunInfo("key", "value");
+  Checkpoint(writer, 2);
+  writer.WriteRunInfo("key", "value");
+  Checkpoint(writer, 3);
+  writer.Close();
+
+  std::map<std::string, std::string> checkpoint;
+
+  // The newest checkpoint is resumed
+  nexus::HDF5Writer resumed;
+  REQUIRE(resumed.Resume(filename, false, true, false, false, checkpoint));
+  REQUIRE(checkpoint["events_processed"] == "3");
+  REQUIRE(checkpoint["rng_state"] == std::string(1000, 'd'));
+  REQUIRE(checkpoint["rows_configuration"] == "3");
+  resumed.Close();
+
+  // A job stopped before the checkpoint was complete
+  // resumes from the previous one, left whole
+  hid_t file = H5Fopen(filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  hid_t table = H5Dopen2(file, "/MC/checkpoint_1", H5P_DEFAULT);
+  resizeTable(table, getTableSize(table) - 1);
+  H5Dclose(table);
+  H5Fclose(file);
+
+  nexus::HDF5Writer interrupted;
+  REQUIRE(interrupted.Resume(filename, false, true, false, false, checkpoint));
+  REQUIRE(checkpoint["events_processed"] == "2");
+  REQUIRE(checkpoint["rng_state"] == std::string(1000, 'c'));
+  REQUIRE(checkpoint["rows_configuration"] == "2");
+
+  // The next checkpoint replaces the incomplete one
+  Checkpoint(interrupted, 4);
+  interrupted.Close();
+
+  nexus::HDF5Writer extended;
+  REQUIRE(extended.Resume(filename, false, true, false, false, checkpoint));
+  REQUIRE(checkpoint["events_processed"] == "4");
+  extended.Close();
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,96 @@
+#include "SensorDigitizer.h"
+#include "SensorHit.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4UImanager.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("SensorDigitizer ideal response") {
+
+  nexus::SensorHit hit(1, G4ThreeVector(), 1.*microsecond);
+  hit.Fill(2.5*microsecond, 3);
+  hit.Fill(5.5*microsecond, 7);
+
+  nexus::SensorDigitizer digitizer;
+  digitizer.SetOutput(nexus::SensorDigitizer::WAVEFORM);
+
+  // Without a kernel nor fluctuations the histogram is reproduced
+  std::vector<nexus::SensorDigitizer::Sample> samples;
+  digitizer.Digitize(hit, digitizer.GetResponse("PmtR11410"),
+                     0., 10.*microsecond, samples);
+
+  REQUIRE(samples.size() == 2);
+  REQUIRE(samples[0].time_bin == 2);
+  REQUIRE(samples[0].charge   == Approx(3.));
+  REQUIRE(samples[1].time_bin == 5);
+  REQUIRE(samples[1].charge   == Approx(7.));
+}
+
+
+
+TEST_CASE("SensorDigitizer kernel and threshold") {
+
+  nexus::SensorHit hit(1, G4ThreeVector(), 1.*microsecond);
+  hit.Fill(2.5*microsecond, 10);
+
+  nexus::SensorDigitizer digitizer;
+  nexus::SensorDigitizer::Response response;
+  response.kernel = {0.5, 0.3, 0.2};
+  digitizer.SetResponse("PmtR11410", response);
+
+  // The charge of a photoelectron is spread over the kernel
+  digitizer.SetOutput(nexus::SensorDigitizer::WAVEFORM);
+  std::vector<nexus::SensorDigitizer::Sample> samples;
+  digitizer.Digitize(hit, digitizer.GetResponse("PmtR11410"),
+                     0., 10.*microsecond, samples);
+
+  REQUIRE(samples.size() == 3);
+  REQUIRE(samples[0].time_bin == 2);
+  REQUIRE(samples[2].time_bin == 4);
+  REQUIRE(samples[0].charge + samples[1].charge + samples[2].charge == Approx(10.));
+
+  // Samples below threshold are suppressed
+  response.threshold = 2.5;
+  digitizer.SetResponse("PmtR11410", response);
+  digitizer.Digitize(hit, digitizer.GetResponse("PmtR11410"),
+                     0., 10.*microsecond, samples);
+  REQUIRE(samples.size() == 2);
+
+  // The integrated charge is stored in the first bin of the window
+  digitizer.SetOutput(nexus::SensorDigitizer::CHARGE);
+  digitizer.Digitize(hit, digitizer.GetResponse("PmtR11410"),
+                     1.*microsecond, 10.*microsecond, samples);
+  REQUIRE(samples.size() == 1);
+  REQUIRE(samples[0].time_bin == 1);
+  REQUIRE(samples[0].charge   == Approx(10.));
+
+  // Other sensitive detectors keep the ideal response
+  REQUIRE(digitizer.GetResponse("SiPMSensl").kernel.empty());
+}
+
+
+
+TEST_CASE("SensorDigitizer settings for all the sensors") {
+
+  nexus::SensorDigitizer digitizer;
+  G4UImanager* UI = G4UImanager::GetUIpointer();
+
+  // Settings for all the sensors apply to those of a sensitive
+  // detector that were not given for it, whatever their order
+  UI->ApplyCommand("/nexus/digitization/threshold /PMT_R11410/PmtR11410 2.");
+  UI->ApplyCommand("/nexus/digitization/threshold all 0.5");
+  UI->ApplyCommand("/nexus/digitization/dark_rate all 100 hertz");
+  UI->ApplyCommand("/nexus/digitization/gain_spread PmtR11410 0.3");
+
+  const auto& pmt = digitizer.GetResponse("PmtR11410");
+  REQUIRE(pmt.threshold   == Approx(2.));
+  REQUIRE(pmt.gain_spread == Approx(0.3));
+  REQUIRE(pmt.dark_rate   == Approx(100.*hertz));
+
+  const auto& sipm = digitizer.GetResponse("SiPMSensl");
+  REQUIRE(sipm.threshold   == Approx(0.5));
+  REQUIRE(sipm.gain_spread == 0.);
+  REQUIRE(sipm.dark_rate   == Approx(100.*hertz));
+}
@@ -0,0 +1,27 @@
+#include "SensorHit.h"
+
+#include <G4SystemOfUnits.hh>
+
+#include <catch.hpp>
+
+
+TEST_CASE("SensorHit trimming") {
+
+  nexus::SensorHit hit(1, G4ThreeVector(), 1.*microsecond);
+  for (G4int i=0; i<10; i++) hit.Fill((i + 0.5) * microsecond, i + 1);
+
+  REQUIRE(hit.GetHistogram().size() == 10);
+
+  // Bins overlapping the window are kept whole
+  hit.Trim(2.5*microsecond, 6.*microsecond);
+
+  const auto& histogram = hit.GetHistogram();
+  REQUIRE(histogram.size() == 4);
+  REQUIRE(histogram.begin() ->first == Approx(2.*microsecond));
+  REQUIRE(histogram.rbegin()->first == Approx(5.*microsecond));
+  REQUIRE(histogram.begin() ->second == 3);
+
+  // Nothing is left of a window without photons
+  hit.Trim(20.*microsecond, 30.*microsecond);
+  REQUIRE(hit.GetHistogram().empty());
+}
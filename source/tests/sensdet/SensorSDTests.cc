@@ -0,0 +1,141 @@
+#include "SensorSD.h"
+#include "SensorHit.h"
+
+#include <G4SDManager.hh>
+#include <G4HCofThisEvent.hh>
+#include <G4Step.hh>
+#include <G4Track.hh>
+#include <G4DynamicParticle.hh>
+#include <G4OpticalPhoton.hh>
+#include <G4TouchableHistory.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4TransportationManager.hh>
+#include <G4Navigator.hh>
+
+#include <catch.hpp>
+
+
+namespace {
+
+  /// Photon detected by a sensitive detector at a given time
+  void Detect(nexus::SensorSD& sd, G4double time)
+  {
+    auto photon = new G4DynamicParticle(G4OpticalPhoton::Definition(),
+                                        G4ThreeVector(0., 0., 1.), 3.*eV);
+    G4Track track(photon, time, G4ThreeVector());
+
+    G4Step step;
+    step.SetTrack(&track);
+    step.GetPostStepPoint()->SetGlobalTime(time);
+    step.GetPostStepPoint()->SetTouchableHandle(G4TouchableHandle(new G4TouchableHistory()));
+
+    sd.Hit(&step);
+  }
+
+
+  /// Photons recorded in each hit of the event
+  std::vector<G4int> RecordedPhotons(nexus::SensorSD& sd,
+                                     const std::vector<G4double>& times)
+  {
+    G4HCofThisEvent hce(G4SDManager::GetSDMpointer()->GetCollectionCapacity());
+    sd.Initialize(&hce);
+    for (auto time : times) Detect(sd, time);
+    sd.EndOfEvent(&hce);
+
+    G4int hcid = G4SDManager::GetSDMpointer()->
+      GetCollectionID(sd.GetName() + "/" + sd.GetCollectionName(0));
+    auto hits = static_cast<nexus::SensorHitsCollection*>(hce.GetHC(hcid));
+
+    std::vector<G4int> photons;
+    for (size_t i=0; i<hits->entries(); i++) {
+      G4int n = 0;
+      for (const auto& bin : (*hits)[i]->GetHistogram()) n += bin.second;
+      photons.push_back(n);
+    }
+    return photons;
+  }
+
+}
+
+
+TEST_CASE("SensorSD acquisition window") {
+
+  auto sd = new nexus::SensorSD("/SENSOR_SD_TEST/SensorSDTest");
+  sd->SetTimeBinning(1.*microsecond);
+  G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+
+  std::vector<G4double> times = {5.*microsecond, 12.*microsecond,
+                                 12.5*microsecond, 20.*microsecond};
+
+  // Without a window every photon is recorded
+  REQUIRE(RecordedPhotons(*sd, times) == std::vector<G4int>{4});
+
+  // Only the photons between 10 and 15 us after the start of the event
+  sd->SetDAQWindow(10.*microsecond, 5.*microsecond);
+  REQUIRE(RecordedPhotons(*sd, times) == std::vector<G4int>{2});
+  REQUIRE(nexus::SensorSD::GetLatestDAQTime() == Approx(15.*microsecond));
+
+  // Relative to the first ionization, which there is none of here:
+  // the photons are trimmed at the end of the event instead
+  sd->SetDAQWindow(10.*microsecond, 5.*microsecond, nexus::SensorSD::FIRST_IONIZATION);
+  REQUIRE(RecordedPhotons(*sd, times) == std::vector<G4int>{2});
+
+  // A sensor without photons in the window is dropped
+  REQUIRE(RecordedPhotons(*sd, {5.*microsecond, 20.*microsecond}).empty());
+
+  sd->SetDAQWindow(0., 0.);
+  sd->Activate(false);
+}
+
+
+
+TEST_CASE("SensorSD sensor positions") {
+
+  // Board with three sensors, placed in a world
+  G4Material* air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+  auto world_logic = new G4LogicalVolume(new G4Box("SD_WORLD", 1.*m, 1.*m, 1.*m),
+                                         air, "SD_WORLD");
+  auto world = new G4PVPlacement(nullptr, G4ThreeVector(), world_logic,
+                                 "SD_WORLD", nullptr, false, 0);
+
+  auto board_logic = new G4LogicalVolume(new G4Box("SD_BOARD", 10.*cm, 10.*cm, 1.*cm),
+                                         air, "SD_BOARD");
+  new G4PVPlacement(nullptr, G4ThreeVector(0., 0., 50.*cm), board_logic,
+                    "SD_BOARD", world_logic, false, 2);
+
+  auto sensor_logic = new G4LogicalVolume(new G4Box("SD_SENSOR", 1.*cm, 1.*cm, 1.*cm),
+                                          air, "SD_SENSOR");
+  for (G4int i=0; i<3; ++i)
+    new G4PVPlacement(nullptr, G4ThreeVector((i - 1) * 5.*cm, 0., 0.), sensor_logic,
+                      "SD_SENSOR", board_logic, false, i);
+
+  auto sd = new nexus::SensorSD("/SENSOR_SD_TEST/SensorSDPositions");
+  sd->SetDetectorVolumeDepth(0);
+  sd->SetMotherVolumeDepth(1);
+  sd->SetDetectorNamingOrder(10);
+  G4SDManager::GetSDMpointer()->AddNewDetector(sd);
+  sensor_logic->SetSensitiveDetector(sd);
+
+  G4Navigator* navigator =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  G4VPhysicalVolume* previous = navigator->GetWorldVolume();
+  navigator->SetWorldVolume(world);
+
+  // Every sensor is found, with the IDs of the naming scheme
+  // and the positions of the touchables of its hits
+  const auto& positions = sd->GetSensorPositions();
+  REQUIRE(positions.size() == 3);
+  for (G4int i=0; i<3; ++i) {
+    REQUIRE(positions.count(20 + i) == 1);
+    REQUIRE(positions.at(20 + i).x() == Approx((i - 1) * 5.*cm));
+    REQUIRE(positions.at(20 + i).z() == Approx(50.*cm));
+  }
+
+  navigator->SetWorldVolume(previous);
+  sd->Activate(false);
+}
@@ -120,3 +120,26 @@ TEST_CASE("Box Arbitrary valid intersect") {
   REQUIRE(std::abs(origin_point.dot(dir)) == Approx(origin_point.mag()));
 
 }
+
+TEST_CASE("Box bounding box") {
+
+  // Checks that the generated vertices lie within the bounding box
+  // of a rotated and translated box sampler with thick walls
+  auto rotation = new G4RotationMatrix();
+  rotation->rotateZ(CLHEP::twopi * G4UniformRand());
+  auto origin = G4ThreeVector(G4UniformRand(), G4UniformRand(), G4UniformRand());
+
+  auto sampler = nexus::BoxPointSampler(1., 2., 3., 0.5, origin, rotation);
+  G4ThreeVector min, max;
+  sampler.GetBoundingBox(min, max);
+
+  for (G4int i=0; i<100; i++) {
+    auto vertex = sampler.GenerateVertex(nexus::VOLUME);
+    for (G4int j=0; j<3; j++) {
+      REQUIRE(vertex[j] >= min[j] - 1.e-9);
+      REQUIRE(vertex[j] <= max[j] + 1.e-9);
+    }
+  }
+
+  delete rotation;
+}
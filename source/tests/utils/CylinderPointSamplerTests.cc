@@ -101,3 +101,28 @@ TEST_CASE("Cylinder Arbitrary valid intersect") {
   REQUIRE(std::abs(origin_point.dot(dir)) == Approx(origin_point.mag()));
 
 }
+
+TEST_CASE("Cylinder bounding box") {
+
+  // Checks that the generated vertices lie within the bounding box
+  // of a rotated and translated cylinder sampler
+  auto rotation = new G4RotationMatrix();
+  rotation->rotateX(CLHEP::twopi * G4UniformRand());
+  rotation->rotateY(CLHEP::twopi * G4UniformRand());
+  auto origin = G4ThreeVector(G4UniformRand(), G4UniformRand(), G4UniformRand());
+
+  auto sampler = nexus::CylinderPointSampler(1., 2., 3., 0., CLHEP::twopi,
+                                             rotation, origin);
+  G4ThreeVector min, max;
+  sampler.GetBoundingBox(min, max);
+
+  for (G4int i=0; i<100; i++) {
+    auto vertex = sampler.GenerateVertex(nexus::VOLUME);
+    for (G4int j=0; j<3; j++) {
+      REQUIRE(vertex[j] >= min[j] - 1.e-9);
+      REQUIRE(vertex[j] <= max[j] + 1.e-9);
+    }
+  }
+
+  delete rotation;
+}
@@ -0,0 +1,98 @@
+#include "GeometryCache.h"
+#include "SolidPointSampler.h"
+
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4SubtractionSolid.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <dirent.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+
+namespace {
+
+  void RemoveCache(const G4String& path)
+  {
+    DIR* dir = opendir(path.c_str());
+    if (dir) {
+      while (dirent* entry = readdir(dir)) {
+        G4String name = entry->d_name;
+        if (name != "." && name != "..")
+          std::remove((path + "/" + name).c_str());
+      }
+      closedir(dir);
+    }
+    rmdir(path.c_str());
+  }
+
+}
+
+
+TEST_CASE("Geometry cache keys") {
+
+  // Keys depend on the dimensions of the solids and of their
+  // constituents, and not on how the solids were created
+  auto box  = new G4Box("CACHE_BOX", 10.*mm, 20.*mm, 30.*mm);
+  auto same = new G4Box("CACHE_BOX", 10.*mm, 20.*mm, 30.*mm);
+  auto wide = new G4Box("CACHE_BOX", 11.*mm, 20.*mm, 30.*mm);
+  auto hole = new G4Tubs("CACHE_HOLE", 0., 5.*mm, 40.*mm, 0., twopi);
+
+  REQUIRE(nexus::GeometryCache::ComputeKey(box) == nexus::GeometryCache::ComputeKey(same));
+  REQUIRE(nexus::GeometryCache::ComputeKey(box) != nexus::GeometryCache::ComputeKey(wide));
+
+  auto centred = new G4SubtractionSolid("CACHE_SUB", box, hole);
+  auto shifted = new G4SubtractionSolid("CACHE_SUB", box, hole, nullptr,
+                                        G4ThreeVector(1.*mm, 0., 0.));
+  REQUIRE(nexus::GeometryCache::ComputeKey(centred) != nexus::GeometryCache::ComputeKey(shifted));
+}
+
+
+
+TEST_CASE("Geometry cache entries") {
+
+  nexus::GeometryCache& cache = nexus::GeometryCache::Instance();
+  G4String cache_dir = "geometry_cache_test";
+  RemoveCache(cache_dir);
+
+  auto box  = new G4Box("CACHE_BOX", 10.*mm, 20.*mm, 30.*mm);
+  auto hole = new G4Tubs("CACHE_HOLE", 0., 5.*mm, 40.*mm, 0., twopi);
+  auto solid = new G4SubtractionSolid("CACHE_SUB", box, hole);
+
+  // Nothing is stored without a directory
+  cache.SetDirectory("");
+  std::vector<G4double> values;
+  cache.Write(1, "test", {1., 2.});
+  REQUIRE(!cache.Read(1, "test", values));
+
+  cache.SetDirectory(cache_dir);
+
+  cache.Write(1, "test", {1., 2.});
+  REQUIRE(cache.Read(1, "test", values));
+  REQUIRE(values == std::vector<G4double>{1., 2.});
+  REQUIRE(!cache.Read(2, "test", values));
+  REQUIRE(!cache.Read(1, "other", values));
+
+  // The cached volume is the one estimated the first time
+  G4double volume = cache.GetCubicVolume(solid);
+  REQUIRE(volume == Approx(48000. - 60. * pi * 25.).epsilon(0.01));
+  REQUIRE(cache.Read(nexus::GeometryCache::ComputeKey(solid), "volume", values));
+  REQUIRE(cache.GetCubicVolume(solid) == volume);
+
+  // A sampler reads the table of cells built by another one
+  nexus::SolidPointSampler built(solid);
+  nexus::SolidPointSampler cached(solid);
+  REQUIRE(built.GetPartialFraction() == cached.GetPartialFraction());
+  for (G4int i=0; i<1000; i++) {
+    G4ThreeVector point = cached.GenerateVertex(nexus::VOLUME);
+    REQUIRE(solid->Inside(point) != kOutside);
+  }
+
+  cache.SetDirectory("");
+  RemoveCache(cache_dir);
+}
@@ -0,0 +1,187 @@
+#include "HexagonMeshModel.h"
+#include "MeshBoundaryProcess.h"
+
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+#include <Randomize.hh>
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4MaterialPropertiesTable.hh>
+#include <G4NistManager.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <vector>
+
+
+namespace {
+
+  // NEXT-100 EL mesh
+  const G4double hole_diam = 2.5  * mm;
+  const G4double thickness = 0.13 * mm;
+  const G4double pitch     = hole_diam + thickness;
+
+  // Hole centres of an explicit mesh, as placed by PlaceHexagons
+  std::vector<G4TwoVector> HoleCentres(G4int n_hole)
+  {
+    std::vector<G4TwoVector> centres;
+    G4double size = pitch / std::sqrt(3.);
+    for (G4int q=-n_hole; q<=n_hole; ++q)
+      for (G4int r=-n_hole; r<=n_hole; ++r)
+        centres.emplace_back(size * 3./2. * q,
+                             size * (std::sqrt(3.)/2. * q + std::sqrt(3.) * r));
+    return centres;
+  }
+
+  // Point inside the hexagon of CreateHexagon centred at the given point
+  G4bool InHexagon(const G4TwoVector& point, const G4TwoVector& centre)
+  {
+    G4double circumradius = hole_diam / std::sqrt(3.);
+    for (G4int i=0; i<6; ++i) {
+      G4TwoVector a = centre + circumradius * G4TwoVector(std::cos(i*pi/3.),     std::sin(i*pi/3.));
+      G4TwoVector b = centre + circumradius * G4TwoVector(std::cos((i+1)*pi/3.), std::sin((i+1)*pi/3.));
+      G4TwoVector edge = b - a, rel = point - a;
+      if (edge.x() * rel.y() - edge.y() * rel.x() < 0.) return false;
+    }
+    return true;
+  }
+
+}
+
+
+TEST_CASE("Hexagon mesh model lattice") {
+
+  nexus::HexagonMeshModel mesh(hole_diam, pitch, thickness);
+
+  // The cells of the model are the holes of PlaceHexagons
+  for (const auto& centre : HoleCentres(5)) {
+    G4TwoVector cell = mesh.GetCellCentre(centre.x() + 0.3*mm, centre.y() - 0.2*mm);
+    REQUIRE(cell.x() == Approx(centre.x()).margin(1.e-9));
+    REQUIRE(cell.y() == Approx(centre.y()).margin(1.e-9));
+  }
+
+  // Any point is inside the hole of its cell or on the land around it
+  for (G4int i=0; i<10000; ++i) {
+    G4double x = (G4UniformRand() - 0.5) * 20. * pitch;
+    G4double y = (G4UniformRand() - 0.5) * 20. * pitch;
+    G4TwoVector local = G4TwoVector(x, y) - mesh.GetCellCentre(x, y);
+    REQUIRE(local.mag() <= pitch / std::sqrt(3.) + 1.e-9);
+    REQUIRE(mesh.IsInHole(local.x(), local.y()) == InHexagon(local, G4TwoVector()));
+  }
+}
+
+
+TEST_CASE("Hexagon mesh model against explicit hexagons") {
+
+  // Straight transmission through the explicit holes,
+  // which the model must reproduce for a black metal
+  nexus::HexagonMeshModel mesh(hole_diam, pitch, thickness);
+  std::vector<G4TwoVector> centres = HoleCentres(3);
+
+  // Entry points are uniform over one period of the lattice
+  G4TwoVector a1(pitch * std::sqrt(3.)/2., pitch/2.);
+  G4TwoVector a2(0., pitch);
+
+  const G4int nphotons = 100000;
+
+  for (G4double theta : {0.*deg, 20.*deg, 45.*deg, 70.*deg}) {
+    G4double phi = 0.4;
+    G4ThreeVector direction(std::sin(theta) * std::cos(phi),
+                            std::sin(theta) * std::sin(phi),
+                            -std::cos(theta));
+
+    G4int ntransmitted = 0;
+    for (G4int i=0; i<nphotons; ++i) {
+      G4TwoVector entry = G4UniformRand() * a1 + G4UniformRand() * a2;
+      G4TwoVector exit = entry + thickness * std::tan(theta) * G4TwoVector(std::cos(phi), std::sin(phi));
+      for (const auto& centre : centres) {
+        if (InHexagon(entry, centre)) {
+          if (InHexagon(exit, centre)) ++ntransmitted;
+          break;
+        }
+      }
+    }
+
+    G4double expected = G4double(ntransmitted) / nphotons;
+    G4double model    = mesh.Transmission(direction, 0., 1., nphotons);
+    G4double sigma    = std::sqrt(2. * expected * (1. - expected) / nphotons);
+
+    REQUIRE(std::abs(model - expected) < 5. * sigma + 1.e-4);
+  }
+
+  // At normal incidence, the transmission is the open area
+  REQUIRE(mesh.Transmission(G4ThreeVector(0., 0., 1.), 0., 1., nphotons) ==
+          Approx(mesh.GetOpenArea()).margin(0.005));
+}
+
+
+TEST_CASE("Hexagon mesh model outcomes") {
+
+  nexus::HexagonMeshModel mesh(hole_diam, pitch, thickness);
+
+  G4ThreeVector incident = G4ThreeVector(0.5, 0.2, -1.).unit();
+
+  // A black mesh transmits the photons unchanged or absorbs them
+  for (G4int i=0; i<1000; ++i) {
+    G4ThreeVector position((G4UniformRand() - 0.5) * 10. * pitch,
+                           (G4UniformRand() - 0.5) * 10. * pitch, 0.);
+    G4ThreeVector direction = incident;
+    auto outcome = mesh.Propagate(position, direction, 0., 1.);
+    REQUIRE(outcome != nexus::HexagonMeshModel::REFLECTED);
+    if (outcome == nexus::HexagonMeshModel::TRANSMITTED) {
+      REQUIRE(direction == incident);
+      REQUIRE(position.z() == Approx(-thickness/2.));
+    }
+  }
+
+  // A specular mirror never absorbs and sends photons on either side
+  // with the same angle to the mesh normal
+  G4int ntransmitted = 0, nreflected = 0;
+  for (G4int i=0; i<10000; ++i) {
+    G4ThreeVector position((G4UniformRand() - 0.5) * 10. * pitch,
+                           (G4UniformRand() - 0.5) * 10. * pitch, 0.);
+    G4ThreeVector direction = incident;
+    auto outcome = mesh.Propagate(position, direction, 1., 1.);
+    REQUIRE(outcome != nexus::HexagonMeshModel::ABSORBED);
+    REQUIRE(std::abs(direction.z()) == Approx(std::abs(incident.z())));
+    if (outcome == nexus::HexagonMeshModel::TRANSMITTED) {
+      REQUIRE(direction.z() < 0.);
+      ++ntransmitted;
+    } else {
+      REQUIRE(direction.z() > 0.);
+      ++nreflected;
+    }
+  }
+  REQUIRE(ntransmitted > 0);
+  REQUIRE(nreflected   > 0);
+
+  // Reflections on the walls can only help photons through
+  G4double black  = mesh.Transmission(incident, 0.,  1., 50000);
+  G4double steel  = mesh.Transmission(incident, 0.6, 0.75, 50000);
+  G4double mirror = mesh.Transmission(incident, 1.,  1., 50000);
+  REQUIRE(black  < steel);
+  REQUIRE(steel  < mirror);
+}
+
+
+
+TEST_CASE("MeshBoundaryProcess meshes") {
+
+  // The process is only registered for geometries with meshes
+  REQUIRE(!nexus::MeshBoundaryProcess::HasMeshes());
+
+  G4Material* gas = G4NistManager::Instance()->FindOrBuildMaterial("G4_Xe");
+  G4LogicalVolume volume(new G4Box("MESH_GAS", 1.*cm, 1.*cm, thickness/2.),
+                         gas, "MESH_GAS");
+  G4MaterialPropertiesTable surface;
+
+  auto model = new nexus::HexagonMeshModel(hole_diam, pitch, thickness);
+  nexus::MeshBoundaryProcess::AddMesh(&volume, model, &surface);
+  REQUIRE(nexus::MeshBoundaryProcess::HasMeshes());
+
+  // Nothing is left pointing to a deleted model
+  nexus::MeshBoundaryProcess::RemoveMeshes(model);
+  delete model;
+  REQUIRE(!nexus::MeshBoundaryProcess::HasMeshes());
+}
@@ -0,0 +1,122 @@
+#include "HistogramSampler.h"
+
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+
+TEST_CASE("Histogram sampler alias table") {
+
+  // Checks that bins are drawn with a frequency
+  // proportional to their content
+  std::vector<G4double> weights = {0., 1., 5., 0.5, 3.5, 0., 10.};
+  std::vector<G4double> centres(weights.size()), smears(weights.size(), 0.);
+  for (size_t i=0; i<weights.size(); i++) centres[i] = i;
+
+  nexus::HistogramSampler hist(1, weights, centres, smears);
+
+  REQUIRE(hist.GetNumberOfBins() == weights.size());
+
+  const G4int nsamples = 200000;
+  std::vector<G4int> counts(weights.size(), 0);
+  for (G4int i=0; i<nsamples; i++) {
+    G4double value;
+    size_t bin = hist.Sample(&value);
+    REQUIRE(value == centres[bin]);
+    counts[bin]++;
+  }
+
+  G4double total = 20.;
+  for (size_t i=0; i<weights.size(); i++) {
+    G4double expected = nsamples * weights[i] / total;
+    if (weights[i] == 0.) REQUIRE(counts[i] == 0);
+    else REQUIRE(std::abs(counts[i] - expected) < 5 * std::sqrt(expected));
+  }
+}
+
+
+TEST_CASE("Histogram sampler CSV and cache") {
+
+  // Reads a 2D histogram from a CSV file, then from the binary cache
+  G4String filename = "histogram_sampler_test.csv";
+  {
+    std::ofstream file(filename);
+    file << "value,1,0.5,10,0.1,1\n"
+         << "value,0,1.5,10,0.1,1\n"
+         << "value,3,2.5,20,0.1,1\n"
+         << "energy,1\n"
+         << "energy,4\n"
+         << "energy,2\n";
+  }
+  std::remove(nexus::HistogramSampler::CacheFileName(filename).c_str());
+
+  nexus::HistogramSampler parsed(filename, 2);
+  nexus::HistogramSampler cached(filename, 2);
+
+  REQUIRE(!parsed.IsMapped());
+  REQUIRE(cached.IsMapped());
+
+  for (auto hist : {&parsed, &cached}) {
+    REQUIRE(hist->GetDimension()    == 2);
+    REQUIRE(hist->GetNumberOfBins() == 3);
+    REQUIRE(hist->GetWeight(2)    == 3.);
+    REQUIRE(hist->GetCentre(2, 0) == 2.5);
+    REQUIRE(hist->GetCentre(2, 1) == 20.);
+    REQUIRE(hist->GetSmear (2, 1) == 1.);
+
+    G4double min, max;
+    REQUIRE(hist->GetLabelRange("energy", min, max));
+    REQUIRE(min == 1.);
+    REQUIRE(max == 4.);
+    REQUIRE(!hist->GetLabelRange("zenith", min, max));
+  }
+
+  std::ifstream cache(nexus::HistogramSampler::CacheFileName(filename));
+  REQUIRE(cache.good());
+
+  // The mapped tables outlive the file, as when another job replaces it
+  std::remove(nexus::HistogramSampler::CacheFileName(filename).c_str());
+  REQUIRE(cached.GetCentre(1, 1) == 10.);
+  for (G4int i=0; i<100; i++) REQUIRE(cached.SampleBin() != 1);
+
+  std::remove(filename.c_str());
+}
+
+
+TEST_CASE("Histogram sampler corrupted cache") {
+
+  G4String filename = "histogram_sampler_alias_test.csv";
+  {
+    std::ofstream file(filename);
+    file << "value,1,0.5,10,0.1,1\n"
+         << "value,0,1.5,10,0.1,1\n"
+         << "value,3,2.5,20,0.1,1\n";
+  }
+  G4String cache = nexus::HistogramSampler::CacheFileName(filename);
+  std::remove(cache.c_str());
+
+  nexus::HistogramSampler parsed(filename, 2);
+
+  // Alias of the first bin out of the table: after the 48-byte header
+  // and the weights, centres, smears and probabilities of the 3 bins
+  {
+    std::fstream file(cache, std::ios::in | std::ios::out | std::ios::binary);
+    uint32_t alias = 1000;
+    file.seekp(48 + 3*8 + 2*6*8 + 3*8);
+    file.write(reinterpret_cast<const char*>(&alias), sizeof(alias));
+  }
+
+  // The cache is not used, and is written again
+  nexus::HistogramSampler rejected(filename, 2);
+  REQUIRE(!rejected.IsMapped());
+  for (G4int i=0; i<1000; i++) REQUIRE(rejected.SampleBin() < 3);
+
+  nexus::HistogramSampler cached(filename, 2);
+  REQUIRE(cached.IsMapped());
+
+  std::remove(cache.c_str());
+  std::remove(filename.c_str());
+}
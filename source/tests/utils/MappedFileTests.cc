@@ -0,0 +1,60 @@
+#include "MappedFile.h"
+
+#include <catch.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+
+TEST_CASE("Mapped file accessors") {
+
+  G4String filename = "mapped_file_test.bin";
+  {
+    std::ofstream file(filename, std::ios::binary);
+    uint64_t n = 3;
+    double values[3] = {1., 2., 3.};
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    file.write(reinterpret_cast<const char*>(values), sizeof(values));
+  }
+
+  nexus::MappedFile mapping;
+  REQUIRE(!mapping.Open("mapped_file_missing.bin"));
+  REQUIRE(!mapping.IsOpen());
+
+  REQUIRE(mapping.Open(filename));
+  REQUIRE(mapping.GetSize() == 32);
+
+  // Values used in place, within the file only
+  REQUIRE(mapping.At<double>(8, 3)[2] == 3.);
+  REQUIRE(!mapping.At<double>(8, 4));
+  REQUIRE(!mapping.At<double>(40));
+  REQUIRE(!mapping.At<double>(4));
+
+  std::vector<double> values;
+  size_t offset = 0;
+  REQUIRE(mapping.ReadVector(offset, values));
+  REQUIRE(values == std::vector<double>{1., 2., 3.});
+  REQUIRE(offset == 32);
+
+  // A table longer than the file is not read
+  uint64_t n;
+  offset = 0;
+  REQUIRE(mapping.Read(offset, &n));
+  REQUIRE(!mapping.Read(offset, values.data(), 4));
+  REQUIRE(offset == 8);
+
+  mapping.Close();
+  REQUIRE(!mapping.IsOpen());
+
+  {
+    std::ofstream file(filename, std::ios::binary);
+    uint64_t n = 1000;
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  }
+  REQUIRE(mapping.Open(filename));
+  offset = 0;
+  REQUIRE(!mapping.ReadVector(offset, values));
+  REQUIRE(offset == 0);
+
+  std::remove(filename.c_str());
+}
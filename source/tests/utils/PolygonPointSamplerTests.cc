@@ -0,0 +1,52 @@
+#include "PolygonPointSampler.h"
+#include "RandomUtils.h"
+
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+
+TEST_CASE("PolygonPointSampler") {
+
+  // Checks that points are generated between the inner and the outer
+  // hexagons, and uniformly: half of the area of the region is outside
+  // the hexagon with the same apothem as the mean of the two
+  G4int    n_sides     = 6;
+  G4double min_radius  = 10.;
+  G4double max_radius  = 12.;
+  G4double half_length = 5.;
+
+  auto sampler = nexus::PolygonPointSampler(min_radius, max_radius, half_length, n_sides);
+
+  // Largest projection on the directions perpendicular to the sides,
+  // which is the apothem of the hexagon on which the point lies
+  auto apothem = [n_sides](const G4ThreeVector& vertex) {
+    G4double max = 0.;
+    for (G4int k=0; k<n_sides; k++) {
+      G4double phi = (k + 0.5) * twopi / n_sides;
+      max = std::max(max, vertex.x() * std::cos(phi) + vertex.y() * std::sin(phi));
+    }
+    return max;
+  };
+
+  G4double cos_half = std::cos(pi / n_sides);
+  G4double mid_radius = std::sqrt((min_radius*min_radius + max_radius*max_radius) / 2.);
+
+  G4int nout = 0;
+  G4int npoints = 10000;
+  for (G4int i=0; i<npoints; i++) {
+    auto vertex = sampler.GenerateVertex(nexus::VOLUME);
+    REQUIRE(apothem(vertex) >= min_radius * cos_half - 1.e-9);
+    REQUIRE(apothem(vertex) <= max_radius * cos_half + 1.e-9);
+    REQUIRE(std::abs(vertex.z()) <= half_length);
+    if (apothem(vertex) > mid_radius * cos_half) nout++;
+
+    vertex = sampler.GenerateVertex(nexus::INSIDE);
+    REQUIRE(apothem(vertex) <= min_radius * cos_half + 1.e-9);
+  }
+
+  REQUIRE(G4double(nout) / npoints == Approx(0.5).margin(0.02));
+}
@@ -0,0 +1,111 @@
+#include "SolidPointSampler.h"
+#include "RandomUtils.h"
+
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4SubtractionSolid.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <cmath>
+
+
+TEST_CASE("SolidPointSampler volume") {
+
+  // Checks that points are generated uniformly within a boolean solid:
+  // a box with a hollow cubic centre
+  auto outer = new G4Box("OUTER", 10.*mm, 10.*mm, 10.*mm);
+  auto inner = new G4Box("INNER",  5.*mm,  5.*mm,  5.*mm);
+  auto shell = new G4SubtractionSolid("SHELL", outer, inner);
+
+  auto sampler = nexus::SolidPointSampler(shell);
+  sampler.SetVoxelization(4, 2);
+
+  G4int ntop = 0;
+  G4int npoints = 20000;
+  for (G4int i=0; i<npoints; i++) {
+    auto vertex = sampler.GenerateVertex(nexus::VOLUME);
+    REQUIRE(shell->Inside(vertex) != kOutside);
+    if (vertex.z() > 5.*mm) ntop++;
+  }
+
+  // Fraction of the volume in the top slab of the box
+  REQUIRE(G4double(ntop) / npoints == Approx(2000./7000.).margin(0.02));
+  REQUIRE(sampler.GetPartialFraction() < 1.);
+}
+
+
+TEST_CASE("SolidPointSampler surface") {
+
+  // The triangulated surface of a box is exact
+  auto box = new G4Box("BOX", 10.*mm, 20.*mm, 30.*mm);
+  auto box_sampler = nexus::SolidPointSampler(box);
+
+  REQUIRE(box_sampler.GetSurfaceArea() == Approx(box->GetSurfaceArea()));
+
+  for (G4int i=0; i<1000; i++) {
+    auto vertex = box_sampler.GenerateVertex(nexus::SURFACE);
+    REQUIRE(box->Inside(vertex) == kSurface);
+  }
+
+  // Curved surfaces are approximated by facets, whose points
+  // are projected onto the surface, inner and outer
+  auto tube = new G4Tubs("TUBE", 40.*mm, 50.*mm, 60.*mm, 0., twopi);
+  auto tube_sampler = nexus::SolidPointSampler(tube);
+  tube_sampler.SetRotationSteps(12);
+
+  G4int ninner = 0;
+  G4int npoints = 10000;
+  for (G4int i=0; i<npoints; i++) {
+    auto vertex = tube_sampler.GenerateVertex(nexus::SURFACE);
+    REQUIRE(tube->Inside(vertex) == kSurface);
+    if (vertex.perp() < 40.*mm + 1.e-6*mm) ninner++;
+  }
+
+  // The inner surface is 4/(4 + 5) of the lateral surfaces
+  G4double inner_area = twopi * 40.*mm * 120.*mm;
+  G4double outer_area = twopi * 50.*mm * 120.*mm;
+  G4double caps_area  = 2. * pi * (50.*mm * 50.*mm - 40.*mm * 40.*mm);
+  REQUIRE(G4double(ninner) / npoints ==
+          Approx(inner_area / (inner_area + outer_area + caps_area)).margin(0.02));
+
+  // With the default number of segments the area is
+  // that of the solid within (pi/120)^2/6
+  auto fine_sampler = nexus::SolidPointSampler(tube);
+  REQUIRE(fine_sampler.GetSurfaceArea() ==
+          Approx(tube->GetSurfaceArea()).epsilon(1.e-3));
+}
+
+
+TEST_CASE("SolidPointSampler logical volume") {
+
+  // Points generated in a logical volume are never in its daughters
+  G4Material* air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+  auto mother_solid = new G4Box("MOTHER", 10.*mm, 10.*mm, 10.*mm);
+  auto mother_logic = new G4LogicalVolume(mother_solid, air, "MOTHER");
+
+  auto daughter_solid = new G4Tubs("DAUGHTER", 0., 5.*mm, 10.*mm, 0., twopi);
+  auto daughter_logic = new G4LogicalVolume(daughter_solid, air, "DAUGHTER");
+  G4RotationMatrix* rotation = new G4RotationMatrix();
+  rotation->rotateX(90.*deg);
+  new G4PVPlacement(rotation, G4ThreeVector(2.*mm, 0., 0.), daughter_logic,
+                    "DAUGHTER", mother_logic, false, 0);
+
+  auto sampler = nexus::SolidPointSampler(mother_logic, nullptr,
+                                          G4ThreeVector(0., 0., 100.*mm));
+
+  for (G4int i=0; i<1000; i++) {
+    auto vertex = sampler.GenerateVertex(nexus::VOLUME) - G4ThreeVector(0., 0., 100.*mm);
+    REQUIRE(mother_solid->Inside(vertex) != kOutside);
+
+    // Daughter axis along y
+    auto r = std::hypot(vertex.x() - 2.*mm, vertex.z());
+    REQUIRE(r >= 5.*mm - 1.e-9*mm);
+  }
+}
@@ -0,0 +1,63 @@
+#include "TransformParameterisation.h"
+
+#include <G4Box.hh>
+#include <G4LogicalVolume.hh>
+#include <G4NistManager.hh>
+#include <G4PVPlacement.hh>
+#include <G4Point3D.hh>
+#include <G4SystemOfUnits.hh>
+#include <G4PhysicalConstants.hh>
+
+#include <catch.hpp>
+
+#include <vector>
+
+
+TEST_CASE("TransformParameterisation") {
+
+  // Copies of a parameterised volume must be placed exactly
+  // as the G4PVPlacement of the same transform would be
+  auto material = G4NistManager::Instance()->FindOrBuildMaterial("G4_Galactic");
+  auto solid    = new G4Box("PARAM_TEST", 1.*mm, 2.*mm, 3.*mm);
+  auto logical  = new G4LogicalVolume(solid, material, "PARAM_TEST");
+
+  std::vector<G4Transform3D> transforms;
+  G4RotationMatrix rot;
+  rot.rotateY(pi);
+  for (G4int i=0; i<10; i++) {
+    rot.rotateZ(-0.3);
+    transforms.emplace_back(rot, G4ThreeVector(10.*i*mm, -5.*i*mm, 1.*mm));
+  }
+
+  nexus::TransformParameterisation param(transforms);
+  REQUIRE(param.GetNumberOfCopies() == 10);
+
+  auto physvol = new G4PVPlacement(nullptr, G4ThreeVector(), logical,
+                                   "PARAM_TEST", nullptr, false, 0);
+
+  for (G4int i=0; i<10; i++) {
+    param.ComputeTransformation(i, physvol);
+    G4PVPlacement placement(transforms[i], logical, "PARAM_TEST_REF", nullptr, false, i);
+
+    REQUIRE(physvol->GetTranslation() == placement.GetTranslation());
+    REQUIRE(physvol->GetObjectRotationValue() == placement.GetObjectRotationValue());
+
+    // A point of the volume ends up at the same position in the mother
+    G4ThreeVector point(0.5*mm, 1.*mm, -2.*mm);
+    G4ThreeVector moved = physvol->GetObjectRotationValue() * point + physvol->GetTranslation();
+    G4ThreeVector expected = transforms[i] * G4Point3D(point);
+    REQUIRE(moved.x() == Approx(expected.x()));
+    REQUIRE(moved.y() == Approx(expected.y()));
+    REQUIRE(moved.z() == Approx(expected.z()));
+  }
+
+  // Without rotations, copies are only translated
+  std::vector<G4ThreeVector> positions = {{1., 2., 3.}, {-4., 5., -6.}};
+  nexus::TransformParameterisation translations(positions);
+  REQUIRE(translations.GetNumberOfCopies() == 2);
+
+  physvol->SetRotation(nullptr);
+  translations.ComputeTransformation(1, physvol);
+  REQUIRE(physvol->GetTranslation() == positions[1]);
+  REQUIRE(physvol->GetRotation() == nullptr);
+}
@@ -0,0 +1,55 @@
+#include "VoxelAcceptanceMap.h"
+
+#include <G4Box.hh>
+#include <G4Tubs.hh>
+#include <G4LogicalVolume.hh>
+#include <G4PVPlacement.hh>
+#include <G4NistManager.hh>
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <G4SystemOfUnits.hh>
+#include <Randomize.hh>
+
+#include <catch.hpp>
+
+TEST_CASE("VoxelAcceptanceMap") {
+
+  // Checks that the acceptance map agrees with the navigator on a
+  // thin cylindrical shell, while calling it only near the boundaries
+  G4Material* air = G4NistManager::Instance()->FindOrBuildMaterial("G4_AIR");
+
+  auto world_solid = new G4Box("WORLD", 50.*mm, 50.*mm, 50.*mm);
+  auto world_logic = new G4LogicalVolume(world_solid, air, "WORLD");
+  auto world_phys  = new G4PVPlacement(nullptr, G4ThreeVector(), world_logic,
+                                       "WORLD", nullptr, false, 0);
+
+  auto shell_solid = new G4Tubs("SHELL", 10.*mm, 12.*mm, 20.*mm, 0., CLHEP::twopi);
+  auto shell_logic = new G4LogicalVolume(shell_solid, air, "SHELL");
+  new G4PVPlacement(nullptr, G4ThreeVector(), shell_logic,
+                    "SHELL", world_logic, false, 0);
+
+  G4Navigator* navigator =
+    G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking();
+  G4VPhysicalVolume* previous = navigator->GetWorldVolume();
+  navigator->SetWorldVolume(world_phys);
+
+  auto map = nexus::VoxelAcceptanceMap(G4ThreeVector(-15.*mm, -15.*mm, -25.*mm),
+                                       G4ThreeVector( 15.*mm,  15.*mm,  25.*mm),
+                                       {"SHELL"}, G4ThreeVector(), 20);
+
+  for (G4int i=0; i<1000; i++) {
+    auto vertex = G4ThreeVector(15.*mm * (2 * G4UniformRand() - 1),
+                                15.*mm * (2 * G4UniformRand() - 1),
+                                25.*mm * (2 * G4UniformRand() - 1));
+    auto inside = map.Contains(vertex);
+    auto volume = navigator->LocateGlobalPointAndSetup(vertex, 0, false);
+    REQUIRE(inside == (volume->GetName() == "SHELL"));
+  }
+
+  REQUIRE(map.GetNumberOfCalls() == 1000);
+  REQUIRE(map.GetNumberOfNavigatorCalls() < map.GetNumberOfCalls());
+  REQUIRE(map.GetInsideFraction() + map.GetOutsideFraction() +
+          map.GetPartialFraction() == Approx(1.));
+
+  navigator->SetWorldVolume(previous);
+}
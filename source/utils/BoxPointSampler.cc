@@ -13,6 +13,9 @@
 #include <G4VPhysicalVolume.hh>
 #include <G4Box.hh>
 
+#include <algorithm>
+#include <cfloat>
+
 
 namespace nexus {
 
@@ -227,6 +230,29 @@ namespace nexus {
 
 
 
+  void BoxPointSampler::GetBoundingBox(G4ThreeVector& min,
+                                       G4ThreeVector& max) const
+  {
+    G4ThreeVector half(outer_x_/2., outer_y_/2., outer_z_/2.);
+    min = G4ThreeVector( DBL_MAX,  DBL_MAX,  DBL_MAX);
+    max = G4ThreeVector(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+
+    // Enclose the eight corners of the (possibly rotated) local box
+    for (G4int i=0; i<8; ++i) {
+      G4ThreeVector corner((i & 1 ? 1. : -1.) * half.x(),
+                           (i & 2 ? 1. : -1.) * half.y(),
+                           (i & 4 ? 1. : -1.) * half.z());
+      if (rotation_) corner *= *rotation_;
+      corner += origin_;
+      for (G4int j=0; j<3; ++j) {
+        min[j] = std::min(min[j], corner[j]);
+        max[j] = std::max(max[j], corner[j]);
+      }
+    }
+  }
+
+
+
   G4ThreeVector BoxPointSampler::RotateAndTranslate(G4ThreeVector position)
   {
     G4ThreeVector real_pos = position;
@@ -40,6 +40,9 @@ namespace nexus {
     G4ThreeVector GetIntersect(const G4ThreeVector& point,
 			       const G4ThreeVector& dir);
 
+    /// Return the axis-aligned box enclosing all the generated vertices
+    void GetBoundingBox(G4ThreeVector& min, G4ThreeVector& max) const;
+
   private:
     G4double GetLength(G4double origin, G4double max_length);
     G4ThreeVector RotateAndTranslate(G4ThreeVector position);
@@ -16,6 +16,9 @@
 #include <G4PhysicalConstants.hh>
 #include <Randomize.hh>
 
+#include <algorithm>
+#include <cfloat>
+
 
 namespace nexus {
 
@@ -178,6 +181,29 @@ namespace nexus {
 
 
 
+  void CylinderPointSampler::GetBoundingBox(G4ThreeVector& min,
+                                            G4ThreeVector& max) const
+  {
+    G4ThreeVector half(maxRad_, maxRad_, halfLength_);
+    min = G4ThreeVector( DBL_MAX,  DBL_MAX,  DBL_MAX);
+    max = G4ThreeVector(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+
+    // Enclose the eight corners of the (possibly rotated) local box
+    for (G4int i=0; i<8; ++i) {
+      G4ThreeVector corner((i & 1 ? 1. : -1.) * half.x(),
+                           (i & 2 ? 1. : -1.) * half.y(),
+                           (i & 4 ? 1. : -1.) * half.z());
+      if (rotation_) corner *= *rotation_;
+      corner += origin_;
+      for (G4int j=0; j<3; ++j) {
+        min[j] = std::min(min[j], corner[j]);
+        max[j] = std::max(max[j], corner[j]);
+      }
+    }
+  }
+
+
+
   G4ThreeVector CylinderPointSampler::RotateAndTranslate(G4ThreeVector position)
   {
     // Rotating if needed
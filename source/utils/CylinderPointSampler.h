@@ -47,6 +47,9 @@ namespace nexus {
     G4ThreeVector GetIntersect(const G4ThreeVector& point,
     			       const G4ThreeVector& dir);
 
+    /// Return the axis-aligned box enclosing all the generated vertices
+    void GetBoundingBox(G4ThreeVector& min, G4ThreeVector& max) const;
+
   private:
     G4double      GetRadius(G4double innerRad, G4double outerRad);
     G4double      GetPhi();
@@ -0,0 +1,187 @@
+// ----------------------------------------------------------------------------
+// nexus | GeometryCache.cc
+//
+// This class keeps in a cache directory the quantities derived from the
+// solids of a geometry that are expensive to compute in every job, such as
+// the cubic volumes of boolean solids (estimated by Monte Carlo in Geant4)
+// or the tables of the point samplers. Entries are stored in files named
+// after a hash of the description of the solid, so they are found again
+// whatever the geometry parameters that led to the same solid.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "GeometryCache.h"
+#include "MappedFile.h"
+
+#include <G4VSolid.hh>
+#include <G4Version.hh>
+#include <G4ios.hh>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+
+namespace {
+
+  const char     CACHE_MAGIC[8] = {'N', 'X', 'G', 'E', 'O', 'M', 'C', 'H'};
+  const uint32_t CACHE_VERSION  = 1;
+
+  /// 64-bit FNV-1a hash of a string
+  uint64_t Hash(const std::string& text)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+}
+
+
+namespace nexus {
+
+  GeometryCache& GeometryCache::Instance()
+  {
+    static GeometryCache instance;
+    return instance;
+  }
+
+
+
+  GeometryCache::GeometryCache(): nreads_(0), nwrites_(0)
+  {
+  }
+
+
+
+  GeometryCache::~GeometryCache()
+  {
+  }
+
+
+
+  void GeometryCache::SetDirectory(const G4String& cache_dir)
+  {
+    cache_dir_ = cache_dir;
+    if (cache_dir_.empty()) return;
+
+    mkdir(cache_dir_.c_str(), 0755);
+    G4cout << "[GeometryCache] Geometry quantities are cached in "
+           << cache_dir_ << G4endl;
+  }
+
+
+
+  G4double GeometryCache::GetCubicVolume(G4VSolid* solid)
+  {
+    if (cache_dir_.empty()) return solid->GetCubicVolume();
+
+    uint64_t key = ComputeKey(solid);
+
+    std::vector<G4double> values;
+    if (Read(key, "volume", values) && values.size() == 1)
+      return values[0];
+
+    G4double volume = solid->GetCubicVolume();
+    Write(key, "volume", {volume});
+    return volume;
+  }
+
+
+
+  G4bool GeometryCache::Read(uint64_t key, const G4String& type,
+                             std::vector<G4double>& values) const
+  {
+    if (cache_dir_.empty()) return false;
+
+    MappedFile file;
+    if (!file.Open(FileName(key, type))) return false;
+
+    char magic[8];
+    uint32_t version;
+    size_t offset = 0;
+
+    if (!file.Read(offset, magic, sizeof(magic)) || !file.Read(offset, &version) ||
+        std::memcmp(magic, CACHE_MAGIC, sizeof(magic)) != 0 ||
+        version != CACHE_VERSION)
+      return false;
+
+    if (!file.ReadVector(offset, values)) {
+      values.clear();
+      return false;
+    }
+
+    nreads_++;
+    return true;
+  }
+
+
+
+  void GeometryCache::Write(uint64_t key, const G4String& type,
+                            const std::vector<G4double>& values) const
+  {
+    if (cache_dir_.empty()) return;
+
+    G4String filename = FileName(key, type);
+
+    // Written to a temporary file and renamed, so that concurrent
+    // jobs never read a partially written entry
+    G4String tmp = filename + ".tmp" + std::to_string(getpid());
+    std::ofstream file(tmp, std::ios::binary);
+
+    if (!file) {
+      G4cout << "[GeometryCache] Cannot write the cache file "
+             << filename << G4endl;
+      return;
+    }
+
+    uint64_t n = values.size();
+    file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&CACHE_VERSION), sizeof(CACHE_VERSION));
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    file.write(reinterpret_cast<const char*>(values.data()), n * sizeof(G4double));
+    file.close();
+
+    if (!file || std::rename(tmp.c_str(), filename.c_str()) != 0) {
+      std::remove(tmp.c_str());
+      G4cout << "[GeometryCache] Cannot write the cache file "
+             << filename << G4endl;
+      return;
+    }
+
+    nwrites_++;
+  }
+
+
+
+  uint64_t GeometryCache::ComputeKey(const G4VSolid* solid)
+  {
+    std::ostringstream description;
+    description << std::setprecision(17);
+
+    description << "geant4 " << G4VERSION_NUMBER << "\n";
+    solid->StreamInfo(description);
+
+    return Hash(description.str());
+  }
+
+
+
+  G4String GeometryCache::FileName(uint64_t key, const G4String& type) const
+  {
+    std::ostringstream filename;
+    filename << cache_dir_ << "/" << type << "_" << std::hex << std::setw(16)
+             << std::setfill('0') << key << ".bin";
+    return filename.str();
+  }
+
+} // end namespace nexus
@@ -0,0 +1,82 @@
+// ----------------------------------------------------------------------------
+// nexus | GeometryCache.h
+//
+// This class keeps in a cache directory the quantities derived from the
+// solids of a geometry that are expensive to compute in every job, such as
+// the cubic volumes of boolean solids (estimated by Monte Carlo in Geant4)
+// or the tables of the point samplers. Entries are stored in files named
+// after a hash of the description of the solid, so they are found again
+// whatever the geometry parameters that led to the same solid.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef GEOMETRY_CACHE_H
+#define GEOMETRY_CACHE_H
+
+#include <G4String.hh>
+
+#include <cstdint>
+#include <vector>
+
+class G4VSolid;
+
+
+namespace nexus {
+
+  class GeometryCache
+  {
+  public:
+    /// Returns the instance of the cache shared by all the geometries
+    static GeometryCache& Instance();
+
+    /// Sets the directory of the cache. The cache is disabled
+    /// (nothing is read or stored) while the directory is empty.
+    void SetDirectory(const G4String& cache_dir);
+    const G4String& GetDirectory() const;
+
+    /// Cubic volume of a solid, computed by Geant4 the first time
+    /// and read from the cache afterwards
+    G4double GetCubicVolume(G4VSolid*);
+
+    /// Reads the values stored under a key and a type of entry.
+    /// Returns false if there are none.
+    G4bool Read(uint64_t key, const G4String& type, std::vector<G4double>& values) const;
+
+    /// Stores values under a key and a type of entry
+    void Write(uint64_t key, const G4String& type, const std::vector<G4double>& values) const;
+
+    /// Entries read from the cache and entries computed and stored
+    /// in it so far, to report what the cache saved in a job
+    G4int GetNumberOfReads() const;
+    G4int GetNumberOfWrites() const;
+
+    /// Hash of the description of a solid, including its dimensions and,
+    /// for boolean solids, those of its constituents and their placement
+    static uint64_t ComputeKey(const G4VSolid*);
+
+  private:
+    GeometryCache();
+    ~GeometryCache();
+
+    G4String FileName(uint64_t key, const G4String& type) const;
+
+  private:
+    G4String cache_dir_; ///< Directory that holds the cached entries
+    mutable G4int nreads_, nwrites_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline const G4String& GeometryCache::GetDirectory() const
+  { return cache_dir_; }
+
+  inline G4int GeometryCache::GetNumberOfReads() const
+  { return nreads_; }
+
+  inline G4int GeometryCache::GetNumberOfWrites() const
+  { return nwrites_; }
+
+} // end namespace nexus
+
+#endif
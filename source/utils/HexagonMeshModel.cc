@@ -0,0 +1,192 @@
+// ----------------------------------------------------------------------------
+// nexus | HexagonMeshModel.cc
+//
+// Analytic model of the optical transport through a metallic mesh with
+// hexagonal holes, as built by PlaceHexagons. A photon entering the mesh
+// is traced inside the single hole (or against the single land) it hits,
+// so that the mesh can be simulated as one thin volume with the same
+// transmission and reflection as the explicit hexagons.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "HexagonMeshModel.h"
+
+#include <G4Exception.hh>
+#include <G4RandomTools.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+
+namespace {
+  /// Walls hit by a photon before it is considered absorbed. Only reached
+  /// for near-grazing photons, given the reflectivity of metals.
+  const G4int MAX_REFLECTIONS = 100;
+}
+
+
+namespace nexus {
+
+  using namespace CLHEP;
+
+  HexagonMeshModel::HexagonMeshModel(G4double hole_diam, G4double pitch,
+                                     G4double thickness):
+    hole_diam_(hole_diam), pitch_(pitch), thickn_(thickness)
+  {
+    if (hole_diam_ <= 0. || pitch_ <= hole_diam_ || thickn_ <= 0.)
+      G4Exception("[HexagonMeshModel]", "HexagonMeshModel()", FatalException,
+                  "The pitch of the mesh must be larger than its holes");
+
+    // The vertices of the holes lie on the x axis, so the walls
+    // are perpendicular to the directions at 30, 90 and 150 deg
+    for (G4int k=0; k<3; ++k)
+      normals_[k] = G4TwoVector(std::cos(pi/6. + k*pi/3.), std::sin(pi/6. + k*pi/3.));
+  }
+
+
+
+  HexagonMeshModel::~HexagonMeshModel()
+  {
+  }
+
+
+
+  G4double HexagonMeshModel::GetOpenArea() const
+  {
+    return (hole_diam_ * hole_diam_) / (pitch_ * pitch_);
+  }
+
+
+
+  G4TwoVector HexagonMeshModel::GetCellCentre(G4double x, G4double y) const
+  {
+    // Axial coordinates of the same lattice as PlaceHexagons,
+    // rounded to the nearest cell in cube coordinates
+    G4double size = pitch_ / std::sqrt(3.);
+    G4double q = 2./3. * x / size;
+    G4double r = (-x/3. + std::sqrt(3.)/3. * y) / size;
+    G4double s = -q - r;
+
+    G4double rq = std::round(q), rr = std::round(r), rs = std::round(s);
+    G4double dq = std::abs(rq - q), dr = std::abs(rr - r), ds = std::abs(rs - s);
+
+    if (dq > dr && dq > ds) rq = -rr - rs;
+    else if (dr > ds)       rr = -rq - rs;
+
+    return G4TwoVector(size * 3./2. * rq,
+                       size * (std::sqrt(3.)/2. * rq + std::sqrt(3.) * rr));
+  }
+
+
+
+  G4bool HexagonMeshModel::IsInHole(G4double x, G4double y) const
+  {
+    for (const auto& n : normals_)
+      if (std::abs(x * n.x() + y * n.y()) > hole_diam_/2.) return false;
+    return true;
+  }
+
+
+
+  HexagonMeshModel::Outcome
+  HexagonMeshModel::Propagate(G4ThreeVector& position, G4ThreeVector& direction,
+                              G4double reflectivity, G4double specular) const
+  {
+    if (direction.z() == 0.) return ABSORBED;
+
+    // The photon enters through the face it moves away from
+    G4double sign = (direction.z() > 0.) ? 1. : -1.;
+    G4double half = thickn_/2.;
+
+    G4TwoVector centre = GetCellCentre(position.x(), position.y());
+    G4ThreeVector point(position.x() - centre.x(), position.y() - centre.y(), -sign*half);
+    G4ThreeVector dir = direction;
+
+    if (!IsInHole(point.x(), point.y())) {
+      // Land between holes, facing the photon
+      if (G4UniformRand() >= reflectivity) return ABSORBED;
+      direction = Reflect(dir, G4ThreeVector(0., 0., -sign), specular);
+      position.setZ(-sign*half);
+      return REFLECTED;
+    }
+
+    for (G4int i=0; i<MAX_REFLECTIONS; ++i) {
+
+      // Distance to the face ahead of the photon and to the hole walls
+      G4double dist = DBL_MAX;
+      G4int wall = -1;
+
+      if (dir.z() != 0.)
+        dist = ((dir.z() > 0. ? half : -half) - point.z()) / dir.z();
+
+      for (G4int k=0; k<3; ++k) {
+        const G4TwoVector& n = normals_[k];
+        G4double dn = dir.x() * n.x() + dir.y() * n.y();
+        if (dn == 0.) continue;
+        G4double pn = point.x() * n.x() + point.y() * n.y();
+        G4double d = std::max(((dn > 0. ? hole_diam_ : -hole_diam_)/2. - pn) / dn, 0.);
+        if (d < dist) {
+          dist = d;
+          wall = k;
+        }
+      }
+
+      point += dist * dir;
+
+      if (wall < 0) {
+        position.set(point.x() + centre.x(), point.y() + centre.y(), point.z());
+        direction = dir;
+        return (dir.z() * sign > 0.) ? TRANSMITTED : REFLECTED;
+      }
+
+      if (G4UniformRand() >= reflectivity) return ABSORBED;
+
+      // Normal of the wall pointing into the hole
+      const G4TwoVector& n = normals_[wall];
+      G4double dn = dir.x() * n.x() + dir.y() * n.y();
+      G4ThreeVector normal = (dn > 0. ? -1. : 1.) * G4ThreeVector(n.x(), n.y(), 0.);
+
+      dir = Reflect(dir, normal, specular);
+    }
+
+    return ABSORBED;
+  }
+
+
+
+  G4ThreeVector HexagonMeshModel::Reflect(const G4ThreeVector& direction,
+                                          const G4ThreeVector& normal,
+                                          G4double specular) const
+  {
+    if (G4UniformRand() < specular)
+      return direction - 2. * direction.dot(normal) * normal;
+
+    return G4LambertianRand(normal);
+  }
+
+
+
+  G4double HexagonMeshModel::Transmission(const G4ThreeVector& direction,
+                                          G4double reflectivity, G4double specular,
+                                          G4int nphotons) const
+  {
+    // Entry points are uniform over one period of the lattice
+    G4TwoVector a1(pitch_ * std::sqrt(3.)/2., pitch_/2.);
+    G4TwoVector a2(0., pitch_);
+
+    G4int ntransmitted = 0;
+    for (G4int i=0; i<nphotons; ++i) {
+      G4TwoVector xy = G4UniformRand() * a1 + G4UniformRand() * a2;
+      G4ThreeVector position(xy.x(), xy.y(), 0.);
+      G4ThreeVector dir = direction.unit();
+      if (Propagate(position, dir, reflectivity, specular) == TRANSMITTED)
+        ++ntransmitted;
+    }
+
+    return G4double(ntransmitted) / nphotons;
+  }
+
+} // end namespace nexus
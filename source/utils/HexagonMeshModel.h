@@ -0,0 +1,74 @@
+// ----------------------------------------------------------------------------
+// nexus | HexagonMeshModel.h
+//
+// Analytic model of the optical transport through a metallic mesh with
+// hexagonal holes, as built by PlaceHexagons. A photon entering the mesh
+// is traced inside the single hole (or against the single land) it hits,
+// so that the mesh can be simulated as one thin volume with the same
+// transmission and reflection as the explicit hexagons.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef HEXAGON_MESH_MODEL_H
+#define HEXAGON_MESH_MODEL_H
+
+#include <G4ThreeVector.hh>
+#include <G4TwoVector.hh>
+
+
+namespace nexus {
+
+  class HexagonMeshModel
+  {
+  public:
+    enum Outcome { TRANSMITTED, REFLECTED, ABSORBED };
+
+    /// Constructor. The holes are hexagonal prisms with the given
+    /// flat-to-flat width, placed on a triangular lattice of the given
+    /// pitch (hole width plus metal land) centred at the origin, with
+    /// vertices along the x axis as in CreateHexagon.
+    HexagonMeshModel(G4double hole_diam, G4double pitch, G4double thickness);
+
+    /// Destructor
+    ~HexagonMeshModel();
+
+    /// Propagates a photon entering the mesh at the given point of one of
+    /// its faces (in the local frame, with the mesh centred at z=0) through
+    /// the hole or off the metal it hits. The metal reflects with the given
+    /// probability, specularly with probability specular and otherwise with
+    /// a Lambertian distribution. Position and direction are updated to
+    /// the exit point and direction.
+    Outcome Propagate(G4ThreeVector& position, G4ThreeVector& direction,
+                      G4double reflectivity, G4double specular) const;
+
+    /// Fraction of photons transmitted for a given incidence direction,
+    /// averaged over nphotons random entry points
+    G4double Transmission(const G4ThreeVector& direction, G4double reflectivity,
+                          G4double specular, G4int nphotons) const;
+
+    /// Fraction of the mesh area taken by the holes
+    G4double GetOpenArea() const;
+
+    /// Centre of the lattice cell (hole and surrounding land)
+    /// that contains the point
+    G4TwoVector GetCellCentre(G4double x, G4double y) const;
+
+    /// True if the point, relative to a hole centre, lies inside the hole
+    G4bool IsInHole(G4double x, G4double y) const;
+
+  private:
+    G4ThreeVector Reflect(const G4ThreeVector& direction,
+                          const G4ThreeVector& normal, G4double specular) const;
+
+  private:
+    G4double hole_diam_; ///< Flat-to-flat width of the holes
+    G4double pitch_;     ///< Distance between the centres of adjacent holes
+    G4double thickn_;    ///< Thickness of the mesh
+
+    G4TwoVector normals_[3]; ///< Normals to the pairs of hole walls
+  };
+
+} // end namespace nexus
+
+#endif
@@ -0,0 +1,416 @@
+// ----------------------------------------------------------------------------
+// nexus | HistogramSampler.cc
+//
+// This class samples points from an N-dimensional histogram, such as those
+// stored in the csv files read by IOUtils. Bins are drawn in constant time
+// with Walker's alias method and the bin centres are smeared with a Gaussian
+// of per-bin width. The parsed histogram and the alias table are cached in
+// a binary file next to the csv file, so that later jobs skip the parsing.
+// The cache is mapped in memory read-only, so that all the jobs running on
+// a node share a single copy of the tables.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "HistogramSampler.h"
+
+#include <G4Exception.hh>
+#include <G4ios.hh>
+#include <Randomize.hh>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+
+namespace {
+
+  const char     CACHE_MAGIC[8] = {'N', 'X', 'H', 'I', 'S', 'T', 'O', 'S'};
+  const uint32_t CACHE_VERSION  = 2;
+
+  /// Header at the beginning of a cache file. It is followed by the
+  /// tables, each aligned to 8 bytes so that they can be used in place
+  /// once mapped, and by the labels.
+  struct CacheHeader
+  {
+    char     magic[8]; ///< File signature ("NXHISTOS")
+    uint32_t version;  ///< Format version
+    int32_t  ndim;     ///< Number of dimensions
+    int64_t  size;     ///< Size of the csv file
+    int64_t  mtime;    ///< Modification time of the csv file
+    uint64_t nbins;    ///< Number of bins
+    uint64_t nlabels;  ///< Number of labels
+  };
+
+  /// Size and modification time of the csv file, stored in the cache
+  /// to detect when it is stale
+  struct FileStamp
+  {
+    int64_t size;
+    int64_t mtime;
+  };
+
+  FileStamp GetFileStamp(const G4String& filename)
+  {
+    struct stat file_stat;
+    if (stat(filename.c_str(), &file_stat) != 0) return {-1, -1};
+    return {static_cast<int64_t>(file_stat.st_size),
+            static_cast<int64_t>(file_stat.st_mtime)};
+  }
+
+  /// Bytes taken by n values of a table, padded to 8 bytes
+  template <typename T>
+  size_t TableSize(size_t n)
+  {
+    return (n * sizeof(T) + 7) / 8 * 8;
+  }
+
+  template <typename T>
+  void WriteTable(std::ofstream& file, const std::vector<T>& v)
+  {
+    const char padding[8] = {};
+    size_t bytes = v.size() * sizeof(T);
+    file.write(reinterpret_cast<const char*>(v.data()), bytes);
+    file.write(padding, TableSize<T>(v.size()) - bytes);
+  }
+
+}
+
+
+namespace nexus {
+
+  HistogramSampler::HistogramSampler(const G4String& filename, G4int ndim,
+                                     G4bool use_cache):
+    ndim_(ndim)
+  {
+    if (use_cache && ReadCache(filename)) return;
+
+    LoadCSV(filename);
+    BuildAliasTable();
+    SetTables();
+
+    if (use_cache) WriteCache(filename);
+  }
+
+
+
+  HistogramSampler::HistogramSampler(G4int ndim,
+                                     const std::vector<G4double>& weights,
+                                     const std::vector<G4double>& centres,
+                                     const std::vector<G4double>& smears):
+    ndim_(ndim), weights_(weights), centres_(centres), smears_(smears)
+  {
+    if (centres_.size() != weights_.size() * ndim_ ||
+        smears_.size()  != weights_.size() * ndim_)
+      G4Exception("[HistogramSampler]", "HistogramSampler()", FatalException,
+                  "Bin centres and smears do not match the number of bins");
+
+    BuildAliasTable();
+    SetTables();
+  }
+
+
+
+  HistogramSampler::~HistogramSampler()
+  {
+  }
+
+
+
+  size_t HistogramSampler::SampleBin() const
+  {
+    G4double u = G4UniformRand() * tables_.nbins;
+    size_t bin = std::min(static_cast<size_t>(u), tables_.nbins - 1);
+    return (u - bin < tables_.prob[bin]) ? bin : tables_.alias[bin];
+  }
+
+
+
+  size_t HistogramSampler::Sample(G4double* values) const
+  {
+    size_t bin = SampleBin();
+
+    for (G4int i=0; i<ndim_; ++i)
+      values[i] = GetCentre(bin, i) + G4RandGauss::shoot(0., GetSmear(bin, i));
+
+    return bin;
+  }
+
+
+
+  G4bool HistogramSampler::GetLabelRange(const G4String& label,
+                                         G4double& min, G4double& max) const
+  {
+    auto it = labels_.find(label);
+    if (it == labels_.end()) return false;
+
+    min = it->second.first;
+    max = it->second.second;
+    return true;
+  }
+
+
+
+  G4String HistogramSampler::CacheFileName(const G4String& filename)
+  {
+    return filename + ".bin";
+  }
+
+
+
+  void HistogramSampler::LoadCSV(const G4String& filename)
+  {
+    std::ifstream file(filename);
+
+    if (!file.is_open())
+      G4Exception("[HistogramSampler]", "LoadCSV()", FatalException,
+                  ("Could not read in the CSV file " + filename).c_str());
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    // Parse the numbers in place rather than through getline and stod
+    const char* c = text.c_str();
+    const char* end = c + text.size();
+
+    while (c < end) {
+
+      const char* comma = static_cast<const char*>(std::memchr(c, ',', end - c));
+      const char* eol   = static_cast<const char*>(std::memchr(c, '\n', end - c));
+      if (!eol) eol = end;
+
+      if (!comma || comma > eol) { // Blank or malformed line
+        c = eol + 1;
+        continue;
+      }
+
+      G4String label(c, comma - c);
+      c = comma + 1;
+
+      std::vector<G4double> numbers;
+      while (c < eol) {
+        char* next;
+        G4double value = std::strtod(c, &next);
+        if (next == c) break;
+        numbers.push_back(value);
+        c = (*next == ',') ? next + 1 : next;
+      }
+      c = eol + 1;
+
+      if (label == "value") {
+
+        if (numbers.size() != static_cast<size_t>(1 + 2 * ndim_))
+          G4Exception("[HistogramSampler]", "LoadCSV()", FatalException,
+                      ("Wrong number of columns in the CSV file " + filename).c_str());
+
+        weights_.push_back(numbers[0]);
+        centres_.insert(centres_.end(), numbers.begin() + 1, numbers.begin() + 1 + ndim_);
+        smears_.insert(smears_.end(), numbers.begin() + 1 + ndim_, numbers.end());
+      }
+      else if (!numbers.empty()) {
+
+        auto it = labels_.find(label);
+        if (it == labels_.end())
+          labels_[label] = std::make_pair(numbers[0], numbers[0]);
+        else {
+          it->second.first  = std::min(it->second.first,  numbers[0]);
+          it->second.second = std::max(it->second.second, numbers[0]);
+        }
+      }
+    }
+  }
+
+
+
+  void HistogramSampler::BuildAliasTable()
+  {
+    size_t nbins = weights_.size();
+
+    G4double total = 0.;
+    for (auto w : weights_) {
+      if (w < 0.)
+        G4Exception("[HistogramSampler]", "BuildAliasTable()", FatalException,
+                    "Negative bin content");
+      total += w;
+    }
+
+    if (nbins == 0 || total <= 0.)
+      G4Exception("[HistogramSampler]", "BuildAliasTable()", FatalException,
+                  "Empty histogram");
+
+    // Vose's construction: bins below the mean are topped up
+    // with the excess of a bin above it
+    prob_.resize(nbins);
+    alias_.resize(nbins);
+
+    std::vector<G4double> scaled(nbins);
+    std::vector<uint32_t> small, large;
+
+    for (size_t i=0; i<nbins; ++i) {
+      scaled[i] = weights_[i] * nbins / total;
+      if (scaled[i] < 1.) small.push_back(i);
+      else                large.push_back(i);
+    }
+
+    while (!small.empty() && !large.empty()) {
+      uint32_t s = small.back(); small.pop_back();
+      uint32_t l = large.back(); large.pop_back();
+
+      prob_[s]  = scaled[s];
+      alias_[s] = l;
+
+      scaled[l] += scaled[s] - 1.;
+      if (scaled[l] < 1.) small.push_back(l);
+      else                large.push_back(l);
+    }
+
+    // Remaining bins are full, up to rounding
+    for (auto i : large) { prob_[i] = 1.; alias_[i] = i; }
+    for (auto i : small) { prob_[i] = 1.; alias_[i] = i; }
+  }
+
+
+
+  void HistogramSampler::SetTables()
+  {
+    tables_.nbins   = weights_.size();
+    tables_.weights = weights_.data();
+    tables_.centres = centres_.data();
+    tables_.smears  = smears_.data();
+    tables_.prob    = prob_.data();
+    tables_.alias   = alias_.data();
+  }
+
+
+
+  G4bool HistogramSampler::ReadCache(const G4String& filename)
+  {
+    if (!mapping_.Open(CacheFileName(filename))) return false;
+
+    if (!MapTables(filename)) {
+      mapping_.Close();
+      tables_ = Tables();
+      labels_.clear();
+      return false;
+    }
+
+    return true;
+  }
+
+
+
+  G4bool HistogramSampler::MapTables(const G4String& filename)
+  {
+    const CacheHeader* header = mapping_.At<CacheHeader>(0);
+    if (!header) return false;
+
+    FileStamp csv_stamp = GetFileStamp(filename);
+
+    if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header->version != CACHE_VERSION || header->ndim != ndim_ ||
+        header->size != csv_stamp.size || header->mtime != csv_stamp.mtime ||
+        header->nbins == 0)
+      return false;
+
+    // The tables are used in place
+    size_t nbins  = header->nbins;
+    size_t offset = sizeof(CacheHeader);
+
+    tables_.nbins   = nbins;
+    tables_.weights = mapping_.At<G4double>(offset, nbins);
+    offset += TableSize<G4double>(nbins);
+    tables_.centres = mapping_.At<G4double>(offset, nbins * ndim_);
+    offset += TableSize<G4double>(nbins * ndim_);
+    tables_.smears  = mapping_.At<G4double>(offset, nbins * ndim_);
+    offset += TableSize<G4double>(nbins * ndim_);
+    tables_.prob    = mapping_.At<G4double>(offset, nbins);
+    offset += TableSize<G4double>(nbins);
+    tables_.alias   = mapping_.At<uint32_t>(offset, nbins);
+    offset += TableSize<uint32_t>(nbins);
+
+    if (!tables_.weights || !tables_.centres || !tables_.smears ||
+        !tables_.prob || !tables_.alias)
+      return false;
+
+    // A corrupted alias would make SampleBin read past the tables
+    for (size_t i=0; i<nbins; ++i)
+      if (tables_.alias[i] >= nbins) return false;
+
+    // The labels are few, and copied: length of the name,
+    // name and range of values of each of them
+    for (uint64_t i=0; i<header->nlabels; ++i) {
+      uint64_t length;
+      G4double range[2];
+      if (!mapping_.Read(offset, &length)) return false;
+      const char* name = mapping_.At<char>(offset, length);
+      if (!name) return false;
+      offset += length;
+      if (!mapping_.Read(offset, range, 2)) return false;
+      labels_[G4String(name, length)] = std::make_pair(range[0], range[1]);
+    }
+
+    return labels_.size() == header->nlabels;
+  }
+
+
+
+  void HistogramSampler::WriteCache(const G4String& filename) const
+  {
+    G4String cache = CacheFileName(filename);
+
+    // Written to a temporary file and renamed, so that concurrent
+    // jobs never read a partially written cache. Jobs that mapped
+    // a previous version of the file keep reading it.
+    G4String tmp = cache + ".tmp" + std::to_string(getpid());
+    std::ofstream file(tmp, std::ios::binary);
+
+    if (!file) {
+      G4cout << "[HistogramSampler] Cannot write the cache file "
+             << cache << G4endl;
+      return;
+    }
+
+    FileStamp stamp = GetFileStamp(filename);
+
+    CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.ndim    = ndim_;
+    header.size    = stamp.size;
+    header.mtime   = stamp.mtime;
+    header.nbins   = weights_.size();
+    header.nlabels = labels_.size();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    WriteTable(file, weights_);
+    WriteTable(file, centres_);
+    WriteTable(file, smears_);
+    WriteTable(file, prob_);
+    WriteTable(file, alias_);
+
+    for (const auto& label : labels_) {
+      uint64_t length = label.first.size();
+      G4double range[2] = {label.second.first, label.second.second};
+      file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+      file.write(label.first.data(), length);
+      file.write(reinterpret_cast<const char*>(range), sizeof(range));
+    }
+
+    file.close();
+
+    if (!file || std::rename(tmp.c_str(), cache.c_str()) != 0) {
+      std::remove(tmp.c_str());
+      G4cout << "[HistogramSampler] Cannot write the cache file "
+             << cache << G4endl;
+    }
+  }
+
+} // end namespace nexus
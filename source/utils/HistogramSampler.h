@@ -0,0 +1,135 @@
+// ----------------------------------------------------------------------------
+// nexus | HistogramSampler.h
+//
+// This class samples points from an N-dimensional histogram, such as those
+// stored in the csv files read by IOUtils. Bins are drawn in constant time
+// with Walker's alias method and the bin centres are smeared with a Gaussian
+// of per-bin width. The parsed histogram and the alias table are cached in
+// a binary file next to the csv file, so that later jobs skip the parsing.
+// The cache is mapped in memory read-only, so that all the jobs running on
+// a node share a single copy of the tables.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef HISTOGRAM_SAMPLER_H
+#define HISTOGRAM_SAMPLER_H
+
+#include "MappedFile.h"
+
+#include <G4String.hh>
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+
+namespace nexus {
+
+  class HistogramSampler
+  {
+  public:
+    /// Constructor. Loads a ndim-dimensional histogram from a csv file with
+    /// lines value,<intensity>,<bin centres>,<bin smears>. Other lines,
+    /// of the form <label>,<value>, are kept as the range of each label.
+    /// The binary cache is used if it is newer than the csv file. It is
+    /// written by the first job that reads the csv file and mapped by
+    /// the later ones.
+    HistogramSampler(const G4String& filename, G4int ndim,
+                     G4bool use_cache = true);
+
+    /// Constructor from histogram contents. Centres and smears are given
+    /// per bin, with ndim consecutive values each.
+    HistogramSampler(G4int ndim, const std::vector<G4double>& weights,
+                     const std::vector<G4double>& centres,
+                     const std::vector<G4double>& smears);
+
+    /// Destructor. Unmaps the cache.
+    ~HistogramSampler();
+
+    HistogramSampler(const HistogramSampler&) = delete;
+    HistogramSampler& operator=(const HistogramSampler&) = delete;
+
+    /// Returns a bin index with probability proportional to its weight
+    size_t SampleBin() const;
+
+    /// Samples a bin, fills values with its smeared centre
+    /// and returns its index
+    size_t Sample(G4double* values) const;
+
+    G4int GetDimension() const;
+    size_t GetNumberOfBins() const;
+    G4double GetWeight(size_t bin) const;
+    G4double GetCentre(size_t bin, G4int dim) const;
+    G4double GetSmear(size_t bin, G4int dim) const;
+
+    /// Minimum and maximum value of the lines with a given label.
+    /// Returns false if there is no such label.
+    G4bool GetLabelRange(const G4String& label,
+                         G4double& min, G4double& max) const;
+
+    /// Name of the binary cache of a csv file
+    static G4String CacheFileName(const G4String& filename);
+
+    /// True if the tables are those of the mapped cache
+    G4bool IsMapped() const;
+
+  private:
+    void LoadCSV(const G4String& filename);
+    void BuildAliasTable();
+    void SetTables();
+    G4bool ReadCache(const G4String& filename);
+    G4bool MapTables(const G4String& filename);
+    void WriteCache(const G4String& filename) const;
+
+  private:
+    /// Tables used for sampling, either in the vectors below
+    /// or in the mapped cache
+    struct Tables
+    {
+      size_t nbins = 0;
+      const G4double* weights = nullptr;
+      const G4double* centres = nullptr;
+      const G4double* smears  = nullptr;
+      const G4double* prob    = nullptr;
+      const uint32_t* alias   = nullptr;
+    };
+
+    G4int ndim_; ///< Number of dimensions
+    std::vector<G4double> weights_; ///< Bin contents
+    std::vector<G4double> centres_; ///< Bin centres, ndim per bin
+    std::vector<G4double> smears_;  ///< Bin smearing widths, ndim per bin
+
+    std::vector<G4double> prob_;  ///< Probability of keeping each bin
+    std::vector<uint32_t> alias_; ///< Bin used otherwise
+
+    std::map<G4String, std::pair<G4double, G4double>> labels_;
+
+    Tables tables_;
+    MappedFile mapping_; ///< Mapped cache file, if any
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4int HistogramSampler::GetDimension() const
+  { return ndim_; }
+
+  inline size_t HistogramSampler::GetNumberOfBins() const
+  { return tables_.nbins; }
+
+  inline G4double HistogramSampler::GetWeight(size_t bin) const
+  { return tables_.weights[bin]; }
+
+  inline G4double HistogramSampler::GetCentre(size_t bin, G4int dim) const
+  { return tables_.centres[bin * ndim_ + dim]; }
+
+  inline G4double HistogramSampler::GetSmear(size_t bin, G4int dim) const
+  { return tables_.smears[bin * ndim_ + dim]; }
+
+  inline G4bool HistogramSampler::IsMapped() const
+  { return mapping_.IsOpen(); }
+
+} // end namespace nexus
+
+#endif
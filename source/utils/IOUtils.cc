@@ -9,6 +9,23 @@
 
 namespace nexus {
 
+  namespace {
+
+    void CheckVarRange(G4double file_VarMin, G4double file_VarMax,
+                       G4double var_min, G4double var_max, std::string HeaderName){
+
+      // Check if the specified variable range has been set to a suitable value
+      if ((var_min < file_VarMin || var_max > file_VarMax )){
+        std::cout << "The minimum " << HeaderName <<" value allowed is: " << file_VarMin << ", your input config min value is: " << var_min << std::endl;
+        std::cout << "The maximum " << HeaderName <<" value allowed is: " << file_VarMax << ", your input config max value is: " << var_max << std::endl;
+        G4Exception("[RandomUtils]", "CheckVarBounds()",
+                  FatalException, " Specified range for sampling is outside permitted range or the min/max of the variable has not been set");
+      }
+
+    }
+
+  }
+
   // --------
 
   // Input file format:
@@ -203,18 +220,26 @@ namespace nexus {
 
     } // END While
 
-     // Check if the specified variable range has been set to a suitable value
-    if ((var_min < file_VarMin || var_max > file_VarMax )){
-      std::cout << "The minimum " << HeaderName <<" value allowed is: " << file_VarMin << ", your input config min value is: " << var_min << std::endl;
-      std::cout << "The maximum " << HeaderName <<" value allowed is: " << file_VarMax << ", your input config max value is: " << var_max << std::endl;
-      G4Exception("[RandomUtils]", "CheckVarBounds()",
-                FatalException, " Specified range for sampling is outside permitted range or the min/max of the variable has not been set");
-    }
+    CheckVarRange(file_VarMin, file_VarMax, var_min, var_max, HeaderName);
 
     FileIn_.close();
   
   }  // END CheckVarBounds
 
+  // --------
+
+  void CheckVarBounds(const HistogramSampler& hist, G4double var_min, G4double var_max, std::string HeaderName){
+
+    // Same defaults as when the variable is not found in the file
+    G4double file_VarMin = 1.0e20;
+    G4double file_VarMax = 0.;
+
+    hist.GetLabelRange(HeaderName, file_VarMin, file_VarMax);
+
+    CheckVarRange(file_VarMin, file_VarMax, var_min, var_max, HeaderName);
+
+  }  // END CheckVarBounds
+
 
   // -------
 
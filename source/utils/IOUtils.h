@@ -6,6 +6,8 @@
 // The NEXT Collaboration
 // ----------------------------------------------------------------------------
 
+#include "HistogramSampler.h"
+
 #include <G4ThreeVector.hh>
 
 #include <Randomize.hh>
@@ -37,6 +39,9 @@ namespace nexus {
     // Header name is the string in the file that identifies the bins you want to check. e.g. energy, azimuth, zenith
     void CheckVarBounds(std::string filename, G4double var_min, G4double var_max, std::string HeaderName);
 
+    // Same check on the labels of a histogram already loaded, without reading the file again
+    void CheckVarBounds(const HistogramSampler& hist, G4double var_min, G4double var_max, std::string HeaderName);
+
 
 }
 
@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// nexus | MappedFile.cc
+//
+// Read-only memory mapping of a binary file, such as the caches of tables
+// written by the samplers and generators. The pages are shared by all the
+// jobs that map the same file on a node. Tables are read in place or copied
+// through bounds-checked accessors, so that a truncated file is detected.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "MappedFile.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+namespace nexus {
+
+  MappedFile::MappedFile(): data_(nullptr), size_(0)
+  {
+  }
+
+
+
+  MappedFile::~MappedFile()
+  {
+    Close();
+  }
+
+
+
+  G4bool MappedFile::Open(const G4String& filename)
+  {
+    Close();
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat file_stat;
+    void* data = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+      data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid once the descriptor is closed
+    close(fd);
+
+    if (data == MAP_FAILED) return false;
+
+    data_ = data;
+    size_ = file_stat.st_size;
+    return true;
+  }
+
+
+
+  void MappedFile::Close()
+  {
+    if (data_) munmap(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+
+} // end namespace nexus
@@ -0,0 +1,117 @@
+// ----------------------------------------------------------------------------
+// nexus | MappedFile.h
+//
+// Read-only memory mapping of a binary file, such as the caches of tables
+// written by the samplers and generators. The pages are shared by all the
+// jobs that map the same file on a node. Tables are read in place or copied
+// through bounds-checked accessors, so that a truncated file is detected.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <G4String.hh>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+
+namespace nexus {
+
+  class MappedFile
+  {
+  public:
+    /// Constructor. Nothing is mapped until Open is called.
+    MappedFile();
+    /// Destructor. Unmaps the file.
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Maps a file. Returns false, and maps nothing, if it
+    /// does not exist, is empty or cannot be mapped.
+    G4bool Open(const G4String& filename);
+    /// Unmaps the file, if any
+    void Close();
+
+    G4bool IsOpen() const;
+    const char* GetData() const;
+    size_t GetSize() const;
+
+    /// Whether n values of type T starting at a byte offset fit in the file
+    template <typename T>
+    G4bool Fits(size_t offset, size_t n = 1) const;
+
+    /// Pointer to n values of type T starting at a byte offset, which
+    /// must be aligned for T, or null if they do not fit in the file
+    template <typename T>
+    const T* At(size_t offset, size_t n = 1) const;
+
+    /// Copies n values starting at a byte offset, which is moved past
+    /// them. Returns false if they do not fit in the file.
+    template <typename T>
+    G4bool Read(size_t& offset, T* values, size_t n = 1) const;
+
+    /// Reads a table stored as its number of values (uint64_t)
+    /// followed by the values
+    template <typename T>
+    G4bool ReadVector(size_t& offset, std::vector<T>& values) const;
+
+  private:
+    void*  data_; ///< Mapped file
+    size_t size_; ///< Size of the mapped file
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4bool MappedFile::IsOpen() const
+  { return data_ != nullptr; }
+
+  inline const char* MappedFile::GetData() const
+  { return static_cast<const char*>(data_); }
+
+  inline size_t MappedFile::GetSize() const
+  { return size_; }
+
+  template <typename T>
+  inline G4bool MappedFile::Fits(size_t offset, size_t n) const
+  {
+    return data_ && offset <= size_ && n <= (size_ - offset) / sizeof(T);
+  }
+
+  template <typename T>
+  inline const T* MappedFile::At(size_t offset, size_t n) const
+  {
+    if (!Fits<T>(offset, n) || offset % alignof(T) != 0) return nullptr;
+    return reinterpret_cast<const T*>(GetData() + offset);
+  }
+
+  template <typename T>
+  inline G4bool MappedFile::Read(size_t& offset, T* values, size_t n) const
+  {
+    if (!Fits<T>(offset, n)) return false;
+    std::memcpy(values, GetData() + offset, n * sizeof(T));
+    offset += n * sizeof(T);
+    return true;
+  }
+
+  template <typename T>
+  inline G4bool MappedFile::ReadVector(size_t& offset, std::vector<T>& values) const
+  {
+    uint64_t n = 0;
+    size_t start = offset;
+    if (!Read(start, &n) || !Fits<T>(start, n)) return false;
+    values.resize(n);
+    Read(start, values.data(), n);
+    offset = start;
+    return true;
+  }
+
+} // end namespace nexus
+
+#endif
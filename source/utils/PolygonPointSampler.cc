@@ -66,14 +66,7 @@ namespace nexus {
 
     // Sample inside the polygon
     else if (region == INSIDE) {
-      G4bool valid_sample = false;
-      std::vector<G4double> point;
-      while (!valid_sample){
-        point = {2.0 * min_radius_ * (G4UniformRand() - 0.5),
-                 2.0 * min_radius_ * (G4UniformRand() - 0.5)};
-        valid_sample = CheckXYBoundsPolygon(point, polygon_inner_);
-      }
-
+      std::vector<G4double> point = SampleXYinPolygon(0., min_radius_);
       x = point[0];
       y = point[1];
       z = GetLength(half_length_);
@@ -81,27 +74,7 @@ namespace nexus {
 
     // Generating from inside the polygon (between min_radius and max_radius)
     else if (region == VOLUME) {
-
-      // sample position based on interior radius
-      G4bool valid_sample = false;
-      std::vector<G4double> point;
-
-      while (!valid_sample){
-        
-        G4double internal_radius = min_radius_ * std::cos(M_PI/n_sides_);
-
-        G4double phi = GetPhi();
-        G4double rad = GetRadius(internal_radius, max_radius_);
-        point = {rad * cos(phi), rad * sin(phi)};
-
-        G4bool inside_inner = CheckXYBoundsPolygon(point, polygon_inner_);
-        G4bool inside_outer = CheckXYBoundsPolygon(point, polygon_outer_);
-
-        // Want outside inner and inside outer
-        if (!inside_inner && inside_outer)
-          valid_sample = true;
-      }
-
+      std::vector<G4double> point = SampleXYinPolygon(min_radius_, max_radius_);
       x = point[0];
       y = point[1];
       z = GetLength(half_length_);
@@ -142,50 +115,13 @@ namespace nexus {
   }
 
 
-  G4bool PolygonPointSampler::CheckXYBoundsPolygon(std::vector<G4double> point, std::vector<std::vector<G4double>> polygon){
-
-    // This function checks if a point is inside a polygon (needed for checking if
-    // inside the drift tube which has an octagonal-like shape).
-    // It works by counting intersections of the point in the horizontal plane.
-    // A point is inside the polygon if either count of intersections is odd
-    // or point lies on an edge of polygon. As described in 
-    // https://www.geeksforgeeks.org/how-to-check-if-a-given-point-lies-inside-a-polygon/
-    
-
-    G4double x = point[0], y = point[1];
-    G4bool inside = false;
-
-    // Store the first vertex in the polygon
-    std::vector<G4double> p1 = {polygon[0][0],polygon[0][1]};
-
-    // Loop through each edge in the polygon
-    for (G4int i = 1; i <= n_sides_; i++) {
-      
-      // Get the next vertex in the polygon
-      std::vector<G4double> p2 ={polygon[i % n_sides_][0], polygon[i % n_sides_][1]};
+  std::vector<G4double> PolygonPointSampler::SampleXYinPolygon(G4double min_radius, G4double max_radius) {
 
-      // 1. Check if the point is above the minimum y coordinate of the edge
-      // 2. Check if the point is below the maximum y coordinate of the edge
-      // 3. Check if the point is to the left of the maximum x coordinate of the edge
-      if ( (y > std::min(p1[1], p2[1])) && (y <= std::max(p1[1], p2[1])) && (x <= std::max(p1[0], p2[0])) ) {
-
-        // Calculate the x-intersection of the line connecting the point to the edge
-        G4double x_intersection = (y - p1[1]) * (p2[0] - p1[0]) / (p2[1] - p1[1]) + p1[0];
-
-        // Check if the point is to the left of the x-intersection
-        if (x <= x_intersection) {
-          // Flip the inside flag
-          inside = !inside;
-        }
-      }
-
-        // Store the current vertex as the first vertex for the next iteration
-        p1 = p2;
-    }
-   
-    // Return the value of the inside flag
-    return inside;
-    
+    // The region between two concentric regular polygons is the union of
+    // the edges of the polygons with a radius in between. Choosing the
+    // radius with a density proportional to it (as in an annulus) and a
+    // uniform point on one of the edges gives a uniform point in the region.
+    return SampleXYonPolygonEdge(GetRadius(min_radius, max_radius));
   }
 
 
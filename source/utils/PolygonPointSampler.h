@@ -49,8 +49,8 @@ namespace nexus {
     G4ThreeVector RotateAndTranslate(G4ThreeVector position);
     void InvertRotationAndTranslation(G4ThreeVector& vec, G4bool translate=true);
 
-    // Check if point is inside the polygon
-    G4bool CheckXYBoundsPolygon(std::vector<G4double> point, std::vector<std::vector<G4double>> polygon);
+    // Function to sample x and y positions uniformly between two regular polygons with given radii
+    std::vector<G4double> SampleXYinPolygon(G4double min_radius, G4double max_radius);
 
     // Function to sample x and y positions on the edge of a regular polygon with given radius and number of sides
     std::vector<G4double> SampleXYonPolygonEdge(G4double radius);
@@ -34,7 +34,7 @@ namespace nexus {
                           cosTheta).unit();
   }
 
-  G4int GetRandBinIndex(G4RandGeneral *fRandomGeneral, std::vector<G4double> intensity){
+  G4int GetRandBinIndex(G4RandGeneral *fRandomGeneral, const std::vector<G4double>& intensity){
 
     return round(fRandomGeneral->fire()*intensity.size());
 
@@ -22,7 +22,7 @@ namespace nexus {
                                        G4double phi_min, G4double phi_max);
 
     /// Get the random bin index of histogram distribution
-    G4int GetRandBinIndex(G4RandGeneral *fRandomGeneral, std::vector<G4double> value);
+    G4int GetRandBinIndex(G4RandGeneral *fRandomGeneral, const std::vector<G4double>& value);
 
     /// Get the value of the random sample
     G4double Sample(G4double sample, G4bool smear, G4double smearval);
@@ -36,7 +36,7 @@ namespace nexus {
     /// Check if the sampled value is out of bounds, max check only
     G4bool CheckOutOfBoundMax(G4double max, G4double val);
 
-  enum vtx_region {VOLUME, INSIDE, INNER_SURF, OUTER_SURF, CENTER};
+  enum vtx_region {VOLUME, INSIDE, INNER_SURF, OUTER_SURF, CENTER, SURFACE};
 
 
 }
@@ -0,0 +1,382 @@
+// ----------------------------------------------------------------------------
+// nexus | SolidPointSampler.cc
+//
+// This class is a sampler of random uniform points in the volume or on the
+// surface of any Geant4 solid, including boolean ones. The surface is
+// triangulated once into a table of cumulative areas, points on the facets
+// being projected onto the curved surfaces, and the bounding box
+// of the solid is divided into cells, refined near the surface, whose
+// cumulative volumes are tabulated, so that a point costs a binary search.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "SolidPointSampler.h"
+#include "GeometryCache.h"
+
+#include <G4VSolid.hh>
+#include <G4LogicalVolume.hh>
+#include <G4VPhysicalVolume.hh>
+#include <G4SubtractionSolid.hh>
+#include <G4Polyhedron.hh>
+#include <G4Transform3D.hh>
+#include <G4Exception.hh>
+#include <Randomize.hh>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace {
+
+  /// Points rejected in a row before giving up on a solid
+  const G4int MAX_TRIALS = 1000000;
+
+  /// Index of the bin of a cumulative table where a random number falls
+  size_t SampleIndex(const std::vector<G4double>& cumulative)
+  {
+    auto bin = std::upper_bound(cumulative.begin(), cumulative.end(),
+                                G4UniformRand() * cumulative.back());
+    return std::min<size_t>(bin - cumulative.begin(), cumulative.size() - 1);
+  }
+
+}
+
+
+namespace nexus {
+
+  SolidPointSampler::SolidPointSampler(const G4VSolid* solid,
+                                       G4RotationMatrix* rotation,
+                                       G4ThreeVector origin):
+    solid_(solid), logic_(nullptr), rotation_(rotation), origin_(origin),
+    nbins_(16), depth_(3), rotation_steps_(120), partial_volume_(0.)
+  {
+  }
+
+
+
+  SolidPointSampler::SolidPointSampler(const G4LogicalVolume* logic,
+                                       G4RotationMatrix* rotation,
+                                       G4ThreeVector origin):
+    solid_(nullptr), logic_(logic), rotation_(rotation), origin_(origin),
+    nbins_(16), depth_(3), rotation_steps_(120), partial_volume_(0.)
+  {
+  }
+
+
+
+  SolidPointSampler::~SolidPointSampler()
+  {
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::GenerateVertex(const vtx_region& region)
+  {
+    G4ThreeVector position;
+
+    if (region == VOLUME) {
+      if (cells_.empty()) BuildVolumeTable();
+      position = SampleVolume();
+    }
+    else if (region == SURFACE) {
+      if (triangles_.empty()) BuildSurfaceTable();
+      position = SampleSurface();
+    }
+    else {
+      G4Exception("[SolidPointSampler]", "GenerateVertex()", FatalErrorInArgument,
+                  "Unknown vertex region! Possible are VOLUME and SURFACE");
+    }
+
+    return RotateAndTranslate(position);
+  }
+
+
+
+  void SolidPointSampler::SetVoxelization(G4int nbins, G4int depth)
+  {
+    if (nbins < 1 || depth < 0)
+      G4Exception("[SolidPointSampler]", "SetVoxelization()", FatalErrorInArgument,
+                  "The number of cells must be positive.");
+    nbins_ = nbins;
+    depth_ = depth;
+  }
+
+
+
+  void SolidPointSampler::SetRotationSteps(G4int steps)
+  {
+    if (steps < 3)
+      G4Exception("[SolidPointSampler]", "SetRotationSteps()", FatalErrorInArgument,
+                  "At least 3 segments are needed to describe curved surfaces.");
+    rotation_steps_ = steps;
+  }
+
+
+
+  G4double SolidPointSampler::GetSurfaceArea()
+  {
+    if (triangles_.empty()) BuildSurfaceTable();
+    return cumulative_area_.back();
+  }
+
+
+
+  G4double SolidPointSampler::GetPartialFraction()
+  {
+    if (cells_.empty()) BuildVolumeTable();
+    return partial_volume_ / cumulative_volume_.back();
+  }
+
+
+
+  const G4VSolid* SolidPointSampler::GetSolid()
+  {
+    if (solid_) return solid_;
+
+    // The region of a logical volume is its solid minus those of the
+    // daughters, placed as they are in the volume
+    G4VSolid* solid = logic_->GetSolid();
+    for (size_t i=0; i<logic_->GetNoDaughters(); ++i) {
+      G4VPhysicalVolume* daughter = logic_->GetDaughter(i);
+      if (daughter->IsReplicated())
+        G4Exception("[SolidPointSampler]", "GetSolid()", FatalException,
+                    ("Replicated or parameterised daughters are not supported: " +
+                     daughter->GetName()).c_str());
+
+      G4Transform3D transform(daughter->GetObjectRotationValue(),
+                              daughter->GetObjectTranslation());
+      solid = new G4SubtractionSolid(logic_->GetName() + "_SAMPLED", solid,
+                                     daughter->GetLogicalVolume()->GetSolid(),
+                                     transform);
+    }
+
+    solid_ = solid;
+    return solid_;
+  }
+
+
+
+  void SolidPointSampler::BuildSurfaceTable()
+  {
+    const G4VSolid* solid = GetSolid();
+
+    // The number of segments is a setting of the polyhedra of the
+    // thread, restored once the surface has been triangulated
+    G4int default_steps = HepPolyhedron::GetNumberOfRotationSteps();
+    HepPolyhedron::SetNumberOfRotationSteps(rotation_steps_);
+    G4Polyhedron* polyhedron = solid->CreatePolyhedron();
+    HepPolyhedron::SetNumberOfRotationSteps(default_steps);
+
+    if (!polyhedron)
+      G4Exception("[SolidPointSampler]", "BuildSurfaceTable()", FatalException,
+                  ("The surface of solid " + solid->GetName() +
+                   " cannot be triangulated.").c_str());
+
+    // Facets have 3 or 4 nodes; quadrilaterals are split in two
+    G4double area = 0.;
+    for (G4int i=1; i<=polyhedron->GetNoFacets(); ++i) {
+      G4int nnodes;
+      G4Point3D nodes[4];
+      polyhedron->GetFacet(i, nnodes, nodes);
+
+      for (G4int j=2; j<nnodes; ++j) {
+        Triangle triangle{G4ThreeVector(nodes[0]),
+                          G4ThreeVector(nodes[j-1] - nodes[0]),
+                          G4ThreeVector(nodes[j]   - nodes[0])};
+        G4ThreeVector normal = triangle.edge1.cross(triangle.edge2);
+        G4double triangle_area = normal.mag() / 2.;
+        if (triangle_area <= 0.) continue;
+
+        // Facets are ordered anticlockwise seen from outside the solid
+        triangle.normal = normal.unit();
+        triangle.max_shift = std::max({triangle.edge1.mag(), triangle.edge2.mag(),
+                                       (triangle.edge2 - triangle.edge1).mag()});
+
+        area += triangle_area;
+        triangles_.push_back(triangle);
+        cumulative_area_.push_back(area);
+      }
+    }
+
+    delete polyhedron;
+
+    if (triangles_.empty())
+      G4Exception("[SolidPointSampler]", "BuildSurfaceTable()", FatalException,
+                  ("No surface found in solid " + solid->GetName()).c_str());
+  }
+
+
+
+  void SolidPointSampler::BuildVolumeTable()
+  {
+    const G4VSolid* solid = GetSolid();
+
+    // The table depends on the solid and the voxelization only
+    GeometryCache& cache = GeometryCache::Instance();
+    uint64_t key = GeometryCache::ComputeKey(solid);
+    G4String type = "cells" + std::to_string(nbins_) + "_" + std::to_string(depth_);
+
+    std::vector<G4double> table;
+    if (cache.Read(key, type, table) && ReadVolumeTable(table)) return;
+
+    G4ThreeVector min, max;
+    solid->BoundingLimits(min, max);
+    cell_size_ = (max - min) / nbins_;
+
+    for (G4int k=0; k<nbins_; ++k)
+      for (G4int j=0; j<nbins_; ++j)
+        for (G4int i=0; i<nbins_; ++i)
+          AddCell(min + G4ThreeVector(i * cell_size_.x(),
+                                      j * cell_size_.y(),
+                                      k * cell_size_.z()), 0);
+
+    if (cells_.empty())
+      G4Exception("[SolidPointSampler]", "BuildVolumeTable()", FatalException,
+                  ("No volume found in solid " + solid->GetName()).c_str());
+
+    cache.Write(key, type, WriteVolumeTable());
+  }
+
+
+
+  G4bool SolidPointSampler::ReadVolumeTable(const std::vector<G4double>& table)
+  {
+    // Size of the unrefined cells and volume of the partial cells,
+    // followed by the position, level, partial flag and cumulative
+    // volume of each cell
+    if (table.size() < 4 || (table.size() - 4) % 6 != 0) return false;
+
+    cell_size_ = G4ThreeVector(table[0], table[1], table[2]);
+    partial_volume_ = table[3];
+
+    for (size_t i=4; i<table.size(); i+=6) {
+      cells_.push_back({G4ThreeVector(table[i], table[i+1], table[i+2]),
+                        static_cast<G4int>(table[i+3]), table[i+4] != 0.});
+      cumulative_volume_.push_back(table[i+5]);
+    }
+
+    return !cells_.empty();
+  }
+
+
+
+  std::vector<G4double> SolidPointSampler::WriteVolumeTable() const
+  {
+    std::vector<G4double> table = {cell_size_.x(), cell_size_.y(),
+                                   cell_size_.z(), partial_volume_};
+
+    for (size_t i=0; i<cells_.size(); ++i) {
+      const Cell& cell = cells_[i];
+      table.insert(table.end(), {cell.min.x(), cell.min.y(), cell.min.z(),
+                                 G4double(cell.level), cell.partial ? 1. : 0.,
+                                 cumulative_volume_[i]});
+    }
+
+    return table;
+  }
+
+
+
+  void SolidPointSampler::AddCell(const G4ThreeVector& min, G4int level)
+  {
+    G4ThreeVector size = cell_size_ / std::pow(2., level);
+    G4ThreeVector centre = min + size / 2.;
+    G4double half_diagonal = size.mag() / 2.;
+
+    // A cell is entirely inside (outside) the solid if the isotropic
+    // safety from its centre to the surface exceeds its half diagonal
+    EInside inside = solid_->Inside(centre);
+    if (inside == kOutside && solid_->DistanceToIn(centre) >= half_diagonal)
+      return;
+
+    G4bool partial =
+      !(inside == kInside && solid_->DistanceToOut(centre) >= half_diagonal);
+
+    if (partial && level < depth_) {
+      G4ThreeVector half = size / 2.;
+      for (G4int i=0; i<8; ++i)
+        AddCell(min + G4ThreeVector(i & 1 ? half.x() : 0.,
+                                    i & 2 ? half.y() : 0.,
+                                    i & 4 ? half.z() : 0.), level + 1);
+      return;
+    }
+
+    G4double volume = size.x() * size.y() * size.z();
+    if (partial) partial_volume_ += volume;
+
+    cells_.push_back({min, level, partial});
+    cumulative_volume_.push_back(volume + (cumulative_volume_.empty() ?
+                                           0. : cumulative_volume_.back()));
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::SampleSurface()
+  {
+    const Triangle& triangle = triangles_[SampleIndex(cumulative_area_)];
+
+    // Uniform point in a triangle from its barycentric coordinates
+    G4double u = std::sqrt(G4UniformRand());
+    G4double v = G4UniformRand();
+
+    G4ThreeVector position =
+      triangle.origin + u * (1. - v) * triangle.edge1 + u * v * triangle.edge2;
+
+    // Facets of curved surfaces are chords, up to R(1 - cos(pi/steps))
+    // away from them (0.35 mm for the 1 m radius of the NEXT-100 vessel
+    // with 120 steps), so points are moved along the normal of their
+    // facet onto the surface of the solid. The density of points then
+    // departs from uniform by less than (pi/steps)^2/2 (3e-4 for 120).
+    G4double shift = 0.;
+    EInside inside = solid_->Inside(position);
+    if (inside == kInside)
+      shift = solid_->DistanceToOut(position, triangle.normal);
+    else if (inside == kOutside)
+      shift = -solid_->DistanceToIn(position, -triangle.normal);
+
+    // Not a chord of a curved surface, but a facet crossing other parts
+    // of the solid, where the closest surface is not the one of the facet
+    if (std::abs(shift) > triangle.max_shift) return position;
+
+    return position + shift * triangle.normal;
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::SampleVolume()
+  {
+    // Cells are chosen according to their volume, so a point rejected in
+    // a cell crossed by the surface must be drawn again from the table
+    // and not from the same cell, to keep the distribution uniform
+    for (G4int i=0; i<MAX_TRIALS; ++i) {
+      const Cell& cell = cells_[SampleIndex(cumulative_volume_)];
+      G4ThreeVector size = cell_size_ / std::pow(2., cell.level);
+
+      G4ThreeVector position =
+        cell.min + G4ThreeVector(G4UniformRand() * size.x(),
+                                 G4UniformRand() * size.y(),
+                                 G4UniformRand() * size.z());
+
+      if (!cell.partial || solid_->Inside(position) != kOutside)
+        return position;
+    }
+
+    G4Exception("[SolidPointSampler]", "SampleVolume()", FatalException,
+                ("Cannot generate a vertex in solid " + solid_->GetName()).c_str());
+    return G4ThreeVector();
+  }
+
+
+
+  G4ThreeVector SolidPointSampler::RotateAndTranslate(G4ThreeVector position)
+  {
+    // Rotating if needed
+    if (rotation_) position *= *rotation_;
+    // Translating
+    position += origin_;
+
+    return position;
+  }
+
+} // end namespace nexus
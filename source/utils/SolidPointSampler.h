@@ -0,0 +1,118 @@
+// ----------------------------------------------------------------------------
+// nexus | SolidPointSampler.h
+//
+// This class is a sampler of random uniform points in the volume or on the
+// surface of any Geant4 solid, including boolean ones. The surface is
+// triangulated once into a table of cumulative areas, points on the facets
+// being projected onto the curved surfaces, and the bounding box
+// of the solid is divided into cells, refined near the surface, whose
+// cumulative volumes are tabulated, so that a point costs a binary search.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef SOLID_POINT_SAMPLER_H
+#define SOLID_POINT_SAMPLER_H
+
+#include "RandomUtils.h"
+
+#include <G4ThreeVector.hh>
+#include <G4RotationMatrix.hh>
+
+#include <vector>
+
+class G4VSolid;
+class G4LogicalVolume;
+
+
+namespace nexus {
+
+  class SolidPointSampler
+  {
+  public:
+    /// Constructor. Points are generated in the frame of the solid,
+    /// rotated and translated as in the other point samplers.
+    SolidPointSampler(const G4VSolid* solid,
+                      G4RotationMatrix* rotation = nullptr,
+                      G4ThreeVector     origin   = G4ThreeVector(0,0,0));
+
+    /// Constructor. Points are generated in the solid of the logical
+    /// volume except in its daughters, that is, where the navigator
+    /// would locate the volume itself. The daughters are read the first
+    /// time a vertex is generated, once the geometry is built.
+    SolidPointSampler(const G4LogicalVolume* logic,
+                      G4RotationMatrix* rotation = nullptr,
+                      G4ThreeVector     origin   = G4ThreeVector(0,0,0));
+
+    /// Destructor
+    ~SolidPointSampler();
+
+    /// Returns a vertex in the VOLUME or on the SURFACE of the solid
+    G4ThreeVector GenerateVertex(const vtx_region& region);
+
+    /// Number of cells per axis of the bounding box and number of times
+    /// the cells crossed by the surface are halved. They must be set
+    /// before the first vertex in the volume is generated. The table of
+    /// cells is kept in the GeometryCache, if one is set.
+    void SetVoxelization(G4int nbins, G4int depth);
+
+    /// Number of segments of the curved surfaces in the triangulation
+    /// (120 by default). Points are projected onto the curved surfaces,
+    /// but their density follows the area of the facets, which differs
+    /// from that of the surface by less than (pi/steps)^2/2. It must be
+    /// set before the first vertex on the surface is generated.
+    void SetRotationSteps(G4int steps);
+
+    /// Area of the triangulated surface, which underestimates
+    /// that of convex curved surfaces by up to (pi/steps)^2/6
+    G4double GetSurfaceArea();
+
+    /// Fraction of the volume of the cells that is in cells
+    /// crossed by the surface, where points may be rejected
+    G4double GetPartialFraction();
+
+  private:
+    struct Triangle
+    {
+      G4ThreeVector origin, edge1, edge2;
+      G4ThreeVector normal; ///< Outward unit normal
+      G4double max_shift;   ///< Longest projection onto the surface
+    };
+
+    struct Cell
+    {
+      G4ThreeVector min;
+      G4int  level;   ///< Number of times the cell has been halved
+      G4bool partial; ///< Crossed by the surface of the solid
+    };
+
+    const G4VSolid* GetSolid();
+    void BuildSurfaceTable();
+    void BuildVolumeTable();
+    void AddCell(const G4ThreeVector& min, G4int level);
+    G4bool ReadVolumeTable(const std::vector<G4double>& table);
+    std::vector<G4double> WriteVolumeTable() const;
+    G4ThreeVector SampleSurface();
+    G4ThreeVector SampleVolume();
+    G4ThreeVector RotateAndTranslate(G4ThreeVector position);
+
+  private:
+    const G4VSolid*        solid_;
+    const G4LogicalVolume* logic_;
+    G4RotationMatrix*      rotation_; // Rotation of the solid (if any)
+    G4ThreeVector          origin_;   // Origin of coordinates
+
+    G4int nbins_, depth_, rotation_steps_;
+
+    std::vector<Triangle> triangles_;
+    std::vector<G4double> cumulative_area_;
+
+    G4ThreeVector cell_size_; ///< Size of the unrefined cells
+    std::vector<Cell>     cells_;
+    std::vector<G4double> cumulative_volume_;
+    G4double partial_volume_;
+  };
+
+} // namespace nexus
+
+#endif
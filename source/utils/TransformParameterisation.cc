@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// nexus | TransformParameterisation.cc
+//
+// Parameterisation that places the copies of a G4PVParameterised at a list
+// of transforms, as an alternative to one G4PVPlacement per copy for large
+// arrays of identical volumes (SiPMs, holes of masks, fibre sensors).
+// The copy number of each volume is its index in the list.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "TransformParameterisation.h"
+
+#include <G4VPhysicalVolume.hh>
+
+
+namespace nexus {
+
+  TransformParameterisation::TransformParameterisation
+  (const std::vector<G4ThreeVector>& positions):
+    G4VPVParameterisation(), translations_(positions)
+  {
+  }
+
+
+
+  TransformParameterisation::TransformParameterisation
+  (const std::vector<G4Transform3D>& transforms):
+    G4VPVParameterisation()
+  {
+    // Physical volumes hold the rotation of the frame, which is the
+    // inverse of the rotation of the object (see G4PVPlacement)
+    for (const auto& transform : transforms) {
+      translations_.push_back(transform.getTranslation());
+      rotations_.push_back(transform.getRotation().inverse());
+    }
+  }
+
+
+
+  TransformParameterisation::~TransformParameterisation()
+  {
+  }
+
+
+
+  void TransformParameterisation::ComputeTransformation
+  (const G4int copy_no, G4VPhysicalVolume* physvol) const
+  {
+    physvol->SetTranslation(translations_[copy_no]);
+
+    // The rotation matrices are owned by the parameterisation and
+    // are never modified, so the navigator can keep pointers to them
+    if (!rotations_.empty())
+      physvol->SetRotation(const_cast<G4RotationMatrix*>(&rotations_[copy_no]));
+  }
+
+} // end namespace nexus
@@ -0,0 +1,56 @@
+// ----------------------------------------------------------------------------
+// nexus | TransformParameterisation.h
+//
+// Parameterisation that places the copies of a G4PVParameterised at a list
+// of transforms, as an alternative to one G4PVPlacement per copy for large
+// arrays of identical volumes (SiPMs, holes of masks, fibre sensors).
+// The copy number of each volume is its index in the list.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef TRANSFORM_PARAMETERISATION_H
+#define TRANSFORM_PARAMETERISATION_H
+
+#include <G4VPVParameterisation.hh>
+#include <G4RotationMatrix.hh>
+#include <G4ThreeVector.hh>
+#include <G4Transform3D.hh>
+
+#include <vector>
+
+
+namespace nexus {
+
+  class TransformParameterisation: public G4VPVParameterisation
+  {
+  public:
+    /// Constructor. Copies are translated to the given positions
+    /// without rotation.
+    TransformParameterisation(const std::vector<G4ThreeVector>& positions);
+
+    /// Constructor. Transforms have the same meaning as
+    /// in the G4PVPlacement constructor that takes a G4Transform3D.
+    TransformParameterisation(const std::vector<G4Transform3D>& transforms);
+
+    /// Destructor
+    ~TransformParameterisation();
+
+    void ComputeTransformation(const G4int copy_no,
+                               G4VPhysicalVolume* physvol) const override;
+
+    G4int GetNumberOfCopies() const;
+
+  private:
+    std::vector<G4ThreeVector>    translations_;
+    std::vector<G4RotationMatrix> rotations_; ///< Frame rotations, if any
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4int TransformParameterisation::GetNumberOfCopies() const
+  { return translations_.size(); }
+
+} // end namespace nexus
+
+#endif
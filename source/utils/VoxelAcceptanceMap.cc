@@ -0,0 +1,132 @@
+// ----------------------------------------------------------------------------
+// nexus | VoxelAcceptanceMap.cc
+//
+// This class speeds up the rejection sampling of vertices in regions defined
+// by physical volume names. The bounding box of the sampler is voxelised once
+// and each voxel is classified as fully inside, fully outside or partially
+// inside the region, so that the navigator is only invoked for points that
+// fall in partial voxels.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#include "VoxelAcceptanceMap.h"
+
+#include <G4Navigator.hh>
+#include <G4TransportationManager.hh>
+#include <G4VPhysicalVolume.hh>
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace nexus {
+
+  VoxelAcceptanceMap::VoxelAcceptanceMap(const G4ThreeVector& min,
+                                         const G4ThreeVector& max,
+                                         const std::vector<G4String>& volumes,
+                                         const G4ThreeVector& origin,
+                                         G4int nbins):
+    min_(min), max_(max), origin_(origin), nbins_(nbins), volumes_(volumes),
+    built_(false), navigator_(nullptr), ncalls_(0), nnavigator_(0)
+  {
+    voxel_size_ = (max_ - min_) / nbins_;
+  }
+
+
+
+  VoxelAcceptanceMap::~VoxelAcceptanceMap()
+  {
+  }
+
+
+
+  G4bool VoxelAcceptanceMap::Contains(const G4ThreeVector& vertex)
+  {
+    if (!built_) Build();
+
+    ++ncalls_;
+
+    G4int index[3];
+    for (G4int i=0; i<3; ++i) {
+      index[i] = static_cast<G4int>(std::floor((vertex[i] - min_[i]) / voxel_size_[i]));
+      // Points outside the map are left to the navigator
+      if (index[i] < 0 || index[i] >= nbins_)
+        return LocateInVolumes(vertex);
+    }
+
+    Status status = voxels_[(index[2] * nbins_ + index[1]) * nbins_ + index[0]];
+
+    if (status == PARTIAL) return LocateInVolumes(vertex);
+
+    return status == INSIDE;
+  }
+
+
+
+  void VoxelAcceptanceMap::Build()
+  {
+    navigator_ = G4TransportationManager::GetTransportationManager()->
+      GetNavigatorForTracking();
+
+    voxels_.assign(nbins_ * nbins_ * nbins_, PARTIAL);
+
+    // A voxel is entirely contained in the volume where its centre lies
+    // if the isotropic safety from the centre exceeds its half diagonal
+    G4double half_diagonal = voxel_size_.mag() / 2.;
+
+    for (G4int k=0; k<nbins_; ++k) {
+      for (G4int j=0; j<nbins_; ++j) {
+        for (G4int i=0; i<nbins_; ++i) {
+          G4ThreeVector centre =
+            min_ + G4ThreeVector((i + 0.5) * voxel_size_.x(),
+                                 (j + 0.5) * voxel_size_.y(),
+                                 (k + 0.5) * voxel_size_.z());
+          G4ThreeVector glob_vtx = centre - origin_;
+
+          G4VPhysicalVolume* volume =
+            navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+          if (!volume) continue;
+
+          G4double safety = navigator_->ComputeSafety(glob_vtx);
+          if (safety < half_diagonal) continue;
+
+          voxels_[(k * nbins_ + j) * nbins_ + i] =
+            IsTargetVolume(volume->GetName()) ? INSIDE : OUTSIDE;
+        }
+      }
+    }
+
+    built_ = true;
+  }
+
+
+
+  G4bool VoxelAcceptanceMap::IsTargetVolume(const G4String& name) const
+  {
+    return std::find(volumes_.begin(), volumes_.end(), name) != volumes_.end();
+  }
+
+
+
+  G4bool VoxelAcceptanceMap::LocateInVolumes(const G4ThreeVector& vertex)
+  {
+    ++nnavigator_;
+
+    G4ThreeVector glob_vtx = vertex - origin_;
+    G4VPhysicalVolume* volume =
+      navigator_->LocateGlobalPointAndSetup(glob_vtx, 0, false);
+
+    return volume && IsTargetVolume(volume->GetName());
+  }
+
+
+
+  G4double VoxelAcceptanceMap::GetFraction(Status status) const
+  {
+    if (voxels_.empty()) return 0.;
+    return G4double(std::count(voxels_.begin(), voxels_.end(), status)) /
+      voxels_.size();
+  }
+
+} // end namespace nexus
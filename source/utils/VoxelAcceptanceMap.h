@@ -0,0 +1,96 @@
+// ----------------------------------------------------------------------------
+// nexus | VoxelAcceptanceMap.h
+//
+// This class speeds up the rejection sampling of vertices in regions defined
+// by physical volume names. The bounding box of the sampler is voxelised once
+// and each voxel is classified as fully inside, fully outside or partially
+// inside the region, so that the navigator is only invoked for points that
+// fall in partial voxels.
+//
+// The NEXT Collaboration
+// ----------------------------------------------------------------------------
+
+#ifndef VOXEL_ACCEPTANCE_MAP_H
+#define VOXEL_ACCEPTANCE_MAP_H
+
+#include <G4ThreeVector.hh>
+#include <G4String.hh>
+
+#include <vector>
+
+class G4Navigator;
+
+
+namespace nexus {
+
+  class VoxelAcceptanceMap
+  {
+  public:
+    /// Constructor. The box [min, max] is given in the same frame as the
+    /// vertices to be tested, which is shifted by origin with respect
+    /// to the global frame (global = vertex - origin).
+    VoxelAcceptanceMap(const G4ThreeVector& min, const G4ThreeVector& max,
+                       const std::vector<G4String>& volumes,
+                       const G4ThreeVector& origin = G4ThreeVector(0., 0., 0.),
+                       G4int nbins = 50);
+
+    /// Destructor
+    ~VoxelAcceptanceMap();
+
+    /// Returns true if the vertex lies within one of the volumes. The map
+    /// is built the first time it is called, once the geometry is closed.
+    G4bool Contains(const G4ThreeVector& vertex);
+
+    /// Number of calls and of those that needed the navigator
+    G4long GetNumberOfCalls() const;
+    G4long GetNumberOfNavigatorCalls() const;
+
+    /// Fraction of voxels fully inside, fully outside and partially
+    /// inside the volumes
+    G4double GetInsideFraction() const;
+    G4double GetOutsideFraction() const;
+    G4double GetPartialFraction() const;
+
+  private:
+    enum Status : char {OUTSIDE, INSIDE, PARTIAL};
+
+    void Build();
+    G4bool IsTargetVolume(const G4String& name) const;
+    G4bool LocateInVolumes(const G4ThreeVector& vertex);
+    G4double GetFraction(Status status) const;
+
+  private:
+    G4ThreeVector min_, max_; ///< Voxelised box
+    G4ThreeVector origin_; ///< Shift of the vertex frame w.r.t. the global one
+    G4ThreeVector voxel_size_;
+    G4int nbins_; ///< Number of voxels per axis
+    std::vector<G4String> volumes_; ///< Names of the accepted volumes
+
+    G4bool built_;
+    std::vector<Status> voxels_;
+
+    G4Navigator* navigator_;
+
+    G4long ncalls_, nnavigator_;
+  };
+
+  // INLINE DEFINITIONS //////////////////////////////////////////////
+
+  inline G4long VoxelAcceptanceMap::GetNumberOfCalls() const
+  { return ncalls_; }
+
+  inline G4long VoxelAcceptanceMap::GetNumberOfNavigatorCalls() const
+  { return nnavigator_; }
+
+  inline G4double VoxelAcceptanceMap::GetInsideFraction() const
+  { return GetFraction(INSIDE); }
+
+  inline G4double VoxelAcceptanceMap::GetOutsideFraction() const
+  { return GetFraction(OUTSIDE); }
+
+  inline G4double VoxelAcceptanceMap::GetPartialFraction() const
+  { return GetFraction(PARTIAL); }
+
+} // end namespace nexus
+
+#endif